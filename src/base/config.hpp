@@ -79,6 +79,10 @@ constexpr std::size_t NET_PING_FREQUENCY = 3600;           // seconds
 constexpr std::size_t NET_CONNECT_TIMEOUT = 10;            // seconds
 constexpr std::size_t NET_LOOKUP_ALPHA = 5;                // how many peers to return during lookup
 constexpr std::size_t NET_REQUEST_TIMEOUT = 10; // how many seconds do we wait for a request, until we call it lost
+constexpr std::size_t NET_SNAPSHOT_CHUNK_SIZE = 12 * 1024; // must fit, with a header, into a single message
+constexpr std::size_t NET_SNAPSHOT_TIMEOUT = 60;          // seconds to fetch all snapshot chunks
+constexpr std::size_t NET_RATINGS_FLUSH_PERIOD = 10;      // seconds between writes of changed peer ratings
+constexpr std::size_t NET_RATINGS_CACHE_SIZE = 10'000;    // unchanged peer ratings kept in memory after a flush
 //------------------------
 
 // blockchain
@@ -87,11 +91,20 @@ constexpr std::size_t BC_TARGET_BLOCKS_PER_MINUTE = 1;      // block every 60 /
 constexpr std::size_t BC_DIFFICULTY_RECALCULATION_RATE = 2; // how many blocks must be added to recalculate difficulty
 constexpr std::size_t BC_MAXIMAL_CHANGE_MULTIPLIER = 1'000'000'000; // times complexity could change at once
 constexpr std::size_t BC_EMISSION_VALUE = 1000;
+constexpr std::size_t BC_SNAPSHOT_PERIOD = 1000; // state snapshots for fast sync are made every this number of blocks
+constexpr std::size_t BC_LOAD_PREFETCHED_BLOCKS_COUNT = 256; // blocks deserialized ahead of the added one on loading
+constexpr std::size_t BC_LOGS_SECTION_SIZE = 1024; // blocks, which logs blooms are merged into one kept in memory
 //------------------------
 
 // websocket
 constexpr const std::uint32_t RPC_PUBLIC_API_VERSION = 1;
-constexpr std::size_t RPC_MESSAGE_BUFFER_SIZE = 16 * 1024; // 16KB
+constexpr std::size_t RPC_MESSAGE_BUFFER_SIZE = 16 * 1024;         // 16KB
+constexpr std::size_t RPC_ACCOUNT_TRANSACTIONS_PAGE_SIZE = 100;      // transactions hashes in account_info by default
+constexpr std::size_t RPC_ACCOUNT_TRANSACTIONS_MAX_PAGE_SIZE = 1000; // at most in a single account_info answer
+constexpr std::size_t RPC_CONTRACT_CALL_WORKERS_COUNT = 4;           // threads executing call_contract commands
+constexpr std::uint64_t RPC_CONTRACT_CALL_GAS_LIMIT = 10'000'000;    // of a call_contract, if the fee isn't given
+constexpr std::size_t RPC_FEE_ESTIMATION_THREADS_COUNT = 4;          // concurrent dry runs of a single estimate_fee
+constexpr std::size_t RPC_LOGS_MAX_COUNT = 10'000;                   // at most in a single get_logs answer
 //--------------------
 
 // database
@@ -99,6 +112,18 @@ constexpr std::size_t DATABASE_WRITE_BUFFER_SIZE = 50 * 1024 * 1024;     // 50MB
 constexpr std::size_t DATABASE_DATA_BLOCK_SIZE = 10 * 1024;              // 10KB data-block size
 constexpr std::size_t DATABASE_DATA_BLOCK_CACHE_SIZE = 50 * 1024 * 1024; // 50MB data-block cache size
 constexpr bool DATABASE_COMPRESS_DATA = false;                           // no compress data
+constexpr int DATABASE_BLOOM_FILTER_BITS_PER_KEY = 10;                   // ~1% false positives on missing keys
+constexpr int DATABASE_MAX_OPEN_FILES = 1000;                            // table files kept open
+constexpr bool DATABASE_SYNC_WRITES = true;                              // every write waits for the disk
+constexpr std::size_t DATABASE_BLOCKS_CACHE_SIZE = 64 * 1024 * 1024;     // 64MB of recently used blocks
+constexpr std::size_t DATABASE_STATE_TRIE_CACHE_SIZE = 1'000'000;        // state trie nodes kept in memory
+constexpr std::size_t DATABASE_PRUNING_COMPACTION_PERIOD = 10'000;       // pruned blocks between compactions
+//--------------------
+
+// vm
+constexpr std::size_t VM_CONTRACT_ABI_CACHE_SIZE = 64;       // contracts with parsed ABI kept for encoding and decoding
+constexpr std::int32_t VM_MAX_CALL_DEPTH = 1024;             // nested calls deeper than this fail
+constexpr std::size_t VM_CODE_STORE_SIZE = 16 * 1024 * 1024; // 16MB of recently deployed code shared by contracts
 //--------------------
 
 // keys paths
@@ -78,6 +78,16 @@ base::Secp256PrivateKey loadOrGenerateKey(const std::string_view& keys_dir_path)
     return key;
 }
 
+
+// creation of a context precomputes its tables, so recovery, which is called by contracts, uses a shared one: a
+// context is safe to use concurrently, since it's never changed after the creation
+const secp256k1_context* getVerifyContext()
+{
+    static const std::unique_ptr<secp256k1_context, decltype(&secp256k1_context_destroy)> context(
+      secp256k1_context_create(SECP256K1_CONTEXT_VERIFY), secp256k1_context_destroy);
+    return context.get();
+}
+
 } // namespace
 
 
@@ -366,27 +376,32 @@ base::FixedBytes<Secp256PrivateKey::SECP256_PUBLIC_KEY_SIZE> Secp256PrivateKey::
   const Signature& signature,
   const base::Bytes& bytes_to_check)
 {
-    auto hash = base::Sha256::compute(bytes_to_check);
-    std::unique_ptr<secp256k1_context, decltype(&secp256k1_context_destroy)> context(
-      secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY), secp256k1_context_destroy);
+    return recoverPublicKey(signature, base::Sha256::compute(bytes_to_check).getBytes());
+}
+
 
-    auto sig_data = signature.toBytes();
+base::FixedBytes<Secp256PrivateKey::SECP256_PUBLIC_KEY_SIZE> Secp256PrivateKey::recoverPublicKey(
+  const Signature& signature,
+  const base::FixedBytes<base::Sha256::LENGTH>& hash)
+{
+    const auto* context = getVerifyContext();
+    auto recovery_id = static_cast<int>(signature[SECP256_SIGNATURE_SIZE - 1]);
     secp256k1_ecdsa_recoverable_signature recoverable_signature;
-    if (secp256k1_ecdsa_recoverable_signature_parse_compact(
-          context.get(), &recoverable_signature, sig_data.getData(), static_cast<int>(sig_data[sig_data.size() - 1])) ==
-        0) {
+    if (recovery_id > 3 ||
+        secp256k1_ecdsa_recoverable_signature_parse_compact(
+          context, &recoverable_signature, signature.getData(), recovery_id) == 0) {
         RAISE_ERROR(base::CryptoError, "could not parsed signature");
     }
 
     secp256k1_pubkey pubkey;
-    if (secp256k1_ecdsa_recover(context.get(), &pubkey, &recoverable_signature, hash.getBytes().getData()) == 0) {
+    if (secp256k1_ecdsa_recover(context, &pubkey, &recoverable_signature, hash.getData()) == 0) {
         RAISE_ERROR(base::CryptoError, "recover public key is invalid");
     }
 
     base::FixedBytes<SECP256_PUBLIC_KEY_SIZE> output;
     std::size_t output_size = output.size();
 
-    secp256k1_ec_pubkey_serialize(context.get(), output.getData(), &output_size, &pubkey, SECP256K1_EC_UNCOMPRESSED);
+    secp256k1_ec_pubkey_serialize(context, output.getData(), &output_size, &pubkey, SECP256K1_EC_UNCOMPRESSED);
     if (output_size == 0) {
         RAISE_ERROR(base::CryptoError, "secret key for create public key is invalid");
     }
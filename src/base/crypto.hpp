@@ -83,6 +83,10 @@ class Secp256PrivateKey
     Signature sign(const base::Bytes& bytes_to_sign) const;
     static base::FixedBytes<SECP256_PUBLIC_KEY_SIZE> decodeSignatureToPublicKey(const Signature& signature,
                                                                                 const base::Bytes& bytes_to_check);
+    // the key, which signed the hash, e.g. given to a contract; thread-safe
+    static base::FixedBytes<SECP256_PUBLIC_KEY_SIZE> recoverPublicKey(
+      const Signature& signature,
+      const base::FixedBytes<base::Sha256::LENGTH>& hash);
     //---------------------------
     void save(const std::filesystem::path& path) const;
     static Secp256PrivateKey load(const std::filesystem::path& path);
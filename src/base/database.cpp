@@ -3,79 +3,250 @@
 #include "base/config.hpp"
 #include "base/error.hpp"
 
-#include <leveldb/cache.h>
+#include "base/leveldb_store.hpp"
+#include "base/memory_store.hpp"
 
 namespace base
 {
 
-Database::Database(Directory const& path)
+leveldb::Slice toSlice(const Bytes& bytes) noexcept
 {
-    open(path);
+    return leveldb::Slice(reinterpret_cast<const char*>(bytes.getData()), bytes.size());
 }
 
 
-void Database::open(Directory const& path)
+leveldb::Slice toSlice(std::span<const Byte> bytes) noexcept
 {
-    if (_inited) {
-        RAISE_ERROR(LogicError, "Double initialization of one database instance");
+    return leveldb::Slice(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+}
+
+
+leveldb::Slice toSlice(const leveldb::Slice& slice) noexcept
+{
+    return slice;
+}
+
+
+namespace
+{
+
+// the first key, that is greater than any key with the prefix
+std::string makePrefixLimit(const leveldb::Slice& key_prefix)
+{
+    std::string limit = key_prefix.ToString();
+    while (!limit.empty() && static_cast<unsigned char>(limit.back()) == 0xFF) {
+        limit.pop_back();
     }
-    // reset and set up read options
-    _read_options = leveldb::ReadOptions{};
-    _read_options.fill_cache = true;
-
-    // reset and set up write options
-    _write_options = leveldb::WriteOptions{};
-    _write_options.sync = true;
-
-    // set up database init options;
-    leveldb::Options database_options;
-    database_options.create_if_missing = true;
-    database_options.write_buffer_size = config::DATABASE_WRITE_BUFFER_SIZE;
-    database_options.block_size = config::DATABASE_DATA_BLOCK_SIZE;
-    if constexpr (config::DATABASE_COMPRESS_DATA) {
-        database_options.compression = leveldb::kSnappyCompression; // fast compression
+    if (limit.empty()) {
+        limit.assign(key_prefix.size() + 1, '\xFF');
     }
     else {
-        database_options.compression = leveldb::kNoCompression; // no compress data
+        limit.back() = static_cast<char>(static_cast<unsigned char>(limit.back()) + 1);
     }
+    return limit;
+}
+
+} // namespace
 
-    _cache = std::unique_ptr<leveldb::Cache>(leveldb::NewLRUCache(config::DATABASE_DATA_BLOCK_CACHE_SIZE));
-    database_options.block_cache = _cache.get();
 
-    // create database
-    leveldb::DB* database = nullptr;
-    auto const status = leveldb::DB::Open(database_options, path.string(), &database);
-    if (!status.ok() || database == nullptr) {
-        RAISE_ERROR(base::DatabaseError, "Failed to create database instance.");
+DatabaseOptions readDatabaseOptions(const PropertyTree& config, const std::string& section)
+{
+    DatabaseOptions options;
+    auto read = [&config, &section](const std::string& name, auto& value) {
+        if (const auto path = section + '.' + name; config.hasKey(path)) {
+            value = config.get<std::remove_reference_t<decltype(value)>>(path);
+        }
+    };
+    if (const auto path = section + ".engine"; config.hasKey(path)) {
+        const auto engine = config.get<std::string>(path);
+        if (engine == "leveldb") {
+            options.engine = StorageEngine::LEVELDB;
+        }
+        else if (engine == "memory") {
+            options.engine = StorageEngine::MEMORY;
+        }
+        else {
+            RAISE_ERROR(InvalidArgument, "Unknown storage engine " + engine);
+        }
     }
-    _database.reset(database);
+    read("write_buffer_size", options.write_buffer_size);
+    read("data_block_size", options.data_block_size);
+    read("data_block_cache_size", options.data_block_cache_size);
+    read("bloom_filter_bits_per_key", options.bloom_filter_bits_per_key);
+    read("compression", options.is_compressed);
+    read("max_open_files", options.max_open_files);
+    read("sync_writes", options.is_write_synced);
+    return options;
+}
 
-    // set up guard flag
-    _inited = true;
+
+Database::Database(Directory const& path, const DatabaseOptions& options)
+{
+    open(path, options);
+}
+
+
+Database::Database(std::shared_ptr<KeyValueStore> store)
+  : _store{ std::move(store) }
+{}
+
+
+void Database::open(Directory const& path, const DatabaseOptions& options)
+{
+    if (_store) {
+        RAISE_ERROR(LogicError, "Double initialization of one database instance");
+    }
+
+    switch (options.engine) {
+        case StorageEngine::LEVELDB:
+            _store = std::make_shared<LevelDbStore>(path, options);
+            break;
+        case StorageEngine::MEMORY:
+            _store = std::make_shared<MemoryStore>();
+            break;
+        default:
+            RAISE_ERROR(InvalidArgument, "Unknown storage engine");
+    }
+}
+
+
+bool Database::Batch::isEmpty() const noexcept
+{
+    return _is_empty;
+}
+
+
+void Database::write(Batch&& batch)
+{
+    checkStatus();
+    if (batch.isEmpty()) {
+        return;
+    }
+
+    if (!_write_queue) {
+        _store->write(batch._batch);
+        return;
+    }
+
+    PendingWrite write{ &batch._batch };
+    std::unique_lock lk(_write_queue->mutex);
+    _write_queue->writes.push_back(&write);
+    _write_queue->written.wait(lk, [&] { return write.is_done || _write_queue->writes.front() == &write; });
+    if (!write.is_done) {
+        // the first writer in the queue writes batches of all writers, that are waiting behind it
+        std::vector<PendingWrite*> group(_write_queue->writes.begin(), _write_queue->writes.end());
+        lk.unlock();
+
+        leveldb::WriteBatch merged_batch;
+        auto* batch_to_write = write.batch;
+        if (group.size() > 1) {
+            for (const auto* pending : group) {
+                merged_batch.Append(*pending->batch);
+            }
+            batch_to_write = &merged_batch;
+        }
+        std::exception_ptr error;
+        try {
+            _store->write(*batch_to_write);
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+
+        lk.lock();
+        for (auto* pending : group) {
+            pending->error = error;
+            pending->is_done = true;
+            _write_queue->writes.pop_front();
+        }
+        _write_queue->written.notify_all();
+    }
+
+    if (write.error) {
+        std::rethrow_exception(write.error);
+    }
+}
+
+
+Database Database::getSnapshot() const
+{
+    checkStatus();
+    return Database(_store->getSnapshot());
+}
+
+
+std::optional<std::string> Database::getProperty(const std::string& name) const
+{
+    checkStatus();
+    return _store->getProperty(name);
+}
+
+
+void Database::setGroupCommit(bool is_enabled)
+{
+    if (!is_enabled) {
+        _write_queue.reset();
+    }
+    else if (!_write_queue) {
+        _write_queue = std::make_unique<WriteQueue>();
+    }
 }
 
 
 void Database::checkStatus() const
 {
-    if (!_inited) {
+    if (!_store) {
         RAISE_ERROR(base::DatabaseError, "Database is not inited yet");
     }
 }
 
 
-Database createDefaultDatabaseInstance(Directory const& path)
+bool Database::readValue(const leveldb::Slice& key, std::string& value) const
+{
+    checkStatus();
+    return _store->get(key, value);
+}
+
+
+void Database::scanRange(const leveldb::Slice& key_prefix,
+                         const leveldb::Slice& first_key,
+                         const ScanFunction& on_entry) const
+{
+    checkStatus();
+
+    _store->scan(first_key, [&key_prefix, &on_entry](const leveldb::Slice& key, const leveldb::Slice& value) {
+        return key.starts_with(key_prefix) && on_entry(key, value);
+    });
+}
+
+
+std::uint64_t Database::getApproximateRangeSize(const leveldb::Slice& key_prefix) const
+{
+    checkStatus();
+    return _store->getApproximateSize(key_prefix, makePrefixLimit(key_prefix));
+}
+
+
+void Database::compactRange(const leveldb::Slice& key_prefix)
+{
+    checkStatus();
+    _store->compact(key_prefix, makePrefixLimit(key_prefix));
+}
+
+
+Database createDefaultDatabaseInstance(Directory const& path, const DatabaseOptions& options)
 {
     createIfNotExists(path);
-    return Database(path);
+    return Database(path, options);
 }
 
 
-Database createClearDatabaseInstance(Directory const& path)
+Database createClearDatabaseInstance(Directory const& path, const DatabaseOptions& options)
 {
     if (std::filesystem::exists(path)) {
         std::filesystem::remove_all(path);
     }
-    return createDefaultDatabaseInstance(path);
+    return createDefaultDatabaseInstance(path, options);
 }
 
 
@@ -1,58 +1,173 @@
 #pragma once
 
 #include "base/bytes.hpp"
+#include "base/config.hpp"
 #include "base/directory.hpp"
+#include "base/key_value_store.hpp"
+#include "base/property_tree.hpp"
 
-#include <leveldb/cache.h>
-#include <leveldb/db.h>
+#include <leveldb/slice.h>
+#include <leveldb/write_batch.h>
 
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <filesystem>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <span>
 #include <string>
 
 namespace base
 {
 
+// views the bytes as a database key or value without copying them
+leveldb::Slice toSlice(const Bytes& bytes) noexcept;
+
+template<std::size_t S>
+leveldb::Slice toSlice(const FixedBytes<S>& bytes) noexcept;
+
+leveldb::Slice toSlice(std::span<const Byte> bytes) noexcept;
+
+leveldb::Slice toSlice(const leveldb::Slice& slice) noexcept;
+
+
+enum class StorageEngine
+{
+    LEVELDB, // persistent, on disk
+    MEMORY   // nothing is stored on disk, for tests and benchmarks
+};
+
+// engine and LevelDB tuning of a single database
+struct DatabaseOptions
+{
+    StorageEngine engine{ StorageEngine::LEVELDB };
+    std::size_t write_buffer_size{ config::DATABASE_WRITE_BUFFER_SIZE };
+    std::size_t data_block_size{ config::DATABASE_DATA_BLOCK_SIZE };
+    std::size_t data_block_cache_size{ config::DATABASE_DATA_BLOCK_CACHE_SIZE };
+    int bloom_filter_bits_per_key{ config::DATABASE_BLOOM_FILTER_BITS_PER_KEY }; // 0 disables the filter
+    bool is_compressed{ config::DATABASE_COMPRESS_DATA };
+    int max_open_files{ config::DATABASE_MAX_OPEN_FILES };
+    bool is_write_synced{ config::DATABASE_SYNC_WRITES }; // if false, written data can be lost on OS crash
+};
+
+// options, which are not set in the config section, are left default
+DatabaseOptions readDatabaseOptions(const PropertyTree& config, const std::string& section);
+
 class Database
 {
   public:
+    // changes, which are written to the database at once: either all of them are stored or none
+    class Batch
+    {
+      public:
+        template<typename B1, typename B2>
+        void put(const B1& key, const B2& value);
+
+        template<typename B>
+        void remove(const B& key);
+
+        bool isEmpty() const noexcept;
+
+      private:
+        friend Database;
+
+        leveldb::WriteBatch _batch;
+        bool _is_empty{ true };
+    };
+    //======================
     explicit Database() = default;
-    explicit Database(Directory const& path);
+    explicit Database(Directory const& path, const DatabaseOptions& options = {});
+    // database on top of the given engine, e.g. a wrapper of another engine
+    explicit Database(std::shared_ptr<KeyValueStore> store);
     Database(Database&&) = default;
     Database& operator=(Database&&) = default;
     ~Database() = default;
     //======================
-    void open(Directory const& path);
+    void open(Directory const& path, const DatabaseOptions& options = {});
     //======================
-    template<typename B> // expects base::Bytes or base::FixedBytes<>
+    // keys and values are expected to be base::Bytes, base::FixedBytes<>, std::span<const Byte> or leveldb::Slice
+    template<typename B>
     [[nodiscard]] std::optional<Bytes> get(const B& key) const;
 
+    // reads the value into the caller's buffer, so a reused buffer costs no allocation per read
+    template<typename B>
+    bool get(const B& key, std::string& value) const;
+
     template<typename B>
     bool exists(const B& key) const;
 
+    using ScanFunction = KeyValueStore::ScanFunction;
+
+    // reads all entries, which keys start with the prefix, sequentially
+    template<typename B>
+    void scan(const B& key_prefix, const ScanFunction& on_entry) const;
+
+    // the same, but starts from the first key, that is not less than the given one
+    template<typename B1, typename B2>
+    void scan(const B1& key_prefix, const B2& first_key, const ScanFunction& on_entry) const;
+
     template<typename B1, typename B2>
     void put(const B1& key, const B2& value);
 
     template<typename B>
     void remove(const B& key);
+
+    // writes the whole batch with a single synchronous write
+    void write(Batch&& batch);
+
+    // read-only database, which keeps the current contents regardless of later writes
+    Database getSnapshot() const;
+
+    // engine property, such as "leveldb.stats" or "leveldb.approximate-memory-usage"
+    std::optional<std::string> getProperty(const std::string& name) const;
+
+    // approximate size on disk of the entries, which keys start with the prefix
+    template<typename B>
+    std::uint64_t getApproximateSize(const B& key_prefix) const;
+
+    // rewrites the entries, which keys start with the prefix, dropping the removed ones;
+    // LevelDB does it on its own over time, this only speeds up freeing the disk after mass removals
+    template<typename B>
+    void compact(const B& key_prefix);
+
+    // if enabled, batches written concurrently are merged and written with a single synchronous write;
+    // must not be changed while the database is in use
+    void setGroupCommit(bool is_enabled);
     //======================
   private:
     //======================
-    bool _inited{ false };
-    std::unique_ptr<leveldb::DB> _database;
-    leveldb::ReadOptions _read_options;
-    leveldb::WriteOptions _write_options;
+    struct PendingWrite
+    {
+        leveldb::WriteBatch* batch;
+        bool is_done{ false };
+        std::exception_ptr error{};
+    };
 
-    std::unique_ptr<leveldb::Cache> _cache;
+    struct WriteQueue
+    {
+        std::mutex mutex;
+        std::condition_variable written;
+        std::deque<PendingWrite*> writes;
+    };
+    //======================
+    std::shared_ptr<KeyValueStore> _store;
+    std::unique_ptr<WriteQueue> _write_queue; // set only in the group commit mode
     //=====================
     void checkStatus() const;
+    bool readValue(const leveldb::Slice& key, std::string& value) const;
+    void scanRange(const leveldb::Slice& key_prefix,
+                   const leveldb::Slice& first_key,
+                   const ScanFunction& on_entry) const;
+    std::uint64_t getApproximateRangeSize(const leveldb::Slice& key_prefix) const;
+    void compactRange(const leveldb::Slice& key_prefix);
     //=====================
 };
 
-Database createDefaultDatabaseInstance(Directory const& path);
+Database createDefaultDatabaseInstance(Directory const& path, const DatabaseOptions& options = {});
 
-Database createClearDatabaseInstance(Directory const& path);
+Database createClearDatabaseInstance(Directory const& path, const DatabaseOptions& options = {});
 
 } // namespace base
 
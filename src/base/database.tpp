@@ -2,47 +2,91 @@
 
 namespace base
 {
+
+template<std::size_t S>
+leveldb::Slice toSlice(const FixedBytes<S>& bytes) noexcept
+{
+    return leveldb::Slice(reinterpret_cast<const char*>(bytes.getData()), bytes.size());
+}
+
+
 template<typename B1, typename B2>
 void Database::put(const B1& key, const B2& value)
 {
     checkStatus();
-
-    auto const status = _database->Put(_write_options, key.toString(), value.toString());
-    if (!status.ok()) {
-        RAISE_ERROR(base::DatabaseError, status.ToString());
-    }
+    _store->put(toSlice(key), toSlice(value));
 }
 
 
 template<typename B>
 std::optional<Bytes> Database::get(const B& key) const
 {
-    checkStatus();
-
-    std::string value;
-    auto const status = _database->Get(_read_options, key.toString(), &value);
-    if (!status.ok()) {
+    thread_local std::string value;
+    if (!readValue(toSlice(key), value)) {
         return std::nullopt;
     }
-    return Bytes(value);
+    return Bytes(reinterpret_cast<const Byte*>(value.data()), value.size());
+}
+
+
+template<typename B>
+bool Database::get(const B& key, std::string& value) const
+{
+    return readValue(toSlice(key), value);
 }
 
 
 template<typename B>
 bool Database::exists(const B& key) const
 {
-    checkStatus();
+    // with LevelDB the bloom filter answers for most missing keys without reading the data blocks
+    thread_local std::string value;
+    return readValue(toSlice(key), value);
+}
 
-    std::string value;
-    auto const status = _database->Get(_read_options, key.toString(), &value);
-    if (status.IsNotFound()) {
-        return false;
-    }
-    if (!status.ok()) {
-        RAISE_ERROR(base::DatabaseError, status.ToString());
-    }
 
-    return true;
+template<typename B>
+void Database::scan(const B& key_prefix, const ScanFunction& on_entry) const
+{
+    const auto prefix = toSlice(key_prefix);
+    scanRange(prefix, prefix, on_entry);
+}
+
+
+template<typename B1, typename B2>
+void Database::scan(const B1& key_prefix, const B2& first_key, const ScanFunction& on_entry) const
+{
+    scanRange(toSlice(key_prefix), toSlice(first_key), on_entry);
+}
+
+
+template<typename B>
+std::uint64_t Database::getApproximateSize(const B& key_prefix) const
+{
+    return getApproximateRangeSize(toSlice(key_prefix));
+}
+
+
+template<typename B>
+void Database::compact(const B& key_prefix)
+{
+    compactRange(toSlice(key_prefix));
+}
+
+
+template<typename B1, typename B2>
+void Database::Batch::put(const B1& key, const B2& value)
+{
+    _batch.Put(toSlice(key), toSlice(value));
+    _is_empty = false;
+}
+
+
+template<typename B>
+void Database::Batch::remove(const B& key)
+{
+    _batch.Delete(toSlice(key));
+    _is_empty = false;
 }
 
 
@@ -50,11 +94,7 @@ template<typename B>
 void Database::remove(const B& key)
 {
     checkStatus();
-
-    auto const status = _database->Delete(_write_options, key.toString());
-    if (!status.ok()) {
-        RAISE_ERROR(base::DatabaseError, status.ToString());
-    }
+    _store->remove(toSlice(key));
 }
 
 } // namespace base
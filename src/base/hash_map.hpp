@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace base
+{
+
+// Cheap hash for keys, whose bytes are already uniformly distributed (hashes, addresses): only the first 8 bytes
+// are taken and mixed with a per-process seed, so colliding keys cannot be picked in advance.
+template<typename T>
+struct PrefixHash
+{
+    std::size_t operator()(const T& key) const noexcept;
+};
+
+
+// Hash for fixed-size keys, whose bytes are not uniformly distributed (e.g. storage slots of contracts, which are
+// mostly small numbers): every 8 bytes of the key are mixed in.
+template<typename T>
+struct WordsHash
+{
+    std::size_t operator()(const T& key) const noexcept;
+};
+
+
+// std::hash of an integer is usually the identity, so consecutive keys (e.g. block depths) would make a single
+// cluster of the probing array, which every erasure walks through; the bits of the key are mixed instead.
+template<typename T>
+struct IntegerHash
+{
+    std::size_t operator()(T key) const noexcept;
+};
+
+
+// Open-addressing hash map with linear probing. The probing array holds only hashes and pointers to
+// individually allocated entries, so references to keys and values stay valid until the entry is erased,
+// even if the table is rehashed. Iterators are invalidated by any insertion or erasure.
+template<typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+class HashMap
+{
+  public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<const K, V>;
+    using size_type = std::size_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+
+  private:
+    struct Slot
+    {
+        std::size_t hash{ 0 };
+        std::unique_ptr<value_type> entry;
+    };
+
+  public:
+    template<bool IsConst>
+    class Iterator
+    {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = HashMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const value_type*, value_type*>;
+        using reference = std::conditional_t<IsConst, const value_type&, value_type&>;
+        using SlotPointer = std::conditional_t<IsConst, const Slot*, Slot*>;
+        //================
+        Iterator() = default;
+        Iterator(SlotPointer current, SlotPointer end);
+        operator Iterator<true>() const;
+        //================
+        reference operator*() const;
+        pointer operator->() const;
+        Iterator& operator++();
+        Iterator operator++(int);
+        //================
+        bool operator==(const Iterator& other) const;
+        bool operator!=(const Iterator& other) const;
+        //================
+      private:
+        SlotPointer _current{ nullptr };
+        SlotPointer _end{ nullptr };
+
+        void skipEmpty();
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+    //================
+    HashMap() = default;
+    HashMap(const HashMap& other);
+    HashMap(HashMap&& other) noexcept;
+    HashMap& operator=(const HashMap& other);
+    HashMap& operator=(HashMap&& other) noexcept;
+    ~HashMap() = default;
+    //================
+    iterator begin() noexcept;
+    iterator end() noexcept;
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+    //================
+    bool empty() const noexcept;
+    size_type size() const noexcept;
+    size_type capacity() const noexcept;
+    void clear() noexcept;
+    void reserve(size_type count);
+    //================
+    iterator find(const K& key);
+    const_iterator find(const K& key) const;
+    bool contains(const K& key) const;
+    //================
+    V& operator[](const K& key);
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace(const K& key, Args&&... args);
+    template<typename M>
+    std::pair<iterator, bool> insert_or_assign(const K& key, M&& value);
+    std::pair<iterator, bool> insert(value_type value);
+    size_type erase(const K& key);
+    //================
+  private:
+    static constexpr size_type NOT_FOUND = static_cast<size_type>(-1);
+    static constexpr size_type MIN_CAPACITY = 16;
+
+    std::vector<Slot> _slots; // capacity is always a power of 2
+    size_type _size{ 0 };
+    Hash _hash;
+    KeyEqual _equal;
+
+    size_type _findIndex(const K& key, std::size_t hash) const;
+    size_type _findFreeIndex(std::size_t hash) const;
+    iterator _iteratorAt(size_type index);
+    void _reserveForInsertion();
+    void _rehash(size_type new_capacity);
+};
+
+} // namespace base
+
+#include "hash_map.tpp"
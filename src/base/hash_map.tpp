@@ -0,0 +1,447 @@
+#pragma once
+
+#include "hash_map.hpp"
+
+#include "base/assert.hpp"
+
+#include <cstring>
+#include <random>
+
+namespace impl
+{
+
+inline std::uint64_t prefixHashSeed()
+{
+    static const std::uint64_t seed = [] {
+        std::random_device device;
+        return (static_cast<std::uint64_t>(device()) << 32) | device();
+    }();
+    return seed;
+}
+
+} // namespace impl
+
+
+namespace base
+{
+
+
+template<typename T>
+std::size_t PrefixHash<T>::operator()(const T& key) const noexcept
+{
+    const auto& bytes = key.getBytes();
+    static_assert(sizeof(bytes) >= sizeof(std::uint64_t), "key is too short for PrefixHash");
+
+    std::uint64_t prefix;
+    std::memcpy(&prefix, bytes.getData(), sizeof(prefix));
+    prefix ^= impl::prefixHashSeed();
+    prefix *= 0x9E3779B97F4A7C15ull;
+    return static_cast<std::size_t>(prefix ^ (prefix >> 32));
+}
+
+
+template<typename T>
+std::size_t WordsHash<T>::operator()(const T& key) const noexcept
+{
+    const auto& bytes = key.toArray();
+    static_assert(sizeof(bytes) % sizeof(std::uint64_t) == 0, "key size must be a multiple of 8 for WordsHash");
+
+    std::uint64_t hash = impl::prefixHashSeed();
+    for (std::size_t offset = 0; offset < sizeof(bytes); offset += sizeof(std::uint64_t)) {
+        std::uint64_t word;
+        std::memcpy(&word, bytes.data() + offset, sizeof(word));
+        hash = (hash ^ word) * 0x9E3779B97F4A7C15ull;
+        hash ^= hash >> 29;
+    }
+    return static_cast<std::size_t>(hash ^ (hash >> 32));
+}
+
+
+template<typename T>
+std::size_t IntegerHash<T>::operator()(T key) const noexcept
+{
+    auto value = static_cast<std::uint64_t>(key) * 0x9E3779B97F4A7C15ull;
+    return static_cast<std::size_t>(value ^ (value >> 32));
+}
+
+//================================================
+
+template<typename K, typename V, typename H, typename E>
+template<bool IsConst>
+HashMap<K, V, H, E>::Iterator<IsConst>::Iterator(SlotPointer current, SlotPointer end)
+  : _current{ current }
+  , _end{ end }
+{
+    skipEmpty();
+}
+
+
+template<typename K, typename V, typename H, typename E>
+template<bool IsConst>
+HashMap<K, V, H, E>::Iterator<IsConst>::operator Iterator<true>() const
+{
+    return Iterator<true>{ _current, _end };
+}
+
+
+template<typename K, typename V, typename H, typename E>
+template<bool IsConst>
+typename HashMap<K, V, H, E>::template Iterator<IsConst>::reference HashMap<K, V, H, E>::Iterator<IsConst>::operator*()
+  const
+{
+    return *_current->entry;
+}
+
+
+template<typename K, typename V, typename H, typename E>
+template<bool IsConst>
+typename HashMap<K, V, H, E>::template Iterator<IsConst>::pointer HashMap<K, V, H, E>::Iterator<IsConst>::operator->()
+  const
+{
+    return _current->entry.get();
+}
+
+
+template<typename K, typename V, typename H, typename E>
+template<bool IsConst>
+typename HashMap<K, V, H, E>::template Iterator<IsConst>& HashMap<K, V, H, E>::Iterator<IsConst>::operator++()
+{
+    ++_current;
+    skipEmpty();
+    return *this;
+}
+
+
+template<typename K, typename V, typename H, typename E>
+template<bool IsConst>
+typename HashMap<K, V, H, E>::template Iterator<IsConst> HashMap<K, V, H, E>::Iterator<IsConst>::operator++(int)
+{
+    auto ret = *this;
+    ++*this;
+    return ret;
+}
+
+
+template<typename K, typename V, typename H, typename E>
+template<bool IsConst>
+bool HashMap<K, V, H, E>::Iterator<IsConst>::operator==(const Iterator& other) const
+{
+    return _current == other._current;
+}
+
+
+template<typename K, typename V, typename H, typename E>
+template<bool IsConst>
+bool HashMap<K, V, H, E>::Iterator<IsConst>::operator!=(const Iterator& other) const
+{
+    return _current != other._current;
+}
+
+
+template<typename K, typename V, typename H, typename E>
+template<bool IsConst>
+void HashMap<K, V, H, E>::Iterator<IsConst>::skipEmpty()
+{
+    while (_current != _end && !_current->entry) {
+        ++_current;
+    }
+}
+
+//================================================
+
+template<typename K, typename V, typename H, typename E>
+HashMap<K, V, H, E>::HashMap(const HashMap& other)
+  : _slots(other._slots.size())
+  , _size{ other._size }
+  , _hash{ other._hash }
+  , _equal{ other._equal }
+{
+    for (size_type i = 0; i < _slots.size(); ++i) {
+        if (const auto& slot = other._slots[i]; slot.entry) {
+            _slots[i].hash = slot.hash;
+            _slots[i].entry = std::make_unique<value_type>(*slot.entry);
+        }
+    }
+}
+
+
+template<typename K, typename V, typename H, typename E>
+HashMap<K, V, H, E>::HashMap(HashMap&& other) noexcept
+  : _slots{ std::move(other._slots) }
+  , _size{ other._size }
+  , _hash{ std::move(other._hash) }
+  , _equal{ std::move(other._equal) }
+{
+    other._slots.clear();
+    other._size = 0;
+}
+
+
+template<typename K, typename V, typename H, typename E>
+HashMap<K, V, H, E>& HashMap<K, V, H, E>::operator=(const HashMap& other)
+{
+    if (this != &other) {
+        HashMap copy{ other };
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+
+template<typename K, typename V, typename H, typename E>
+HashMap<K, V, H, E>& HashMap<K, V, H, E>::operator=(HashMap&& other) noexcept
+{
+    if (this != &other) {
+        _slots = std::move(other._slots);
+        _size = other._size;
+        _hash = std::move(other._hash);
+        _equal = std::move(other._equal);
+        other._slots.clear();
+        other._size = 0;
+    }
+    return *this;
+}
+
+
+template<typename K, typename V, typename H, typename E>
+typename HashMap<K, V, H, E>::iterator HashMap<K, V, H, E>::begin() noexcept
+{
+    return iterator{ _slots.data(), _slots.data() + _slots.size() };
+}
+
+
+template<typename K, typename V, typename H, typename E>
+typename HashMap<K, V, H, E>::iterator HashMap<K, V, H, E>::end() noexcept
+{
+    return iterator{ _slots.data() + _slots.size(), _slots.data() + _slots.size() };
+}
+
+
+template<typename K, typename V, typename H, typename E>
+typename HashMap<K, V, H, E>::const_iterator HashMap<K, V, H, E>::begin() const noexcept
+{
+    return const_iterator{ _slots.data(), _slots.data() + _slots.size() };
+}
+
+
+template<typename K, typename V, typename H, typename E>
+typename HashMap<K, V, H, E>::const_iterator HashMap<K, V, H, E>::end() const noexcept
+{
+    return const_iterator{ _slots.data() + _slots.size(), _slots.data() + _slots.size() };
+}
+
+
+template<typename K, typename V, typename H, typename E>
+bool HashMap<K, V, H, E>::empty() const noexcept
+{
+    return _size == 0;
+}
+
+
+template<typename K, typename V, typename H, typename E>
+typename HashMap<K, V, H, E>::size_type HashMap<K, V, H, E>::size() const noexcept
+{
+    return _size;
+}
+
+
+template<typename K, typename V, typename H, typename E>
+typename HashMap<K, V, H, E>::size_type HashMap<K, V, H, E>::capacity() const noexcept
+{
+    return _slots.size();
+}
+
+
+template<typename K, typename V, typename H, typename E>
+void HashMap<K, V, H, E>::clear() noexcept
+{
+    _slots.clear();
+    _size = 0;
+}
+
+
+template<typename K, typename V, typename H, typename E>
+void HashMap<K, V, H, E>::reserve(size_type count)
+{
+    size_type new_capacity = MIN_CAPACITY;
+    while (new_capacity / 4 * 3 < count) {
+        new_capacity *= 2;
+    }
+    if (new_capacity > _slots.size()) {
+        _rehash(new_capacity);
+    }
+}
+
+
+template<typename K, typename V, typename H, typename E>
+typename HashMap<K, V, H, E>::iterator HashMap<K, V, H, E>::find(const K& key)
+{
+    if (auto index = _findIndex(key, _hash(key)); index != NOT_FOUND) {
+        return _iteratorAt(index);
+    }
+    return end();
+}
+
+
+template<typename K, typename V, typename H, typename E>
+typename HashMap<K, V, H, E>::const_iterator HashMap<K, V, H, E>::find(const K& key) const
+{
+    if (auto index = _findIndex(key, _hash(key)); index != NOT_FOUND) {
+        return const_iterator{ _slots.data() + index, _slots.data() + _slots.size() };
+    }
+    return end();
+}
+
+
+template<typename K, typename V, typename H, typename E>
+bool HashMap<K, V, H, E>::contains(const K& key) const
+{
+    return _findIndex(key, _hash(key)) != NOT_FOUND;
+}
+
+
+template<typename K, typename V, typename H, typename E>
+V& HashMap<K, V, H, E>::operator[](const K& key)
+{
+    return try_emplace(key).first->second;
+}
+
+
+template<typename K, typename V, typename H, typename E>
+template<typename... Args>
+std::pair<typename HashMap<K, V, H, E>::iterator, bool> HashMap<K, V, H, E>::try_emplace(const K& key,
+                                                                                        Args&&... args)
+{
+    auto hash = _hash(key);
+    if (auto index = _findIndex(key, hash); index != NOT_FOUND) {
+        return { _iteratorAt(index), false };
+    }
+
+    _reserveForInsertion();
+    auto index = _findFreeIndex(hash);
+    _slots[index].hash = hash;
+    _slots[index].entry = std::make_unique<value_type>(
+      std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+    ++_size;
+    return { _iteratorAt(index), true };
+}
+
+
+template<typename K, typename V, typename H, typename E>
+template<typename M>
+std::pair<typename HashMap<K, V, H, E>::iterator, bool> HashMap<K, V, H, E>::insert_or_assign(const K& key, M&& value)
+{
+    auto hash = _hash(key);
+    if (auto index = _findIndex(key, hash); index != NOT_FOUND) {
+        _slots[index].entry->second = std::forward<M>(value);
+        return { _iteratorAt(index), false };
+    }
+    return try_emplace(key, std::forward<M>(value));
+}
+
+
+template<typename K, typename V, typename H, typename E>
+std::pair<typename HashMap<K, V, H, E>::iterator, bool> HashMap<K, V, H, E>::insert(value_type value)
+{
+    return try_emplace(value.first, std::move(value.second));
+}
+
+
+template<typename K, typename V, typename H, typename E>
+typename HashMap<K, V, H, E>::size_type HashMap<K, V, H, E>::erase(const K& key)
+{
+    auto index = _findIndex(key, _hash(key));
+    if (index == NOT_FOUND) {
+        return 0;
+    }
+
+    // backward shift deletion: entries that were displaced past the erased slot are moved back,
+    // so that lookups never need tombstones
+    const auto mask = _slots.size() - 1;
+    auto hole = index;
+    for (auto next = (hole + 1) & mask; _slots[next].entry; next = (next + 1) & mask) {
+        auto ideal = _slots[next].hash & mask;
+        bool stays = hole <= next ? (hole < ideal && ideal <= next) : (hole < ideal || ideal <= next);
+        if (!stays) {
+            _slots[hole] = std::move(_slots[next]);
+            hole = next;
+        }
+    }
+    _slots[hole].entry.reset();
+    _slots[hole].hash = 0;
+    --_size;
+    return 1;
+}
+
+
+template<typename K, typename V, typename H, typename E>
+typename HashMap<K, V, H, E>::size_type HashMap<K, V, H, E>::_findIndex(const K& key, std::size_t hash) const
+{
+    if (_slots.empty()) {
+        return NOT_FOUND;
+    }
+    const auto mask = _slots.size() - 1;
+    for (auto index = hash & mask;; index = (index + 1) & mask) {
+        const auto& slot = _slots[index];
+        if (!slot.entry) {
+            return NOT_FOUND;
+        }
+        if (slot.hash == hash && _equal(slot.entry->first, key)) {
+            return index;
+        }
+    }
+}
+
+
+template<typename K, typename V, typename H, typename E>
+typename HashMap<K, V, H, E>::size_type HashMap<K, V, H, E>::_findFreeIndex(std::size_t hash) const
+{
+    ASSERT(_size < _slots.size());
+    const auto mask = _slots.size() - 1;
+    auto index = hash & mask;
+    while (_slots[index].entry) {
+        index = (index + 1) & mask;
+    }
+    return index;
+}
+
+
+template<typename K, typename V, typename H, typename E>
+typename HashMap<K, V, H, E>::iterator HashMap<K, V, H, E>::_iteratorAt(size_type index)
+{
+    return iterator{ _slots.data() + index, _slots.data() + _slots.size() };
+}
+
+
+template<typename K, typename V, typename H, typename E>
+void HashMap<K, V, H, E>::_reserveForInsertion()
+{
+    // keeping load factor not greater than 3/4
+    if (_slots.empty()) {
+        _rehash(MIN_CAPACITY);
+    }
+    else if ((_size + 1) * 4 > _slots.size() * 3) {
+        _rehash(_slots.size() * 2);
+    }
+}
+
+
+template<typename K, typename V, typename H, typename E>
+void HashMap<K, V, H, E>::_rehash(size_type new_capacity)
+{
+    std::vector<Slot> old_slots(new_capacity);
+    old_slots.swap(_slots);
+
+    const auto mask = _slots.size() - 1;
+    for (auto& slot : old_slots) {
+        if (slot.entry) {
+            auto index = slot.hash & mask;
+            while (_slots[index].entry) {
+                index = (index + 1) & mask;
+            }
+            _slots[index] = std::move(slot);
+        }
+    }
+}
+
+} // namespace base
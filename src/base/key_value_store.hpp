@@ -0,0 +1,52 @@
+#pragma once
+
+#include <leveldb/slice.h>
+#include <leveldb/write_batch.h>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace base
+{
+
+// ordered key-value storage engine, on which base::Database is built;
+// all methods raise base::DatabaseError on engine failures
+class KeyValueStore
+{
+  public:
+    // called for the entries in the order of their keys; the slices are valid only during the call,
+    // returning false stops the scan
+    using ScanFunction = std::function<bool(const leveldb::Slice& key, const leveldb::Slice& value)>;
+    //======================
+    virtual ~KeyValueStore() = default;
+    //======================
+    // returns false, if there is no such key
+    virtual bool get(const leveldb::Slice& key, std::string& value) const = 0;
+
+    virtual void put(const leveldb::Slice& key, const leveldb::Slice& value) = 0;
+
+    virtual void remove(const leveldb::Slice& key) = 0;
+
+    // applies all changes of the batch atomically
+    virtual void write(leveldb::WriteBatch& batch) = 0;
+
+    // reads entries starting with the first key, that is not less than the given one;
+    // the entries are read from a consistent state, so writes made during the scan are not seen
+    virtual void scan(const leveldb::Slice& begin, const ScanFunction& on_entry) const = 0;
+
+    // store, which keeps the current contents regardless of later writes; writes to it raise base::LogicError
+    virtual std::shared_ptr<KeyValueStore> getSnapshot() const = 0;
+
+    virtual std::optional<std::string> getProperty(const std::string& name) const = 0;
+
+    // approximate size of the entries with keys in range [begin, end)
+    virtual std::uint64_t getApproximateSize(const leveldb::Slice& begin, const leveldb::Slice& end) const = 0;
+
+    // reclaims the space of removed and overwritten entries with keys in range [begin, end)
+    virtual void compact(const leveldb::Slice& begin, const leveldb::Slice& end) = 0;
+};
+
+} // namespace base
@@ -0,0 +1,230 @@
+#include "leveldb_store.hpp"
+
+#include "base/error.hpp"
+
+#include <leveldb/iterator.h>
+
+namespace base
+{
+
+class LevelDbStore::Snapshot : public KeyValueStore
+{
+  public:
+    explicit Snapshot(std::shared_ptr<const LevelDbStore> origin)
+      : _origin{ std::move(origin) }
+      , _snapshot{ _origin->_database->GetSnapshot() }
+    {
+        _read_options = _origin->_read_options;
+        _read_options.snapshot = _snapshot;
+    }
+
+    Snapshot(const Snapshot&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+
+    ~Snapshot() override
+    {
+        _origin->_database->ReleaseSnapshot(_snapshot);
+    }
+
+
+    bool get(const leveldb::Slice& key, std::string& value) const override
+    {
+        return _origin->readValue(_read_options, key, value);
+    }
+
+
+    void put(const leveldb::Slice&, const leveldb::Slice&) override
+    {
+        RAISE_ERROR(LogicError, "Database snapshot is read-only");
+    }
+
+
+    void remove(const leveldb::Slice&) override
+    {
+        RAISE_ERROR(LogicError, "Database snapshot is read-only");
+    }
+
+
+    void write(leveldb::WriteBatch&) override
+    {
+        RAISE_ERROR(LogicError, "Database snapshot is read-only");
+    }
+
+
+    void scan(const leveldb::Slice& begin, const ScanFunction& on_entry) const override
+    {
+        _origin->scanFrom(_read_options, begin, on_entry);
+    }
+
+
+    std::shared_ptr<KeyValueStore> getSnapshot() const override
+    {
+        return std::make_shared<Snapshot>(_origin);
+    }
+
+
+    std::optional<std::string> getProperty(const std::string& name) const override
+    {
+        return _origin->getProperty(name);
+    }
+
+
+    std::uint64_t getApproximateSize(const leveldb::Slice& begin, const leveldb::Slice& end) const override
+    {
+        return _origin->getApproximateSize(begin, end);
+    }
+
+
+    void compact(const leveldb::Slice&, const leveldb::Slice&) override
+    {
+        RAISE_ERROR(LogicError, "Database snapshot is read-only");
+    }
+
+  private:
+    std::shared_ptr<const LevelDbStore> _origin;
+    const leveldb::Snapshot* _snapshot;
+    leveldb::ReadOptions _read_options;
+};
+
+
+LevelDbStore::LevelDbStore(const Directory& path, const DatabaseOptions& options)
+{
+    // set up read options
+    _read_options.fill_cache = true;
+
+    // set up write options
+    _write_options.sync = options.is_write_synced;
+
+    // set up database init options;
+    leveldb::Options database_options;
+    database_options.create_if_missing = true;
+    database_options.write_buffer_size = options.write_buffer_size;
+    database_options.block_size = options.data_block_size;
+    database_options.max_open_files = options.max_open_files;
+    if (options.is_compressed) {
+        database_options.compression = leveldb::kSnappyCompression; // fast compression
+    }
+    else {
+        database_options.compression = leveldb::kNoCompression; // no compress data
+    }
+
+    _cache = std::unique_ptr<leveldb::Cache>(leveldb::NewLRUCache(options.data_block_cache_size));
+    database_options.block_cache = _cache.get();
+
+    if (options.bloom_filter_bits_per_key > 0) {
+        _filter_policy.reset(leveldb::NewBloomFilterPolicy(options.bloom_filter_bits_per_key));
+        database_options.filter_policy = _filter_policy.get();
+    }
+
+    // create database
+    leveldb::DB* database = nullptr;
+    auto const status = leveldb::DB::Open(database_options, path.string(), &database);
+    if (!status.ok() || database == nullptr) {
+        RAISE_ERROR(base::DatabaseError, "Failed to create database instance.");
+    }
+    _database.reset(database);
+}
+
+
+bool LevelDbStore::get(const leveldb::Slice& key, std::string& value) const
+{
+    return readValue(_read_options, key, value);
+}
+
+
+void LevelDbStore::put(const leveldb::Slice& key, const leveldb::Slice& value)
+{
+    auto const status = _database->Put(_write_options, key, value);
+    if (!status.ok()) {
+        RAISE_ERROR(base::DatabaseError, status.ToString());
+    }
+}
+
+
+void LevelDbStore::remove(const leveldb::Slice& key)
+{
+    auto const status = _database->Delete(_write_options, key);
+    if (!status.ok()) {
+        RAISE_ERROR(base::DatabaseError, status.ToString());
+    }
+}
+
+
+void LevelDbStore::write(leveldb::WriteBatch& batch)
+{
+    auto const status = _database->Write(_write_options, &batch);
+    if (!status.ok()) {
+        RAISE_ERROR(base::DatabaseError, status.ToString());
+    }
+}
+
+
+void LevelDbStore::scan(const leveldb::Slice& begin, const ScanFunction& on_entry) const
+{
+    scanFrom(_read_options, begin, on_entry);
+}
+
+
+std::shared_ptr<KeyValueStore> LevelDbStore::getSnapshot() const
+{
+    return std::make_shared<Snapshot>(shared_from_this());
+}
+
+
+std::optional<std::string> LevelDbStore::getProperty(const std::string& name) const
+{
+    std::string value;
+    if (!_database->GetProperty(name, &value)) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+
+std::uint64_t LevelDbStore::getApproximateSize(const leveldb::Slice& begin, const leveldb::Slice& end) const
+{
+    leveldb::Range range{ begin, end };
+    std::uint64_t size = 0;
+    _database->GetApproximateSizes(&range, 1, &size);
+    return size;
+}
+
+
+void LevelDbStore::compact(const leveldb::Slice& begin, const leveldb::Slice& end)
+{
+    _database->CompactRange(&begin, &end);
+}
+
+
+bool LevelDbStore::readValue(const leveldb::ReadOptions& read_options,
+                             const leveldb::Slice& key,
+                             std::string& value) const
+{
+    auto const status = _database->Get(read_options, key, &value);
+    if (status.IsNotFound()) {
+        return false;
+    }
+    if (!status.ok()) {
+        RAISE_ERROR(base::DatabaseError, status.ToString());
+    }
+    return true;
+}
+
+
+void LevelDbStore::scanFrom(leveldb::ReadOptions read_options,
+                            const leveldb::Slice& begin,
+                            const ScanFunction& on_entry) const
+{
+    read_options.fill_cache = false; // a bulk read would only evict the blocks, that are read often
+    std::unique_ptr<leveldb::Iterator> it(_database->NewIterator(read_options));
+    for (it->Seek(begin); it->Valid(); it->Next()) {
+        if (!on_entry(it->key(), it->value())) {
+            return;
+        }
+    }
+    if (!it->status().ok()) {
+        RAISE_ERROR(base::DatabaseError, it->status().ToString());
+    }
+}
+
+} // namespace base
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "base/database.hpp"
+#include "base/directory.hpp"
+#include "base/key_value_store.hpp"
+
+#include <leveldb/cache.h>
+#include <leveldb/db.h>
+#include <leveldb/filter_policy.h>
+
+#include <memory>
+
+namespace base
+{
+
+// persistent engine, which keeps the data in a LevelDB database on disk
+class LevelDbStore
+  : public KeyValueStore
+  , public std::enable_shared_from_this<LevelDbStore>
+{
+  public:
+    //======================
+    LevelDbStore(const Directory& path, const DatabaseOptions& options);
+    LevelDbStore(const LevelDbStore&) = delete;
+    LevelDbStore& operator=(const LevelDbStore&) = delete;
+    ~LevelDbStore() override = default;
+    //======================
+    bool get(const leveldb::Slice& key, std::string& value) const override;
+
+    void put(const leveldb::Slice& key, const leveldb::Slice& value) override;
+
+    void remove(const leveldb::Slice& key) override;
+
+    void write(leveldb::WriteBatch& batch) override;
+
+    void scan(const leveldb::Slice& begin, const ScanFunction& on_entry) const override;
+
+    // the store must be owned by a std::shared_ptr, since the snapshot keeps it alive
+    std::shared_ptr<KeyValueStore> getSnapshot() const override;
+
+    std::optional<std::string> getProperty(const std::string& name) const override;
+
+    std::uint64_t getApproximateSize(const leveldb::Slice& begin, const leveldb::Slice& end) const override;
+
+    void compact(const leveldb::Slice& begin, const leveldb::Slice& end) override;
+    //======================
+  private:
+    class Snapshot;
+    //======================
+    // declared before the database, so they are still alive while the database is closed
+    std::unique_ptr<const leveldb::FilterPolicy> _filter_policy; // lets lookups of missing keys skip data blocks
+    std::unique_ptr<leveldb::Cache> _cache;
+    std::unique_ptr<leveldb::DB> _database;
+    leveldb::ReadOptions _read_options;
+    leveldb::WriteOptions _write_options;
+    //======================
+    bool readValue(const leveldb::ReadOptions& read_options, const leveldb::Slice& key, std::string& value) const;
+    void scanFrom(leveldb::ReadOptions read_options, const leveldb::Slice& begin, const ScanFunction& on_entry) const;
+    //======================
+};
+
+} // namespace base
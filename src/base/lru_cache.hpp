@@ -0,0 +1,60 @@
+#pragma once
+
+#include "base/hash_map.hpp"
+
+#include <cstddef>
+#include <list>
+#include <optional>
+
+namespace base
+{
+
+// Bounded key-value cache, that evicts the least recently used entries when it's full. Every entry takes
+// its charge (1 by default) of the capacity, so the capacity can be a number of entries or a memory budget.
+// Not thread-safe: owner must guard it, since even lookups reorder the entries.
+template<typename K, typename V, typename Hash = std::hash<K>>
+class LruCache
+{
+  public:
+    //================
+    explicit LruCache(std::size_t capacity);
+    LruCache(const LruCache&) = delete;
+    LruCache(LruCache&&) = default;
+    LruCache& operator=(const LruCache&) = delete;
+    LruCache& operator=(LruCache&&) = default;
+    ~LruCache() = default;
+    //================
+    std::optional<V> get(const K& key);
+    bool contains(const K& key) const;
+    // an entry charged more than the whole capacity is not cached
+    void put(const K& key, V value, std::size_t charge = 1);
+    void erase(const K& key);
+    void clear();
+    //================
+    std::size_t size() const noexcept;
+    std::size_t capacity() const noexcept;
+    std::size_t charge() const noexcept; // the sum of charges of cached entries
+    //================
+    std::size_t hits() const noexcept;
+    std::size_t misses() const noexcept;
+    //================
+  private:
+    struct Entry
+    {
+        K key;
+        V value;
+        std::size_t charge;
+    };
+    using Entries = std::list<Entry>;
+
+    std::size_t _capacity;
+    std::size_t _charge{ 0 };
+    std::size_t _hits{ 0 };
+    std::size_t _misses{ 0 };
+    Entries _entries; // the most recently used go first
+    HashMap<K, typename Entries::iterator, Hash> _index;
+};
+
+} // namespace base
+
+#include "lru_cache.tpp"
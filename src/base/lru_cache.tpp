@@ -0,0 +1,114 @@
+#pragma once
+
+#include "lru_cache.hpp"
+
+#include "base/error.hpp"
+
+namespace base
+{
+
+template<typename K, typename V, typename H>
+LruCache<K, V, H>::LruCache(std::size_t capacity)
+  : _capacity{ capacity }
+{
+    if (_capacity == 0) {
+        RAISE_ERROR(InvalidArgument, "cache capacity must be positive");
+    }
+}
+
+
+template<typename K, typename V, typename H>
+std::optional<V> LruCache<K, V, H>::get(const K& key)
+{
+    auto it = _index.find(key);
+    if (it == _index.end()) {
+        ++_misses;
+        return std::nullopt;
+    }
+    ++_hits;
+    _entries.splice(_entries.begin(), _entries, it->second);
+    return it->second->value;
+}
+
+
+template<typename K, typename V, typename H>
+bool LruCache<K, V, H>::contains(const K& key) const
+{
+    return _index.contains(key);
+}
+
+
+template<typename K, typename V, typename H>
+void LruCache<K, V, H>::put(const K& key, V value, std::size_t charge)
+{
+    erase(key);
+    if (charge > _capacity) {
+        return;
+    }
+
+    while (_charge + charge > _capacity) {
+        _charge -= _entries.back().charge;
+        _index.erase(_entries.back().key);
+        _entries.pop_back();
+    }
+    _entries.push_front(Entry{ key, std::move(value), charge });
+    _index.insert_or_assign(key, _entries.begin());
+    _charge += charge;
+}
+
+
+template<typename K, typename V, typename H>
+void LruCache<K, V, H>::erase(const K& key)
+{
+    if (auto it = _index.find(key); it != _index.end()) {
+        _charge -= it->second->charge;
+        _entries.erase(it->second);
+        _index.erase(key);
+    }
+}
+
+
+template<typename K, typename V, typename H>
+void LruCache<K, V, H>::clear()
+{
+    _entries.clear();
+    _index.clear();
+    _charge = 0;
+}
+
+
+template<typename K, typename V, typename H>
+std::size_t LruCache<K, V, H>::size() const noexcept
+{
+    return _entries.size();
+}
+
+
+template<typename K, typename V, typename H>
+std::size_t LruCache<K, V, H>::capacity() const noexcept
+{
+    return _capacity;
+}
+
+
+template<typename K, typename V, typename H>
+std::size_t LruCache<K, V, H>::charge() const noexcept
+{
+    return _charge;
+}
+
+
+template<typename K, typename V, typename H>
+std::size_t LruCache<K, V, H>::hits() const noexcept
+{
+    return _hits;
+}
+
+
+template<typename K, typename V, typename H>
+std::size_t LruCache<K, V, H>::misses() const noexcept
+{
+    return _misses;
+}
+
+} // namespace base
@@ -0,0 +1,170 @@
+#include "memory_store.hpp"
+
+#include "base/error.hpp"
+
+#include <mutex>
+#include <string_view>
+
+namespace
+{
+
+std::string_view toStringView(const leveldb::Slice& slice) noexcept
+{
+    return std::string_view(slice.data(), slice.size());
+}
+
+} // namespace
+
+
+namespace base
+{
+
+MemoryStore::MemoryStore()
+  : _entries{ std::make_shared<Entries>() }
+{}
+
+
+bool MemoryStore::get(const leveldb::Slice& key, std::string& value) const
+{
+    std::shared_lock lk(_mutex);
+    if (auto it = _entries->find(toStringView(key)); it != _entries->end()) {
+        value = it->second;
+        return true;
+    }
+    return false;
+}
+
+
+void MemoryStore::put(const leveldb::Slice& key, const leveldb::Slice& value)
+{
+    std::unique_lock lk(_mutex);
+    setEntry(getEntriesToModify(), key, value);
+}
+
+
+void MemoryStore::remove(const leveldb::Slice& key)
+{
+    std::unique_lock lk(_mutex);
+    auto& entries = getEntriesToModify();
+    if (auto it = entries.find(toStringView(key)); it != entries.end()) {
+        entries.erase(it);
+    }
+}
+
+
+void MemoryStore::write(leveldb::WriteBatch& batch)
+{
+    class Applier : public leveldb::WriteBatch::Handler
+    {
+      public:
+        explicit Applier(Entries& entries)
+          : _entries{ entries }
+        {}
+
+        void Put(const leveldb::Slice& key, const leveldb::Slice& value) override
+        {
+            setEntry(_entries, key, value);
+        }
+
+        void Delete(const leveldb::Slice& key) override
+        {
+            if (auto it = _entries.find(toStringView(key)); it != _entries.end()) {
+                _entries.erase(it);
+            }
+        }
+
+      private:
+        Entries& _entries;
+    };
+
+    // readers take the shared lock, so they see either none or all of the batch
+    std::unique_lock lk(_mutex);
+    Applier applier(getEntriesToModify());
+    auto const status = batch.Iterate(&applier);
+    if (!status.ok()) {
+        RAISE_ERROR(base::DatabaseError, status.ToString());
+    }
+}
+
+
+void MemoryStore::scan(const leveldb::Slice& begin, const ScanFunction& on_entry) const
+{
+    // the callback runs without the lock, so it may write to the store: the write just copies the entries
+    const auto entries = acquireEntries();
+    for (auto it = entries->lower_bound(toStringView(begin)); it != entries->end(); ++it) {
+        if (!on_entry(leveldb::Slice(it->first), leveldb::Slice(it->second))) {
+            return;
+        }
+    }
+}
+
+
+std::shared_ptr<KeyValueStore> MemoryStore::getSnapshot() const
+{
+    auto snapshot = std::make_shared<MemoryStore>();
+    snapshot->_entries = acquireEntries();
+    snapshot->_is_read_only = true;
+    return snapshot;
+}
+
+
+std::optional<std::string> MemoryStore::getProperty(const std::string& name) const
+{
+    if (name == "memory.entries-count") {
+        std::shared_lock lk(_mutex);
+        return std::to_string(_entries->size());
+    }
+    return std::nullopt;
+}
+
+
+std::uint64_t MemoryStore::getApproximateSize(const leveldb::Slice& begin, const leveldb::Slice& end) const
+{
+    if (toStringView(end) <= toStringView(begin)) {
+        return 0;
+    }
+    std::shared_lock lk(_mutex);
+    std::uint64_t size = 0;
+    const auto last = _entries->lower_bound(toStringView(end));
+    for (auto it = _entries->lower_bound(toStringView(begin)); it != last; ++it) {
+        size += it->first.size() + it->second.size();
+    }
+    return size;
+}
+
+
+void MemoryStore::compact(const leveldb::Slice&, const leveldb::Slice&)
+{}
+
+
+std::shared_ptr<MemoryStore::Entries> MemoryStore::acquireEntries() const
+{
+    std::shared_lock lk(_mutex);
+    return _entries;
+}
+
+
+MemoryStore::Entries& MemoryStore::getEntriesToModify()
+{
+    if (_is_read_only) {
+        RAISE_ERROR(LogicError, "Database snapshot is read-only");
+    }
+    // copies are made under the shared lock only, so no new owner can appear while the unique lock is held
+    if (_entries.use_count() > 1) {
+        _entries = std::make_shared<Entries>(*_entries);
+    }
+    return *_entries;
+}
+
+
+void MemoryStore::setEntry(Entries& entries, const leveldb::Slice& key, const leveldb::Slice& value)
+{
+    if (auto it = entries.find(toStringView(key)); it != entries.end()) {
+        it->second.assign(value.data(), value.size());
+    }
+    else {
+        entries.emplace(key.ToString(), value.ToString());
+    }
+}
+
+} // namespace base
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "base/key_value_store.hpp"
+
+#include <map>
+#include <memory>
+#include <shared_mutex>
+
+namespace base
+{
+
+// ordered in-memory engine: nothing is stored on disk, so the data is lost once the store is destroyed;
+// meant for tests and benchmarks, which should not depend on the disk
+class MemoryStore : public KeyValueStore
+{
+  public:
+    //======================
+    MemoryStore();
+    MemoryStore(const MemoryStore&) = delete;
+    MemoryStore& operator=(const MemoryStore&) = delete;
+    ~MemoryStore() override = default;
+    //======================
+    bool get(const leveldb::Slice& key, std::string& value) const override;
+
+    void put(const leveldb::Slice& key, const leveldb::Slice& value) override;
+
+    void remove(const leveldb::Slice& key) override;
+
+    void write(leveldb::WriteBatch& batch) override;
+
+    void scan(const leveldb::Slice& begin, const ScanFunction& on_entry) const override;
+
+    std::shared_ptr<KeyValueStore> getSnapshot() const override;
+
+    // "memory.entries-count" is the only supported property
+    std::optional<std::string> getProperty(const std::string& name) const override;
+
+    // sum of sizes of keys and values in the range
+    std::uint64_t getApproximateSize(const leveldb::Slice& begin, const leveldb::Slice& end) const override;
+
+    // the removed entries are freed at once, so there is nothing to compact
+    void compact(const leveldb::Slice& begin, const leveldb::Slice& end) override;
+    //======================
+  private:
+    using Entries = std::map<std::string, std::string, std::less<>>;
+    //======================
+    mutable std::shared_mutex _mutex;
+    // shared with snapshots and running scans: a write copies the entries first, if they are shared
+    std::shared_ptr<Entries> _entries;
+    bool _is_read_only{ false };
+    //======================
+    std::shared_ptr<Entries> acquireEntries() const;
+    Entries& getEntriesToModify();
+    static void setEntry(Entries& entries, const leveldb::Slice& key, const leveldb::Slice& value);
+    //======================
+};
+
+} // namespace base
@@ -111,6 +111,12 @@ void PropertyTree::add(const std::string& path, PropertyTree&& val)
 }
 
 
+void PropertyTree::pushBack(PropertyTree&& val)
+{
+    _ptree.push_back({ "", std::move(val._ptree) });
+}
+
+
 std::string PropertyTree::toString() const
 {
     std::ostringstream output;
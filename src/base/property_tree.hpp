@@ -48,6 +48,12 @@ class PropertyTree
 
     void add(const std::string& path, PropertyTree&& val);
 
+    // the tree is an array then: its elements have no keys
+    template<typename R>
+    void pushBack(R val);
+
+    void pushBack(PropertyTree&& val);
+
     template<typename R>
     std::vector<R> getVector(const std::string& path) const;
 
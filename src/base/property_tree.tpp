@@ -26,6 +26,15 @@ void PropertyTree::add(const std::string& path, R val)
 }
 
 
+template<typename R>
+void PropertyTree::pushBack(R val)
+{
+    boost::property_tree::ptree element;
+    element.put_value(val);
+    _ptree.push_back({ "", std::move(element) });
+}
+
+
 template<typename R>
 std::vector<R> PropertyTree::getVector(const std::string& path) const
 {
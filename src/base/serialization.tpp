@@ -4,6 +4,7 @@
 
 #include "base/assert.hpp"
 #include "base/big_integer.hpp"
+#include "base/error.hpp"
 
 #include <boost/asio.hpp>
 #include <boost/endian/conversion.hpp>
@@ -91,9 +92,8 @@ class global_deserialize
                           "this integral type is not serializable");
 
             if (_index + sizeof(T) > _bytes.size()) {
-                _index += 120;
+                RAISE_ERROR(base::InvalidArgument, "not enough bytes to deserialize a value");
             }
-            ASSERT(_index + sizeof(T) <= _bytes.size());
 
             v = *reinterpret_cast<const T*>(_bytes.getData() + _index);
             _index += sizeof(v);
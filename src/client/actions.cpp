@@ -284,6 +284,70 @@ void contract_call(std::ostream& output,
 }
 
 
+void call_contract(websocket::WebSocketClient& client, const lk::Address& to_address, const std::string& message)
+{
+    LOG_INFO << "call_contract to " << to_address << ", message " << message;
+    base::PropertyTree request_args;
+    request_args.add("to", websocket::serializeAddress(to_address));
+    request_args.add("data", websocket::serializeBytes(base::fromHex<base::Bytes>(message)));
+    client.send(websocket::Command::CALL_CONTRACT, request_args);
+}
+
+
+void estimate_fee(websocket::WebSocketClient& client,
+                  const lk::Address& from_address,
+                  const lk::Address& to_address,
+                  const lk::Balance& amount,
+                  const std::string& message)
+{
+    LOG_INFO << "estimate_fee from " << from_address << ", to " << to_address << ", amount " << amount
+             << ", message " << message;
+    base::PropertyTree request_args;
+    request_args.add("from", websocket::serializeAddress(from_address));
+    request_args.add("to", websocket::serializeAddress(to_address));
+    request_args.add("amount", websocket::serializeBalance(amount));
+    request_args.add("data", websocket::serializeBytes(base::fromHex<base::Bytes>(message)));
+    client.send(websocket::Command::CALL_ESTIMATE_FEE, request_args);
+}
+
+
+void trace_transaction(websocket::WebSocketClient& client, const base::Sha256& hash)
+{
+    LOG_INFO << "trace_transaction by hash: " << hash;
+    base::PropertyTree request_args;
+    request_args.add("hash", websocket::serializeHash(hash));
+    client.send(websocket::Command::CALL_TRACE_TRANSACTION, request_args);
+}
+
+
+void call_logs(websocket::WebSocketClient& client,
+               lk::BlockDepth from_depth,
+               lk::BlockDepth to_depth,
+               const lk::Address& contract_address)
+{
+    LOG_INFO << "logs of " << contract_address << " from block " << from_depth << " to block " << to_depth;
+    base::PropertyTree request_args = websocket::serializeLogsFilter(lk::LogsFilter{ { contract_address }, {} });
+    request_args.add("from_depth", from_depth);
+    request_args.add("to_depth", to_depth);
+    client.send(websocket::Command::CALL_LOGS, request_args);
+}
+
+
+void subscribe_logs(websocket::WebSocketClient& client, const lk::Address& contract_address)
+{
+    LOG_INFO << "subscription logs of " << contract_address;
+    base::PropertyTree request_args = websocket::serializeLogsFilter(lk::LogsFilter{ { contract_address }, {} });
+    client.send(websocket::Command::SUBSCRIBE_LOGS, request_args);
+}
+
+
+void unsubscribe_logs(websocket::WebSocketClient& client)
+{
+    LOG_INFO << "unsubscription logs";
+    client.send(websocket::Command::UNSUBSCRIBE_LOGS, base::PropertyTree{});
+}
+
+
 void push_contract(std::ostream& output,
                    websocket::WebSocketClient& client,
                    const lk::Balance& amount,
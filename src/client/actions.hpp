@@ -47,6 +47,25 @@ void contract_call(std::ostream& output,
                    const std::filesystem::path& keys_dir,
                    const std::string& message);
 
+void call_contract(websocket::WebSocketClient& client, const lk::Address& to_address, const std::string& message);
+
+void estimate_fee(websocket::WebSocketClient& client,
+                  const lk::Address& from_address,
+                  const lk::Address& to_address,
+                  const lk::Balance& amount,
+                  const std::string& message);
+
+void trace_transaction(websocket::WebSocketClient& client, const base::Sha256& hash);
+
+void call_logs(websocket::WebSocketClient& client,
+               lk::BlockDepth from_depth,
+               lk::BlockDepth to_depth,
+               const lk::Address& contract_address);
+
+void subscribe_logs(websocket::WebSocketClient& client, const lk::Address& contract_address);
+
+void unsubscribe_logs(websocket::WebSocketClient& client);
+
 void push_contract(std::ostream& output,
                    websocket::WebSocketClient& client,
                    const lk::Balance& amount,
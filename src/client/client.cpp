@@ -283,6 +283,107 @@ void Client::setupCli()
         "amount of coins for call",
         "message for call at hex" }));
 
+    _connected_mode_commands.push_back(_root_menu->Insert(
+      "call_contract",
+      [this](std::ostream& out, std::string contract_address_at_base58, std::string message) {
+          try {
+              lk::Address to_address{ contract_address_at_base58 };
+              if (!message.empty()) {
+                  call_contract(_web_socket_client, to_address, message);
+              }
+              else {
+                  out << "can't parse input data for call_contract";
+                  LOG_ERROR << "can't parse input data for call_contract";
+              }
+          }
+          catch (const base::Error& e) {
+              out << "can't execute call_contract";
+              LOG_ERROR << "can't execute call_contract:" << e.what();
+          }
+      },
+      "call deployed contract without a transaction, nothing is changed by the call",
+      { "address of contract at base58", "message for call at hex" }));
+
+    _connected_mode_commands.push_back(_root_menu->Insert(
+      "estimate_fee",
+      [this](std::ostream& out,
+             std::string sender_address_at_base58,
+             std::string recipient_address_at_base58,
+             std::string amount_str,
+             std::string message) {
+          try {
+              lk::Address from_address{ sender_address_at_base58 };
+              lk::Address to_address{ recipient_address_at_base58 };
+              auto amount = websocket::deserializeBalance(amount_str);
+              if (amount) {
+                  estimate_fee(_web_socket_client, from_address, to_address, *amount, message);
+              }
+              else {
+                  out << "can't parse input data for estimate_fee";
+                  LOG_ERROR << "can't parse input data for estimate_fee";
+              }
+          }
+          catch (const base::Error& e) {
+              out << "can't execute estimate_fee";
+              LOG_ERROR << "can't execute estimate_fee:" << e.what();
+          }
+      },
+      "estimate the least fee for a transfer or a call of contract",
+      { "address of sender at base58",
+        "address of recipient or contract at base58",
+        "amount of coins",
+        "message for call at hex, may be empty for a transfer" }));
+
+    _connected_mode_commands.push_back(_root_menu->Insert(
+      "trace_transaction",
+      [this](std::ostream& out, std::string tx_hash_at_hex) {
+          try {
+              auto hash = base::Sha256::fromHex(tx_hash_at_hex);
+              trace_transaction(_web_socket_client, hash);
+          }
+          catch (const base::Error& e) {
+              out << "can't execute trace_transaction";
+              LOG_ERROR << "can't execute trace_transaction:" << e.what();
+          }
+      },
+      "get the trace of a transaction of a block, if the node keeps the traces",
+      { "transaction hash at hex" }));
+
+    _connected_mode_commands.push_back(_root_menu->Insert(
+      "get_logs",
+      [this](std::ostream& out, std::string contract_address_at_base58, std::string from_depth, std::string to_depth) {
+          try {
+              lk::Address contract_address{ contract_address_at_base58 };
+              call_logs(_web_socket_client, std::stoull(from_depth), std::stoull(to_depth), contract_address);
+          }
+          catch (const std::exception& e) {
+              out << "can't execute get_logs";
+              LOG_ERROR << "can't execute get_logs:" << e.what();
+          }
+      },
+      "get logs emitted by contract in range of blocks",
+      { "address of contract at base58", "depth of first block", "depth of last block" }));
+
+    _connected_mode_commands.push_back(_root_menu->Insert(
+      "subscribe_logs",
+      [this](std::ostream& out, std::string contract_address_at_base58) {
+          try {
+              lk::Address contract_address{ contract_address_at_base58 };
+              subscribe_logs(_web_socket_client, contract_address);
+          }
+          catch (const base::Error& e) {
+              out << "can't execute subscribe_logs";
+              LOG_ERROR << "can't execute subscribe_logs:" << e.what();
+          }
+      },
+      "get logs emitted by contract when appeared new block",
+      { "address of contract at base58" }));
+
+    _connected_mode_commands.push_back(_root_menu->Insert(
+      "unsubscribe_logs",
+      [this]([[maybe_unused]] std::ostream& out) { unsubscribe_logs(_web_socket_client); },
+      "stop getting logs of new blocks"));
+
     _connected_mode_commands.push_back(_root_menu->Insert(
       "push_contract",
       [this](std::ostream& out,
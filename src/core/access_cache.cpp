@@ -0,0 +1,70 @@
+#include "access_cache.hpp"
+
+namespace lk
+{
+
+AccessCache::AccessCache(Commit& commit)
+  : _commit{ commit }
+{}
+
+
+Commit& AccessCache::getCommit() noexcept
+{
+    return _commit;
+}
+
+
+bool AccessCache::isWarm(const lk::Address& address) const
+{
+    return _accounts.contains(address);
+}
+
+
+bool AccessCache::isWarm(const lk::Address& contract_address, const StorageKey& key) const
+{
+    if (auto it = _accounts.find(contract_address); it != _accounts.end() && it->second.storage) {
+        return it->second.storage->isCached(key);
+    }
+    return false;
+}
+
+
+bool AccessCache::hasAccount(const lk::Address& address)
+{
+    auto& account = _accounts[address];
+    if (!account.exists) {
+        account.exists = _commit.hasAccount(address);
+    }
+    return account.exists;
+}
+
+
+ContractStorage& AccessCache::getStorage(const lk::Address& contract_address)
+{
+    auto& account = _accounts[contract_address];
+    if (!account.storage) {
+        account.storage.emplace(_commit, contract_address);
+        account.exists = true;
+    }
+    return *account.storage;
+}
+
+
+void AccessCache::forget(const lk::Address& address)
+{
+    if (auto it = _accounts.find(address); it != _accounts.end()) {
+        it->second.exists = false;
+        it->second.storage.reset();
+    }
+}
+
+
+void AccessCache::reset()
+{
+    for (auto& [address, account] : _accounts) {
+        account.exists = false;
+        account.storage.reset();
+    }
+}
+
+} // namespace lk
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "core/managers.hpp"
+
+#include <optional>
+
+namespace lk
+{
+
+// Accounts and storage slots touched by a transaction, while its contracts are executed. What was read is cached in
+// front of the commit of the transaction, so the accesses repeated by contract code, e.g. in loops or in calls of the
+// same contract, cost one lookup without the checks and the walk through the commit layers. Touched accounts and
+// slots are warm in terms of EIP-2929, the rest are cold. Like ContractStorage, it takes no locks.
+class AccessCache
+{
+  public:
+    explicit AccessCache(Commit& commit);
+    AccessCache(const AccessCache&) = delete;
+    AccessCache& operator=(const AccessCache&) = delete;
+    ~AccessCache() = default;
+    //================
+    Commit& getCommit() noexcept;
+    //================
+    bool isWarm(const lk::Address& address) const;
+    bool isWarm(const lk::Address& contract_address, const StorageKey& key) const;
+    //================
+    bool hasAccount(const lk::Address& address);
+    // storage of the contract shared by all its calls in the transaction, raises if there is no such contract
+    ContractStorage& getStorage(const lk::Address& contract_address);
+    // drops the cached data of the account, e.g. when it is deleted; the account stays warm
+    void forget(const lk::Address& address);
+    // drops the cached data of all accounts, e.g. when the commit is reverted to a savepoint; they stay warm
+    void reset();
+
+  private:
+    struct Account
+    {
+        bool exists{ false }; // cached only when true: a missing account may be created by a transfer
+        std::optional<ContractStorage> storage;
+    };
+
+    Commit& _commit;
+    AddressMap<Account> _accounts;
+};
+
+} // namespace lk
@@ -10,12 +10,14 @@ namespace lk
 ImmutableBlock::ImmutableBlock(lk::BlockDepth depth,
                                NonceInt nonce,
                                base::Sha256 prev_block_hash,
+                               base::Sha256 state_root,
                                base::Time timestamp,
                                lk::Address coinbase,
                                TransactionsSet txs)
   : _depth{ depth }
   , _nonce{ nonce }
   , _prev_block_hash{ std::move(prev_block_hash) }
+  , _state_root{ std::move(state_root) }
   , _timestamp{ std::move(timestamp) }
   , _coinbase{ std::move(coinbase) }
   , _txs(std::move(txs))
@@ -36,6 +38,7 @@ void ImmutableBlock::serialize(base::SerializationOArchive& oa) const
     oa.serialize(_depth);
     oa.serialize(_nonce);
     oa.serialize(_prev_block_hash);
+    oa.serialize(_state_root);
     oa.serialize(_timestamp);
     oa.serialize(_coinbase);
     oa.serialize(_txs);
@@ -47,11 +50,17 @@ ImmutableBlock ImmutableBlock::deserialize(base::SerializationIArchive& ia)
     auto depth = ia.deserialize<BlockDepth>();
     auto nonce = ia.deserialize<NonceInt>();
     auto prev_block_hash = ia.deserialize<base::Sha256>();
+    auto state_root = ia.deserialize<base::Sha256>();
     auto timestamp = ia.deserialize<base::Time>();
     auto coinbase = ia.deserialize<lk::Address>();
     auto txs = ia.deserialize<TransactionsSet>();
 
-    ImmutableBlock ret{ depth,         nonce, std::move(prev_block_hash), std::move(timestamp), std::move(coinbase),
+    ImmutableBlock ret{ depth,
+                        nonce,
+                        std::move(prev_block_hash),
+                        std::move(state_root),
+                        std::move(timestamp),
+                        std::move(coinbase),
                         std::move(txs) };
     return ret;
 }
@@ -69,6 +78,12 @@ const base::Sha256& ImmutableBlock::getPrevBlockHash() const noexcept
 }
 
 
+const base::Sha256& ImmutableBlock::getStateRoot() const noexcept
+{
+    return _state_root;
+}
+
+
 const TransactionsSet& ImmutableBlock::getTransactions() const noexcept
 {
     return _txs;
@@ -103,12 +118,14 @@ const base::Sha256& ImmutableBlock::getHash() const noexcept
 MutableBlock::MutableBlock(lk::BlockDepth depth,
                            NonceInt nonce,
                            base::Sha256 prev_block_hash,
+                           base::Sha256 state_root,
                            base::Time timestamp,
                            lk::Address coinbase,
                            TransactionsSet txs)
   : _depth{ depth }
   , _nonce{ nonce }
   , _prev_block_hash{ std::move(prev_block_hash) }
+  , _state_root{ std::move(state_root) }
   , _timestamp{ std::move(timestamp) }
   , _coinbase{ std::move(coinbase) }
   , _txs(std::move(txs))
@@ -120,6 +137,7 @@ void MutableBlock::serialize(base::SerializationOArchive& oa) const
     oa.serialize(_depth);
     oa.serialize(_nonce);
     oa.serialize(_prev_block_hash);
+    oa.serialize(_state_root);
     oa.serialize(_timestamp);
     oa.serialize(_coinbase);
     oa.serialize(_txs);
@@ -131,11 +149,17 @@ MutableBlock MutableBlock::deserialize(base::SerializationIArchive& ia)
     auto depth = ia.deserialize<BlockDepth>();
     auto nonce = ia.deserialize<NonceInt>();
     auto prev_block_hash = ia.deserialize<base::Sha256>();
+    auto state_root = ia.deserialize<base::Sha256>();
     auto timestamp = ia.deserialize<base::Time>();
     auto coinbase = ia.deserialize<lk::Address>();
     auto txs = ia.deserialize<TransactionsSet>();
 
-    MutableBlock ret{ depth,         nonce, std::move(prev_block_hash), std::move(timestamp), std::move(coinbase),
+    MutableBlock ret{ depth,
+                      nonce,
+                      std::move(prev_block_hash),
+                      std::move(state_root),
+                      std::move(timestamp),
+                      std::move(coinbase),
                       std::move(txs) };
     return ret;
 }
@@ -153,6 +177,12 @@ const base::Sha256& MutableBlock::getPrevBlockHash() const noexcept
 }
 
 
+const base::Sha256& MutableBlock::getStateRoot() const noexcept
+{
+    return _state_root;
+}
+
+
 const TransactionsSet& MutableBlock::getTransactions() const noexcept
 {
     return _txs;
@@ -195,6 +225,12 @@ void MutableBlock::setPrevBlockHash(const base::Sha256& prev_block_hash)
 }
 
 
+void MutableBlock::setStateRoot(const base::Sha256& state_root)
+{
+    _state_root = state_root;
+}
+
+
 void MutableBlock::setTimestamp(base::Time timestamp)
 {
     _timestamp = std::move(timestamp);
@@ -217,8 +253,9 @@ void MutableBlock::addTransaction(const Transaction& tx)
 bool operator==(const ImmutableBlock& a, const ImmutableBlock& b)
 {
     return a.getDepth() == b.getDepth() && a.getNonce() == b.getNonce() &&
-           a.getPrevBlockHash() == b.getPrevBlockHash() && a.getTimestamp() == b.getTimestamp() &&
-           a.getCoinbase() == b.getCoinbase() && a.getTransactions() == b.getTransactions();
+           a.getPrevBlockHash() == b.getPrevBlockHash() && a.getStateRoot() == b.getStateRoot() &&
+           a.getTimestamp() == b.getTimestamp() && a.getCoinbase() == b.getCoinbase() &&
+           a.getTransactions() == b.getTransactions();
     // or simply check hashes on equality?
 }
 
@@ -232,8 +269,9 @@ bool operator!=(const ImmutableBlock& a, const ImmutableBlock& b)
 bool operator==(const MutableBlock& a, const MutableBlock& b)
 {
     return a.getDepth() == b.getDepth() && a.getNonce() == b.getNonce() &&
-           a.getPrevBlockHash() == b.getPrevBlockHash() && a.getTimestamp() == b.getTimestamp() &&
-           a.getCoinbase() == b.getCoinbase() && a.getTransactions() == b.getTransactions();
+           a.getPrevBlockHash() == b.getPrevBlockHash() && a.getStateRoot() == b.getStateRoot() &&
+           a.getTimestamp() == b.getTimestamp() && a.getCoinbase() == b.getCoinbase() &&
+           a.getTransactions() == b.getTransactions();
 }
 
 
@@ -268,6 +306,12 @@ const base::Sha256& BlockFieldsView::getPrevBlockHash() const noexcept
 }
 
 
+const base::Sha256& BlockFieldsView::getStateRoot() const noexcept
+{
+    return (_b1 ? _b1->getStateRoot() : _b2->getStateRoot());
+}
+
+
 const TransactionsSet& BlockFieldsView::getTransactions() const noexcept
 {
     return (_b1 ? _b1->getTransactions() : _b2->getTransactions());
@@ -311,6 +355,7 @@ void BlockBuilder::initFromBlock(const T& b)
     setDepth(b.getDepth());
     setNonce(b.getNonce());
     setPrevBlockHash(b.getPrevBlockHash());
+    setStateRoot(b.getStateRoot());
     setTimestamp(b.getTimestamp());
     setCoinbase(b.getCoinbase());
     setTransactionsSet(b.getTransactions());
@@ -335,6 +380,12 @@ void BlockBuilder::setPrevBlockHash(base::Sha256 hash)
 }
 
 
+void BlockBuilder::setStateRoot(base::Sha256 state_root)
+{
+    _state_root = std::move(state_root);
+}
+
+
 void BlockBuilder::setTimestamp(base::Time timestamp)
 {
     _timestamp = std::move(timestamp);
@@ -356,23 +407,27 @@ void BlockBuilder::setTransactionsSet(TransactionsSet txs)
 ImmutableBlock BlockBuilder::buildImmutable() const&
 {
     raiseIfNotEverythingIsSet();
-    return ImmutableBlock{ *_depth, *_nonce, *_prev_block_hash, *_timestamp, *_coinbase, *_txs };
+    return ImmutableBlock{ *_depth, *_nonce, *_prev_block_hash, *_state_root, *_timestamp, *_coinbase, *_txs };
 }
 
 
 MutableBlock BlockBuilder::buildMutable() const&
 {
     raiseIfNotEverythingIsSet();
-    return MutableBlock{ *_depth, *_nonce, *_prev_block_hash, *_timestamp, *_coinbase, *_txs };
+    return MutableBlock{ *_depth, *_nonce, *_prev_block_hash, *_state_root, *_timestamp, *_coinbase, *_txs };
 }
 
 
 ImmutableBlock BlockBuilder::buildImmutable() &&
 {
     raiseIfNotEverythingIsSet();
-    auto ret = ImmutableBlock{
-        *_depth, *_nonce, *std::move(_prev_block_hash), *std::move(_timestamp), *std::move(_coinbase), *std::move(_txs)
-    };
+    auto ret = ImmutableBlock{ *_depth,
+                               *_nonce,
+                               *std::move(_prev_block_hash),
+                               *std::move(_state_root),
+                               *std::move(_timestamp),
+                               *std::move(_coinbase),
+                               *std::move(_txs) };
     null();
     return ret;
 }
@@ -381,9 +436,13 @@ ImmutableBlock BlockBuilder::buildImmutable() &&
 MutableBlock BlockBuilder::buildMutable() &&
 {
     raiseIfNotEverythingIsSet();
-    auto ret = MutableBlock{
-        *_depth, *_nonce, *std::move(_prev_block_hash), *std::move(_timestamp), *std::move(_coinbase), *std::move(_txs)
-    };
+    auto ret = MutableBlock{ *_depth,
+                             *_nonce,
+                             *std::move(_prev_block_hash),
+                             *std::move(_state_root),
+                             *std::move(_timestamp),
+                             *std::move(_coinbase),
+                             *std::move(_txs) };
     null();
     return ret;
 }
@@ -391,7 +450,7 @@ MutableBlock BlockBuilder::buildMutable() &&
 
 void BlockBuilder::raiseIfNotEverythingIsSet() const
 {
-    if (!(_depth && _nonce && _prev_block_hash && _timestamp && _coinbase && _txs)) {
+    if (!(_depth && _nonce && _prev_block_hash && _state_root && _timestamp && _coinbase && _txs)) {
         RAISE_ERROR(base::UseOfUninitializedValue, "cannot build block if not all fields are set up");
         // FIX DB LOADING AND SAVING (IT MIGHT BE GENESIS BLOCK PROBLEM)
     }
@@ -403,6 +462,7 @@ void BlockBuilder::null()
     _depth = std::nullopt;
     _nonce = std::nullopt;
     _prev_block_hash = std::nullopt;
+    _state_root = std::nullopt;
     _timestamp = std::nullopt;
     _coinbase = std::nullopt;
     _txs = std::nullopt;
@@ -21,6 +21,7 @@ class ImmutableBlock
     ImmutableBlock(BlockDepth depth,
                    NonceInt nonce,
                    base::Sha256 prev_block_hash,
+                   base::Sha256 state_root,
                    base::Time timestamp,
                    Address coinbase,
                    TransactionsSet txs);
@@ -38,6 +39,7 @@ class ImmutableBlock
     //=================
     BlockDepth getDepth() const noexcept;
     const base::Sha256& getPrevBlockHash() const noexcept;
+    const base::Sha256& getStateRoot() const noexcept;
     const TransactionsSet& getTransactions() const noexcept;
     NonceInt getNonce() const noexcept;
     const base::Time& getTimestamp() const noexcept;
@@ -50,6 +52,7 @@ class ImmutableBlock
     const BlockDepth _depth;
     const NonceInt _nonce;
     const base::Sha256 _prev_block_hash;
+    const base::Sha256 _state_root; // root of the state trie before applying the block
     const base::Time _timestamp;
     const Address _coinbase;
     const TransactionsSet _txs;
@@ -67,6 +70,7 @@ class MutableBlock
     MutableBlock(BlockDepth depth,
                  NonceInt nonce,
                  base::Sha256 prev_block_hash,
+                 base::Sha256 state_root,
                  base::Time timestamp,
                  Address coinbase,
                  TransactionsSet txs);
@@ -85,6 +89,7 @@ class MutableBlock
     BlockDepth getDepth() const noexcept;
     NonceInt getNonce() const noexcept;
     const base::Sha256& getPrevBlockHash() const noexcept;
+    const base::Sha256& getStateRoot() const noexcept;
     const TransactionsSet& getTransactions() const noexcept;
     const base::Time& getTimestamp() const noexcept;
     const Address& getCoinbase() const noexcept;
@@ -92,6 +97,7 @@ class MutableBlock
     void setDepth(BlockDepth depth) noexcept;
     void setNonce(NonceInt nonce) noexcept;
     void setPrevBlockHash(const base::Sha256& prev_block_hash);
+    void setStateRoot(const base::Sha256& state_root);
     void setTimestamp(base::Time timestamp);
     void setTransactions(TransactionsSet txs);
     void addTransaction(const Transaction& tx);
@@ -101,6 +107,7 @@ class MutableBlock
     BlockDepth _depth;
     NonceInt _nonce;
     base::Sha256 _prev_block_hash;
+    base::Sha256 _state_root;
     base::Time _timestamp;
     Address _coinbase;
     TransactionsSet _txs;
@@ -123,6 +130,7 @@ class BlockFieldsView
     //=================
     BlockDepth getDepth() const noexcept;
     const base::Sha256& getPrevBlockHash() const noexcept;
+    const base::Sha256& getStateRoot() const noexcept;
     const TransactionsSet& getTransactions() const noexcept;
     NonceInt getNonce() const noexcept;
     const base::Time& getTimestamp() const noexcept;
@@ -144,6 +152,7 @@ class BlockBuilder
     void setDepth(BlockDepth depth);
     void setNonce(NonceInt nonce);
     void setPrevBlockHash(base::Sha256 hash);
+    void setStateRoot(base::Sha256 state_root);
     void setTimestamp(base::Time timestamp);
     void setCoinbase(Address address);
     void setTransactionsSet(TransactionsSet txs);
@@ -158,6 +167,7 @@ class BlockBuilder
     std::optional<BlockDepth> _depth;
     std::optional<NonceInt> _nonce;
     std::optional<base::Sha256> _prev_block_hash;
+    std::optional<base::Sha256> _state_root;
     std::optional<base::Time> _timestamp;
     std::optional<Address> _coinbase;
     std::optional<TransactionsSet> _txs;
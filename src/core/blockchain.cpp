@@ -4,39 +4,57 @@
 #include "base/log.hpp"
 
 #include "core/consensus.hpp"
+#include "core/database_keys.hpp"
 
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+
+#include <deque>
+#include <future>
 #include <optional>
+#include <thread>
 
 namespace
 {
 
-enum class DataType
+// approximate memory taken by a deserialized block
+std::size_t estimateSize(const lk::ImmutableBlock& block)
 {
-    SYSTEM = 1,
-    BLOCK = 2,
-    PREVIOUS_BLOCK_HASH = 3
-};
+    std::size_t size = sizeof(lk::ImmutableBlock);
+    for (const auto& tx : block.getTransactions()) {
+        size += sizeof(lk::Transaction) + tx.getData().size();
+    }
+    return size;
+}
 
 
-base::Bytes toBytes(DataType type, const base::Bytes& key)
+std::size_t getBlocksCacheSize(const base::PropertyTree& config)
 {
-    base::Bytes data;
-    data.append(static_cast<base::Byte>(type));
-    data.append(key);
-    return data;
+    if (config.hasKey("database.blocks_cache_size")) {
+        return config.get<std::size_t>("database.blocks_cache_size");
+    }
+    return base::config::DATABASE_BLOCKS_CACHE_SIZE;
 }
 
 
-template<std::size_t S>
-base::Bytes toBytes(DataType type, const base::FixedBytes<S>& key)
+lk::BlockDepth getKeptBlocksCount(const base::PropertyTree& config)
 {
-    base::Bytes data;
-    data.append(static_cast<base::Byte>(type));
-    data.append(key.getData(), S);
-    return data;
+    if (!config.hasKey("database.pruning.kept_blocks")) {
+        return 0;
+    }
+    return config.get<lk::BlockDepth>("database.pruning.kept_blocks");
 }
 
-const base::Bytes LAST_BLOCK_HASH_KEY{ toBytes(DataType::SYSTEM, base::Bytes("last_block_hash")) };
+
+// what is left of a pruned block: enough to restore the chain of hashes and the consensus
+base::Bytes makeHeaderData(const lk::ImmutableBlock& block)
+{
+    base::SerializationOArchive oa;
+    oa.serialize(block.getDepth());
+    oa.serialize(block.getHash());
+    oa.serialize(block.getTimestamp());
+    return std::move(oa).getBytes();
+}
 
 } // namespace
 
@@ -46,9 +64,6 @@ namespace lk
 
 Blockchain::Blockchain(ImmutableBlock genesis_block, const base::PropertyTree& config)
   : _config{ config }
-  , _top_level_block_hash{ base::Sha256::null() }
-  // temporary null, because it requires initialization. Set to real value in addGenesisBlock
-  , _genesis_block_hash{ base::Sha256::null() }
 {
     addGenesisBlock(genesis_block);
 }
@@ -58,88 +73,158 @@ void Blockchain::addGenesisBlock(ImmutableBlock block)
 {
     const auto hash = block.getHash();
 
-    std::lock_guard lk(_blocks_mutex);
-    if (!_blocks.empty()) {
-        RAISE_ERROR(base::LogicError, "cannot add genesis to non-empty chain");
-    }
+    {
+        std::lock_guard lk(_blocks_mutex);
+        if (!_hashes_by_depth.empty()) {
+            RAISE_ERROR(base::LogicError, "cannot add genesis to non-empty chain");
+        }
 
-    auto inserted_block = _blocks.insert({ hash, std::move(block) }).first;
-    _blocks_by_depth.insert({0, hash});
-    _top_level_block_hash = _genesis_block_hash = hash;
+        _depths_by_hash.insert({ hash, 0 });
+        _hashes_by_depth.push_back(hash);
+        _genesis_block.emplace(block);
+        _top_block.emplace(std::move(block));
+    }
 
     LOG_DEBUG << "Adding genesis block. Block hash = " << hash;
-    _block_added.notify(inserted_block->second);
+    _block_added.notify(*_genesis_block);
 }
 
 
 Blockchain::AdditionResult Blockchain::tryAddBlock(const ImmutableBlock& block)
+{
+    return addBlock(block, false);
+}
+
+
+Blockchain::AdditionResult Blockchain::addBlock(const ImmutableBlock& block, bool is_trusted)
 {
     const auto hash = block.getHash();
 
-    decltype(_blocks)::iterator inserted_block;
     {
         std::lock_guard lk(_blocks_mutex);
 
-        if (!_blocks.empty() && _blocks.find(hash) != _blocks.end()) {
+        if (_depths_by_hash.contains(hash)) {
             return AdditionResult::ALREADY_IN_BLOCKCHAIN;
         }
-        else if (!_blocks.empty() && _top_level_block_hash != block.getPrevBlockHash()) {
+        else if (_hashes_by_depth.back() != block.getPrevBlockHash()) {
             return AdditionResult::INVALID_PARENT_HASH;
         }
-        else if (_blocks.size() != block.getDepth()) {
+        else if (_hashes_by_depth.size() != block.getDepth()) {
             return AdditionResult::INVALID_DEPTH;
         }
-        else if (!checkConsensus(block)) {
-            return AdditionResult::CONSENSUS_ERROR;
-        }
-        else if (_top_level_block_hash != block.getPrevBlockHash()) {
-            return AdditionResult::INVALID_PARENT_HASH;
-        }
-        else if (block.getTransactions().size() == 0 ||
-                 block.getTransactions().size() > base::config::BC_MAX_TRANSACTIONS_IN_BLOCK) {
-            return AdditionResult::INVALID_TRANSACTIONS_NUMBER;
-        }
-        else if (_getTopBlock().getTimestamp() >= block.getTimestamp()) {
-            return AdditionResult::OLD_TIMESTAMP;
-        }
-        else if (constexpr unsigned SECONDS_IN_DAY = 24 * 60 * 60;
-                 block.getTimestamp().getSeconds() > base::Time::now().getSeconds() + SECONDS_IN_DAY) {
-            return AdditionResult::FUTURE_TIMESTAMP;
+
+        if (!is_trusted) {
+            if (!checkConsensus(block)) {
+                return AdditionResult::CONSENSUS_ERROR;
+            }
+            else if (block.getTransactions().size() == 0 ||
+                     block.getTransactions().size() > base::config::BC_MAX_TRANSACTIONS_IN_BLOCK) {
+                return AdditionResult::INVALID_TRANSACTIONS_NUMBER;
+            }
+            else if (_top_block->getTimestamp() >= block.getTimestamp()) {
+                return AdditionResult::OLD_TIMESTAMP;
+            }
+            else if (constexpr unsigned SECONDS_IN_DAY = 24 * 60 * 60;
+                     block.getTimestamp().getSeconds() > base::Time::now().getSeconds() + SECONDS_IN_DAY) {
+                return AdditionResult::FUTURE_TIMESTAMP;
+            }
         }
 
         // if here, this means that the block is ok
         LOG_DEBUG << "Complexity right now is: " << _consensus.getComplexity().getDensed();
         _consensus.applyBlock(block);
 
-        inserted_block = _blocks.insert({ hash, block }).first;
-        _blocks_by_depth.insert({ block.getDepth(), hash });
-        _top_level_block_hash = hash;
+        _depths_by_hash.insert({ hash, block.getDepth() });
+        _hashes_by_depth.push_back(hash);
+        storeBlock(block);
+        _top_block.emplace(block);
     }
 
     LOG_DEBUG << "Block " << hash << " has been added to blockchain";
-    _block_added.notify(inserted_block->second);
+    _block_added.notify(block);
 
     return AdditionResult::ADDED;
 }
 
 
-std::optional<ImmutableBlock> Blockchain::findBlock(const base::Sha256& block_hash) const
+bool Blockchain::addPrunedBlock(BlockDepth depth, const base::Sha256& hash, const base::Time& timestamp)
+{
+    std::lock_guard lk(_blocks_mutex);
+    if (_hashes_by_depth.size() != depth || _top_block->getDepth() != 0 || _depths_by_hash.contains(hash)) {
+        return false;
+    }
+    _consensus.applyBlock(depth, timestamp);
+    _depths_by_hash.insert({ hash, depth });
+    _hashes_by_depth.push_back(hash);
+    return true;
+}
+
+
+void Blockchain::storeBlock(const ImmutableBlock& block)
+{
+    for (const auto& tx : block.getTransactions()) {
+        _transactions_depths.insert({ tx.hashOfTransaction(), block.getDepth() });
+    }
+    _stored_blocks.insert({ block.getDepth(), block });
+}
+
+
+std::optional<ImmutableBlock> Blockchain::loadBlock(BlockDepth depth) const
 {
     std::shared_lock lk(_blocks_mutex);
-    if (auto it = _blocks.find(block_hash); it != _blocks.end()) {
+    if (auto it = _stored_blocks.find(depth); it != _stored_blocks.end()) {
         return it->second;
     }
-    else {
+    return std::nullopt;
+}
+
+
+std::optional<BlockDepth> Blockchain::findTransactionBlockDepth(const base::Sha256& tx_hash) const
+{
+    std::shared_lock lk(_blocks_mutex);
+    if (auto it = _transactions_depths.find(tx_hash); it != _transactions_depths.end()) {
+        return it->second;
+    }
+    return std::nullopt;
+}
+
+
+std::optional<ImmutableBlock> Blockchain::findBlock(const base::Sha256& block_hash) const
+{
+    std::optional<BlockDepth> depth;
+    {
+        std::shared_lock lk(_blocks_mutex);
+        if (auto it = _depths_by_hash.find(block_hash); it != _depths_by_hash.end()) {
+            depth = it->second;
+        }
+    }
+    if (!depth) {
         return std::nullopt;
     }
+    return findBlockByDepth(*depth);
+}
+
+
+std::optional<ImmutableBlock> Blockchain::findBlockByDepth(BlockDepth depth) const
+{
+    {
+        std::shared_lock lk(_blocks_mutex);
+        if (depth == 0) {
+            return _genesis_block;
+        }
+        else if (depth == _top_block->getDepth()) {
+            return _top_block;
+        }
+    }
+    return loadBlock(depth);
 }
 
 
 std::optional<base::Sha256> Blockchain::findBlockHashByDepth(lk::BlockDepth depth) const
 {
     std::shared_lock lk(_blocks_mutex);
-    if (auto it = _blocks_by_depth.find(depth); it != _blocks_by_depth.end()) {
-        return it->second;
+    if (depth < _hashes_by_depth.size()) {
+        return _hashes_by_depth[depth];
     }
     else {
         return std::nullopt;
@@ -149,13 +234,26 @@ std::optional<base::Sha256> Blockchain::findBlockHashByDepth(lk::BlockDepth dept
 
 std::optional<lk::Transaction> Blockchain::findTransaction(const base::Sha256& tx_hash) const
 {
-    std::shared_lock lk(_blocks_mutex);
-    for (const auto& block : _blocks) {
-        for (const auto& tx : block.second.getTransactions()) {
+    auto find_in_block = [&tx_hash](const ImmutableBlock& block) -> std::optional<lk::Transaction> {
+        for (const auto& tx : block.getTransactions()) {
             if (tx.hashOfTransaction() == tx_hash) {
                 return tx;
             }
         }
+        return std::nullopt;
+    };
+
+    // the top block may be not indexed yet
+    if (auto tx = find_in_block(getTopBlock()); tx) {
+        return tx;
+    }
+    else if (auto tx = find_in_block(getGenesisBlock()); tx) {
+        return tx;
+    }
+    else if (auto depth = findTransactionBlockDepth(tx_hash); depth) {
+        if (auto block = findBlockByDepth(*depth); block) {
+            return find_in_block(*block);
+        }
     }
     return std::nullopt;
 }
@@ -163,38 +261,29 @@ std::optional<lk::Transaction> Blockchain::findTransaction(const base::Sha256& t
 
 ImmutableBlock Blockchain::getGenesisBlock() const
 {
-    auto block = findBlock(_genesis_block_hash);
-    ASSERT(block);
-    return *block;
+    std::shared_lock lk(_blocks_mutex);
+    return *_genesis_block;
 }
 
 
 std::pair<ImmutableBlock, lk::Complexity> Blockchain::getTopBlockAndComplexity() const
 {
     std::shared_lock lk(_blocks_mutex);
-    return { getTopBlock(), _consensus.getComplexity() };
+    return { *_top_block, _consensus.getComplexity() };
 }
 
 
 ImmutableBlock Blockchain::getTopBlock() const
 {
     std::shared_lock lk(_blocks_mutex);
-    return _getTopBlock();
-}
-
-
-const ImmutableBlock& Blockchain::_getTopBlock() const
-{
-    ASSERT(!_blocks_mutex.try_lock()); // ensures that this function is used only in thread-safe environment
-    auto it = _blocks.find(_top_level_block_hash);
-    ASSERT(it != _blocks.end());
-    return it->second;
+    return *_top_block;
 }
 
 
 base::Sha256 Blockchain::getTopBlockHash() const
 {
-    return _top_level_block_hash;
+    std::shared_lock lk(_blocks_mutex);
+    return _top_block->getHash();
 }
 
 
@@ -204,37 +293,103 @@ bool Blockchain::checkConsensus(const ImmutableBlock& block) const
 }
 
 
-PersistentBlockchain::PersistentBlockchain(ImmutableBlock genesis_block, const base::PropertyTree& config)
+PersistentBlockchain::PersistentBlockchain(ImmutableBlock genesis_block,
+                                           base::Database& database,
+                                           const base::PropertyTree& config)
   : Blockchain{ std::move(genesis_block), config }
+  , _database{ database }
+  , _is_stored_data_trusted{ config.hasKey("database.trusted") && config.get<bool>("database.trusted") }
+  , _blocks_cache{ getBlocksCacheSize(config) }
+  , _kept_blocks_count{ getKeptBlocksCount(config) }
+{}
+
+
+void PersistentBlockchain::load()
 {
-    auto database_path = config.get<std::string>("database.path");
-    if (config.get<bool>("database.clean")) {
-        _database = base::createClearDatabaseInstance(base::Directory(database_path));
-        LOG_INFO << "Created clear database instance.";
+    // the calling thread reads and adds blocks, so the rest of cores deserialize them
+    const auto workers_count = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+    boost::asio::thread_pool workers(workers_count);
+    std::deque<std::future<ImmutableBlock>> deserialized_blocks;
+
+    bool is_chain_consistent = true;
+    auto add_next_block = [this, &deserialized_blocks, &is_chain_consistent] {
+        auto block = deserialized_blocks.front().get();
+        deserialized_blocks.pop_front();
+        LOG_DEBUG << "Loading block " << block.getHash() << " from database";
+        if (auto r = addBlock(block, _is_stored_data_trusted); r != AdditionResult::ADDED) {
+            LOG_WARNING << "Stored block " << block.getHash() << " is not added with reason " << static_cast<int>(r)
+                        << ", loading is stopped at depth " << getTopBlock().getDepth();
+            is_chain_consistent = false;
+        }
+    };
+
+    std::lock_guard pruning_lk(_pruning_mutex);
+    std::shared_lock lk(_database_rw_mutex);
+
+    // headers of pruned blocks go before the first stored body
+    std::optional<BlockDepth> first_body_depth;
+    _database.scan(makeDatabaseKey(DataType::BLOCK, base::Bytes{}),
+                   [&first_body_depth](const leveldb::Slice&, const leveldb::Slice& value) {
+                       // the depth is serialized first
+                       const base::Bytes block_data(reinterpret_cast<const base::Byte*>(value.data()), value.size());
+                       base::SerializationIArchive ia(block_data);
+                       first_body_depth = ia.deserialize<BlockDepth>();
+                       return false;
+                   });
+    if (first_body_depth && *first_body_depth > 1) {
+        _database.scan(makeDatabaseKey(DataType::BLOCK_HEADER, base::Bytes{}),
+                       [&](const leveldb::Slice&, const leveldb::Slice& value) {
+                           const base::Bytes header_data(reinterpret_cast<const base::Byte*>(value.data()),
+                                                         value.size());
+                           base::SerializationIArchive ia(header_data);
+                           auto depth = ia.deserialize<BlockDepth>();
+                           auto hash = ia.deserialize<base::Sha256>();
+                           auto timestamp = ia.deserialize<base::Time>();
+                           if (depth >= *first_body_depth) {
+                               return false;
+                           }
+                           if (!addPrunedBlock(depth, hash, timestamp)) {
+                               LOG_WARNING << "Header of pruned block " << hash << " is not added, loading is stopped";
+                               is_chain_consistent = false;
+                           }
+                           return is_chain_consistent;
+                       });
+        _pruned_depth = *first_body_depth - 1;
     }
-    else {
-        _database = base::createDefaultDatabaseInstance(base::Directory(database_path));
-        LOG_INFO << "Loaded database by path: " << database_path;
+
+    _database.scan(makeDatabaseKey(DataType::BLOCK, base::Bytes{}),
+                   [&](const leveldb::Slice&, const leveldb::Slice& value) {
+                       auto deserialization = std::make_shared<std::packaged_task<ImmutableBlock()>>(
+                         [block_data = base::Bytes(reinterpret_cast<const base::Byte*>(value.data()), value.size())] {
+                             return base::fromBytes<ImmutableBlock>(block_data);
+                         });
+                       deserialized_blocks.push_back(deserialization->get_future());
+                       boost::asio::post(workers, [deserialization] { (*deserialization)(); });
+
+                       if (deserialized_blocks.size() > base::config::BC_LOAD_PREFETCHED_BLOCKS_COUNT) {
+                           add_next_block();
+                       }
+                       return is_chain_consistent;
+                   });
+    while (is_chain_consistent && !deserialized_blocks.empty()) {
+        add_next_block();
     }
+    workers.join();
 }
 
 
-void PersistentBlockchain::load()
+IBlockchain::AdditionResult PersistentBlockchain::tryAddBlock(const ImmutableBlock& block)
 {
-    for (const auto& block_hash : createAllBlockHashesListAtPersistentStorage()) {
-        LOG_DEBUG << "Loading block " << block_hash << " from database";
-        auto current_block = findBlockAtPersistentStorage(block_hash);
-        ASSERT(current_block);
-        tryAddBlock(current_block.value());
-    }
+    base::Database::Batch batch;
+    return tryAddBlock(block, batch);
 }
 
 
-IBlockchain::AdditionResult PersistentBlockchain::tryAddBlock(const ImmutableBlock& block)
+IBlockchain::AdditionResult PersistentBlockchain::tryAddBlock(const ImmutableBlock& block, base::Database::Batch& batch)
 {
     auto r = Blockchain::tryAddBlock(block);
     if (r == IBlockchain::AdditionResult::ADDED) {
-        pushForwardToPersistentStorage(block);
+        pushForwardToPersistentStorage(block, std::move(batch));
     }
     else {
         LOG_DEBUG << block.getHash() << " is not added with reason " << static_cast<int>(r);
@@ -243,66 +398,149 @@ IBlockchain::AdditionResult PersistentBlockchain::tryAddBlock(const ImmutableBlo
 }
 
 
-void PersistentBlockchain::pushForwardToPersistentStorage(const ImmutableBlock& block)
+void PersistentBlockchain::pushForwardToPersistentStorage(const ImmutableBlock& block, base::Database::Batch&& batch)
 {
-    const auto raw_block_hash = block.getHash().getBytes();
-    auto serialized_block = base::toBytes(block);
+    const auto depth_data = base::toBytes(block.getDepth());
+    for (const auto& tx : block.getTransactions()) {
+        batch.put(makeDatabaseKey(DataType::TRANSACTION_BLOCK_DEPTH, tx.hashOfTransaction().getBytes()), depth_data);
+    }
+    batch.put(makeDatabaseKey(DataType::BLOCK, block.getDepth()), base::toBytes(block));
+
+    std::lock_guard pruning_lk(_pruning_mutex);
+    const auto pruned_depth = prunePrecedingBlocks(block.getDepth(), batch);
     {
         std::lock_guard lk(_database_rw_mutex);
-        if (_database.exists(toBytes(DataType::BLOCK, raw_block_hash))) {
-            return;
+        _database.write(std::move(batch));
+    }
+
+    if (pruned_depth > _pruned_depth) {
+        {
+            std::lock_guard lk(_blocks_cache_mutex);
+            for (auto depth = _pruned_depth + 1; depth <= pruned_depth; ++depth) {
+                _blocks_cache.erase(depth);
+            }
+        }
+        _pruned_since_compaction += pruned_depth - _pruned_depth;
+        _pruned_depth = pruned_depth;
+        if (_pruned_since_compaction >= base::config::DATABASE_PRUNING_COMPACTION_PERIOD) {
+            startCompaction();
         }
-        _database.put(toBytes(DataType::BLOCK, raw_block_hash), serialized_block);
-        _database.put(toBytes(DataType::PREVIOUS_BLOCK_HASH, raw_block_hash), block.getPrevBlockHash().getBytes());
-        _database.put(LAST_BLOCK_HASH_KEY, raw_block_hash);
     }
 }
 
 
-std::optional<base::Sha256> PersistentBlockchain::getLastBlockHashAtPersistentStorage() const
+BlockDepth PersistentBlockchain::prunePrecedingBlocks(BlockDepth top_depth, base::Database::Batch& batch)
 {
-    if (_database.exists(LAST_BLOCK_HASH_KEY)) {
-        auto hash_data = _database.get(LAST_BLOCK_HASH_KEY);
-        if (hash_data) {
-            return base::Sha256(std::move(hash_data.value()));
+    if (_kept_blocks_count == 0 || top_depth <= _kept_blocks_count) {
+        return _pruned_depth;
+    }
+    const auto pruned_depth = std::max(_pruned_depth, std::min(top_depth - _kept_blocks_count, _prunable_depth.load()));
+    for (auto depth = _pruned_depth + 1; depth <= pruned_depth; ++depth) {
+        // loaded before the database is locked for writing, since loading locks it for reading
+        auto block = loadBlock(depth);
+        if (!block) {
+            RAISE_ERROR(base::LogicError, "body of a block to be pruned is not found");
+        }
+        for (const auto& tx : block->getTransactions()) {
+            batch.remove(makeDatabaseKey(DataType::TRANSACTION_BLOCK_DEPTH, tx.hashOfTransaction().getBytes()));
         }
+        batch.remove(makeDatabaseKey(DataType::BLOCK, depth));
+        batch.put(makeDatabaseKey(DataType::BLOCK_HEADER, depth), makeHeaderData(*block));
     }
-    return std::nullopt;
+    return pruned_depth;
 }
 
 
-std::optional<ImmutableBlock> PersistentBlockchain::findBlockAtPersistentStorage(const base::Sha256& block_hash) const
+void PersistentBlockchain::startCompaction()
 {
-    std::shared_lock lk(_database_rw_mutex);
-    auto block_data = _database.get(toBytes(DataType::BLOCK, block_hash.getBytes()));
-    if (!block_data) {
-        return std::nullopt;
+    // a running compaction will also free the space of blocks pruned since it was started
+    if (_compaction.valid() && _compaction.wait_for(std::chrono::seconds{ 0 }) != std::future_status::ready) {
+        return;
     }
-    base::SerializationIArchive ia(block_data.value());
-    return ia.deserialize<ImmutableBlock>();
+    _pruned_since_compaction = 0;
+    _compaction = std::async(std::launch::async, [this] {
+        try {
+            _database.compact(makeDatabaseKey(DataType::BLOCK, base::Bytes{}));
+            _database.compact(makeDatabaseKey(DataType::TRANSACTION_BLOCK_DEPTH, base::Bytes{}));
+        }
+        catch (const std::exception& e) {
+            LOG_ERROR << "Compaction of pruned blocks failed: " << e.what();
+        }
+    });
 }
 
 
-std::vector<base::Sha256> PersistentBlockchain::createAllBlockHashesListAtPersistentStorage() const
+void PersistentBlockchain::storeBlock(const ImmutableBlock& block)
 {
-    std::vector<base::Sha256> all_blocks_hashes{};
-    auto last_block_hash = getLastBlockHashAtPersistentStorage();
-    if (last_block_hash) {
-        base::Sha256 current_block_hash = last_block_hash.value();
-        const base::Sha256 genesis_hash = getGenesisBlock().getHash();
+    // keeps the block available until it is written
+    std::lock_guard lk(_blocks_cache_mutex);
+    _blocks_cache.put(block.getDepth(), block, estimateSize(block));
+}
 
-        std::shared_lock lk(_database_rw_mutex);
-        while (current_block_hash != genesis_hash) {
-            all_blocks_hashes.push_back(current_block_hash);
-            auto previous_block_hash_data =
-              _database.get(toBytes(DataType::PREVIOUS_BLOCK_HASH, current_block_hash.getBytes()));
-            ASSERT(previous_block_hash_data);
-            current_block_hash = base::Sha256(std::move(previous_block_hash_data.value()));
+
+std::optional<ImmutableBlock> PersistentBlockchain::loadBlock(BlockDepth depth) const
+{
+    {
+        std::lock_guard lk(_blocks_cache_mutex);
+        if (auto block = _blocks_cache.get(depth); block) {
+            return block;
         }
+    }
+
+    std::optional<base::Bytes> block_data;
+    {
+        std::shared_lock lk(_database_rw_mutex);
+        block_data = _database.get(makeDatabaseKey(DataType::BLOCK, depth));
+    }
+    if (!block_data) {
+        return std::nullopt;
+    }
+    auto block = base::fromBytes<ImmutableBlock>(*block_data);
 
-        std::reverse(std::begin(all_blocks_hashes), std::end(all_blocks_hashes));
+    std::lock_guard lk(_blocks_cache_mutex);
+    _blocks_cache.put(depth, block, estimateSize(block));
+    return block;
+}
+
+
+std::optional<BlockDepth> PersistentBlockchain::findTransactionBlockDepth(const base::Sha256& tx_hash) const
+{
+    std::shared_lock lk(_database_rw_mutex);
+    if (auto depth_data = _database.get(makeDatabaseKey(DataType::TRANSACTION_BLOCK_DEPTH, tx_hash.getBytes()));
+        depth_data) {
+        return base::fromBytes<BlockDepth>(*depth_data);
     }
-    return all_blocks_hashes;
+    return std::nullopt;
+}
+
+
+bool PersistentBlockchain::isPruningEnabled() const noexcept
+{
+    return _kept_blocks_count > 0;
+}
+
+
+void PersistentBlockchain::setPrunableDepth(BlockDepth depth)
+{
+    _prunable_depth = depth;
+}
+
+
+BlockDepth PersistentBlockchain::getPrunedDepth() const
+{
+    std::lock_guard lk(_pruning_mutex);
+    return _pruned_depth;
+}
+
+
+PersistentBlockchain::CacheStatistics PersistentBlockchain::getBlocksCacheStatistics() const
+{
+    std::lock_guard lk(_blocks_cache_mutex);
+    return { _blocks_cache.hits(),
+             _blocks_cache.misses(),
+             _blocks_cache.size(),
+             _blocks_cache.charge(),
+             _blocks_cache.capacity() };
 }
 
 } // namespace lk
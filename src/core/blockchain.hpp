@@ -1,6 +1,8 @@
 #pragma once
 
 #include "base/database.hpp"
+#include "base/hash_map.hpp"
+#include "base/lru_cache.hpp"
 #include "base/property_tree.hpp"
 #include "base/utility.hpp"
 #include "core/block.hpp"
@@ -8,8 +10,12 @@
 #include "core/transaction.hpp"
 #include "core/transactions_set.hpp"
 
+#include <atomic>
+#include <future>
+#include <mutex>
 #include <shared_mutex>
 #include <unordered_map>
+#include <vector>
 
 namespace lk
 {
@@ -32,6 +38,7 @@ class IBlockchain
         INVALID_TRANSACTIONS_NUMBER,
         INVALID_TRANSACTIONS,
         CONSENSUS_ERROR,
+        INVALID_STATE_ROOT,
     };
 
     virtual AdditionResult tryAddBlock(const ImmutableBlock& block) = 0;
@@ -69,23 +76,34 @@ class Blockchain : public IBlockchain
     ImmutableBlock getTopBlock() const override;
     base::Sha256 getTopBlockHash() const override;
     //===================
+  protected:
+    // a trusted block (e.g. loaded from the node's own database) is only checked to extend the top block
+    AdditionResult addBlock(const ImmutableBlock& block, bool is_trusted);
+    // restores a block, whose body was pruned, from its header: only its hash is kept, so it must precede any body
+    bool addPrunedBlock(BlockDepth depth, const base::Sha256& hash, const base::Time& timestamp);
+    //===================
+    // Block bodies and the transactions index; the in-memory blockchain keeps all of them. The genesis
+    // and the top blocks are always kept by the blockchain itself. Only storeBlock is called under the lock.
+    virtual void storeBlock(const ImmutableBlock& block);
+    virtual std::optional<ImmutableBlock> loadBlock(BlockDepth depth) const;
+    virtual std::optional<BlockDepth> findTransactionBlockDepth(const base::Sha256& tx_hash) const;
+    //===================
   private:
     //===================
     const base::PropertyTree& _config;
     //===================
-    std::unordered_map<base::Sha256, const ImmutableBlock> _blocks;
-    std::map<lk::BlockDepth, base::Sha256> _blocks_by_depth;
-    base::Sha256 _genesis_block_hash;
-    base::Sha256 _top_level_block_hash;
+    // only hashes are kept for every block
+    base::HashMap<base::Sha256, BlockDepth, base::PrefixHash<base::Sha256>> _depths_by_hash;
+    std::vector<base::Sha256> _hashes_by_depth;
+    std::optional<ImmutableBlock> _genesis_block;
+    std::optional<ImmutableBlock> _top_block;
     mutable std::shared_mutex _blocks_mutex;
 
-    void addGenesisBlock(ImmutableBlock block);
+    std::unordered_map<BlockDepth, ImmutableBlock> _stored_blocks;
+    std::unordered_map<base::Sha256, BlockDepth> _transactions_depths;
 
-    /*
-     * Thread-unsafe: prefix _ means that its purpose it the same as getTopBlock,
-     * but it is an unsafe version. Used in getTopBlock(), only with lock.
-     */
-    const ImmutableBlock& _getTopBlock() const;
+    void addGenesisBlock(ImmutableBlock block);
+    std::optional<ImmutableBlock> findBlockByDepth(BlockDepth depth) const;
     //===================
     Consensus _consensus;
     bool checkConsensus(const ImmutableBlock& block) const;
@@ -99,23 +117,64 @@ class PersistentBlockchain : public Blockchain
 {
   public:
     //===================
-    PersistentBlockchain(ImmutableBlock genesis_block, const base::PropertyTree& config);
+    // the database is shared with other storages of the node and must outlive the blockchain
+    PersistentBlockchain(ImmutableBlock genesis_block, base::Database& database, const base::PropertyTree& config);
     PersistentBlockchain(const Blockchain&) = delete;
     PersistentBlockchain(Blockchain&&) = delete;
     ~PersistentBlockchain() override = default;
     //===================
+    // reads the blocks with a sequential scan, deserializing them on worker threads ahead of the block being added
     void load();
     //===================
     AdditionResult tryAddBlock(const ImmutableBlock& block) override;
+    // the batch is written atomically with the block if it is added, otherwise it is left untouched
+    AdditionResult tryAddBlock(const ImmutableBlock& block, base::Database::Batch& batch);
+    //===================
+    struct CacheStatistics
+    {
+        std::size_t hits;
+        std::size_t misses;
+        std::size_t blocks_count;
+        std::size_t size; // estimated memory taken by the cached blocks
+        std::size_t capacity;
+    };
+
+    CacheStatistics getBlocksCacheStatistics() const;
+    //===================
+    // Pruning mode is enabled by the "database.pruning.kept_blocks" parameter: bodies of blocks older than
+    // the given number of top blocks are removed with their transactions index, only headers are kept.
+    bool isPruningEnabled() const noexcept;
+    // bodies are not removed above the depth: the node must be able to restore its state without them
+    void setPrunableDepth(BlockDepth depth);
+    // depth of the last block without a body
+    BlockDepth getPrunedDepth() const;
+    //===================
+  protected:
+    void storeBlock(const ImmutableBlock& block) override;
+    std::optional<ImmutableBlock> loadBlock(BlockDepth depth) const override;
+    std::optional<BlockDepth> findTransactionBlockDepth(const base::Sha256& tx_hash) const override;
     //===================
   private:
-    base::Database _database;
+    base::Database& _database;
     mutable std::shared_mutex _database_rw_mutex;
-    //===================
-    void pushForwardToPersistentStorage(const ImmutableBlock& block);
-    std::optional<base::Sha256> getLastBlockHashAtPersistentStorage() const;
-    std::optional<ImmutableBlock> findBlockAtPersistentStorage(const base::Sha256& block_hash) const;
-    std::vector<base::Sha256> createAllBlockHashesListAtPersistentStorage() const;
+    const bool _is_stored_data_trusted; // if set, loaded blocks are not validated again
+
+    // bodies of blocks read or added recently, keyed by depth and bounded by their estimated size
+    mutable base::LruCache<BlockDepth, ImmutableBlock, base::IntegerHash<BlockDepth>> _blocks_cache;
+    mutable std::mutex _blocks_cache_mutex;
+
+    const BlockDepth _kept_blocks_count; // 0 if pruning is disabled
+    std::atomic<BlockDepth> _prunable_depth{ 0 };
+    BlockDepth _pruned_depth{ 0 };
+    std::size_t _pruned_since_compaction{ 0 };
+    mutable std::mutex _pruning_mutex;
+    //===================
+    void pushForwardToPersistentStorage(const ImmutableBlock& block, base::Database::Batch&& batch);
+    BlockDepth prunePrecedingBlocks(BlockDepth top_depth, base::Database::Batch& batch);
+    //===================
+    // declared last, so the destructor waits for the compaction before anything else is destroyed
+    std::future<void> _compaction;
+    void startCompaction();
     //===================
 };
 
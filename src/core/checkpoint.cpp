@@ -0,0 +1,75 @@
+#include "checkpoint.hpp"
+
+#include "base/log.hpp"
+#include "core/database_keys.hpp"
+
+namespace
+{
+
+const base::Bytes CHECKPOINT_KEY = lk::makeDatabaseKey(lk::DataType::SYSTEM, base::Bytes("checkpoint"));
+
+} // namespace
+
+
+namespace lk
+{
+
+void Checkpoint::serialize(base::SerializationOArchive& oa) const
+{
+    oa.serialize(depth);
+    oa.serialize(block_hash);
+    oa.serialize(state_root);
+    oa.serialize(state);
+}
+
+
+Checkpoint Checkpoint::deserialize(base::SerializationIArchive& ia)
+{
+    auto depth = ia.deserialize<BlockDepth>();
+    auto block_hash = ia.deserialize<base::Sha256>();
+    auto state_root = ia.deserialize<base::Sha256>();
+    auto state = ia.deserialize<base::Bytes>();
+    return Checkpoint{ depth, std::move(block_hash), std::move(state_root), std::move(state) };
+}
+
+
+void writeCheckpoint(base::Database& database, StateManager& state_manager, const Checkpoint& checkpoint)
+{
+    base::SerializationOArchive oa;
+    checkpoint.serialize(oa);
+
+    base::Database::Batch batch;
+    state_manager.flush(batch);
+    batch.put(CHECKPOINT_KEY, std::move(oa).getBytes());
+    database.write(std::move(batch));
+}
+
+
+std::optional<Checkpoint> readCheckpoint(const base::Database& database)
+{
+    auto data = database.get(CHECKPOINT_KEY);
+    if (!data) {
+        return std::nullopt;
+    }
+    base::SerializationIArchive ia(*data);
+    return Checkpoint::deserialize(ia);
+}
+
+
+std::optional<Checkpoint> restoreCheckpoint(const base::Database& database,
+                                            const Blockchain& blockchain,
+                                            StateManager& state_manager)
+{
+    auto checkpoint = readCheckpoint(database);
+    if (!checkpoint) {
+        return std::nullopt;
+    }
+    if (blockchain.findBlockHashByDepth(checkpoint->depth) != checkpoint->block_hash ||
+        !state_manager.importState(checkpoint->state, checkpoint->state_root)) {
+        LOG_WARNING << "Stored checkpoint at depth " << checkpoint->depth << " doesn't match the blockchain";
+        return std::nullopt;
+    }
+    return checkpoint;
+}
+
+} // namespace lk
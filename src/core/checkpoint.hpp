@@ -0,0 +1,42 @@
+#pragma once
+
+#include "base/database.hpp"
+#include "base/hash.hpp"
+#include "base/serialization.hpp"
+#include "core/blockchain.hpp"
+#include "core/managers.hpp"
+
+#include <optional>
+
+namespace lk
+{
+
+// State of the node after applying the block. It is written with a single batch together with the state trie nodes
+// and the transactions history entries changed up to the block, so after a crash the stored data is consistent with
+// the last written checkpoint and the node executes only the blocks above it. The chain tip is the block itself,
+// which is written before the checkpoint, and the positions of the transactions history index are the transactions
+// counts of accounts in the state.
+struct Checkpoint
+{
+    BlockDepth depth;
+    base::Sha256 block_hash;
+    base::Sha256 state_root;
+    base::Bytes state; // exported by the state manager
+
+    void serialize(base::SerializationOArchive& oa) const;
+    static Checkpoint deserialize(base::SerializationIArchive& ia);
+};
+
+
+// flushes the state and replaces the stored checkpoint with a single write
+void writeCheckpoint(base::Database& database, StateManager& state_manager, const Checkpoint& checkpoint);
+
+std::optional<Checkpoint> readCheckpoint(const base::Database& database);
+
+// imports the state of the stored checkpoint, if the checkpoint block is in the loaded blockchain;
+// returns std::nullopt and leaves the state unchanged otherwise
+std::optional<Checkpoint> restoreCheckpoint(const base::Database& database,
+                                            const Blockchain& blockchain,
+                                            StateManager& state_manager);
+
+} // namespace lk
@@ -0,0 +1,77 @@
+#include "code_store.hpp"
+
+namespace lk
+{
+
+ContractCode::ContractCode(base::Bytes bytes)
+  : _bytes{ std::move(bytes) }
+  , _hash{ base::Sha256::compute(_bytes) }
+{}
+
+
+const base::Bytes& ContractCode::getBytes() const noexcept
+{
+    return _bytes;
+}
+
+
+const base::Sha256& ContractCode::getHash() const noexcept
+{
+    return _hash;
+}
+
+
+std::size_t ContractCode::size() const noexcept
+{
+    return _bytes.size();
+}
+
+
+bool ContractCode::isEmpty() const noexcept
+{
+    return _bytes.isEmpty();
+}
+
+
+const ContractCodePtr& ContractCode::empty()
+{
+    static const ContractCodePtr empty_code = std::make_shared<const ContractCode>(base::Bytes{});
+    return empty_code;
+}
+
+
+CodeStore::CodeStore(std::size_t capacity)
+  : _codes{ capacity }
+{}
+
+
+ContractCodePtr CodeStore::add(base::Bytes code)
+{
+    if (code.isEmpty()) {
+        return ContractCode::empty();
+    }
+    auto contract_code = std::make_shared<const ContractCode>(std::move(code));
+
+    std::lock_guard lk(_mutex);
+    if (auto stored = _codes.get(contract_code->getHash()); stored) {
+        return *stored;
+    }
+    _codes.put(contract_code->getHash(), contract_code, contract_code->size());
+    return contract_code;
+}
+
+
+std::size_t CodeStore::hits() const
+{
+    std::lock_guard lk(_mutex);
+    return _codes.hits();
+}
+
+
+std::size_t CodeStore::misses() const
+{
+    std::lock_guard lk(_mutex);
+    return _codes.misses();
+}
+
+} // namespace lk
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "base/bytes.hpp"
+#include "base/hash.hpp"
+#include "base/lru_cache.hpp"
+
+#include <memory>
+#include <mutex>
+
+namespace lk
+{
+
+// Runtime code of a contract with its hash, which is computed once. It's immutable, so a single buffer is shared by
+// the account, commits over it and the calls being executed, and is never copied.
+class ContractCode
+{
+  public:
+    explicit ContractCode(base::Bytes bytes);
+    ContractCode(const ContractCode&) = delete;
+    ContractCode& operator=(const ContractCode&) = delete;
+    ~ContractCode() = default;
+    //================
+    const base::Bytes& getBytes() const noexcept;
+    const base::Sha256& getHash() const noexcept;
+    std::size_t size() const noexcept;
+    bool isEmpty() const noexcept;
+    //================
+    // code of client accounts and of contracts, which have not been deployed yet
+    static const std::shared_ptr<const ContractCode>& empty();
+
+  private:
+    base::Bytes _bytes;
+    base::Sha256 _hash;
+};
+
+
+using ContractCodePtr = std::shared_ptr<const ContractCode>;
+
+
+// Code of recently deployed or loaded contracts by its hash, so contracts with equal code share a single buffer.
+// The capacity is the total size of codes; the evicted code lives on while accounts refer to it. Thread-safe.
+class CodeStore
+{
+  public:
+    explicit CodeStore(std::size_t capacity);
+    CodeStore(const CodeStore&) = delete;
+    CodeStore& operator=(const CodeStore&) = delete;
+    ~CodeStore() = default;
+    //================
+    // the stored code equal to the given one, otherwise the given code, which is stored
+    ContractCodePtr add(base::Bytes code);
+    //================
+    std::size_t hits() const;
+    std::size_t misses() const;
+
+  private:
+    mutable std::mutex _mutex;
+    base::LruCache<base::Sha256, ContractCodePtr, base::PrefixHash<base::Sha256>> _codes;
+};
+
+} // namespace lk
@@ -61,25 +61,29 @@ bool Consensus::checkBlock(const ImmutableBlock& block) const
 }
 
 
-void Consensus::applyBlock(ImmutableBlock block)
+void Consensus::applyBlock(const ImmutableBlock& block)
 {
-    _last_blocks.push(std::move(block)); // TODO: change it, of course
-    if (_last_blocks.size() < base::config::BC_DIFFICULTY_RECALCULATION_RATE) {
+    applyBlock(block.getDepth(), block.getTimestamp());
+}
+
+
+void Consensus::applyBlock(BlockDepth depth, const base::Time& timestamp)
+{
+    _last_timestamps.push(timestamp);
+    if (_last_timestamps.size() < base::config::BC_DIFFICULTY_RECALCULATION_RATE) {
         // means we do not have enough block to recalculate anything
         return;
     }
 
-    if (_last_blocks.size() > base::config::BC_DIFFICULTY_RECALCULATION_RATE) {
-        _last_blocks.pop();
+    if (_last_timestamps.size() > base::config::BC_DIFFICULTY_RECALCULATION_RATE) {
+        _last_timestamps.pop();
     }
 
-    if (block.getDepth() != 0 && (block.getDepth() - 1) % base::config::BC_DIFFICULTY_RECALCULATION_RATE != 0) {
+    if (depth != 0 && (depth - 1) % base::config::BC_DIFFICULTY_RECALCULATION_RATE != 0) {
         return;
     }
 
-    const ImmutableBlock& p = _last_blocks.front();
-
-    auto elapsed = (block.getTimestamp() - p.getTimestamp()).getSeconds();
+    auto elapsed = (timestamp - _last_timestamps.front()).getSeconds();
     ASSERT(elapsed);
     if constexpr (!base::config::IS_DEBUG) {
         if (elapsed == 0) {
@@ -37,12 +37,14 @@ class Consensus
 
     bool checkBlock(const ImmutableBlock& block) const;
 
-    void applyBlock(ImmutableBlock block);
+    void applyBlock(const ImmutableBlock& block);
+    // the complexity depends only on depths and timestamps, so it can be restored from headers of pruned blocks
+    void applyBlock(BlockDepth depth, const base::Time& timestamp);
 
     const Complexity& getComplexity() const;
 
   private:
-    std::queue<ImmutableBlock> _last_blocks;
+    std::queue<base::Time> _last_timestamps;
     Complexity _complexity;
 };
 
@@ -1,11 +1,33 @@
 #include "core.hpp"
 
+#include "base/error.hpp"
 #include "base/log.hpp"
+#include "core/database_keys.hpp"
 #include "vm/error.hpp"
 #include "vm/tools.hpp"
 
 #include <algorithm>
 
+namespace
+{
+
+std::size_t getTransactionsHistoryLimit(const base::PropertyTree& config)
+{
+    if (config.hasKey("database.pruning.transactions_history")) {
+        return config.get<std::size_t>("database.pruning.transactions_history");
+    }
+    return 0;
+}
+
+
+bool isTracingEnabled(const base::PropertyTree& config)
+{
+    return config.hasKey("vm.trace_transactions") && config.get<bool>("vm.trace_transactions");
+}
+
+} // namespace
+
+
 namespace lk
 {
 
@@ -13,17 +35,40 @@ Core::Core(const base::PropertyTree& config, const base::KeyVault& key_vault)
   : _config{ config }
   , _vault{ key_vault }
   , _this_node_address{ _vault.getKey().toPublicKey() }
-  , _blockchain{ getGenesisBlock(), _config }
+  , _database{ openDatabase(_config) }
+  , _state_manager{ _database }
+  , _blockchain{ getGenesisBlock(), _database, _config }
+  , _logs_index{ _database }
   , _host{ _config, 0xFFFF, *this }
   , _vm{ vm::load() }
+  , _executor{ std::thread::hardware_concurrency() }
+  , _fee_estimator{ base::config::RPC_FEE_ESTIMATION_THREADS_COUNT }
+  , _is_tracing_enabled{ isTracingEnabled(_config) }
 {
+    _state_manager.setTransactionsHistoryLimit(getTransactionsHistoryLimit(_config));
     _state_manager.updateFromGenesis(getGenesisBlock());
 
+    _state_manager.updateStateRoot();
+
     _blockchain.load();
-    for (lk::BlockDepth d = 1; d <= _blockchain.getTopBlock().getDepth(); ++d) {
-        auto block = *_blockchain.findBlock(*_blockchain.findBlockHashByDepth(d));
-        for (const auto& tx : block.getTransactions()) {
-            tryPerformTransaction(tx, block);
+    for (lk::BlockDepth d = restoreCheckpoint() + 1; d <= _blockchain.getTopBlock().getDepth(); ++d) {
+        auto stored_block = _blockchain.findBlock(*_blockchain.findBlockHashByDepth(d));
+        if (!stored_block) {
+            RAISE_ERROR(base::LogicError, "body of a stored block is pruned, the state cannot be replayed");
+        }
+        const auto& block = *stored_block;
+        if (block.getStateRoot() != _state_manager.getStateRoot()) {
+            RAISE_ERROR(base::LogicError, "state root of a stored block doesn't match the replayed state");
+        }
+        applyBlockTransactions(block);
+        auto state_root = _state_manager.updateStateRoot();
+        base::Database::Batch batch;
+        _state_manager.flush(batch);
+        _logs_index.flush(batch);
+        _database.write(std::move(batch));
+        if (d % base::config::BC_SNAPSHOT_PERIOD == 0 &&
+            d + base::config::BC_SNAPSHOT_PERIOD > _blockchain.getTopBlock().getDepth()) {
+            makeSnapshot(block, state_root);
         }
     }
 
@@ -51,6 +96,7 @@ const ImmutableBlock& Core::getGenesisBlock()
         b.setDepth(0);
         b.setNonce(0);
         b.setPrevBlockHash(base::Sha256::null());
+        b.setStateRoot(base::Sha256::null());
         b.setTimestamp(timestamp);
         b.setCoinbase(initial_emission_address);
         b.setTransactionsSet(std::move(txset));
@@ -62,6 +108,25 @@ const ImmutableBlock& Core::getGenesisBlock()
 }
 
 
+base::Database Core::openDatabase(const base::PropertyTree& config)
+{
+    auto database_path = config.get<std::string>("database.path");
+    const auto options = base::readDatabaseOptions(config, "database");
+    if (config.get<bool>("database.clean")) {
+        auto database = base::createClearDatabaseInstance(base::Directory(database_path), options);
+        database.setGroupCommit(true);
+        LOG_INFO << "Created clear database instance.";
+        return database;
+    }
+    else {
+        auto database = base::createDefaultDatabaseInstance(base::Directory(database_path), options);
+        database.setGroupCommit(true);
+        LOG_INFO << "Loaded database by path: " << database_path;
+        return database;
+    }
+}
+
+
 void Core::run()
 {
     _host.run();
@@ -163,6 +228,23 @@ void Core::addTransactionOutput(const base::Sha256& tx, const TransactionStatus&
 }
 
 
+std::optional<ExecutionTrace> Core::findTransactionTrace(const base::Sha256& tx_hash) const
+{
+    std::shared_lock lk(_tx_outputs_mutex);
+    if (auto it = _tx_traces.find(tx_hash); it != _tx_traces.end()) {
+        return it->second;
+    }
+    return std::nullopt;
+}
+
+
+void Core::addTransactionTrace(const base::Sha256& tx, ExecutionTrace trace)
+{
+    std::unique_lock lk(_tx_outputs_mutex);
+    _tx_traces.insert_or_assign(tx, std::move(trace));
+}
+
+
 Blockchain::AdditionResult Core::tryAddBlock(const ImmutableBlock& b)
 {
     {
@@ -201,7 +283,18 @@ Blockchain::AdditionResult Core::_tryAddBlock(const ImmutableBlock& b)
         return Blockchain::AdditionResult::INVALID_TRANSACTIONS;
     }
 
-    if (auto r = _blockchain.tryAddBlock(b); r != Blockchain::AdditionResult::ADDED) {
+    // a block commits to the state it was built upon
+    if (b.getStateRoot() != _state_manager.getStateRoot()) {
+        return Blockchain::AdditionResult::INVALID_STATE_ROOT;
+    }
+
+    // the block is written at once with the nodes of the state trie, which its state root refers to, and the logs of
+    // the previous block
+    base::Database::Batch batch;
+    _state_manager.flush(batch);
+    _logs_index.flush(batch);
+    if (auto r = _blockchain.tryAddBlock(b, batch); r != Blockchain::AdditionResult::ADDED) {
+        _database.write(std::move(batch)); // the nodes don't depend on the block and are needed anyway
         return r;
     }
 
@@ -213,10 +306,144 @@ Blockchain::AdditionResult Core::_tryAddBlock(const ImmutableBlock& b)
     LOG_DEBUG << "Applying transactions from block #" << b.getDepth();
 
     applyBlockTransactions(b);
+    auto state_root = _state_manager.updateStateRoot();
+    if (b.getDepth() % base::config::BC_SNAPSHOT_PERIOD == 0) {
+        makeSnapshot(b, state_root);
+    }
     return Blockchain::AdditionResult::ADDED;
 }
 
 
+std::optional<SnapshotManifest> Core::getSnapshotManifest() const
+{
+    std::shared_lock lk(_snapshot_mutex);
+    if (_snapshot) {
+        return _snapshot->getManifest();
+    }
+    return std::nullopt;
+}
+
+
+std::optional<base::Bytes> Core::findSnapshotChunk(const base::Sha256& chunk_hash) const
+{
+    std::shared_lock lk(_snapshot_mutex);
+    if (_snapshot) {
+        return _snapshot->findChunk(chunk_hash);
+    }
+    return std::nullopt;
+}
+
+
+bool Core::tryAddBlocksWithSnapshot(const SnapshotManifest& manifest,
+                                    const base::Bytes& state,
+                                    const std::vector<ImmutableBlock>& blocks)
+{
+    std::vector<ImmutableBlock> added_blocks;
+    bool is_state_imported = false;
+    {
+        std::lock_guard lk{ _blockchain_mutex };
+
+        auto is_snapshot_usable = [&] {
+            if (_blockchain.getTopBlock().getDepth() != 0 || manifest.depth == 0 || manifest.depth >= blocks.size()) {
+                return false;
+            }
+            for (std::size_t i = 0; i <= manifest.depth; ++i) {
+                if (blocks[i].getDepth() != i + 1) {
+                    return false;
+                }
+            }
+            const auto& snapshot_block = blocks[manifest.depth - 1];
+            const auto& next_block = blocks[manifest.depth];
+            return snapshot_block.getHash() == manifest.block_hash && next_block.getStateRoot() == manifest.state_root;
+        }();
+
+        std::size_t next_block = 0;
+        if (is_snapshot_usable) {
+            // blocks are still checked by the blockchain, only their transactions are not executed
+            while (next_block < manifest.depth &&
+                   _blockchain.tryAddBlock(blocks[next_block]) == Blockchain::AdditionResult::ADDED) {
+                added_blocks.push_back(blocks[next_block++]);
+            }
+
+            if (next_block == manifest.depth && _state_manager.importState(state, manifest.state_root)) {
+                LOG_INFO << "State at depth " << manifest.depth << " is imported from snapshot";
+                is_state_imported = true;
+                setSnapshot(manifest.depth, manifest.block_hash, manifest.state_root, state);
+            }
+            else {
+                LOG_WARNING << "Snapshot at depth " << manifest.depth << " is rejected, executing blocks";
+                for (const auto& block : added_blocks) {
+                    applyBlockTransactions(block);
+                    _state_manager.updateStateRoot();
+                }
+            }
+
+            std::shared_lock pending_lk(_pending_transactions_mutex);
+            for (const auto& block : added_blocks) {
+                _pending_transactions.remove(block.getTransactions());
+            }
+        }
+
+        for (; next_block < blocks.size(); ++next_block) {
+            if (_tryAddBlock(blocks[next_block]) != Blockchain::AdditionResult::ADDED) {
+                break;
+            }
+            added_blocks.push_back(blocks[next_block]);
+        }
+    }
+
+    for (const auto& block : added_blocks) {
+        _event_block_added.notify(block);
+    }
+    return is_state_imported;
+}
+
+
+void Core::makeSnapshot(const ImmutableBlock& block, const base::Sha256& state_root)
+{
+    setSnapshot(block.getDepth(), block.getHash(), state_root, _state_manager.exportState());
+}
+
+
+void Core::setSnapshot(BlockDepth depth,
+                       const base::Sha256& block_hash,
+                       const base::Sha256& state_root,
+                       const base::Bytes& state)
+{
+    Snapshot snapshot{ depth, block_hash, state_root, state };
+    LOG_DEBUG << "Made snapshot of the state at depth " << depth << " with "
+              << snapshot.getManifest().chunk_hashes.size() << " chunks";
+
+    // the blocks up to the checkpoint are not executed again on restart, so their logs are written before it
+    base::Database::Batch batch;
+    _logs_index.flush(batch);
+    _database.write(std::move(batch));
+    // written before any block below it is pruned
+    writeCheckpoint(_database, _state_manager, Checkpoint{ depth, block_hash, state_root, state });
+    _blockchain.setPrunableDepth(depth);
+
+    std::unique_lock lk(_snapshot_mutex);
+    _snapshot = std::move(snapshot);
+}
+
+
+BlockDepth Core::restoreCheckpoint()
+{
+    auto checkpoint = lk::restoreCheckpoint(_database, _blockchain, _state_manager);
+    if (!checkpoint) {
+        return 0;
+    }
+    LOG_INFO << "State at depth " << checkpoint->depth << " is restored from the checkpoint";
+    _blockchain.setPrunableDepth(checkpoint->depth);
+    std::unique_lock lk(_snapshot_mutex);
+    _snapshot.emplace(checkpoint->depth,
+                      std::move(checkpoint->block_hash),
+                      std::move(checkpoint->state_root),
+                      checkpoint->state);
+    return checkpoint->depth;
+}
+
+
 std::optional<ImmutableBlock> Core::findBlock(const base::Sha256& hash) const
 {
     return _blockchain.findBlock(hash);
@@ -277,6 +504,7 @@ std::pair<MutableBlock, lk::Complexity> Core::getMiningData() const
     b.setDepth(depth);
     b.setNonce(0);
     b.setPrevBlockHash(std::move(prev_hash));
+    b.setStateRoot(_state_manager.getStateRoot());
     b.setTimestamp(base::Time::now());
     b.setCoinbase(getThisNodeAddress());
     b.setTransactionsSet(std::move(pending));
@@ -285,12 +513,19 @@ std::pair<MutableBlock, lk::Complexity> Core::getMiningData() const
 }
 
 
-lk::AccountInfo Core::getAccountInfo(const lk::Address& address) const
+lk::AccountInfo Core::getAccountInfo(const lk::Address& address,
+                                     std::optional<std::uint64_t> transactions_offset,
+                                     std::size_t transactions_limit) const
 {
-    if (_state_manager.hasAccount(address)) {
-        return _state_manager.getAccountInfo(address);
+    if (!_state_manager.hasAccount(address)) {
+        return AccountInfo{ AccountType::CLIENT, address, {}, {}, {}, {} };
     }
-    return AccountInfo{ AccountType::CLIENT, address, {}, {}, {} };
+    auto info = _state_manager.getAccountInfo(address);
+    const auto limit = std::min(transactions_limit, base::config::RPC_ACCOUNT_TRANSACTIONS_MAX_PAGE_SIZE);
+    const auto offset =
+      transactions_offset.value_or(info.transactions_count > limit ? info.transactions_count - limit : 0);
+    info.transactions_hashes = _state_manager.getTransactionsHashes(address, offset, limit);
+    return info;
 }
 
 
@@ -306,6 +541,18 @@ base::Sha256 Core::getTopBlockHash() const
 }
 
 
+DatabaseStatistics Core::getDatabaseStatistics() const
+{
+    const auto memory_usage = _database.getProperty("leveldb.approximate-memory-usage");
+    return { _database.getProperty("leveldb.stats").value_or(""),
+             memory_usage ? std::stoull(*memory_usage) : 0,
+             _database.getApproximateSize(makeDatabaseKey(DataType::BLOCK, base::Bytes{})),
+             _database.getApproximateSize(makeDatabaseKey(DataType::TRANSACTION_BLOCK_DEPTH, base::Bytes{})),
+             _database.getApproximateSize(makeDatabaseKey(DataType::STATE_TRIE_NODE, base::Bytes{})),
+             _blockchain.getBlocksCacheStatistics() };
+}
+
+
 const lk::Address& Core::getThisNodeAddress() const noexcept
 {
     return _this_node_address;
@@ -316,97 +563,123 @@ void Core::applyBlockTransactions(const ImmutableBlock& block)
 {
     static constexpr lk::Balance EMISSION_VALUE{ base::config::BC_EMISSION_VALUE };
     _state_manager.applyBlockEmission(block.getCoinbase(), EMISSION_VALUE);
-    for (const auto& tx : block.getTransactions()) {
-        tryPerformTransaction(tx, block);
-    }
+
+    const auto& transactions = block.getTransactions();
+    std::vector<std::optional<TransactionStatus>> statuses(transactions.size());
+    std::vector<LogRecord> logs;
+    std::vector<ExecutionTrace> traces(_is_tracing_enabled ? transactions.size() : 0);
+    _executor.execute(
+      _state_manager,
+      transactions.size(),
+      [&](std::size_t i, Commit& commit) {
+          if (_is_tracing_enabled) {
+              // a transaction is executed again, if it conflicts with others, then only the last trace is kept
+              traces[i] = ExecutionTrace{};
+              statuses[i] = executeTracedTransaction(commit, transactions.begin()[i], block, traces[i]);
+          }
+          else {
+              statuses[i] = executeTransaction(commit, transactions.begin()[i], block);
+          }
+      },
+      [&](std::size_t i) {
+          auto tx_hash = transactions.begin()[i].hashOfTransaction();
+          for (const auto& log : statuses[i]->getLogs()) {
+              logs.push_back({ block.getDepth(), tx_hash, static_cast<std::uint32_t>(logs.size()), log });
+          }
+          if (_is_tracing_enabled) {
+              addTransactionTrace(tx_hash, std::move(traces[i]));
+          }
+          addTransactionOutput(tx_hash, *statuses[i]);
+      });
+    _logs_index.addBlockLogs(block.getDepth(), std::move(logs));
 }
 
 
-void Core::tryPerformTransaction(const lk::Transaction& tx, const ImmutableBlock& block_where_tx)
+TransactionStatus Core::executeTransaction(Commit& commit,
+                                           const lk::Transaction& tx,
+                                           const ImmutableBlock& block_where_tx,
+                                           ExecutionTrace* trace)
 {
     auto transaction_hash = tx.hashOfTransaction();
     LOG_DEBUG << "Performing transactions with hash " << transaction_hash;
-    _state_manager.addTxHash(tx.getFrom(), transaction_hash);
-    auto commit = _state_manager.createCommit();
+    commit.addTxHash(tx.getFrom(), transaction_hash);
 
     if (tx.getTo() == lk::Address::null()) {
+        // changes made by the contract are dropped on failure, while the nonce and the fee are kept
+        auto execution = commit.createCommit();
         try {
             auto contract_data_hash = base::Sha256::compute(tx.getData());
-            lk::Address contract_address = commit.createContractAccount(tx.getFrom(), contract_data_hash);
+            lk::Address contract_address = execution.createContractAccount(tx.getFrom(), contract_data_hash);
 
-            if (!commit.tryTransferMoney(tx.getFrom(), contract_address, tx.getAmount())) {
-                TransactionStatus status(TransactionStatus::StatusCode::NotEnoughBalance,
+            if (!execution.tryTransferMoney(tx.getFrom(), contract_address, tx.getAmount())) {
+                return TransactionStatus(TransactionStatus::StatusCode::NotEnoughBalance,
                                          TransactionStatus::ActionType::ContractCreation,
                                          tx.getFee(),
                                          {});
-                return addTransactionOutput(transaction_hash, status);
             }
 
-            auto eval_result = callInitContractVm(commit, block_where_tx, tx, contract_address, tx.getData());
+            auto eval_result =
+              callInitContractVm(execution, block_where_tx, tx, contract_address, tx.getData(), trace);
 
             if (eval_result.status_code == evmc_status_code::EVMC_SUCCESS) {
-                auto runtime_code = vm::copy(eval_result.output_data, eval_result.output_size);
-                commit.setRuntimeCode(contract_address, runtime_code);
+                execution.setRuntimeCode(contract_address, vm::copy(eval_result.output_data, eval_result.output_size));
                 LOG_DEBUG << "Deployed contract to address "
                           << base::base58Encode(contract_address.getBytes().toBytes());
 
-                _state_manager.applyCommit(std::move(commit));
-                _state_manager.payFee(tx.getFrom(), block_where_tx.getCoinbase(), tx.getFee() - eval_result.gas_left);
+                auto logs = execution.takeLogs();
+                commit.applyCommit(std::move(execution));
+                commit.payFee(tx.getFrom(), block_where_tx.getCoinbase(), tx.getFee() - eval_result.gas_left);
 
                 TransactionStatus status(TransactionStatus::StatusCode::Success,
                                          TransactionStatus::ActionType::ContractCreation,
                                          eval_result.gas_left,
                                          base::base58Encode(contract_address.getBytes()));
-                return addTransactionOutput(transaction_hash, status);
+                status.getLogs() = std::move(logs);
+                return status;
             }
             else if (eval_result.status_code == evmc_status_code::EVMC_REVERT) {
-                _state_manager.payFee(tx.getFrom(), block_where_tx.getCoinbase(), tx.getFee() - eval_result.gas_left);
+                commit.payFee(tx.getFrom(), block_where_tx.getCoinbase(), tx.getFee() - eval_result.gas_left);
 
-                TransactionStatus status(TransactionStatus::StatusCode::Revert,
+                return TransactionStatus(TransactionStatus::StatusCode::Revert,
                                          TransactionStatus::ActionType::ContractCreation,
                                          eval_result.gas_left,
                                          {});
-                return addTransactionOutput(transaction_hash, status);
             }
             else {
-                _state_manager.payFee(tx.getFrom(), block_where_tx.getCoinbase(), tx.getFee() - eval_result.gas_left);
+                commit.payFee(tx.getFrom(), block_where_tx.getCoinbase(), tx.getFee() - eval_result.gas_left);
 
-                TransactionStatus status(TransactionStatus::StatusCode::BadQueryForm,
+                return TransactionStatus(TransactionStatus::StatusCode::BadQueryForm,
                                          TransactionStatus::ActionType::ContractCreation,
                                          eval_result.gas_left,
                                          {});
-                return addTransactionOutput(transaction_hash, status);
             }
-            ASSERT(false);
         }
         catch (const base::Error&) {
-            TransactionStatus status(
+            return TransactionStatus(
               TransactionStatus::StatusCode::Failed, TransactionStatus::ActionType::ContractCreation, tx.getFee(), {});
-            return addTransactionOutput(transaction_hash, status);
         }
-        ASSERT(false);
     }
     else {
         if (commit.hasAccount(tx.getTo()) && commit.getAccountType(tx.getTo()) == AccountType::CONTRACT) {
+            auto execution = commit.createCommit();
             try {
                 if (tx.getData().isEmpty()) {
-                    TransactionStatus status(TransactionStatus::StatusCode::BadQueryForm,
+                    return TransactionStatus(TransactionStatus::StatusCode::BadQueryForm,
                                              TransactionStatus::ActionType::ContractCall,
                                              tx.getFee(),
                                              {});
-                    return addTransactionOutput(transaction_hash, status);
                 }
 
-                if (tx.getAmount() > 0 && !commit.tryTransferMoney(tx.getFrom(), tx.getTo(), tx.getAmount())) {
-                    TransactionStatus status(TransactionStatus::StatusCode::NotEnoughBalance,
+                if (tx.getAmount() > 0 && !execution.tryTransferMoney(tx.getFrom(), tx.getTo(), tx.getAmount())) {
+                    return TransactionStatus(TransactionStatus::StatusCode::NotEnoughBalance,
                                              TransactionStatus::ActionType::ContractCall,
                                              tx.getFee(),
                                              {});
-                    return addTransactionOutput(transaction_hash, status);
                 }
 
-                auto code = commit.getRuntimeCode(tx.getTo());
-                auto eval_result = callContractVm(commit, block_where_tx, tx, code, tx.getData());
+                auto code = execution.getRuntimeCode(tx.getTo());
+                auto eval_result =
+                  callContractVm(execution, block_where_tx, tx, code->getBytes(), tx.getData(), trace);
 
                 if (eval_result.status_code == evmc_status_code::EVMC_SUCCESS) {
                     auto output_data = vm::copy(eval_result.output_data, eval_result.output_size);
@@ -414,71 +687,261 @@ void Core::tryPerformTransaction(const lk::Transaction& tx, const ImmutableBlock
                         output_data = tx.getData().takePart(0, 4).append(output_data);
                     }
 
-                    _state_manager.payFee(
-                      tx.getFrom(), block_where_tx.getCoinbase(), tx.getFee() - eval_result.gas_left);
-                    _state_manager.applyCommit(std::move(commit));
+                    auto logs = execution.takeLogs();
+                    commit.applyCommit(std::move(execution));
+                    commit.payFee(tx.getFrom(), block_where_tx.getCoinbase(), tx.getFee() - eval_result.gas_left);
 
                     TransactionStatus status(TransactionStatus::StatusCode::Success,
                                              TransactionStatus::ActionType::ContractCall,
                                              eval_result.gas_left,
                                              base::base64Encode(output_data));
-                    return addTransactionOutput(transaction_hash, status);
+                    status.getLogs() = std::move(logs);
+                    return status;
                 }
                 else if (eval_result.status_code == evmc_status_code::EVMC_REVERT) {
-                    _state_manager.payFee(
-                      tx.getFrom(), block_where_tx.getCoinbase(), tx.getFee() - eval_result.gas_left);
+                    commit.payFee(tx.getFrom(), block_where_tx.getCoinbase(), tx.getFee() - eval_result.gas_left);
 
-                    TransactionStatus status(TransactionStatus::StatusCode::Revert,
+                    return TransactionStatus(TransactionStatus::StatusCode::Revert,
                                              TransactionStatus::ActionType::ContractCall,
                                              eval_result.gas_left,
                                              {});
-                    return addTransactionOutput(transaction_hash, status);
                 }
                 else {
-                    _state_manager.payFee(
-                      tx.getFrom(), block_where_tx.getCoinbase(), tx.getFee() - eval_result.gas_left);
+                    commit.payFee(tx.getFrom(), block_where_tx.getCoinbase(), tx.getFee() - eval_result.gas_left);
 
-                    TransactionStatus status(TransactionStatus::StatusCode::BadQueryForm,
+                    return TransactionStatus(TransactionStatus::StatusCode::BadQueryForm,
                                              TransactionStatus::ActionType::ContractCall,
                                              eval_result.gas_left,
                                              {});
-                    return addTransactionOutput(transaction_hash, status);
                 }
             }
             catch (const base::Error&) {
-                TransactionStatus status(
+                return TransactionStatus(
                   TransactionStatus::StatusCode::Failed, TransactionStatus::ActionType::ContractCall, tx.getFee(), {});
-                addTransactionOutput(transaction_hash, status);
-                return;
             }
         }
         else {
             try {
-                _state_manager.payFee(tx.getFrom(), block_where_tx.getCoinbase(), tx.getFee());
+                commit.payFee(tx.getFrom(), block_where_tx.getCoinbase(), tx.getFee());
                 if (!commit.tryTransferMoney(tx.getFrom(), tx.getTo(), tx.getAmount())) {
-                    TransactionStatus status(TransactionStatus::StatusCode::NotEnoughBalance,
+                    return TransactionStatus(TransactionStatus::StatusCode::NotEnoughBalance,
                                              TransactionStatus::ActionType::Transfer,
                                              tx.getFee(),
                                              {});
-                    return addTransactionOutput(transaction_hash, status);
                 }
-                _state_manager.applyCommit(std::move(commit));
 
-                TransactionStatus status(
+                return TransactionStatus(
                   TransactionStatus::StatusCode::Success, TransactionStatus::ActionType::Transfer, 0, {});
-
-                return addTransactionOutput(transaction_hash, status);
             }
             catch (const base::Error& er) {
-                TransactionStatus status(
+                return TransactionStatus(
                   TransactionStatus::StatusCode::Failed, TransactionStatus::ActionType::Transfer, tx.getFee(), {});
+            }
+        }
+    }
+}
 
-                return addTransactionOutput(transaction_hash, status);
+
+TransactionStatus Core::executeTracedTransaction(Commit& commit,
+                                                 const lk::Transaction& tx,
+                                                 const ImmutableBlock& block_where_tx,
+                                                 ExecutionTrace& trace)
+{
+    const auto start = std::chrono::steady_clock::now();
+    auto status = executeTransaction(commit, tx, block_where_tx, &trace);
+    trace.setTime(std::chrono::steady_clock::now() - start);
+    return status;
+}
+
+
+ImmutableBlock Core::makeNextBlock(const ImmutableBlock& top_block) const
+{
+    BlockBuilder b;
+    b.setDepth(top_block.getDepth() + 1);
+    b.setNonce(0);
+    b.setPrevBlockHash(base::Sha256::compute(base::toBytes(top_block)));
+    b.setStateRoot(base::Sha256::null());
+    b.setTimestamp(base::Time::now());
+    b.setCoinbase(getThisNodeAddress());
+    b.setTransactionsSet(TransactionsSet{});
+    return std::move(b).buildImmutable();
+}
+
+
+TransactionStatus Core::callContract(const lk::Transaction& tx)
+{
+    std::shared_lock lk{ _blockchain_mutex };
+    auto top_block = _blockchain.getTopBlock();
+    auto view = _state_manager.createView();
+    lk.unlock();
+
+    auto commit = view.createCommit();
+    try {
+        if (tx.getData().isEmpty() || !commit.hasAccount(tx.getTo()) ||
+            commit.getAccountType(tx.getTo()) != AccountType::CONTRACT) {
+            return TransactionStatus(TransactionStatus::StatusCode::BadQueryForm,
+                                     TransactionStatus::ActionType::ContractCall,
+                                     tx.getFee(),
+                                     {});
+        }
+
+        if (tx.getAmount() > 0 && !commit.tryTransferMoney(tx.getFrom(), tx.getTo(), tx.getAmount())) {
+            return TransactionStatus(TransactionStatus::StatusCode::NotEnoughBalance,
+                                     TransactionStatus::ActionType::ContractCall,
+                                     tx.getFee(),
+                                     {});
+        }
+
+        auto code = commit.getRuntimeCode(tx.getTo());
+        auto eval_result = callContractVm(commit, top_block, tx, code->getBytes(), tx.getData(), nullptr);
+        switch (eval_result.status_code) {
+            case evmc_status_code::EVMC_SUCCESS: {
+                auto output_data = vm::copy(eval_result.output_data, eval_result.output_size);
+                if (!output_data.isEmpty()) {
+                    output_data = tx.getData().takePart(0, 4).append(output_data);
+                }
+                TransactionStatus status(TransactionStatus::StatusCode::Success,
+                                         TransactionStatus::ActionType::ContractCall,
+                                         eval_result.gas_left,
+                                         base::base64Encode(output_data));
+                status.getLogs() = commit.takeLogs();
+                return status;
             }
+            case evmc_status_code::EVMC_REVERT:
+                return TransactionStatus(TransactionStatus::StatusCode::Revert,
+                                         TransactionStatus::ActionType::ContractCall,
+                                         eval_result.gas_left,
+                                         {});
+            default:
+                return TransactionStatus(TransactionStatus::StatusCode::BadQueryForm,
+                                         TransactionStatus::ActionType::ContractCall,
+                                         eval_result.gas_left,
+                                         {});
         }
-        ASSERT(false);
     }
-    ASSERT(false);
+    catch (const base::Error&) {
+        return TransactionStatus(
+          TransactionStatus::StatusCode::Failed, TransactionStatus::ActionType::ContractCall, tx.getFee(), {});
+    }
+}
+
+
+FeeEstimate Core::estimateFee(const lk::Transaction& tx)
+{
+    std::shared_lock lk{ _blockchain_mutex };
+    auto top_block = _blockchain.getTopBlock();
+    auto view = _state_manager.createView();
+    TransactionsSet pending;
+    {
+        // pending transactions are removed, when a block is added under the unique lock
+        std::shared_lock pending_lk(_pending_transactions_mutex);
+        pending = _pending_transactions;
+    }
+    lk.unlock();
+
+    auto block = makeNextBlock(top_block);
+
+    auto pending_commit = view.createCommit();
+    for (const auto& pending_tx : pending) {
+        executeTransaction(pending_commit, pending_tx, block);
+    }
+
+    // the pending commit isn't changed anymore, so the runs read it concurrently
+    auto dry_run = [&](lk::Fee fee) {
+        lk::Transaction tx_with_fee{ tx.getFrom(), tx.getTo(), tx.getAmount(), fee, tx.getTimestamp(), tx.getData() };
+        auto commit = pending_commit.createCommit();
+        return executeTransaction(commit, tx_with_fee, block);
+    };
+
+    const lk::Fee gas_limit = tx.getFee() > 0 ? tx.getFee() : base::config::RPC_CONTRACT_CALL_GAS_LIMIT;
+    auto status = dry_run(gas_limit);
+    if (!status) {
+        return { gas_limit, std::move(status) };
+    }
+
+    // less than the used gas is never enough, while the fee of a transfer is not spent on its execution
+    lk::Fee used_gas = 0;
+    if (status.getType() == TransactionStatus::ActionType::ContractCall ||
+        status.getType() == TransactionStatus::ActionType::ContractCreation) {
+        used_gas = gas_limit - status.getFeeLeft();
+    }
+    // usually a little more is enough, then the search is much shorter
+    auto high = gas_limit;
+    if (auto expected_fee = used_gas + used_gas / 63 + 1; used_gas > 0 && expected_fee < gas_limit) {
+        if (auto expected_status = dry_run(expected_fee); expected_status) {
+            high = expected_fee;
+            status = std::move(expected_status);
+        }
+    }
+    auto fee = _fee_estimator.findLeastFee(
+      used_gas, high, [&dry_run](lk::Fee fee) { return static_cast<bool>(dry_run(fee)); });
+    if (fee == high) {
+        return { fee, std::move(status) };
+    }
+    return { fee, dry_run(fee) };
+}
+
+
+TransactionTrace Core::traceTransaction(const lk::Transaction& tx)
+{
+    std::shared_lock lk{ _blockchain_mutex };
+    auto top_block = _blockchain.getTopBlock();
+    auto view = _state_manager.createView();
+    lk.unlock();
+
+    const lk::Fee gas_limit = tx.getFee() > 0 ? tx.getFee() : base::config::RPC_CONTRACT_CALL_GAS_LIMIT;
+    lk::Transaction tx_with_fee{ tx.getFrom(), tx.getTo(), tx.getAmount(), gas_limit, tx.getTimestamp(), tx.getData() };
+    auto commit = view.createCommit();
+    ExecutionTrace trace;
+    auto status = executeTracedTransaction(commit, tx_with_fee, makeNextBlock(top_block), trace);
+    return { std::move(status), std::move(trace) };
+}
+
+
+ExecutionProfile Core::profileBlocks(BlockDepth from_depth, BlockDepth to_depth)
+{
+    static constexpr lk::Balance EMISSION_VALUE{ base::config::BC_EMISSION_VALUE };
+    // the states of past blocks are not kept, so the blocks are executed again from the genesis
+    StateManager state_manager;
+    state_manager.updateFromGenesis(getGenesisBlock());
+    ExecutionProfile profile;
+    to_depth = std::min(to_depth, getTopBlock().getDepth());
+    for (BlockDepth depth = 1; depth <= to_depth; ++depth) {
+        auto block_hash = findBlockHash(depth);
+        auto block = block_hash ? findBlock(*block_hash) : std::nullopt;
+        if (!block) {
+            RAISE_ERROR(base::LogicError, "body of a stored block is pruned, the blocks cannot be replayed");
+        }
+        if (block->getStateRoot() != state_manager.updateStateRoot()) {
+            RAISE_ERROR(base::LogicError, "state root of a stored block doesn't match the replayed state");
+        }
+
+        state_manager.applyBlockEmission(block->getCoinbase(), EMISSION_VALUE);
+        for (const auto& tx : block->getTransactions()) {
+            auto commit = state_manager.createCommit();
+            if (depth >= from_depth) {
+                ExecutionTrace trace;
+                executeTracedTransaction(commit, tx, *block, trace);
+                profile.add(trace);
+            }
+            else {
+                executeTransaction(commit, tx, *block);
+            }
+            state_manager.applyCommit(std::move(commit));
+        }
+    }
+    return profile;
+}
+
+
+std::vector<LogRecord> Core::getLogs(BlockDepth from_depth,
+                                     BlockDepth to_depth,
+                                     const LogsFilter& filter,
+                                     std::size_t limit) const
+{
+    // the logs of a block are moved from memory to the database under the lock
+    std::shared_lock lk{ _blockchain_mutex };
+    return _logs_index.find(from_depth, to_depth, filter, limit);
 }
 
 
@@ -492,7 +955,8 @@ evmc::result Core::callInitContractVm(Commit& current_commit,
                                       const ImmutableBlock& associated_block,
                                       const Transaction& tx,
                                       const Address& contract_address,
-                                      const base::Bytes& code)
+                                      const base::Bytes& code,
+                                      ExecutionTrace* trace)
 {
     evmc_message message{};
     message.kind = evmc_call_kind::EVMC_CALL;
@@ -503,7 +967,8 @@ evmc::result Core::callInitContractVm(Commit& current_commit,
     message.destination = vm::toEthAddress(contract_address);
     message.value = vm::toEvmcUint256(tx.getAmount());
     message.create2_salt = evmc_bytes32();
-    return callVm(current_commit, associated_block, tx, message, code);
+    AccessCache accesses{ current_commit };
+    return callVm(accesses, associated_block, tx, message, code, trace);
 }
 
 
@@ -511,7 +976,8 @@ evmc::result Core::callContractVm(Commit& current_commit,
                                   const ImmutableBlock& associated_block,
                                   const Transaction& tx,
                                   const base::Bytes& code,
-                                  const base::Bytes& message_data)
+                                  const base::Bytes& message_data,
+                                  ExecutionTrace* trace)
 {
     evmc_message message{};
     message.kind = evmc_call_kind::EVMC_CALL;
@@ -523,18 +989,30 @@ evmc::result Core::callContractVm(Commit& current_commit,
     message.value = vm::toEvmcUint256(tx.getAmount());
     message.input_data = message_data.getData();
     message.input_size = message_data.size();
-    return callVm(current_commit, associated_block, tx, message, code);
+    AccessCache accesses{ current_commit };
+    return callVm(accesses, associated_block, tx, message, code, trace);
 }
 
 
-evmc::result Core::callVm(Commit& current_commit,
+evmc::result Core::callVm(AccessCache& accesses,
                           const ImmutableBlock& associated_block,
                           const lk::Transaction& associated_tx,
                           const evmc_message& message,
-                          const base::Bytes& code)
+                          const base::Bytes& code,
+                          ExecutionTrace* trace)
 {
-    EthHost _eth_host{ *this, current_commit, associated_block, associated_tx };
-    return _vm.execute(_eth_host, evmc_revision::EVMC_ISTANBUL, message, code.getData(), code.size());
+    EthHost _eth_host{ *this, accesses, associated_block, associated_tx, trace };
+    if (!trace) {
+        return _vm.execute(_eth_host, evmc_revision::EVMC_ISTANBUL, message, code.getData(), code.size());
+    }
+    const auto start = std::chrono::steady_clock::now();
+    auto result = _vm.execute(_eth_host, evmc_revision::EVMC_ISTANBUL, message, code.getData(), code.size());
+    trace->addFrame({ vm::toNativeAddress(message.destination),
+                      static_cast<std::uint32_t>(message.depth),
+                      static_cast<lk::Fee>(message.gas - result.gas_left),
+                      std::chrono::steady_clock::now() - start,
+                      result.status_code == evmc_status_code::EVMC_SUCCESS });
+    return result;
 }
 
 
@@ -570,23 +1048,25 @@ void Core::subscribeToAnyAccountUpdate(decltype(Core::_event_account_update)::Ca
 
 
 EthHost::EthHost(lk::Core& core,
-                 lk::Commit& current_commit,
+                 lk::AccessCache& accesses,
                  const ImmutableBlock& associated_block,
-                 const lk::Transaction& associated_tx)
+                 const lk::Transaction& associated_tx,
+                 ExecutionTrace* trace)
   : _core{ core }
-  , _current_commit{ current_commit }
+  , _accesses{ accesses }
+  , _current_commit{ accesses.getCommit() }
   , _associated_block{ associated_block }
   , _associated_tx{ associated_tx }
+  , _trace{ trace }
 {}
 
 
 bool EthHost::account_exists(const evmc::address& addr) const noexcept
 {
     LOG_DEBUG << "Core::account_exists";
+    HostCallScope scope{ _trace, ExecutionTrace::HostCall::ACCOUNT_EXISTS };
     try {
-        auto address = vm::toNativeAddress(addr);
-        LOG_DEBUG << "Core::account_exists by address " << base::base58Encode(address.getBytes().toBytes());
-        return _current_commit.hasAccount(address);
+        return _accesses.hasAccount(vm::toNativeAddress(addr));
     }
     catch (...) { // cannot pass exceptions since noexcept
         return false;
@@ -596,15 +1076,11 @@ bool EthHost::account_exists(const evmc::address& addr) const noexcept
 
 evmc::bytes32 EthHost::get_storage(const evmc::address& addr, const evmc::bytes32& ethKey) const noexcept
 {
-
-    LOG_DEBUG << "Core::get_storage";
+    HostCallScope scope{ _trace, ExecutionTrace::HostCall::GET_STORAGE };
     try {
-        auto address = vm::toNativeAddress(addr);
-        LOG_DEBUG << "Core::get_storage from address " << base::base58Encode(address.getBytes().toBytes());
-        base::Bytes key(ethKey.bytes, 32);
-        if (_current_commit.hasAccount(address)) {
-            auto storage_value = _current_commit.getStorageValue(address, base::Sha256(key)).data;
-            return vm::toEvmcBytes32(storage_value);
+        auto& storage = _accesses.getStorage(vm::toNativeAddress(addr));
+        if (auto value = storage.find(lk::StorageKey(ethKey.bytes, sizeof(ethKey.bytes))); value) {
+            return vm::toEvmcBytes32(*value);
         }
         return {};
     }
@@ -618,37 +1094,23 @@ evmc_storage_status EthHost::set_storage(const evmc::address& addr,
                                          const evmc::bytes32& ekey,
                                          const evmc::bytes32& evalue) noexcept
 {
-    LOG_DEBUG << "Core::set_storage";
+    HostCallScope scope{ _trace, ExecutionTrace::HostCall::SET_STORAGE };
     try {
-        static const base::Bytes NULL_VALUE(32);
-        auto address = vm::toNativeAddress(addr);
-        LOG_DEBUG << "Core::set_storage to address " << base::base58Encode(address.getBytes().toBytes());
-        auto key = base::Sha256(base::Bytes(ekey.bytes, 32));
-        base::Bytes new_value(evalue.bytes, 32);
-
-        if (!_current_commit.checkStorageValue(address, key)) {
-            if (new_value == NULL_VALUE) {
-                return evmc_storage_status::EVMC_STORAGE_UNCHANGED;
-            }
-            else {
-                _current_commit.setStorageValue(address, key, new_value);
-                return evmc_storage_status::EVMC_STORAGE_ADDED;
-            }
+        lk::StorageValue new_value(evalue.bytes, sizeof(evalue.bytes));
+        auto& storage = _accesses.getStorage(vm::toNativeAddress(addr));
+        auto old_value = storage.set(lk::StorageKey(ekey.bytes, sizeof(ekey.bytes)), new_value);
+        if (!old_value) {
+            return new_value == lk::StorageValue{} ? evmc_storage_status::EVMC_STORAGE_UNCHANGED
+                                                   : evmc_storage_status::EVMC_STORAGE_ADDED;
+        }
+        else if (*old_value == new_value) {
+            return evmc_storage_status::EVMC_STORAGE_UNCHANGED;
+        }
+        else if (new_value == lk::StorageValue{}) {
+            return evmc_storage_status::EVMC_STORAGE_DELETED;
         }
         else {
-            auto old_storage_data = _current_commit.getStorageValue(address, key);
-            const auto& old_value = old_storage_data.data;
-
-            _current_commit.setStorageValue(address, key, new_value);
-            if (old_value == new_value) {
-                return evmc_storage_status::EVMC_STORAGE_UNCHANGED;
-            }
-            else if (new_value == NULL_VALUE) {
-                return evmc_storage_status::EVMC_STORAGE_DELETED;
-            }
-            else {
-                return evmc_storage_status::EVMC_STORAGE_MODIFIED;
-            }
+            return evmc_storage_status::EVMC_STORAGE_MODIFIED;
         }
     }
     catch (...) { // cannot pass exceptions since noexcept
@@ -660,10 +1122,10 @@ evmc_storage_status EthHost::set_storage(const evmc::address& addr,
 evmc::uint256be EthHost::get_balance(const evmc::address& addr) const noexcept
 {
     LOG_DEBUG << "Core::get_balance";
+    HostCallScope scope{ _trace, ExecutionTrace::HostCall::GET_BALANCE };
     try {
         auto address = vm::toNativeAddress(addr);
-        LOG_DEBUG << "Core::get_balance to address " << base::base58Encode(address.getBytes().toBytes());
-        if (_current_commit.hasAccount(address)) {
+        if (_accesses.hasAccount(address)) {
             auto balance = _current_commit.getBalance(address);
             return vm::toEvmcUint256(balance);
         }
@@ -678,11 +1140,10 @@ evmc::uint256be EthHost::get_balance(const evmc::address& addr) const noexcept
 size_t EthHost::get_code_size(const evmc::address& addr) const noexcept
 {
     LOG_DEBUG << "Core::get_code_size";
+    HostCallScope scope{ _trace, ExecutionTrace::HostCall::GET_CODE_SIZE };
     try {
         auto address = vm::toNativeAddress(addr);
-        LOG_DEBUG << "Core::get_code_size to address " << base::base58Encode(address.getBytes().toBytes());
-
-        if (_current_commit.hasAccount(address)) {
+        if (_accesses.hasAccount(address)) {
             return _current_commit.getCodeSize(address);
         }
         return 0;
@@ -696,11 +1157,13 @@ size_t EthHost::get_code_size(const evmc::address& addr) const noexcept
 evmc::bytes32 EthHost::get_code_hash(const evmc::address& addr) const noexcept
 {
     LOG_DEBUG << "Core::get_code_hash";
+    HostCallScope scope{ _trace, ExecutionTrace::HostCall::GET_CODE_HASH };
     try {
         auto address = vm::toNativeAddress(addr);
-        LOG_DEBUG << "Core::get_code_hash to address " << base::base58Encode(address.getBytes().toBytes());
-        auto account_code_hash = _current_commit.getCodeHash(address);
-        return vm::toEvmcBytes32(account_code_hash.getBytes());
+        if (_accesses.hasAccount(address)) {
+            return vm::toEvmcBytes32(_current_commit.getCodeHash(address).getBytes());
+        }
+        return {};
     }
     catch (...) { // cannot pass exceptions since noexcept
         return {};
@@ -714,15 +1177,18 @@ size_t EthHost::copy_code(const evmc::address& addr,
                           size_t buffer_size) const noexcept
 {
     LOG_DEBUG << "Core::copy_code";
+    HostCallScope scope{ _trace, ExecutionTrace::HostCall::COPY_CODE };
     try {
         auto address = vm::toNativeAddress(addr);
-        LOG_DEBUG << "Core::copy_code to address " << base::base58Encode(address.getBytes().toBytes());
-        if (auto code = _current_commit.getRuntimeCode(address); code.isEmpty()) {
+        if (!_accesses.hasAccount(address)) {
+            return 0;
+        }
+        if (auto code = _current_commit.getRuntimeCode(address); code->isEmpty()) {
             return 0;
         }
         else {
-            std::size_t bytes_to_copy = std::min(buffer_size, code.size() - code_offset);
-            std::copy_n(code.getData() + code_offset, bytes_to_copy, buffer_data);
+            std::size_t bytes_to_copy = std::min(buffer_size, code->size() - code_offset);
+            std::copy_n(code->getBytes().getData() + code_offset, bytes_to_copy, buffer_data);
             return bytes_to_copy;
         }
     }
@@ -735,11 +1201,12 @@ size_t EthHost::copy_code(const evmc::address& addr,
 void EthHost::selfdestruct(const evmc::address& eaddr, const evmc::address& ebeneficiary) noexcept
 {
     LOG_DEBUG << "Core::selfdestruct";
+    HostCallScope scope{ _trace, ExecutionTrace::HostCall::SELFDESTRUCT };
     try {
         auto address = vm::toNativeAddress(eaddr);
-        LOG_DEBUG << "Core::selfdestruct to address " << base::base58Encode(address.getBytes().toBytes());
         auto beneficiary_address = vm::toNativeAddress(ebeneficiary);
         _current_commit.deleteAccount(address, beneficiary_address);
+        _accesses.forget(address);
     }
     catch (...) { // cannot pass exceptions since noexcept
         return;
@@ -750,19 +1217,29 @@ void EthHost::selfdestruct(const evmc::address& eaddr, const evmc::address& eben
 evmc::result EthHost::call(const evmc_message& msg) noexcept
 {
     LOG_DEBUG << "Core::call";
+    HostCallScope scope{ _trace, ExecutionTrace::HostCall::CALL };
+    if (msg.depth >= base::config::VM_MAX_CALL_DEPTH) {
+        return evmc::result{ evmc_status_code::EVMC_CALL_DEPTH_EXCEEDED, msg.gas, nullptr, 0 };
+    }
+
     try {
-        lk::Address to = vm::toNativeAddress(msg.destination);
-        LOG_DEBUG << "Core::call to address " << base::base58Encode(to.getBytes().toBytes());
-        if (_current_commit.hasAccount(to) && _current_commit.getAccountType(to) == lk::AccountType::CONTRACT) {
-            const auto& code = _current_commit.getRuntimeCode(to);
-            return _core.callVm(_current_commit, _associated_block, _associated_tx, msg, code);
+        // the call is a frame of its own: if it fails, only its changes are rewound
+        auto savepoint = _current_commit.createSavepoint();
+        evmc::result result{ evmc_status_code::EVMC_FAILURE, msg.gas, nullptr, 0 };
+        try {
+            result = _callFrame(msg);
+        }
+        catch (...) { // the call fails, and its changes are rewound as well
+        }
+
+        if (result.status_code == evmc_status_code::EVMC_SUCCESS) {
+            _current_commit.releaseSavepoint(savepoint);
         }
         else {
-            lk::Address from = vm::toNativeAddress(msg.sender);
-            _current_commit.tryTransferMoney(from, to, vm::toBalance(msg.value));
-            evmc::result result{ evmc_status_code::EVMC_SUCCESS, msg.gas, nullptr, 0 };
-            return result;
+            _current_commit.revertToSavepoint(savepoint);
+            _accesses.reset(); // the cached data may refer to the rewound changes
         }
+        return result;
     }
     catch (...) { // cannot pass exceptions since noexcept
         return evmc::result{ evmc_status_code::EVMC_FAILURE, msg.gas, nullptr, 0 };
@@ -773,6 +1250,7 @@ evmc::result EthHost::call(const evmc_message& msg) noexcept
 evmc_tx_context EthHost::get_tx_context() const noexcept
 {
     LOG_DEBUG << "Core::get_tx_context";
+    HostCallScope scope{ _trace, ExecutionTrace::HostCall::GET_TX_CONTEXT };
     try {
         evmc_tx_context ret;
         std::fill(std::begin(ret.tx_gas_price.bytes), std::end(ret.tx_gas_price.bytes), 0);
@@ -795,6 +1273,7 @@ evmc_tx_context EthHost::get_tx_context() const noexcept
 evmc::bytes32 EthHost::get_block_hash(int64_t block_number) const noexcept
 {
     LOG_DEBUG << "Core::get_block_hash";
+    HostCallScope scope{ _trace, ExecutionTrace::HostCall::GET_BLOCK_HASH };
     try {
         auto hash = _core.findBlockHash(block_number);
         if (hash) {
@@ -808,14 +1287,63 @@ evmc::bytes32 EthHost::get_block_hash(int64_t block_number) const noexcept
 }
 
 
-void EthHost::emit_log([[maybe_unused]] const evmc::address&,
-                       [[maybe_unused]] const uint8_t*,
-                       [[maybe_unused]] size_t,
-                       [[maybe_unused]] const evmc::bytes32[],
-                       [[maybe_unused]] size_t) noexcept
+void EthHost::emit_log(const evmc::address& addr,
+                       const uint8_t* data,
+                       size_t data_size,
+                       const evmc::bytes32 topics[],
+                       size_t num_topics) noexcept
 {
     LOG_DEBUG << "Core::emit_log";
-    LOG_WARNING << "emit_log is denied. For more information, see docs";
+    HostCallScope scope{ _trace, ExecutionTrace::HostCall::EMIT_LOG };
+    try {
+        Log log{ vm::toNativeAddress(addr), {}, vm::copy(data, data_size) };
+        log.topics.reserve(num_topics);
+        for (size_t i = 0; i < num_topics; ++i) {
+            log.topics.emplace_back(topics[i].bytes, sizeof(topics[i].bytes));
+        }
+        // the log belongs to the current frame, so it is dropped, if the frame is reverted
+        _current_commit.addLog(std::move(log));
+    }
+    catch (...) { // cannot pass exceptions since noexcept
+        return;
+    }
+}
+
+
+evmc::result EthHost::_callFrame(const evmc_message& msg)
+{
+    lk::Address to = vm::toNativeAddress(msg.destination);
+    if (const auto* precompile = PrecompilesRegistry::getNative().find(to)) {
+        // executed by the node itself, the failure of a precompile is an empty output, not a failed call
+        const auto value = vm::toBalance(msg.value);
+        if (value != 0) {
+            _current_commit.tryTransferMoney(vm::toNativeAddress(msg.sender), to, value);
+        }
+        const auto input = vm::copy(msg.input_data, msg.input_size);
+        const auto gas = precompile->gas(input);
+        if (gas > static_cast<lk::Fee>(msg.gas)) {
+            return evmc::result{ evmc_status_code::EVMC_OUT_OF_GAS, 0, nullptr, 0 };
+        }
+        const auto start = std::chrono::steady_clock::now();
+        const auto output = precompile->run(input);
+        if (_trace) {
+            _trace->addFrame(
+              { to, static_cast<std::uint32_t>(msg.depth), gas, std::chrono::steady_clock::now() - start, true });
+        }
+        return evmc::result{
+            evmc_status_code::EVMC_SUCCESS, msg.gas - static_cast<std::int64_t>(gas), output.getData(), output.size()
+        };
+    }
+    else if (_accesses.hasAccount(to) && _current_commit.getAccountType(to) == lk::AccountType::CONTRACT) {
+        // the code is held by the frame, since the call may delete the contract
+        auto code = _current_commit.getRuntimeCode(to);
+        return _core.callVm(_accesses, _associated_block, _associated_tx, msg, code->getBytes(), _trace);
+    }
+    else {
+        lk::Address from = vm::toNativeAddress(msg.sender);
+        _current_commit.tryTransferMoney(from, to, vm::toBalance(msg.value));
+        return evmc::result{ evmc_status_code::EVMC_SUCCESS, msg.gas, nullptr, 0 };
+    }
 }
 
 
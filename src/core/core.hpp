@@ -3,10 +3,18 @@
 #include "base/crypto.hpp"
 #include "base/property_tree.hpp"
 #include "base/utility.hpp"
+#include "core/access_cache.hpp"
 #include "core/block.hpp"
 #include "core/blockchain.hpp"
+#include "core/checkpoint.hpp"
+#include "core/fee_estimator.hpp"
 #include "core/host.hpp"
+#include "core/logs.hpp"
 #include "core/managers.hpp"
+#include "core/parallel_executor.hpp"
+#include "core/precompiles.hpp"
+#include "core/snapshot.hpp"
+#include "core/trace.hpp"
 
 #include "vm/vm.hpp"
 
@@ -17,6 +25,32 @@ namespace lk
 
 class EthHost;
 
+struct DatabaseStatistics
+{
+    std::string leveldb_stats;
+    std::uint64_t memory_usage; // of LevelDB memtables and caches
+    // approximate sizes on disk
+    std::uint64_t blocks_size;
+    std::uint64_t transactions_index_size;
+    std::uint64_t state_size;
+    PersistentBlockchain::CacheStatistics blocks_cache;
+};
+
+
+struct FeeEstimate
+{
+    lk::Fee fee; // the least enough one
+    TransactionStatus status; // of the transaction with this fee, or with the gas limit, if even it isn't enough
+};
+
+
+struct TransactionTrace
+{
+    TransactionStatus status;
+    ExecutionTrace trace;
+};
+
+
 class Core
 {
     friend EthHost;
@@ -40,9 +74,34 @@ class Core
      */
     void run();
     //==================
-    lk::AccountInfo getAccountInfo(const lk::Address& address) const;
+    // with a page of the transactions history: the latest transactions, if the offset is not set
+    lk::AccountInfo getAccountInfo(
+      const lk::Address& address,
+      std::optional<std::uint64_t> transactions_offset = std::nullopt,
+      std::size_t transactions_limit = base::config::RPC_ACCOUNT_TRANSACTIONS_PAGE_SIZE) const;
     //==================
     void addPendingTransaction(const lk::Transaction& tx);
+    // executes a call of a contract on the state after the top block and drops its changes, while blocks keep being
+    // added; the transaction isn't signed and its fee is the gas limit, which is not paid
+    TransactionStatus callContract(const lk::Transaction& tx);
+    // dry runs of the transaction on the state after the top block and the pending transactions; the fee of the
+    // transaction is the upper bound of the search, if it's set
+    FeeEstimate estimateFee(const lk::Transaction& tx);
+    // executes the transaction, which isn't signed, with tracing on the state after the top block and drops its
+    // changes; the fee of the transaction is the gas limit, if it's set
+    TransactionTrace traceTransaction(const lk::Transaction& tx);
+    // traces of transactions of blocks are kept, if "vm.trace_transactions" is set in the config
+    std::optional<ExecutionTrace> findTransactionTrace(const base::Sha256& tx_hash) const;
+    // replays the stored blocks up to to_depth from the genesis on a state in memory, and traces the transactions of
+    // the blocks starting from from_depth; the state of the node is not changed
+    ExecutionProfile profileBlocks(BlockDepth from_depth, BlockDepth to_depth);
+    //==================
+    // matching logs of blocks in [from_depth, to_depth]; blocks, which were not executed by this node (e.g. the ones
+    // below a snapshot, that the node was synchronized with), have no logs
+    std::vector<LogRecord> getLogs(BlockDepth from_depth,
+                                   BlockDepth to_depth,
+                                   const LogsFilter& filter,
+                                   std::size_t limit = base::config::RPC_LOGS_MAX_COUNT) const;
     //==================
     std::optional<TransactionStatus> getTransactionOutput(const base::Sha256& tx_hash);
     void addTransactionOutput(const base::Sha256& tx, const TransactionStatus& status);
@@ -58,6 +117,23 @@ class Core
     //==================
     std::pair<MutableBlock, lk::Complexity> getMiningData() const;
     //==================
+    // the latest state snapshot, which is made every base::config::BC_SNAPSHOT_PERIOD blocks
+    std::optional<SnapshotManifest> getSnapshotManifest() const;
+    std::optional<base::Bytes> findSnapshotChunk(const base::Sha256& chunk_hash) const;
+
+    /*
+     * Fast synchronization of a node, that has only the genesis block. Blocks are expected in the order of depths,
+     * starting from 1. Blocks up to the snapshot depth are added without execution of their transactions: the state
+     * is taken from the snapshot instead. The snapshot is used only if the block following it commits to the same
+     * state root, otherwise all blocks are executed as usual.
+     * @return true if the state was taken from the snapshot
+     */
+    bool tryAddBlocksWithSnapshot(const SnapshotManifest& manifest,
+                                  const base::Bytes& state,
+                                  const std::vector<ImmutableBlock>& blocks);
+    //==================
+    DatabaseStatistics getDatabaseStatistics() const;
+    //==================
     const lk::Address& getThisNodeAddress() const noexcept;
     //==================
   private:
@@ -72,30 +148,60 @@ class Core
     base::Observable<base::Sha256> _event_transaction_status_update;
     base::Observable<lk::Address> _event_account_update;
     //==================
+    base::Database _database;
     StateManager _state_manager;
 
     mutable std::shared_mutex _blockchain_mutex;
     PersistentBlockchain _blockchain;
+    LogsIndex _logs_index; // changed and flushed under the blockchain lock, as the state
 
     Blockchain::AdditionResult _tryAddBlock(const ImmutableBlock& b);
 
+    std::optional<Snapshot> _snapshot;
+    mutable std::shared_mutex _snapshot_mutex;
+    void makeSnapshot(const ImmutableBlock& block, const base::Sha256& state_root);
+    void setSnapshot(BlockDepth depth,
+                     const base::Sha256& block_hash,
+                     const base::Sha256& state_root,
+                     const base::Bytes& state);
+    // a snapshot is stored as a checkpoint, so on restart only blocks above it are executed;
+    // returns the depth of the restored state or 0
+    BlockDepth restoreCheckpoint();
+
     lk::Host _host;
     //==================
     evmc::VM _vm;
+    ParallelExecutor _executor;
+    FeeEstimator _fee_estimator;
     //==================
     lk::TransactionsSet _pending_transactions;
     mutable std::shared_mutex _pending_transactions_mutex;
     //================
     std::unordered_map<base::Sha256, TransactionStatus> _tx_outputs;
+    std::unordered_map<base::Sha256, ExecutionTrace> _tx_traces; // kept with the outputs under the same lock
     mutable std::shared_mutex _tx_outputs_mutex;
+    const bool _is_tracing_enabled;
+    void addTransactionTrace(const base::Sha256& tx, ExecutionTrace trace);
     //==================
     static const ImmutableBlock& getGenesisBlock();
+    static base::Database openDatabase(const base::PropertyTree& config);
     void applyBlockTransactions(const ImmutableBlock& block);
     //==================
     // Only called from tryAddBlock -- just a helper function, not thread safe
     bool checkBlockTransactions(const ImmutableBlock& block) const;
     //==================
-    void tryPerformTransaction(const lk::Transaction& tx, const ImmutableBlock& block_where_tx);
+    // changes nothing but the commit, so transactions of a block can be executed speculatively in parallel
+    TransactionStatus executeTransaction(Commit& commit,
+                                         const lk::Transaction& tx,
+                                         const ImmutableBlock& block_where_tx,
+                                         ExecutionTrace* trace = nullptr);
+    // the same, and the trace gets the time of the whole transaction
+    TransactionStatus executeTracedTransaction(Commit& commit,
+                                               const lk::Transaction& tx,
+                                               const ImmutableBlock& block_where_tx,
+                                               ExecutionTrace& trace);
+    // the block, that a transaction sent now would get into, for dry runs
+    ImmutableBlock makeNextBlock(const ImmutableBlock& top_block) const;
     //==================
     void on_account_updated(lk::Address address);
     //==================
@@ -103,17 +209,21 @@ class Core
                                     const ImmutableBlock& associated_block,
                                     const lk::Transaction& tx,
                                     const lk::Address& contract_address,
-                                    const base::Bytes& code);
+                                    const base::Bytes& code,
+                                    ExecutionTrace* trace);
     evmc::result callContractVm(Commit& current_commit,
                                 const ImmutableBlock& associated_block,
                                 const lk::Transaction& tx,
                                 const base::Bytes& code,
-                                const base::Bytes& message_data);
-    evmc::result callVm(Commit& current_commit,
+                                const base::Bytes& message_data,
+                                ExecutionTrace* trace);
+    // all calls made by a transaction share its access cache and its trace, if it's traced
+    evmc::result callVm(AccessCache& accesses,
                         const ImmutableBlock& associated_block,
                         const lk::Transaction& associated_tx,
                         const evmc_message& message,
-                        const base::Bytes& code);
+                        const base::Bytes& code,
+                        ExecutionTrace* trace);
 
   public:
     //==================
@@ -139,9 +249,10 @@ class EthHost : public evmc::Host
 {
   public:
     EthHost(lk::Core& core,
-            lk::Commit& current_commit,
+            lk::AccessCache& accesses,
             const ImmutableBlock& associated_block,
-            const lk::Transaction& associated_tx);
+            const lk::Transaction& associated_tx,
+            ExecutionTrace* trace);
 
     bool account_exists(const evmc::address& addr) const noexcept override;
 
@@ -174,9 +285,13 @@ class EthHost : public evmc::Host
 
   private:
     Core& _core;
+    AccessCache& _accesses;
     Commit& _current_commit;
     const ImmutableBlock& _associated_block;
     const Transaction& _associated_tx;
+    ExecutionTrace* _trace; // nullptr, if the execution is not traced
+
+    evmc::result _callFrame(const evmc_message& msg);
 };
 
 } // namespace core
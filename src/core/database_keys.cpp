@@ -0,0 +1,30 @@
+#include "database_keys.hpp"
+
+namespace lk
+{
+
+base::Bytes makeDatabaseKey(DataType type, const base::Bytes& key)
+{
+    base::Bytes data;
+    data.append(static_cast<base::Byte>(type));
+    data.append(key);
+    return data;
+}
+
+
+base::Bytes makeDatabaseKey(DataType type, std::uint64_t index)
+{
+    return makeDatabaseKey(type, base::Bytes{}, index);
+}
+
+
+base::Bytes makeDatabaseKey(DataType type, const base::Bytes& key, std::uint64_t index)
+{
+    auto data = makeDatabaseKey(type, key);
+    for (int shift = 56; shift >= 0; shift -= 8) {
+        data.append(static_cast<base::Byte>(index >> shift));
+    }
+    return data;
+}
+
+} // namespace lk
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "base/bytes.hpp"
+
+#include <cstdint>
+
+namespace lk
+{
+
+// prefixes of the keys, under which different kinds of node data are kept in a single database
+enum class DataType : base::Byte
+{
+    SYSTEM = 1,
+    // 2 and 3 were taken by blocks and their parents' hashes keyed by block hash
+    STATE_TRIE_NODE = 4,
+    BLOCK = 5, // keyed by block depth
+    TRANSACTION_BLOCK_DEPTH = 6,
+    BLOCK_HEADER = 7, // keyed by block depth, kept instead of the body of a pruned block
+    ACCOUNT_TRANSACTION = 8, // keyed by account address and sequence number of the transaction
+    BLOCK_LOGS = 9, // keyed by block depth, only blocks with logs are there
+    BLOCK_LOGS_BLOOM = 10, // keyed by block depth, the same blocks
+    LOGS_SECTION_BLOOM = 11 // keyed by number of the section of blocks
+};
+
+
+base::Bytes makeDatabaseKey(DataType type, const base::Bytes& key);
+
+template<std::size_t S>
+base::Bytes makeDatabaseKey(DataType type, const base::FixedBytes<S>& key);
+
+// the index is stored big-endian, so keys of a type are ordered by their indices
+base::Bytes makeDatabaseKey(DataType type, std::uint64_t index);
+
+// the same, but the index follows the key, so the entries of a key are ordered by their indices
+base::Bytes makeDatabaseKey(DataType type, const base::Bytes& key, std::uint64_t index);
+
+} // namespace lk
+
+#include "database_keys.tpp"
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "database_keys.hpp"
+
+namespace lk
+{
+
+template<std::size_t S>
+base::Bytes makeDatabaseKey(DataType type, const base::FixedBytes<S>& key)
+{
+    base::Bytes data;
+    data.append(static_cast<base::Byte>(type));
+    data.append(key.getData(), S);
+    return data;
+}
+
+} // namespace lk
@@ -0,0 +1,97 @@
+#include "fee_estimator.hpp"
+
+#include "base/assert.hpp"
+#include "base/log.hpp"
+
+#include <boost/asio/post.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace lk
+{
+
+FeeEstimator::FeeEstimator(std::size_t threads_count)
+  : _threads_count{ std::max<std::size_t>(threads_count, 1) }
+{
+    if (_threads_count > 1) {
+        _pool.emplace(_threads_count - 1);
+    }
+}
+
+
+lk::Fee FeeEstimator::findLeastFee(lk::Fee low, lk::Fee high, const RunFunction& run)
+{
+    ASSERT(low <= high);
+    std::vector<lk::Fee> fees;
+    std::vector<char> results; // written concurrently, so not std::vector<bool>
+    while (low < high) {
+        // fees below low are not enough, high is enough
+        const lk::Fee distance = high - low;
+        fees.clear();
+        if (distance <= _threads_count) {
+            for (auto fee = low; fee < high; ++fee) {
+                fees.push_back(fee);
+            }
+        }
+        else {
+            const auto step = distance / (_threads_count + 1);
+            for (std::size_t i = 1; i <= _threads_count; ++i) {
+                fees.push_back(low + step * i);
+            }
+        }
+        results.assign(fees.size(), false);
+
+        std::atomic<std::size_t> next_run{ 0 };
+        auto run_fees = [&] {
+            for (auto i = next_run++; i < fees.size(); i = next_run++) {
+                try {
+                    results[i] = run(fees[i]);
+                }
+                catch (const std::exception& e) {
+                    LOG_DEBUG << "Dry run with fee " << fees[i] << " failed: " << e.what();
+                }
+            }
+        };
+
+        std::size_t workers_left = std::min(_threads_count, fees.size()) - 1;
+        std::mutex workers_mutex;
+        std::condition_variable workers_done;
+        for (std::size_t i = workers_left; i > 0; --i) {
+            boost::asio::post(*_pool, [&] {
+                run_fees();
+                std::lock_guard lk(workers_mutex);
+                if (--workers_left == 0) {
+                    workers_done.notify_one();
+                }
+            });
+        }
+        run_fees();
+        {
+            std::unique_lock lk(workers_mutex);
+            workers_done.wait(lk, [&] { return workers_left == 0; });
+        }
+
+        // fees are sorted, so the first enough one is the new high, and the fee before it is not enough
+        auto enough = std::find(results.begin(), results.end(), true);
+        auto first_enough = static_cast<std::size_t>(enough - results.begin());
+        if (first_enough < fees.size()) {
+            high = fees[first_enough];
+        }
+        if (first_enough > 0) {
+            low = fees[first_enough - 1] + 1;
+        }
+    }
+    return high;
+}
+
+
+std::size_t FeeEstimator::getThreadsCount() const noexcept
+{
+    return _threads_count;
+}
+
+} // namespace lk
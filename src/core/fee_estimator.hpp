@@ -0,0 +1,44 @@
+#pragma once
+
+#include "core/types.hpp"
+
+#include <boost/asio/thread_pool.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+
+namespace lk
+{
+
+/*
+ * Search of the least fee, that is enough for a transaction, by dry runs of the transaction with different fees.
+ * Gas used by a successful run is not the answer: the calls of contracts get only a part of the gas left, and the
+ * refunds are made after the execution. Instead of a binary search, the interval of fees is split at several points
+ * at once, and the runs at these points are executed concurrently, so the search takes log(threads + 1) rounds instead
+ * of log(2). If a fee is enough, any greater fee is expected to be enough too.
+ */
+class FeeEstimator
+{
+  public:
+    // executes the transaction with the fee against its own commit: called concurrently for different fees
+    using RunFunction = std::function<bool(lk::Fee fee)>;
+    //================
+    explicit FeeEstimator(std::size_t threads_count);
+    FeeEstimator(const FeeEstimator&) = delete;
+    FeeEstimator(FeeEstimator&&) = delete;
+    FeeEstimator& operator=(const FeeEstimator&) = delete;
+    FeeEstimator& operator=(FeeEstimator&&) = delete;
+    ~FeeEstimator() = default;
+    //================
+    // the least enough fee in [low, high], the high fee must be enough: it is not run again
+    lk::Fee findLeastFee(lk::Fee low, lk::Fee high, const RunFunction& run);
+    //================
+    std::size_t getThreadsCount() const noexcept;
+
+  private:
+    const std::size_t _threads_count;
+    std::optional<boost::asio::thread_pool> _pool; // the calling thread is a worker too, so there is no pool for one
+};
+
+} // namespace lk
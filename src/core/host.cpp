@@ -449,6 +449,77 @@ void Host::broadcast(const Transaction& tx)
 }
 
 
+void Host::requestSnapshotChunks(std::shared_ptr<SnapshotImport> snapshot_import,
+                                 std::weak_ptr<Peer> source,
+                                 std::function<void()> on_complete)
+{
+    std::vector<std::shared_ptr<Peer>> peers;
+    _handshaked_peers.forEachPeer([&peers](Peer& peer) { peers.push_back(peer.shared_from_this()); });
+    if (peers.empty()) {
+        if (auto source_peer = source.lock()) {
+            peers.push_back(std::move(source_peer));
+        }
+        else {
+            return;
+        }
+    }
+
+    auto missing_chunks = snapshot_import->getMissingChunks();
+    {
+        std::lock_guard lk(_snapshot_import_mutex);
+        _snapshot_import = snapshot_import;
+        _snapshot_source = std::move(source);
+        _on_snapshot_import_complete = std::move(on_complete);
+    }
+
+    LOG_INFO << "Requesting " << missing_chunks.size() << " snapshot chunks from " << peers.size() << " peers";
+    for (std::size_t i = 0; i < missing_chunks.size(); ++i) {
+        peers[i % peers.size()]->requestSnapshotChunk(missing_chunks[i]);
+    }
+}
+
+
+void Host::handleSnapshotChunk(const base::Sha256& chunk_hash, const base::Bytes& chunk)
+{
+    std::function<void()> on_complete;
+    {
+        std::lock_guard lk(_snapshot_import_mutex);
+        auto snapshot_import = _snapshot_import.lock();
+        if (!snapshot_import || !snapshot_import->addChunk(chunk_hash, chunk)) {
+            LOG_DEBUG << "Received snapshot chunk " << chunk_hash << " is not expected";
+            return;
+        }
+        if (snapshot_import->isComplete()) {
+            _snapshot_import.reset();
+            _snapshot_source.reset();
+            on_complete = std::move(_on_snapshot_import_complete);
+        }
+    }
+
+    if (on_complete) {
+        on_complete();
+    }
+}
+
+
+void Host::handleSnapshotChunkNotFound(const base::Sha256& chunk_hash, const Peer& peer)
+{
+    std::shared_ptr<Peer> source;
+    {
+        std::lock_guard lk(_snapshot_import_mutex);
+        if (_snapshot_import.expired()) {
+            return;
+        }
+        source = _snapshot_source.lock();
+    }
+
+    // the source peer has sent the manifest, so it has all the chunks unless its snapshot was already replaced
+    if (source && source.get() != &peer) {
+        source->requestSnapshotChunk(chunk_hash);
+    }
+}
+
+
 bool Host::isConnectedTo(const net::Endpoint& endpoint) const
 {
     return _non_handshaked_peers.hasPeerWithEndpoint(endpoint) || _handshaked_peers.hasPeerWithEndpoint(endpoint);
@@ -5,6 +5,7 @@
 #include "core/block.hpp"
 #include "core/peer.hpp"
 #include "core/rating.hpp"
+#include "core/snapshot.hpp"
 #include "net/acceptor.hpp"
 #include "net/connector.hpp"
 #include "net/session.hpp"
@@ -124,6 +125,17 @@ class Host
     void broadcastNewBlock(const ImmutableBlock& block);
     void broadcast(const lk::Transaction& tx);
     //=================================
+    /*
+     * Chunks of the snapshot are requested from all handshaked peers in parallel. A chunk, that some peer doesn't
+     * have, is requested from the source peer, which has sent the manifest. The import is abandoned as soon as its
+     * owner drops it.
+     */
+    void requestSnapshotChunks(std::shared_ptr<SnapshotImport> snapshot_import,
+                               std::weak_ptr<Peer> source,
+                               std::function<void()> on_complete);
+    void handleSnapshotChunk(const base::Sha256& chunk_hash, const base::Bytes& chunk);
+    void handleSnapshotChunkNotFound(const base::Sha256& chunk_hash, const Peer& peer);
+    //=================================
     void run();
     void join();
     //=================================
@@ -163,6 +175,11 @@ class Host
     std::set<net::Endpoint> _connector_in_process;
     std::mutex _conntextor_set_mutex;
     //=================================
+    std::weak_ptr<SnapshotImport> _snapshot_import;
+    std::weak_ptr<Peer> _snapshot_source;
+    std::function<void()> _on_snapshot_import_complete;
+    std::mutex _snapshot_import_mutex;
+    //=================================
 };
 
 } // namespace net
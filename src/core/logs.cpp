@@ -0,0 +1,347 @@
+#include "logs.hpp"
+
+#include "base/assert.hpp"
+#include "core/database_keys.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <set>
+
+namespace
+{
+
+base::Bytes makeBlockLogsKey(lk::BlockDepth depth)
+{
+    return lk::makeDatabaseKey(lk::DataType::BLOCK_LOGS, depth);
+}
+
+
+base::Bytes makeBlockBloomKey(lk::BlockDepth depth)
+{
+    return lk::makeDatabaseKey(lk::DataType::BLOCK_LOGS_BLOOM, depth);
+}
+
+
+base::Bytes makeSectionBloomKey(std::uint64_t section)
+{
+    return lk::makeDatabaseKey(lk::DataType::LOGS_SECTION_BLOOM, section);
+}
+
+
+// the index, which is stored big-endian at the end of the key
+std::uint64_t getKeyIndex(const leveldb::Slice& key)
+{
+    ASSERT(key.size() >= sizeof(std::uint64_t));
+    std::uint64_t index = 0;
+    for (auto i = key.size() - sizeof(index); i < key.size(); ++i) {
+        index = (index << 8) | static_cast<base::Byte>(key.data()[i]);
+    }
+    return index;
+}
+
+
+std::uint64_t getSection(lk::BlockDepth depth)
+{
+    return depth / base::config::BC_LOGS_SECTION_SIZE;
+}
+
+
+lk::LogsBloom toBloom(const leveldb::Slice& value)
+{
+    return lk::LogsBloom(
+      base::FixedBytes<lk::LogsBloom::SIZE>(reinterpret_cast<const base::Byte*>(value.data()), value.size()));
+}
+
+
+// the filter with the items hashed in advance, since it is checked in many blooms
+class BloomQuery
+{
+  public:
+    explicit BloomQuery(const lk::LogsFilter& filter)
+    {
+        if (!filter.addresses.empty()) {
+            auto& alternatives = _items.emplace_back();
+            for (const auto& address : filter.addresses) {
+                alternatives.push_back(lk::LogsBloom::getPositions(address.getBytes().toBytes()));
+            }
+        }
+        for (const auto& topic_alternatives : filter.topics) {
+            if (topic_alternatives.empty()) {
+                continue;
+            }
+            auto& alternatives = _items.emplace_back();
+            for (const auto& topic : topic_alternatives) {
+                alternatives.push_back(lk::LogsBloom::getPositions(topic.toBytes()));
+            }
+        }
+    }
+
+    bool mightMatch(const lk::LogsBloom& bloom) const
+    {
+        // only blocks with logs have blooms, so an empty one is a section without logs
+        if (bloom.isEmpty()) {
+            return false;
+        }
+        return std::all_of(_items.begin(), _items.end(), [&bloom](const auto& alternatives) {
+            return std::any_of(alternatives.begin(), alternatives.end(), [&bloom](const auto& positions) {
+                return bloom.mightContain(positions);
+            });
+        });
+    }
+
+  private:
+    std::vector<std::vector<lk::LogsBloom::Positions>> _items;
+};
+
+} // namespace
+
+
+namespace lk
+{
+
+void LogRecord::serialize(base::SerializationOArchive& oa) const
+{
+    oa.serialize(depth);
+    oa.serialize(transaction_hash);
+    oa.serialize(index);
+    oa.serialize(log);
+}
+
+
+LogRecord LogRecord::deserialize(base::SerializationIArchive& ia)
+{
+    auto depth = ia.deserialize<BlockDepth>();
+    auto transaction_hash = ia.deserialize<base::Sha256>();
+    auto index = ia.deserialize<std::uint32_t>();
+    auto log = ia.deserialize<Log>();
+    return LogRecord{ depth, std::move(transaction_hash), index, std::move(log) };
+}
+
+
+LogsBloom::LogsBloom(const base::FixedBytes<SIZE>& bits)
+  : _bits{ bits }
+{}
+
+
+LogsBloom::Positions LogsBloom::getPositions(const base::Bytes& item)
+{
+    const auto hash = base::Keccak256::compute(item);
+    const auto& bytes = hash.getBytes();
+    Positions positions;
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+        positions[i] = static_cast<std::uint16_t>(((bytes[2 * i] << 8) | bytes[2 * i + 1]) % (SIZE * 8));
+    }
+    return positions;
+}
+
+
+void LogsBloom::add(const Log& log)
+{
+    add(log.address.getBytes().toBytes());
+    for (const auto& topic : log.topics) {
+        add(topic.toBytes());
+    }
+}
+
+
+void LogsBloom::add(const base::Bytes& item)
+{
+    for (auto bit : getPositions(item)) {
+        _bits[SIZE - 1 - bit / 8] |= static_cast<base::Byte>(1 << (bit % 8));
+    }
+}
+
+
+void LogsBloom::merge(const LogsBloom& other)
+{
+    for (std::size_t i = 0; i < SIZE; ++i) {
+        _bits[i] |= other._bits[i];
+    }
+}
+
+
+bool LogsBloom::mightContain(const base::Bytes& item) const
+{
+    return mightContain(getPositions(item));
+}
+
+
+bool LogsBloom::mightContain(const Positions& positions) const
+{
+    return std::all_of(positions.begin(), positions.end(), [this](auto bit) {
+        return (_bits[SIZE - 1 - bit / 8] & (1 << (bit % 8))) != 0;
+    });
+}
+
+
+bool LogsBloom::isEmpty() const
+{
+    const auto& bits = _bits.toArray();
+    return std::all_of(bits.begin(), bits.end(), [](base::Byte byte) { return byte == 0; });
+}
+
+
+const base::FixedBytes<LogsBloom::SIZE>& LogsBloom::getBits() const noexcept
+{
+    return _bits;
+}
+
+
+bool LogsFilter::matches(const Log& log) const
+{
+    if (!addresses.empty() && std::find(addresses.begin(), addresses.end(), log.address) == addresses.end()) {
+        return false;
+    }
+    if (log.topics.size() < topics.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < topics.size(); ++i) {
+        const auto& alternatives = topics[i];
+        if (!alternatives.empty() &&
+            std::find(alternatives.begin(), alternatives.end(), log.topics[i]) == alternatives.end()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+bool LogsFilter::mightMatch(const LogsBloom& bloom) const
+{
+    return BloomQuery(*this).mightMatch(bloom);
+}
+
+
+LogsIndex::LogsIndex()
+  : _database{ nullptr }
+{}
+
+
+LogsIndex::LogsIndex(base::Database& database)
+  : _database{ &database }
+{
+    const auto prefix = makeDatabaseKey(DataType::LOGS_SECTION_BLOOM, base::Bytes{});
+    _database->scan(prefix, [this](const leveldb::Slice& key, const leveldb::Slice& value) {
+        const auto section = getKeyIndex(key);
+        if (_section_blooms.size() <= section) {
+            _section_blooms.resize(section + 1);
+        }
+        _section_blooms[section] = toBloom(value);
+        return true;
+    });
+}
+
+
+void LogsIndex::addBlockLogs(BlockDepth depth, std::vector<LogRecord> records)
+{
+    if (records.empty()) {
+        return;
+    }
+    BlockLogs block_logs;
+    for (const auto& record : records) {
+        block_logs.bloom.add(record.log);
+    }
+    block_logs.records = std::move(records);
+
+    std::unique_lock lk(_rw_mutex);
+    const auto section = getSection(depth);
+    if (_section_blooms.size() <= section) {
+        _section_blooms.resize(section + 1);
+    }
+    _section_blooms[section].merge(block_logs.bloom);
+    _unflushed_blocks.insert_or_assign(depth, std::move(block_logs));
+}
+
+
+std::vector<LogRecord> LogsIndex::find(BlockDepth from_depth,
+                                       BlockDepth to_depth,
+                                       const LogsFilter& filter,
+                                       std::size_t limit) const
+{
+    std::vector<LogRecord> found;
+    const BloomQuery query(filter);
+    auto add_matching = [&filter](std::vector<LogRecord>& section_found, const std::vector<LogRecord>& records) {
+        for (const auto& record : records) {
+            if (filter.matches(record.log)) {
+                section_found.push_back(record);
+            }
+        }
+    };
+
+    std::shared_lock lk(_rw_mutex);
+    for (auto section = getSection(from_depth);
+         section <= getSection(to_depth) && section < _section_blooms.size() && found.size() < limit;
+         ++section) {
+        if (!query.mightMatch(_section_blooms[section])) {
+            continue;
+        }
+        const auto first_depth = std::max(from_depth, section * base::config::BC_LOGS_SECTION_SIZE);
+        const auto last_depth = std::min(to_depth, (section + 1) * base::config::BC_LOGS_SECTION_SIZE - 1);
+
+        std::vector<LogRecord> section_found;
+        if (_database) {
+            std::vector<BlockDepth> matching_depths;
+            auto on_bloom = [&](const leveldb::Slice& key, const leveldb::Slice& value) {
+                const auto depth = getKeyIndex(key);
+                if (depth > last_depth) {
+                    return false;
+                }
+                // the unflushed logs of the block, if any, override the stored ones
+                if (!_unflushed_blocks.contains(depth) && query.mightMatch(toBloom(value))) {
+                    matching_depths.push_back(depth);
+                }
+                return true;
+            };
+            _database->scan(makeDatabaseKey(DataType::BLOCK_LOGS_BLOOM, base::Bytes{}),
+                            makeBlockBloomKey(first_depth),
+                            on_bloom);
+            for (auto depth : matching_depths) {
+                auto data = _database->get(makeBlockLogsKey(depth));
+                ASSERT(data); // written with the bloom
+                base::SerializationIArchive ia(*data);
+                add_matching(section_found, ia.deserialize<std::vector<LogRecord>>());
+            }
+        }
+        for (auto it = _unflushed_blocks.lower_bound(first_depth);
+             it != _unflushed_blocks.end() && it->first <= last_depth;
+             ++it) {
+            if (query.mightMatch(it->second.bloom)) {
+                add_matching(section_found, it->second.records);
+            }
+        }
+
+        // the records of a block are added together in their order
+        std::stable_sort(section_found.begin(), section_found.end(), [](const LogRecord& a, const LogRecord& b) {
+            return a.depth < b.depth;
+        });
+        std::move(section_found.begin(), section_found.end(), std::back_inserter(found));
+    }
+
+    if (found.size() > limit) {
+        found.erase(found.begin() + static_cast<std::ptrdiff_t>(limit), found.end());
+    }
+    return found;
+}
+
+
+void LogsIndex::flush(base::Database::Batch& batch)
+{
+    std::unique_lock lk(_rw_mutex);
+    if (!_database) {
+        return;
+    }
+    std::set<std::uint64_t> changed_sections;
+    for (const auto& [depth, block_logs] : _unflushed_blocks) {
+        base::SerializationOArchive oa;
+        oa.serialize(block_logs.records);
+        batch.put(makeBlockLogsKey(depth), std::move(oa).getBytes());
+        batch.put(makeBlockBloomKey(depth), block_logs.bloom.getBits());
+        changed_sections.insert(getSection(depth));
+    }
+    for (auto section : changed_sections) {
+        batch.put(makeSectionBloomKey(section), _section_blooms[section].getBits());
+    }
+    _unflushed_blocks.clear();
+}
+
+} // namespace lk
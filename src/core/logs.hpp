@@ -0,0 +1,115 @@
+#pragma once
+
+#include "base/config.hpp"
+#include "base/database.hpp"
+#include "base/hash.hpp"
+#include "core/transaction.hpp"
+#include "core/types.hpp"
+
+#include <array>
+#include <map>
+#include <shared_mutex>
+#include <vector>
+
+namespace lk
+{
+
+// a log with its place in the blockchain
+struct LogRecord
+{
+    BlockDepth depth;
+    base::Sha256 transaction_hash;
+    std::uint32_t index; // of the log among the logs of the block
+    Log log;
+
+    void serialize(base::SerializationOArchive& oa) const;
+    static LogRecord deserialize(base::SerializationIArchive& ia);
+};
+
+
+// Bloom filter of addresses and topics of logs, the same as in Ethereum: 2048 bits, each item sets 3 of them taken
+// from its Keccak-256 hash. Blooms of blocks are merged with OR, so a bloom of many blocks is checked at once.
+class LogsBloom
+{
+  public:
+    static constexpr std::size_t SIZE = 256; // bytes
+    // the bits of an item, so an item is hashed once to be checked in many blooms
+    using Positions = std::array<std::uint16_t, 3>;
+    //================
+    LogsBloom() = default;
+    explicit LogsBloom(const base::FixedBytes<SIZE>& bits);
+    //================
+    static Positions getPositions(const base::Bytes& item);
+    //================
+    void add(const Log& log);
+    void add(const base::Bytes& item);
+    void merge(const LogsBloom& other);
+    //================
+    // false means that the item was never added, true may be a false positive
+    bool mightContain(const base::Bytes& item) const;
+    bool mightContain(const Positions& positions) const;
+    bool isEmpty() const;
+    const base::FixedBytes<SIZE>& getBits() const noexcept;
+    //================
+  private:
+    base::FixedBytes<SIZE> _bits;
+};
+
+
+// Logs emitted by any of the addresses, which topics match the topics of the filter by positions: the n-th topic of a
+// log is one of the n-th alternatives. Empty addresses or alternatives match anything, and a log with fewer topics
+// than the filter has doesn't match.
+struct LogsFilter
+{
+    std::vector<lk::Address> addresses;
+    std::vector<std::vector<LogTopic>> topics;
+
+    bool matches(const Log& log) const;
+    // false means that no log in the bloom matches
+    bool mightMatch(const LogsBloom& bloom) const;
+};
+
+
+// Logs of blocks searched with Bloom filters. The logs of a block are stored under its depth together with their
+// bloom, and the blooms of sections of base::config::BC_LOGS_SECTION_SIZE blocks are merged and kept in memory. A
+// search skips the sections, which blooms don't match, reads the blooms of the blocks with logs only in the rest of
+// the sections, and reads and checks the logs of the blocks, which blooms match. Blocks without logs are not stored.
+// Changes are kept in memory until flushed with a batch, the same as the transactions history.
+class LogsIndex
+{
+  public:
+    //================
+    LogsIndex(); // the logs are kept only in memory
+    explicit LogsIndex(base::Database& database);
+    LogsIndex(const LogsIndex&) = delete;
+    LogsIndex(LogsIndex&&) = delete;
+    LogsIndex& operator=(const LogsIndex&) = delete;
+    LogsIndex& operator=(LogsIndex&&) = delete;
+    ~LogsIndex() = default;
+    //================
+    // the logs of a block: if the block is added again, e.g. replayed on restart, the logs are the same
+    void addBlockLogs(BlockDepth depth, std::vector<LogRecord> records);
+    //================
+    // matching logs of the blocks in [from_depth, to_depth] in the order of blocks and their indices in a block
+    std::vector<LogRecord> find(BlockDepth from_depth,
+                                BlockDepth to_depth,
+                                const LogsFilter& filter,
+                                std::size_t limit) const;
+    //================
+    // moves changes, that were made since the last flush, to the batch for the database of the index
+    void flush(base::Database::Batch& batch);
+    //================
+  private:
+    struct BlockLogs
+    {
+        LogsBloom bloom;
+        std::vector<LogRecord> records;
+    };
+
+    base::Database* _database;
+    mutable std::shared_mutex _rw_mutex;
+    std::vector<LogsBloom> _section_blooms; // by numbers of sections
+    std::map<BlockDepth, BlockLogs> _unflushed_blocks;
+};
+
+} // namespace lk
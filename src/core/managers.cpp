@@ -1,6 +1,48 @@
 #include "managers.hpp"
 
 #include "base/error.hpp"
+#include "base/log.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace
+{
+
+base::Sha256 computeTrieKey(const base::Bytes& key)
+{
+    return base::Sha256::compute(key);
+}
+
+
+base::Sha256 computeAccountHash(const lk::AccountState& account)
+{
+    base::SerializationOArchive oa;
+    oa.serialize(account.type);
+    oa.serialize(account.nonce);
+    oa.serialize(account.balance);
+    oa.serialize(account.code_hash);
+    oa.serialize(account.storage_root);
+    oa.serialize(account.runtime_code->getHash());
+    return base::Sha256::compute(std::move(oa).getBytes());
+}
+
+
+lk::AccountState copyWithoutStorage(const lk::AccountState& account)
+{
+    lk::AccountState copy{ account.type };
+    copy.nonce = account.nonce;
+    copy.balance = account.balance;
+    copy.code_hash = account.code_hash;
+    copy.storage_root = account.storage_root;
+    copy.transactions_count = account.transactions_count;
+    copy.runtime_code = account.runtime_code;
+    return copy;
+}
+
+} // namespace
+
 
 namespace lk
 {
@@ -9,6 +51,72 @@ AccountState::AccountState(AccountType initial_type)
   : type{ initial_type }
   , nonce{ 0 }
   , code_hash{ base::Sha256::null() }
+  , storage_root{ MerkleTrie::emptyRoot() }
+  , transactions_count{ 0 }
+  , runtime_code{ ContractCode::empty() }
+{}
+
+
+void AccessSet::addAccount(const lk::Address& address)
+{
+    _accounts[address].is_account_accessed = true;
+}
+
+
+void AccessSet::addStorageValue(const lk::Address& contract_address, const StorageKey& key)
+{
+    _accounts[contract_address].storage_keys.insert(key);
+}
+
+
+void AccessSet::add(const AccessSet& other)
+{
+    for (const auto& [address, access] : other._accounts) {
+        auto& this_access = _accounts[address];
+        this_access.is_account_accessed = this_access.is_account_accessed || access.is_account_accessed;
+        this_access.storage_keys.insert(access.storage_keys.begin(), access.storage_keys.end());
+    }
+}
+
+
+bool AccessSet::intersects(const AccessSet& other) const
+{
+    if (other._accounts.size() < _accounts.size()) {
+        return other.intersects(*this);
+    }
+
+    for (const auto& [address, access] : _accounts) {
+        auto it = other._accounts.find(address);
+        if (it == other._accounts.end()) {
+            continue;
+        }
+        const auto& other_access = it->second;
+        if (access.is_account_accessed && other_access.is_account_accessed) {
+            return true;
+        }
+        for (const auto& key : access.storage_keys) {
+            if (other_access.storage_keys.contains(key)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+
+bool AccessSet::isEmpty() const
+{
+    return _accounts.empty();
+}
+
+
+Commit::AccountDelta::AccountDelta(AccountType initial_type)
+  : is_created{ true }
+  , type{ initial_type }
+  , nonce{ 0 }
+  , balance{ lk::Balance{} }
+  , code_hash{ base::Sha256::null() }
+  , runtime_code{ ContractCode::empty() }
 {}
 
 
@@ -16,23 +124,133 @@ Commit::Commit(StateManager& state_manager)
   : _state_manager{ state_manager }
 {}
 
+
+Commit::Commit(StateManager& state_manager, Commit* parent)
+  : _state_manager{ state_manager }
+  , _parent{ parent }
+{}
+
+
+Commit::Commit(const StateView& view)
+  : _state_manager{ view._state_manager }
+  , _view{ &view }
+{}
+
+
 Commit::Commit(Commit&& another)
   : _state_manager{ another._state_manager }
+  , _parent{ another._parent }
+  , _view{ another._view }
 {
     _changed_states = std::move(another._changed_states);
+    _credits = std::move(another._credits);
     _deleted_accounts = std::move(another._deleted_accounts);
+    _logs = std::move(another._logs);
+    _journal = std::move(another._journal);
+    _savepoints_count = another._savepoints_count;
+    _read_set = std::move(another._read_set);
 }
 
 
 Commit& Commit::operator=(Commit&& another)
 {
     std::scoped_lock lock{ _rw_mutex, another._rw_mutex };
+    _parent = another._parent;
+    _view = another._view;
     _changed_states = std::move(another._changed_states);
+    _credits = std::move(another._credits);
     _deleted_accounts = std::move(another._deleted_accounts);
+    _logs = std::move(another._logs);
+    _journal = std::move(another._journal);
+    _savepoints_count = another._savepoints_count;
+    _read_set = std::move(another._read_set);
     return *this;
 }
 
 
+Commit Commit::createCommit()
+{
+    return Commit{ _state_manager, this };
+}
+
+
+void Commit::applyCommit(Commit&& child)
+{
+    ASSERT(child._parent == this);
+    std::scoped_lock lock{ _rw_mutex, child._rw_mutex };
+    ASSERT(!_isJournaled());
+    for (auto& [address, delta] : child._changed_states) {
+        if (delta.is_created) {
+            _deleted_accounts.erase(address);
+            _changed_states.insert_or_assign(address, std::move(delta));
+            continue;
+        }
+
+        auto& this_delta = _changed_states[address];
+        if (delta.type) {
+            this_delta.type = *delta.type;
+        }
+        if (delta.nonce) {
+            this_delta.nonce = *delta.nonce;
+        }
+        if (delta.balance) {
+            // the child has read the balance together with the credits of this commit
+            this_delta.balance = std::move(*delta.balance);
+            _credits.erase(address);
+        }
+        if (delta.code_hash) {
+            this_delta.code_hash = std::move(*delta.code_hash);
+        }
+        if (delta.runtime_code) {
+            this_delta.runtime_code = std::move(*delta.runtime_code);
+        }
+        for (auto& tx_hash : delta.transactions) {
+            this_delta.transactions.push_back(std::move(tx_hash));
+        }
+        for (auto& [key, value] : delta.storage) {
+            this_delta.storage.insert_or_assign(key, std::move(value));
+        }
+    }
+    for (auto& [address, credit] : child._credits) {
+        _credits[address] += credit;
+    }
+    _deleted_accounts.insert(child._deleted_accounts.begin(), child._deleted_accounts.end());
+    std::move(child._logs.begin(), child._logs.end(), std::back_inserter(_logs));
+}
+
+
+std::size_t Commit::createSavepoint()
+{
+    std::unique_lock lock{ _rw_mutex };
+    ++_savepoints_count;
+    return _journal.size();
+}
+
+
+void Commit::releaseSavepoint(std::size_t savepoint)
+{
+    std::unique_lock lock{ _rw_mutex };
+    ASSERT(_savepoints_count > 0 && savepoint <= _journal.size());
+    if (--_savepoints_count == 0) {
+        _journal.clear();
+    }
+}
+
+
+void Commit::revertToSavepoint(std::size_t savepoint)
+{
+    std::unique_lock lock{ _rw_mutex };
+    ASSERT(_savepoints_count > 0 && savepoint <= _journal.size());
+    while (_journal.size() > savepoint) {
+        _undo(_journal.back());
+        _journal.pop_back();
+    }
+    if (--_savepoints_count == 0) {
+        _journal.clear();
+    }
+}
+
+
 bool Commit::createClientAccount(const lk::Address& address)
 {
     std::unique_lock lock{ _rw_mutex };
@@ -44,20 +262,20 @@ lk::Address Commit::createContractAccount(const lk::Address& from_account_addres
 {
     std::unique_lock lock{ _rw_mutex };
     if (!_hasAccountAnywhere(from_account_address)) {
-        RAISE_ERROR(base::LogicError, "address already exists");
+        RAISE_ERROR(base::LogicError, "account address was not found by a given key");
     }
 
-
-    auto& account = _getAccountAnywhere(from_account_address);
-    base::Bytes nonce_string_data{ std::to_string(account.nonce) };
+    base::Bytes nonce_string_data{ std::to_string(_getNonce(from_account_address)) };
 
     auto bytes_address = base::Ripemd160::compute(associated_code_hash.getBytes().toBytes() +
                                                   from_account_address.getBytes().toBytes() + nonce_string_data);
     auto account_address = lk::Address(bytes_address.getBytes());
 
-    AccountState state{ AccountType::CONTRACT };
-    state.code_hash = std::move(associated_code_hash);
-    _changed_states.insert({ account_address, std::move(state) });
+    AccountDelta delta{ AccountType::CONTRACT };
+    delta.code_hash = std::move(associated_code_hash);
+    if (_changed_states.try_emplace(account_address, std::move(delta)).second && _isJournaled()) {
+        _journal.push_back(DeltaAdded{ account_address, std::nullopt });
+    }
 
     return account_address;
 }
@@ -76,104 +294,101 @@ bool Commit::deleteAccount(const lk::Address& address, const lk::Address& benefi
     if (!_hasAccountAnywhere(address)) {
         return false;
     }
-    auto value = _getAccountAnywhere(address).balance;
-    if (!tryTransferMoney(address, beneficiary_address, value)) {
+    if (!_tryTransferMoney(address, beneficiary_address, _getBalance(address))) {
         return false;
     }
 
-    {
-        std::unique_lock lock{ _rw_mutex };
-        _deleted_accounts.insert(address);
+    if (_deleted_accounts.insert(address).second && _isJournaled()) {
+        _journal.push_back(DeletionSet{ address, false });
     }
-
-    return false;
+    return true;
 }
 
 
 AccountType Commit::getAccountType(const lk::Address& account_address) const
 {
     std::shared_lock lock{ _rw_mutex };
-    return _getAccountAnywhere(account_address).type;
+    return _getAccountType(account_address);
 }
 
 
 bool Commit::tryTransferMoney(const lk::Address& from, const lk::Address& to, const lk::Balance& amount)
+{
+    std::unique_lock lock{ _rw_mutex };
+    return _tryTransferMoney(from, to, amount);
+}
+
+
+bool Commit::payFee(const lk::Address& from, const lk::Address& to, const lk::Balance& value)
 {
     std::unique_lock lock{ _rw_mutex };
     if (!_hasAccountAnywhere(from)) {
         return false;
     }
-    _copyLocalIfNotExists(from);
-
-    if (!_hasAccountAnywhere(to)) {
-        ASSERT(_createClientAccount(to));
-    }
-    else {
-        _copyLocalIfNotExists(to);
-    }
-
-    auto& from_account = _getAccount(from);
-    if (from_account.balance < amount) {
+    auto from_balance = _getBalance(from);
+    if (from_balance < value) {
         return false;
     }
-    auto& to_account = _getAccount(to);
 
-    from_account.balance -= amount;
-    to_account.balance += amount;
+    _setBalance(from, from_balance - value);
+    auto [credit, is_inserted] = _credits.try_emplace(to);
+    if (_isJournaled()) {
+        _journal.push_back(CreditAdded{ to, is_inserted ? std::nullopt : std::optional{ credit->second } });
+    }
+    credit->second += value;
     return true;
 }
 
 
-bool Commit::checkStorageValue(const lk::Address& contract_address, const base::Sha256& key) const
+void Commit::addTxHash(const lk::Address& address, const base::Sha256& tx_hash)
 {
-    std::shared_lock lock{ _rw_mutex };
-    if (!_hasAccountAnywhere(contract_address)) {
-        RAISE_ERROR(base::LogicError, "account address was not found by a given key");
+    std::unique_lock lock{ _rw_mutex };
+    if (!_hasAccountAnywhere(address)) {
+        ASSERT(_createClientAccount(address));
     }
+    ASSERT(_getAccountType(address) == AccountType::CLIENT);
 
-    const auto& account = _getAccountAnywhere(contract_address);
-    if (account.type != AccountType::CONTRACT) {
-        RAISE_ERROR(base::LogicError, "account is not a contract type");
+    auto nonce = _getNonce(address);
+    auto& delta = _getDelta(address);
+    if (_isJournaled()) {
+        _journal.push_back(TxHashAdded{ address, delta.nonce });
     }
-
-    return account.storage.contains(key);
+    delta.transactions.push_back(tx_hash);
+    delta.nonce = nonce + 1;
 }
 
 
-const StorageData& Commit::getStorageValue(const lk::Address& contract_address, const base::Sha256& key) const
+bool Commit::checkStorageValue(const lk::Address& contract_address, const StorageKey& key) const
 {
     std::shared_lock lock{ _rw_mutex };
-    if (!_hasAccountAnywhere(contract_address)) {
-        RAISE_ERROR(base::LogicError, "account address was not found by a given key");
-    }
+    _checkContractAccount(contract_address);
+    return _findStorageValue(contract_address, key) != nullptr;
+}
 
-    const auto& account = _getAccountAnywhere(contract_address);
-    if (account.type != AccountType::CONTRACT) {
-        RAISE_ERROR(base::LogicError, "account is not a contract type");
-    }
 
-    if (auto it = account.storage.find(key); it == account.storage.end()) {
+const StorageData& Commit::getStorageValue(const lk::Address& contract_address, const StorageKey& key) const
+{
+    std::shared_lock lock{ _rw_mutex };
+    _checkContractAccount(contract_address);
+    if (auto value = _findStorageValue(contract_address, key); value == nullptr) {
         RAISE_ERROR(base::LogicError, "value was not found by a given key");
     }
     else {
-        return it->second;
+        return *value;
     }
 }
 
 
-void Commit::setStorageValue(const lk::Address& contract_address, const base::Sha256& key, base::Bytes value)
+void Commit::setStorageValue(const lk::Address& contract_address, const StorageKey& key, const StorageValue& value)
 {
-    std::shared_lock lock{ _rw_mutex };
-    if (!_copyLocalIfNotExists(contract_address)) {
-        RAISE_ERROR(base::LogicError, "account address was not found by a given key");
-    }
-    auto& account = _getAccount(contract_address);
-    if (account.type != AccountType::CONTRACT) {
-        RAISE_ERROR(base::LogicError, "account is not a contract type");
+    std::unique_lock lock{ _rw_mutex };
+    _checkContractAccount(contract_address);
+    auto [slot, is_inserted] = _getDelta(contract_address).storage.try_emplace(key);
+    if (_isJournaled()) {
+        _journalStorageValue(contract_address, key, is_inserted ? std::nullopt : std::optional{ slot->second });
     }
-
-    StorageData& sd = account.storage[key];
-    sd.data = std::move(value);
+    StorageData& sd = slot->second;
+    sd.data = value;
     sd.was_modified = true;
 }
 
@@ -181,79 +396,349 @@ void Commit::setStorageValue(const lk::Address& contract_address, const base::Sh
 lk::Balance Commit::getBalance(const lk::Address& account_address) const
 {
     std::shared_lock lock{ _rw_mutex };
-    return _getAccountAnywhere(account_address).balance;
+    return _getBalance(account_address);
 }
 
 
 std::size_t Commit::getCodeSize(const lk::Address& account_address) const
 {
     std::shared_lock lock{ _rw_mutex };
-    return _getAccountAnywhere(account_address).runtime_code.size();
+    return _getRuntimeCode(account_address)->size();
 }
 
 
 const base::Sha256& Commit::getCodeHash(const lk::Address& account_address) const
 {
     std::shared_lock lock{ _rw_mutex };
-    return _getAccountAnywhere(account_address).code_hash;
+    return _getCodeHash(account_address);
 }
 
 
-const base::Bytes& Commit::getRuntimeCode(const lk::Address& account_address) const
+ContractCodePtr Commit::getRuntimeCode(const lk::Address& account_address) const
 {
     std::shared_lock lock{ _rw_mutex };
-    return _getAccountAnywhere(account_address).runtime_code;
+    return _getRuntimeCode(account_address);
 }
 
 
-void Commit::setRuntimeCode(const lk::Address& contract_address, const base::Bytes& code)
+void Commit::setRuntimeCode(const lk::Address& contract_address, base::Bytes code)
 {
-    std::shared_lock lock{ _rw_mutex };
-    if (!_copyLocalIfNotExists(contract_address)) {
+    std::unique_lock lock{ _rw_mutex };
+    if (!_hasAccountAnywhere(contract_address)) {
         RAISE_ERROR(base::LogicError, "account address was not found by a given key");
     }
-    auto& account = _getAccount(contract_address);
-    if (account.type != AccountType::CONTRACT) {
+    if (_getAccountType(contract_address) != AccountType::CONTRACT) {
         RAISE_ERROR(base::LogicError, "account is not a contract type");
     }
 
-    account.runtime_code = code;
+    auto& delta = _getDelta(contract_address);
+    if (_isJournaled()) {
+        _journal.push_back(RuntimeCodeSet{ contract_address, delta.runtime_code });
+    }
+    delta.runtime_code = _state_manager._code_store.add(std::move(code));
+}
+
+
+void Commit::addLog(Log log)
+{
+    std::unique_lock lock{ _rw_mutex };
+    if (_isJournaled()) {
+        _journal.push_back(LogAdded{});
+    }
+    _logs.push_back(std::move(log));
+}
+
+
+std::vector<Log> Commit::takeLogs()
+{
+    std::unique_lock lock{ _rw_mutex };
+    ASSERT(!_isJournaled());
+    return std::exchange(_logs, {});
 }
 
 
-AccountState& Commit::_getAccount(const lk::Address& account_address)
+AccessSet Commit::getReadSet() const
 {
-    auto it = _changed_states.find(account_address);
-    if (it == _changed_states.end()) {
+    std::lock_guard lock{ _read_set_mutex };
+    return _read_set;
+}
+
+
+bool Commit::hasReadAnyOf(const AccessSet& access_set) const
+{
+    std::lock_guard lock{ _read_set_mutex };
+    return _read_set.intersects(access_set);
+}
+
+
+AccessSet Commit::getWriteSet() const
+{
+    std::shared_lock lock{ _rw_mutex };
+    AccessSet write_set;
+    for (const auto& [address, delta] : _changed_states) {
+        if (delta.is_created || delta.type || delta.nonce || delta.balance || delta.code_hash || delta.runtime_code ||
+            !delta.transactions.empty()) {
+            write_set.addAccount(address);
+        }
+        for (const auto& [key, value] : delta.storage) {
+            write_set.addStorageValue(address, key);
+        }
+    }
+    for (const auto& [address, credit] : _credits) {
+        write_set.addAccount(address);
+    }
+    for (const auto& address : _deleted_accounts) {
+        write_set.addAccount(address);
+    }
+    return write_set;
+}
+
+
+const Commit::AccountDelta* Commit::_findDelta(const lk::Address& account_address) const
+{
+    if (_deleted_accounts.contains(account_address)) {
         RAISE_ERROR(base::InvalidArgument, "cannot getAccount for non-existent account");
     }
-    else {
-        return it->second;
+    if (auto it = _changed_states.find(account_address); it != _changed_states.end()) {
+        return &it->second;
+    }
+    return nullptr;
+}
+
+
+const AccountState* Commit::_findRootAccount(const lk::Address& account_address) const
+{
+    ASSERT(_parent == nullptr);
+    {
+        std::lock_guard lk(_read_set_mutex);
+        _read_set.addAccount(account_address);
+    }
+    if (_view) {
+        return _view->_findAccount(account_address);
     }
+    std::shared_lock lk(_state_manager._rw_mutex);
+    return _state_manager._findAccount(account_address);
 }
 
 
-const AccountState& Commit::_getAccount(const lk::Address& account_address) const
+const AccountState& Commit::_getRootAccount(const lk::Address& account_address) const
 {
-    auto it = _changed_states.find(account_address);
-    if (it == _changed_states.end() || _deleted_accounts.contains(account_address)) {
+    if (auto account = _findRootAccount(account_address); account == nullptr) {
         RAISE_ERROR(base::InvalidArgument, "cannot getAccount for non-existent account");
     }
     else {
-        return it->second;
+        return *account;
+    }
+}
+
+
+Commit::AccountDelta& Commit::_getDelta(const lk::Address& account_address)
+{
+    ASSERT(_hasAccountAnywhere(account_address));
+    auto [delta, is_inserted] = _changed_states.try_emplace(account_address);
+    if (is_inserted && _isJournaled()) {
+        _journal.push_back(DeltaAdded{ account_address, std::nullopt });
+    }
+    return delta->second;
+}
+
+
+bool Commit::_isJournaled() const noexcept
+{
+    return _savepoints_count > 0;
+}
+
+
+void Commit::_journalStorageValue(const lk::Address& contract_address,
+                                  const StorageKey& key,
+                                  std::optional<StorageData> previous_data)
+{
+    _journal.push_back(StorageSet{ contract_address, key, std::move(previous_data) });
+}
+
+
+void Commit::_undo(JournalEntry& entry)
+{
+    std::visit(
+      [this](auto& change) {
+          using Change = std::decay_t<decltype(change)>;
+          if constexpr (std::is_same_v<Change, DeltaAdded>) {
+              if (change.replaced_delta) {
+                  _changed_states.insert_or_assign(change.address, std::move(*change.replaced_delta));
+              }
+              else {
+                  _changed_states.erase(change.address);
+              }
+          }
+          else if constexpr (std::is_same_v<Change, CreditAdded>) {
+              if (change.credit) {
+                  _credits.insert_or_assign(change.address, std::move(*change.credit));
+              }
+              else {
+                  _credits.erase(change.address);
+              }
+          }
+          else if constexpr (std::is_same_v<Change, DeletionSet>) {
+              if (change.is_deleted) {
+                  _deleted_accounts.insert(change.address);
+              }
+              else {
+                  _deleted_accounts.erase(change.address);
+              }
+          }
+          else if constexpr (std::is_same_v<Change, LogAdded>) {
+              _logs.pop_back();
+          }
+          else {
+              // the rest are changes of a delta, which was added before them, so it's still there
+              auto& delta = _changed_states.find(change.address)->second;
+              if constexpr (std::is_same_v<Change, BalanceSet>) {
+                  delta.balance = std::move(change.balance);
+                  if (change.credit) {
+                      _credits.insert_or_assign(change.address, std::move(*change.credit));
+                  }
+              }
+              else if constexpr (std::is_same_v<Change, TxHashAdded>) {
+                  delta.transactions.pop_back();
+                  delta.nonce = change.nonce;
+              }
+              else if constexpr (std::is_same_v<Change, StorageSet>) {
+                  if (change.data) {
+                      delta.storage.insert_or_assign(change.key, std::move(*change.data));
+                  }
+                  else {
+                      delta.storage.erase(change.key);
+                  }
+              }
+              else if constexpr (std::is_same_v<Change, RuntimeCodeSet>) {
+                  delta.runtime_code = std::move(change.runtime_code);
+              }
+          }
+      },
+      entry);
+}
+
+
+const StorageData* Commit::_findStorageValue(const lk::Address& contract_address, const StorageKey& key) const
+{
+    if (auto delta = _findDelta(contract_address); delta) {
+        if (auto it = delta->storage.find(key); it != delta->storage.end()) {
+            return &it->second;
+        }
+        if (delta->is_created) {
+            return nullptr;
+        }
+    }
+    if (_parent) {
+        return _parent->_findStorageValue(contract_address, key);
+    }
+
+    const auto& storage = _getRootAccount(contract_address).storage;
+    {
+        std::lock_guard lk(_read_set_mutex);
+        _read_set.addStorageValue(contract_address, key);
+    }
+    if (_view) {
+        return _view->_findStorageValue(contract_address, key);
+    }
+    if (auto it = storage.find(key); it != storage.end()) {
+        return &it->second;
     }
+    return nullptr;
 }
 
 
-const AccountState& Commit::_getAccountAnywhere(const lk::Address& account_address) const
+void Commit::_checkContractAccount(const lk::Address& contract_address) const
 {
-    auto it = _changed_states.find(account_address);
-    if (it == _changed_states.end() || _deleted_accounts.contains(account_address)) {
-        return _state_manager._getAccount(account_address);
+    if (!_hasAccountAnywhere(contract_address)) {
+        RAISE_ERROR(base::LogicError, "account address was not found by a given key");
+    }
+    if (_getAccountType(contract_address) != AccountType::CONTRACT) {
+        RAISE_ERROR(base::LogicError, "account is not a contract type");
+    }
+}
+
+
+AccountType Commit::_getAccountType(const lk::Address& account_address) const
+{
+    if (auto delta = _findDelta(account_address); delta && delta->type) {
+        return *delta->type;
+    }
+    if (_parent) {
+        return _parent->_getAccountType(account_address);
+    }
+    return _getRootAccount(account_address).type;
+}
+
+
+std::uint64_t Commit::_getNonce(const lk::Address& account_address) const
+{
+    if (auto delta = _findDelta(account_address); delta && delta->nonce) {
+        return *delta->nonce;
+    }
+    if (_parent) {
+        return _parent->_getNonce(account_address);
+    }
+    return _getRootAccount(account_address).nonce;
+}
+
+
+lk::Balance Commit::_getBalance(const lk::Address& account_address) const
+{
+    lk::Balance balance;
+    if (auto delta = _findDelta(account_address); delta && delta->balance) {
+        balance = *delta->balance;
+    }
+    else if (_parent) {
+        balance = _parent->_getBalance(account_address);
     }
     else {
-        return it->second;
+        balance = _getRootAccount(account_address).balance;
+    }
+
+    if (auto it = _credits.find(account_address); it != _credits.end()) {
+        balance += it->second;
+    }
+    return balance;
+}
+
+
+void Commit::_setBalance(const lk::Address& account_address, lk::Balance balance)
+{
+    auto& delta = _getDelta(account_address);
+    if (_isJournaled()) {
+        BalanceSet change{ account_address, delta.balance, std::nullopt };
+        if (auto it = _credits.find(account_address); it != _credits.end()) {
+            change.credit = it->second;
+        }
+        _journal.push_back(std::move(change));
+    }
+    delta.balance = std::move(balance);
+    _credits.erase(account_address);
+}
+
+
+const base::Sha256& Commit::_getCodeHash(const lk::Address& account_address) const
+{
+    if (auto delta = _findDelta(account_address); delta && delta->code_hash) {
+        return *delta->code_hash;
+    }
+    if (_parent) {
+        return _parent->_getCodeHash(account_address);
+    }
+    return _getRootAccount(account_address).code_hash;
+}
+
+
+const ContractCodePtr& Commit::_getRuntimeCode(const lk::Address& account_address) const
+{
+    if (auto delta = _findDelta(account_address); delta && delta->runtime_code) {
+        return *delta->runtime_code;
+    }
+    if (_parent) {
+        return _parent->_getRuntimeCode(account_address);
     }
+    return _getRootAccount(account_address).runtime_code;
 }
 
 
@@ -265,41 +750,258 @@ bool Commit::_hasAccountThis(const lk::Address& address) const
 
 bool Commit::_hasAccountRoot(const lk::Address& address) const
 {
-    return _state_manager.hasAccount(address);
+    if (_parent) {
+        return _parent->_hasAccountAnywhere(address);
+    }
+    return _findRootAccount(address) != nullptr;
 }
 
 
 bool Commit::_hasAccountAnywhere(const lk::Address& address) const
 {
+    if (_deleted_accounts.contains(address)) {
+        return false;
+    }
     return _hasAccountThis(address) || _hasAccountRoot(address);
 }
 
 
-bool Commit::_copyLocalIfNotExists(const lk::Address& address)
+bool Commit::_createClientAccount(const lk::Address& address)
 {
-    if (!_hasAccountAnywhere(address)) {
+    if (_hasAccountAnywhere(address)) {
         return false;
     }
-    if (!_hasAccountThis(address)) {
-        auto& account = _state_manager._getAccount(address);
-        _changed_states.insert({ address, account });
+
+    if (_isJournaled()) {
+        DeltaAdded change{ address, std::nullopt };
+        if (auto it = _changed_states.find(address); it != _changed_states.end()) {
+            change.replaced_delta = std::move(it->second);
+        }
+        _journal.push_back(std::move(change));
+        if (_deleted_accounts.contains(address)) {
+            _journal.push_back(DeletionSet{ address, true });
+        }
     }
+    _deleted_accounts.erase(address);
+    _changed_states.insert_or_assign(address, AccountDelta{ AccountType::CLIENT });
     return true;
 }
 
 
-bool Commit::_createClientAccount(const lk::Address& address)
+bool Commit::_tryTransferMoney(const lk::Address& from, const lk::Address& to, const lk::Balance& amount)
 {
-    if (_hasAccountAnywhere(address)) {
+    if (!_hasAccountAnywhere(from)) {
         return false;
     }
 
-    AccountState state{ AccountType::CLIENT };
-    _changed_states.insert({ address, state });
+    auto from_balance = _getBalance(from);
+    if (from_balance < amount) {
+        return false;
+    }
+
+    if (!_hasAccountAnywhere(to)) {
+        ASSERT(_createClientAccount(to));
+    }
+
+    _setBalance(from, from_balance - amount);
+    _setBalance(to, _getBalance(to) + amount);
     return true;
 }
 
 
+ContractStorage::ContractStorage(Commit& commit, const lk::Address& contract_address)
+  : _commit{ commit }
+  , _address{ contract_address }
+{
+    std::shared_lock lock{ _commit._rw_mutex };
+    _commit._checkContractAccount(_address);
+}
+
+
+const lk::Address& ContractStorage::getAddress() const noexcept
+{
+    return _address;
+}
+
+
+const StorageValue* ContractStorage::find(const StorageKey& key)
+{
+    auto& slot = _getSlot(key);
+    return slot.value ? &*slot.value : nullptr;
+}
+
+
+std::optional<StorageValue> ContractStorage::set(const StorageKey& key, const StorageValue& value)
+{
+    auto& slot = _getSlot(key);
+    auto previous = slot.value;
+    if (!previous && value == StorageValue{}) {
+        return previous;
+    }
+
+    std::optional<StorageData> previous_data;
+    if (slot.written) {
+        previous_data = *slot.written;
+    }
+    else {
+        if (!_delta) {
+            _delta = &_commit._getDelta(_address);
+        }
+        auto [written, is_inserted] = _delta->storage.try_emplace(key);
+        if (!is_inserted) {
+            previous_data = written->second;
+        }
+        slot.written = &written->second;
+    }
+    if (_commit._isJournaled()) {
+        _commit._journalStorageValue(_address, key, std::move(previous_data));
+    }
+    slot.written->data = value;
+    slot.written->was_modified = true;
+    slot.value = value;
+    return previous;
+}
+
+
+bool ContractStorage::isCached(const StorageKey& key) const
+{
+    return _slots.contains(key);
+}
+
+
+void ContractStorage::reset()
+{
+    _slots.clear();
+    _delta = nullptr;
+}
+
+
+ContractStorage::Slot& ContractStorage::_getSlot(const StorageKey& key)
+{
+    if (auto it = _slots.find(key); it != _slots.end()) {
+        return it->second;
+    }
+
+    Slot slot;
+    if (auto data = _commit._findStorageValue(_address, key); data) {
+        slot.value = data->data;
+    }
+    return _slots.try_emplace(key, std::move(slot)).first->second;
+}
+
+
+StateView::StateView(StateManager& state_manager, std::shared_ptr<Layer> layer)
+  : _state_manager{ state_manager }
+  , _layer{ std::move(layer) }
+{}
+
+
+Commit StateView::createCommit() const
+{
+    return Commit{ *this };
+}
+
+
+std::optional<AccountState>& StateView::_getAccount(const lk::Address& account_address) const
+{
+    auto [cached, is_inserted] = _accounts.try_emplace(account_address);
+    if (!is_inserted) {
+        return cached->second;
+    }
+
+    std::shared_lock lk(_state_manager._rw_mutex);
+    const AccountState* account = nullptr;
+    bool is_found = false;
+    for (auto layer = _layer.get(); layer && !is_found; layer = layer->next.get()) {
+        if (auto kept = layer->accounts.find(account_address); kept != layer->accounts.end()) {
+            account = kept->second.state ? &*kept->second.state : nullptr;
+            is_found = true;
+        }
+        else if (layer->replaced_states) {
+            auto replaced = layer->replaced_states->find(account_address);
+            account = replaced != layer->replaced_states->end() ? &replaced->second : nullptr;
+            is_found = true;
+        }
+    }
+    if (!is_found) {
+        account = _state_manager._findAccount(account_address);
+    }
+    if (account) {
+        cached->second.emplace(copyWithoutStorage(*account));
+    }
+    return cached->second;
+}
+
+
+const AccountState* StateView::_findAccount(const lk::Address& account_address) const
+{
+    std::lock_guard lk(_accounts_mutex);
+    if (auto& account = _getAccount(account_address); account) {
+        return &*account;
+    }
+    return nullptr;
+}
+
+
+const StorageData* StateView::_findStorageValue(const lk::Address& contract_address, const StorageKey& key) const
+{
+    std::lock_guard lk(_accounts_mutex);
+    auto& account = _getAccount(contract_address);
+    if (!account) {
+        return nullptr;
+    }
+    if (auto it = account->storage.find(key); it != account->storage.end()) {
+        return &it->second;
+    }
+
+    // a missing slot isn't cached, it is looked up again
+    const StorageMap* storage = nullptr;
+    {
+        std::shared_lock state_lk(_state_manager._rw_mutex);
+        for (auto layer = _layer.get(); layer && !storage; layer = layer->next.get()) {
+            if (auto kept = layer->accounts.find(contract_address); kept != layer->accounts.end()) {
+                if (auto slot = kept->second.storage.find(key); slot != kept->second.storage.end()) {
+                    return slot->second ? &account->storage.try_emplace(key, *slot->second).first->second : nullptr;
+                }
+                if (kept->second.is_storage_whole) {
+                    return nullptr;
+                }
+            }
+            if (layer->replaced_states) {
+                auto replaced = layer->replaced_states->find(contract_address);
+                if (replaced == layer->replaced_states->end()) {
+                    return nullptr;
+                }
+                storage = &replaced->second.storage;
+            }
+        }
+        if (!storage) {
+            auto state = _state_manager._findAccount(contract_address);
+            if (!state) {
+                return nullptr;
+            }
+            storage = &state->storage;
+        }
+        if (auto slot = storage->find(key); slot != storage->end()) {
+            return &account->storage.try_emplace(key, slot->second).first->second;
+        }
+    }
+    return nullptr;
+}
+
+
+StateManager::StateManager()
+  : _state_root{ MerkleTrie::emptyRoot() }
+{}
+
+
+StateManager::StateManager(base::Database& database)
+  : _trie{ database }
+  , _transactions_history{ database }
+  , _state_root{ MerkleTrie::emptyRoot() }
+{}
+
+
 bool StateManager::checkTransaction(const lk::Transaction& tx) const
 {
     std::shared_lock lk(_rw_mutex);
@@ -334,40 +1036,131 @@ bool StateManager::checkTransactionsSet(const lk::TransactionsSet& tx_set) const
 void StateManager::updateFromGenesis(const ImmutableBlock& block)
 {
     std::unique_lock lk(_rw_mutex);
+    auto view_layer = _lockViewLayer();
     for (const auto& tx : block.getTransactions()) {
+        if (view_layer) {
+            _keepForViews(*view_layer, tx.getTo());
+        }
         AccountState state{ AccountType::CLIENT };
         state.balance = tx.getAmount();
         _states.insert({ tx.getTo(), std::move(state) });
+        _dirty_accounts[tx.getTo()];
     }
 }
 
 
+void StateManager::setTransactionsHistoryLimit(std::size_t limit)
+{
+    std::unique_lock lk(_rw_mutex);
+    _transactions_history_limit = limit;
+}
+
+
 Commit StateManager::createCommit()
 {
     return Commit{ *this };
 }
 
 
+StateView StateManager::createView()
+{
+    std::unique_lock lk(_rw_mutex);
+    auto layer = _newest_view_layer.lock();
+    // views taken with no changes in between share the layer
+    if (!layer || !layer->accounts.empty() || layer->replaced_states) {
+        auto new_layer = std::make_shared<StateView::Layer>();
+        if (layer) {
+            layer->next = new_layer;
+        }
+        _newest_view_layer = new_layer;
+        layer = std::move(new_layer);
+    }
+    return StateView{ *this, std::move(layer) };
+}
+
+
 void StateManager::applyCommit(Commit&& commit)
 {
+    ASSERT(commit._parent == nullptr);
     std::set<lk::Address> updated_set;
     {
         std::unique_lock lk(_rw_mutex);
-        for (auto& changed_account : commit._changed_states) {
-            auto it = _states.find(changed_account.first);
-            if (it == _states.end()) {
-                _states.insert(changed_account);
+        auto view_layer = _lockViewLayer();
+        for (auto& [address, delta] : commit._changed_states) {
+            if (commit._deleted_accounts.contains(address)) {
+                continue;
+            }
+
+            auto it = _states.find(address);
+            if (view_layer) {
+                if (delta.is_created && it != _states.end()) {
+                    _keepRemovedForViews(*view_layer, address);
+                }
+                else {
+                    _keepForViews(*view_layer, address);
+                }
+                for (const auto& [key, value] : delta.storage) {
+                    _keepForViews(*view_layer, address, key);
+                }
+            }
+            if (delta.is_created) {
+                ASSERT(delta.type);
+                it = _states.insert_or_assign(address, AccountState{ *delta.type }).first;
             }
-            else {
-                it->second = changed_account.second;
+            else if (it == _states.end()) {
+                RAISE_ERROR(base::LogicError, "commit changes an account which doesn't exist");
             }
 
-            updated_set.insert(changed_account.first);
+            auto& account = it->second;
+            if (delta.type) {
+                account.type = *delta.type;
+            }
+            if (delta.nonce) {
+                account.nonce = *delta.nonce;
+            }
+            if (delta.balance) {
+                account.balance = std::move(*delta.balance);
+            }
+            if (delta.code_hash) {
+                account.code_hash = std::move(*delta.code_hash);
+            }
+            if (delta.runtime_code) {
+                account.runtime_code = std::move(*delta.runtime_code);
+            }
+            for (const auto& tx_hash : delta.transactions) {
+                const auto sequence = account.transactions_count++;
+                _transactions_history.add(address, sequence, tx_hash);
+                if (_transactions_history_limit > 0 && sequence >= _transactions_history_limit) {
+                    _transactions_history.remove(address, sequence - _transactions_history_limit);
+                }
+            }
+            auto& dirty_keys = _dirty_accounts[address];
+            for (auto& [key, value] : delta.storage) {
+                account.storage.insert_or_assign(key, std::move(value));
+                dirty_keys.push_back(key);
+            }
+
+            updated_set.insert(address);
         }
         for (auto& deleted_account_address : commit._deleted_accounts) {
+            if (view_layer) {
+                _keepRemovedForViews(*view_layer, deleted_account_address);
+            }
             _states.erase(deleted_account_address);
+            _dirty_accounts[deleted_account_address];
             updated_set.insert(deleted_account_address);
         }
+        for (auto& [address, credit] : commit._credits) {
+            if (view_layer) {
+                _keepForViews(*view_layer, address);
+            }
+            if (!_hasAccount(address)) {
+                ASSERT(_createClientAccount(address));
+            }
+            _getAccount(address).balance += credit;
+            _dirty_accounts[address];
+            updated_set.insert(address);
+        }
     }
 
     for (auto& updated_account : updated_set) {
@@ -376,80 +1169,212 @@ void StateManager::applyCommit(Commit&& commit)
 }
 
 
-void StateManager::addTxHash(const lk::Address& address, const base::Sha256& tx_hash)
+void StateManager::applyBlockEmission(const lk::Address& address, const lk::Balance& value)
 {
-    std::shared_lock lk(_rw_mutex);
+    std::unique_lock lk(_rw_mutex);
+    if (auto view_layer = _lockViewLayer(); view_layer) {
+        _keepForViews(*view_layer, address);
+    }
     if (!_hasAccount(address)) {
         ASSERT(_createClientAccount(address));
     }
     auto& account = _getAccount(address);
-    ASSERT(account.type == AccountType::CLIENT);
+    account.balance += value;
+    _dirty_accounts[address];
 
-    account.transactions.emplace_back(std::move(tx_hash));
-    ++(account.nonce);
+    _event_account_update.notify(address);
 }
 
 
-void StateManager::applyBlockEmission(const lk::Address& address, const lk::Balance& value)
+bool StateManager::hasAccount(const lk::Address& address) const
 {
-    std::unique_lock lk(_rw_mutex);
-    if (!_hasAccount(address)) {
-        ASSERT(_createClientAccount(address));
+    std::shared_lock lk(_rw_mutex);
+    return _hasAccount(address);
+}
+
+
+AccountInfo StateManager::getAccountInfo(const lk::Address& account_address) const
+{
+    std::shared_lock lk(_rw_mutex);
+    if (!_hasAccount(account_address)) {
+        return AccountInfo{ AccountType::CLIENT, lk::Address::null(), {}, {}, {}, {} };
     }
-    auto& account = _getAccount(address);
-    account.balance += value;
+    const auto& account = _getAccount(account_address);
+    return AccountInfo{ account.type, account_address, account.balance, account.nonce, account.transactions_count, {} };
+}
 
-    _event_account_update.notify(address);
+
+lk::Balance StateManager::getBalance(const lk::Address& account_address) const
+{
+    std::shared_lock lk(_rw_mutex);
+    return _getBalance(account_address);
 }
 
 
-bool StateManager::payFee(const lk::Address& from, const lk::Address& to, const lk::Balance& value)
+std::vector<base::Sha256> StateManager::getTransactionsHashes(const lk::Address& account_address,
+                                                              std::uint64_t offset,
+                                                              std::size_t limit) const
 {
-    std::unique_lock lk(_rw_mutex);
-    if (!_hasAccount(from)) {
-        return false;
-    }
-    auto& from_account = _getAccount(from);
-    if (from_account.balance < value) {
-        return false;
-    }
-    if (!_hasAccount(to)) {
-        ASSERT(_createClientAccount(to));
-    }
-    auto& to_account = _getAccount(to);
+    return _transactions_history.getPage(account_address, offset, limit);
+}
 
-    from_account.balance -= value;
-    to_account.balance += value;
 
-    _event_account_update.notify(from);
-    _event_account_update.notify(to);
+base::Sha256 StateManager::updateStateRoot()
+{
+    std::unique_lock lk(_rw_mutex);
+    return _updateStateRoot();
+}
+
 
-    return true;
+void StateManager::flush(base::Database::Batch& batch)
+{
+    std::unique_lock lk(_rw_mutex);
+    _trie.flush(batch);
+    _transactions_history.flush(batch);
 }
 
 
-bool StateManager::hasAccount(const lk::Address& address) const
+base::Sha256 StateManager::getStateRoot() const
 {
     std::shared_lock lk(_rw_mutex);
-    return _hasAccount(address);
+    return _state_root;
 }
 
 
-AccountInfo StateManager::getAccountInfo(const lk::Address& account_address) const
+base::Bytes StateManager::exportState() const
 {
     std::shared_lock lk(_rw_mutex);
-    if (!_hasAccount(account_address)) {
-        return AccountInfo{ AccountType::CLIENT, lk::Address::null(), {}, {}, {} };
+    std::vector<const std::pair<const lk::Address, AccountState>*> accounts;
+    accounts.reserve(_states.size());
+    for (const auto& entry : _states) {
+        accounts.push_back(&entry);
     }
-    const auto& account = _getAccount(account_address);
-    return AccountInfo{ account.type, account_address, account.balance, account.nonce, account.transactions };
+    std::sort(accounts.begin(), accounts.end(), [](const auto* a, const auto* b) { return a->first < b->first; });
+
+    base::SerializationOArchive oa;
+    oa.serialize(static_cast<std::uint64_t>(accounts.size()));
+    for (const auto* entry : accounts) {
+        const auto& [address, account] = *entry;
+        oa.serialize(address);
+        oa.serialize(account.type);
+        oa.serialize(account.nonce);
+        oa.serialize(account.balance);
+        oa.serialize(account.code_hash);
+        oa.serialize(account.runtime_code->getBytes());
+        oa.serialize(account.transactions_count);
+
+        std::vector<const std::pair<const StorageKey, StorageData>*> slots;
+        slots.reserve(account.storage.size());
+        for (const auto& slot : account.storage) {
+            slots.push_back(&slot);
+        }
+        std::sort(slots.begin(), slots.end(), [](const auto* a, const auto* b) { return a->first < b->first; });
+        oa.serialize(static_cast<std::uint64_t>(slots.size()));
+        for (const auto* slot : slots) {
+            oa.serialize(slot->first);
+            oa.serialize(slot->second.data);
+        }
+    }
+    return std::move(oa).getBytes();
 }
 
 
-lk::Balance StateManager::getBalance(const lk::Address& account_address) const
+bool StateManager::importState(const base::Bytes& state, const base::Sha256& expected_root)
 {
-    std::shared_lock lk(_rw_mutex);
-    return _getBalance(account_address);
+    AddressMap<AccountState> states;
+    AddressMap<std::vector<StorageKey>> dirty_accounts;
+    try {
+        base::SerializationIArchive ia(state);
+        auto accounts_count = ia.deserialize<std::uint64_t>();
+        for (std::uint64_t i = 0; i < accounts_count; ++i) {
+            auto address = ia.deserialize<lk::Address>();
+            AccountState account{ ia.deserialize<AccountType>() };
+            account.nonce = ia.deserialize<std::uint64_t>();
+            account.balance = ia.deserialize<lk::Balance>();
+            account.code_hash = ia.deserialize<base::Sha256>();
+            account.runtime_code = _code_store.add(ia.deserialize<base::Bytes>());
+            account.transactions_count = ia.deserialize<std::uint64_t>();
+
+            auto& storage_keys = dirty_accounts[address];
+            auto slots_count = ia.deserialize<std::uint64_t>();
+            for (std::uint64_t j = 0; j < slots_count; ++j) {
+                auto key = ia.deserialize<StorageKey>();
+                StorageData value;
+                value.data = ia.deserialize<StorageValue>();
+                storage_keys.push_back(key);
+                account.storage.insert_or_assign(std::move(key), std::move(value));
+            }
+            states.insert_or_assign(std::move(address), std::move(account));
+        }
+    }
+    catch (const std::exception& e) {
+        LOG_WARNING << "Failed to deserialize imported state: " << e.what();
+        return false;
+    }
+
+    std::set<lk::Address> updated_set;
+    {
+        std::unique_lock lk(_rw_mutex);
+        // accounts, which are removed by the import, must leave the trie as well
+        for (const auto& [address, account] : _states) {
+            dirty_accounts[address];
+        }
+        for (const auto& [address, keys] : dirty_accounts) {
+            updated_set.insert(address);
+        }
+
+        std::swap(_states, states);
+        std::swap(_dirty_accounts, dirty_accounts);
+        auto previous_root = _state_root;
+        _state_root = MerkleTrie::emptyRoot();
+        if (_updateStateRoot() != expected_root) {
+            std::swap(_states, states);
+            std::swap(_dirty_accounts, dirty_accounts);
+            _state_root = previous_root;
+            LOG_WARNING << "Imported state doesn't match the expected state root";
+            return false;
+        }
+        if (auto view_layer = _lockViewLayer(); view_layer) {
+            view_layer->replaced_states = std::move(states);
+        }
+    }
+
+    for (auto& updated_account : updated_set) {
+        _event_account_update.notify(updated_account);
+    }
+    return true;
+}
+
+
+base::Sha256 StateManager::_updateStateRoot()
+{
+    MerkleTrie::Changes account_changes;
+    for (const auto& [address, changed_keys] : _dirty_accounts) {
+        auto account_key = computeTrieKey(address.getBytes().toBytes());
+        auto it = _states.find(address);
+        if (it == _states.end()) {
+            account_changes.emplace_back(std::move(account_key), std::nullopt);
+            continue;
+        }
+
+        auto& account = it->second;
+        if (!changed_keys.empty()) {
+            MerkleTrie::Changes storage_changes;
+            for (const auto& key : changed_keys) {
+                std::optional<base::Sha256> value_hash;
+                if (auto value = account.storage.find(key); value != account.storage.end()) {
+                    value_hash = base::Sha256::compute(value->second.data);
+                }
+                storage_changes.emplace_back(computeTrieKey(key.toBytes()), std::move(value_hash));
+            }
+            account.storage_root = _trie.update(account.storage_root, std::move(storage_changes));
+        }
+        account_changes.emplace_back(std::move(account_key), computeAccountHash(account));
+    }
+
+    _state_root = _trie.update(_state_root, std::move(account_changes));
+    _dirty_accounts.clear();
+    return _state_root;
 }
 
 
@@ -477,6 +1402,15 @@ const AccountState& StateManager::_getAccount(const lk::Address& account_address
 }
 
 
+const AccountState* StateManager::_findAccount(const lk::Address& account_address) const
+{
+    if (auto it = _states.find(account_address); it != _states.end()) {
+        return &it->second;
+    }
+    return nullptr;
+}
+
+
 bool StateManager::_hasAccount(const lk::Address& address) const
 {
     return _states.contains(address);
@@ -502,6 +1436,51 @@ lk::Balance StateManager::_getBalance(const lk::Address& account_address) const
     return {};
 }
 
+
+std::shared_ptr<StateView::Layer> StateManager::_lockViewLayer() const
+{
+    // the layer, which has the whole state replaced by an import, already keeps everything for its views
+    if (auto layer = _newest_view_layer.lock(); layer && !layer->replaced_states) {
+        return layer;
+    }
+    return nullptr;
+}
+
+
+StateView::Layer::Account& StateManager::_keepForViews(StateView::Layer& layer, const lk::Address& address) const
+{
+    auto [kept, is_inserted] = layer.accounts.try_emplace(address);
+    if (is_inserted) {
+        if (auto account = _findAccount(address); account) {
+            kept->second.state.emplace(copyWithoutStorage(*account));
+        }
+    }
+    return kept->second;
+}
+
+
+void StateManager::_keepForViews(StateView::Layer& layer, const lk::Address& address, const StorageKey& key) const
+{
+    auto& kept = _keepForViews(layer, address);
+    if (kept.state && !kept.is_storage_whole && !kept.storage.contains(key)) {
+        const auto& storage = _getAccount(address).storage;
+        auto slot = storage.find(key);
+        kept.storage.try_emplace(key, slot != storage.end() ? std::optional{ slot->second } : std::nullopt);
+    }
+}
+
+
+void StateManager::_keepRemovedForViews(StateView::Layer& layer, const lk::Address& address) const
+{
+    auto& kept = _keepForViews(layer, address);
+    if (kept.state && !kept.is_storage_whole) {
+        for (const auto& [key, data] : _getAccount(address).storage) {
+            kept.storage.try_emplace(key, data);
+        }
+        kept.is_storage_whole = true;
+    }
+}
+
 std::size_t StateManager::subscribeToAnyAccountUpdate(decltype(_event_account_update)::CallbackType callback)
 {
     return _event_account_update.subscribe(std::move(callback));
@@ -1,12 +1,23 @@
 #pragma once
 
 #include "core/block.hpp"
+#include "core/code_store.hpp"
+#include "core/merkle_trie.hpp"
 #include "core/transaction.hpp"
+#include "core/transactions_history.hpp"
 
+#include "base/config.hpp"
+#include "base/hash_map.hpp"
 #include "base/utility.hpp"
 
 #include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <mutex>
 #include <shared_mutex>
+#include <unordered_set>
+#include <variant>
 
 namespace lk
 {
@@ -24,40 +35,82 @@ struct AccountInfo
     lk::Address address;
     lk::Balance balance;
     std::uint64_t nonce;
-    std::vector<base::Sha256> transactions_hashes;
+    std::uint64_t transactions_count;
+    std::vector<base::Sha256> transactions_hashes; // a page of the history, which was asked for
 };
 
 
+// storage slots of contracts are EVM words, keys and values alike
+using StorageKey = base::FixedBytes<32>;
+using StorageValue = base::FixedBytes<32>;
+
+
 struct StorageData
 {
     StorageData() = default;
 
-    base::Bytes data;
+    StorageValue data;
     bool was_modified{ false };
 };
 
 
+// keys of plain contract variables are small numbers, so the whole key is hashed, not its prefix
+using StorageMap = base::HashMap<StorageKey, StorageData, base::WordsHash<StorageKey>>;
+
+
+template<typename T>
+using AddressMap = base::HashMap<lk::Address, T, base::PrefixHash<lk::Address>>;
+
+
 struct AccountState
 {
     AccountType type;
     std::uint64_t nonce;
     lk::Balance balance;
     base::Sha256 code_hash;
-    std::vector<base::Sha256> transactions;
-    std::map<base::Sha256, StorageData> storage;
-    base::Bytes runtime_code;
+    base::Sha256 storage_root; // up to date only after StateManager::updateStateRoot
+    std::uint64_t transactions_count; // the hashes are kept by TransactionsHistory
+    StorageMap storage;
+    ContractCodePtr runtime_code;
     //============================
     explicit AccountState(AccountType initial_type);
     ~AccountState() = default;
 };
 
 
+// Accounts and storage slots, that were read or written by a commit. Two sets intersect, if they share an account
+// accessed as a whole, or a storage slot. Reading a storage slot always accesses its account as well.
+class AccessSet
+{
+  public:
+    void addAccount(const lk::Address& address);
+    void addStorageValue(const lk::Address& contract_address, const StorageKey& key);
+    void add(const AccessSet& other);
+    //================
+    bool intersects(const AccessSet& other) const;
+    bool isEmpty() const;
+
+  private:
+    struct AccountAccess
+    {
+        bool is_account_accessed{ false };
+        std::unordered_set<StorageKey, base::WordsHash<StorageKey>> storage_keys;
+    };
+
+    AddressMap<AccountAccess> _accounts;
+};
+
+
 class StateManager;
+class ContractStorage;
+class StateView;
 
 
 class Commit
 {
     friend StateManager;
+    friend ContractStorage;
+    friend StateView;
 
   public:
     Commit(StateManager& state_manager);
@@ -65,6 +118,18 @@ class Commit
     Commit& operator=(Commit&& another);
     ~Commit() = default;
 
+    // a commit over this one: the parent must not be changed until the child is applied or dropped
+    Commit createCommit();
+    // not allowed while the commit has savepoints
+    void applyCommit(Commit&& child);
+    //================
+    // While the commit has savepoints, its changes are journaled, so reverting to a savepoint rewinds only the changes
+    // made after it, e.g. by a nested call of a contract. A savepoint costs O(1) and a revert costs O(changes made
+    // after it). Savepoints are released or reverted in the reverse order of their creation.
+    std::size_t createSavepoint();
+    void releaseSavepoint(std::size_t savepoint);
+    void revertToSavepoint(std::size_t savepoint);
+
     bool createClientAccount(const lk::Address& address);
     lk::Address createContractAccount(const lk::Address& from_account_address, base::Sha256 associated_code_hash);
     bool hasAccount(const lk::Address& address) const;
@@ -73,40 +138,232 @@ class Commit
     AccountType getAccountType(const lk::Address& account_address) const;
     //================
     bool tryTransferMoney(const lk::Address& from, const lk::Address& to, const lk::Balance& amount);
+    // the fee is credited to the receiver without reading its balance, so fees paid to the same coinbase by different
+    // commits don't make them depend on each other
+    bool payFee(const lk::Address& from, const lk::Address& to, const lk::Balance& value);
+    void addTxHash(const lk::Address& address, const base::Sha256& tx_hash);
     //================
-    bool checkStorageValue(const lk::Address& contract_address, const base::Sha256& key) const;
-    const StorageData& getStorageValue(const lk::Address& contract_address, const base::Sha256& key) const;
-    void setStorageValue(const lk::Address& contract_address, const base::Sha256& key, base::Bytes value);
+    bool checkStorageValue(const lk::Address& contract_address, const StorageKey& key) const;
+    const StorageData& getStorageValue(const lk::Address& contract_address, const StorageKey& key) const;
+    void setStorageValue(const lk::Address& contract_address, const StorageKey& key, const StorageValue& value);
     lk::Balance getBalance(const lk::Address& account_address) const;
     std::size_t getCodeSize(const lk::Address& account_address) const;
     const base::Sha256& getCodeHash(const lk::Address& account_address) const;
-    const base::Bytes& getRuntimeCode(const lk::Address& account_address) const;
-    void setRuntimeCode(const lk::Address& contract_address, const base::Bytes& code);
+    // the code stays valid, even if the account is changed or deleted meanwhile
+    ContractCodePtr getRuntimeCode(const lk::Address& account_address) const;
+    void setRuntimeCode(const lk::Address& contract_address, base::Bytes code);
+    //================
+    // logs are rewound with the savepoints, so a reverted call drops the logs it emitted
+    void addLog(Log log);
+    // logs emitted through the commit and the applied children in the order of emission
+    std::vector<Log> takeLogs();
+    //================
+    // what was read from the StateManager through this commit and its children
+    AccessSet getReadSet() const;
+    bool hasReadAnyOf(const AccessSet& access_set) const;
+    // what will be changed in the StateManager, when the commit is applied
+    AccessSet getWriteSet() const;
 
   private:
+    // Commit is an overlay above the StateManager: it stores only the fields and storage slots
+    // that were changed, everything else is read through from the StateManager.
+    struct AccountDelta
+    {
+        bool is_created{ false }; // if set, all fields are present and nothing is read from the StateManager
+        std::optional<AccountType> type;
+        std::optional<std::uint64_t> nonce;
+        std::optional<lk::Balance> balance;
+        std::optional<base::Sha256> code_hash;
+        std::optional<ContractCodePtr> runtime_code;
+        std::vector<base::Sha256> transactions; // appended to the account transactions
+        StorageMap storage;
+        //============================
+        AccountDelta() = default;
+        AccountDelta(AccountType initial_type);
+    };
+
+    // undo records of the journal: each one keeps what was there before the change
+    struct DeltaAdded
+    {
+        lk::Address address;
+        std::optional<AccountDelta> replaced_delta;
+    };
+    struct BalanceSet
+    {
+        lk::Address address;
+        std::optional<lk::Balance> balance;
+        std::optional<lk::Balance> credit;
+    };
+    struct CreditAdded
+    {
+        lk::Address address;
+        std::optional<lk::Balance> credit;
+    };
+    struct TxHashAdded
+    {
+        lk::Address address;
+        std::optional<std::uint64_t> nonce;
+    };
+    struct StorageSet
+    {
+        lk::Address address;
+        StorageKey key;
+        std::optional<StorageData> data;
+    };
+    struct RuntimeCodeSet
+    {
+        lk::Address address;
+        std::optional<ContractCodePtr> runtime_code;
+    };
+    struct DeletionSet
+    {
+        lk::Address address;
+        bool is_deleted;
+    };
+    struct LogAdded
+    {};
+    using JournalEntry = std::variant<DeltaAdded,
+                                      BalanceSet,
+                                      CreditAdded,
+                                      TxHashAdded,
+                                      StorageSet,
+                                      RuntimeCodeSet,
+                                      DeletionSet,
+                                      LogAdded>;
+
+    Commit(StateManager& state_manager, Commit* parent);
+    explicit Commit(const StateView& view);
+
     StateManager& _state_manager;
-    std::map<lk::Address, AccountState> _changed_states;
+    Commit* _parent{ nullptr }; // if set, everything not changed by the commit is read from the parent
+    const StateView* _view{ nullptr }; // if set, the commit reads from the view instead of the StateManager
+    AddressMap<AccountDelta> _changed_states;
+    AddressMap<lk::Balance> _credits; // added to balances on application
     std::set<lk::Address> _deleted_accounts;
+    std::vector<Log> _logs;
+    std::vector<JournalEntry> _journal; // kept only while there are savepoints
+    std::size_t _savepoints_count{ 0 };
     mutable std::shared_mutex _rw_mutex;
 
-    AccountState& _getAccount(const lk::Address& account_address);
-    const AccountState& _getAccount(const lk::Address& account_address) const;
-    const AccountState& _getAccountAnywhere(const lk::Address& account_address) const;
+    mutable AccessSet _read_set;
+    mutable std::mutex _read_set_mutex;
+
+    const AccountDelta* _findDelta(const lk::Address& account_address) const;
+    const AccountState* _findRootAccount(const lk::Address& account_address) const;
+    const AccountState& _getRootAccount(const lk::Address& account_address) const;
+    AccountDelta& _getDelta(const lk::Address& account_address);
+    bool _isJournaled() const noexcept;
+    void _journalStorageValue(const lk::Address& contract_address,
+                              const StorageKey& key,
+                              std::optional<StorageData> previous_data);
+    void _undo(JournalEntry& entry);
+    const StorageData* _findStorageValue(const lk::Address& contract_address, const StorageKey& key) const;
+    void _checkContractAccount(const lk::Address& contract_address) const;
+    AccountType _getAccountType(const lk::Address& account_address) const;
+    std::uint64_t _getNonce(const lk::Address& account_address) const;
+    lk::Balance _getBalance(const lk::Address& account_address) const;
+    void _setBalance(const lk::Address& account_address, lk::Balance balance);
+    const base::Sha256& _getCodeHash(const lk::Address& account_address) const;
+    const ContractCodePtr& _getRuntimeCode(const lk::Address& account_address) const;
     bool _hasAccountThis(const lk::Address& address) const;
     bool _hasAccountRoot(const lk::Address& address) const;
     bool _hasAccountAnywhere(const lk::Address& address) const;
-    bool _copyLocalIfNotExists(const lk::Address& address);
     bool _createClientAccount(const lk::Address& address);
+    bool _tryTransferMoney(const lk::Address& from, const lk::Address& to, const lk::Balance& amount);
+};
+
+
+// Storage of a contract for a single execution: the account is checked once, and every slot is cached after the
+// first access, so reading or writing it again costs one lookup. No locks are taken, so the commit must not be used
+// by other threads meanwhile, and the cache must be reset after the storage is changed past it or the commit is
+// reverted to a savepoint.
+class ContractStorage
+{
+  public:
+    ContractStorage(Commit& commit, const lk::Address& contract_address);
+    ContractStorage(const ContractStorage&) = delete;
+    ContractStorage& operator=(const ContractStorage&) = delete;
+    ~ContractStorage() = default;
+    //================
+    const lk::Address& getAddress() const noexcept;
+    // nullptr, if the slot has never been written
+    const StorageValue* find(const StorageKey& key);
+    // returns the previous value; a zero word is not written to a slot, which has never been written
+    std::optional<StorageValue> set(const StorageKey& key, const StorageValue& value);
+    bool isCached(const StorageKey& key) const;
+    void reset();
+
+  private:
+    struct Slot
+    {
+        std::optional<StorageValue> value;
+        StorageData* written{ nullptr }; // the slot in the commit, once it's written through this object
+    };
+
+    Commit& _commit;
+    lk::Address _address;
+    Commit::AccountDelta* _delta{ nullptr };
+    base::HashMap<StorageKey, Slot, base::WordsHash<StorageKey>> _slots;
+
+    Slot& _getSlot(const StorageKey& key);
+};
+
+
+// Read-only state as it was when the view was taken, e.g. for calls of contracts made through RPC, while blocks
+// keep being applied. Like a commit, the view holds the lock of the StateManager only for a single lookup: before an
+// account or a storage slot is changed, the StateManager keeps its previous value for the views taken earlier.
+// The accounts and slots, which were read, are copied into the view. State roots of accounts are not kept.
+class StateView
+{
+    friend StateManager;
+    friend Commit;
+
+  public:
+    StateView(const StateView&) = delete;
+    StateView& operator=(const StateView&) = delete;
+    ~StateView() = default;
+    //================
+    // changes of the commit can't be applied anywhere, they are dropped with it
+    Commit createCommit() const;
+
+  private:
+    // values changed in the StateManager after the layer was created, as they were before the first change
+    struct Layer
+    {
+        struct Account
+        {
+            std::optional<AccountState> state; // without storage; not set if there was no account
+            bool is_storage_whole{ false }; // the account was removed, so all its slots are kept
+            base::HashMap<StorageKey, std::optional<StorageData>, base::WordsHash<StorageKey>> storage;
+        };
+
+        AddressMap<Account> accounts;
+        std::optional<AddressMap<AccountState>> replaced_states; // the whole state, which was replaced by an import
+        std::shared_ptr<Layer> next; // created for the views taken later
+    };
+
+    StateView(StateManager& state_manager, std::shared_ptr<Layer> layer);
+
+    StateManager& _state_manager;
+    std::shared_ptr<Layer> _layer; // the value of the view is in the first layer, that has it, or in the state
+    mutable std::mutex _accounts_mutex;
+    mutable AddressMap<std::optional<AccountState>> _accounts; // read accounts with read storage slots
+
+    std::optional<AccountState>& _getAccount(const lk::Address& account_address) const;
+    const AccountState* _findAccount(const lk::Address& account_address) const;
+    const StorageData* _findStorageValue(const lk::Address& contract_address, const StorageKey& key) const;
 };
 
 
 class StateManager
 {
     friend Commit;
+    friend StateView;
 
   public:
     //================
-    StateManager() = default;
+    StateManager(); // state trie nodes are kept only in memory
+    explicit StateManager(base::Database& database);
     StateManager(const StateManager&) = delete;
     StateManager(StateManager&& other) = delete;
     StateManager& operator=(const StateManager&) = delete;
@@ -116,30 +373,65 @@ class StateManager
     bool checkTransaction(const lk::Transaction& tx) const;
     bool checkTransactionsSet(const lk::TransactionsSet& tx) const;
     void updateFromGenesis(const ImmutableBlock& block);
+    // only this number of the latest transactions hashes is kept for an account, 0 means no limit;
+    // the hashes are not part of the state root, so nodes may keep histories of different lengths
+    void setTransactionsHistoryLimit(std::size_t limit);
     //================
     Commit createCommit();
     void applyCommit(Commit&& commit);
+    StateView createView();
     //================
-    void addTxHash(const lk::Address& address, const base::Sha256& tx_hash);
     void applyBlockEmission(const lk::Address& address, const lk::Balance& value);
-    bool payFee(const lk::Address& from, const lk::Address& to, const lk::Balance& value);
     //================
     bool hasAccount(const lk::Address& address) const;
     AccountInfo getAccountInfo(const lk::Address& account_address) const;
     lk::Balance getBalance(const lk::Address& account_address) const;
+    // hashes of transactions sent by the account with sequence numbers from the offset
+    std::vector<base::Sha256> getTransactionsHashes(const lk::Address& account_address,
+                                                    std::uint64_t offset,
+                                                    std::size_t limit) const;
+    //================
+    // recomputes the state root, walking only through accounts and storage slots changed since the previous call
+    base::Sha256 updateStateRoot();
+    base::Sha256 getStateRoot() const;
+    // nodes of the state trie and the transactions history, changed since the previous flush, are kept in memory
+    // until written with the batch
+    void flush(base::Database::Batch& batch);
+    //================
+    // accounts serialized in the order of addresses, so equal states are exported to equal bytes
+    base::Bytes exportState() const;
+    // replaces the whole state if the imported one has the expected root, otherwise leaves the state unchanged
+    bool importState(const base::Bytes& state, const base::Sha256& expected_root);
 
   private:
     //================
-    std::map<lk::Address, AccountState> _states;
+    AddressMap<AccountState> _states;
     mutable std::shared_mutex _rw_mutex;
+    CodeStore _code_store{ base::config::VM_CODE_STORE_SIZE };
+    std::weak_ptr<StateView::Layer> _newest_view_layer;
+    std::size_t _transactions_history_limit{ 0 };
+    //================
+    MerkleTrie _trie;
+    TransactionsHistory _transactions_history;
+    base::Sha256 _state_root;
+    AddressMap<std::vector<StorageKey>> _dirty_accounts; // changed accounts with their changed storage keys
+
+    base::Sha256 _updateStateRoot();
     //================
     base::Observable<lk::Address> _event_account_update;
 
     AccountState& _getAccount(const lk::Address& account_address);
     const AccountState& _getAccount(const lk::Address& account_address) const;
+    const AccountState* _findAccount(const lk::Address& account_address) const;
     bool _hasAccount(const lk::Address& address) const;
     bool _createClientAccount(const lk::Address& address);
     lk::Balance _getBalance(const lk::Address& account_address) const;
+    //================
+    // the layer, where the values about to be changed must be kept for views, or nullptr if there are no views
+    std::shared_ptr<StateView::Layer> _lockViewLayer() const;
+    StateView::Layer::Account& _keepForViews(StateView::Layer& layer, const lk::Address& address) const;
+    void _keepForViews(StateView::Layer& layer, const lk::Address& address, const StorageKey& key) const;
+    void _keepRemovedForViews(StateView::Layer& layer, const lk::Address& address) const;
 
   public:
     std::size_t subscribeToAnyAccountUpdate(decltype(_event_account_update)::CallbackType callback);
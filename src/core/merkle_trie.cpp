@@ -0,0 +1,221 @@
+#include "merkle_trie.hpp"
+
+#include "base/assert.hpp"
+#include "base/error.hpp"
+
+#include "core/database_keys.hpp"
+
+#include <algorithm>
+
+namespace
+{
+
+constexpr std::size_t KEY_BITS = base::Sha256::LENGTH * 8;
+constexpr base::Byte LEAF_NODE_TAG = 0;
+constexpr base::Byte BRANCH_NODE_TAG = 1;
+
+
+bool getBit(const base::Sha256& key, std::size_t depth)
+{
+    return (key.getBytes()[depth / 8] >> (7 - depth % 8)) & 1;
+}
+
+} // namespace
+
+
+namespace lk
+{
+
+base::Bytes MerkleTrie::Node::toBytes() const
+{
+    base::Bytes ret;
+    ret.append(is_leaf ? LEAF_NODE_TAG : BRANCH_NODE_TAG);
+    ret.append(first.getBytes().getData(), base::Sha256::LENGTH);
+    ret.append(second.getBytes().getData(), base::Sha256::LENGTH);
+    return ret;
+}
+
+
+MerkleTrie::Node MerkleTrie::Node::fromBytes(const base::Bytes& data)
+{
+    if (data.size() != 1 + 2 * base::Sha256::LENGTH) {
+        RAISE_ERROR(base::InvalidArgument, "invalid size of serialized trie node");
+    }
+    return Node{ data[0] == LEAF_NODE_TAG,
+                 base::Sha256(data.takePart(1, 1 + base::Sha256::LENGTH)),
+                 base::Sha256(data.takePart(1 + base::Sha256::LENGTH, data.size())) };
+}
+
+
+base::Sha256 MerkleTrie::Node::computeHash() const
+{
+    return base::Sha256::compute(toBytes());
+}
+
+
+MerkleTrie::MerkleTrie()
+  : _database{ nullptr }
+  , _cache{ 1 }
+{}
+
+
+MerkleTrie::MerkleTrie(base::Database& database, std::size_t cache_size)
+  : _database{ &database }
+  , _cache{ cache_size }
+{}
+
+
+const base::Sha256& MerkleTrie::emptyRoot()
+{
+    static const base::Sha256 empty_root = base::Sha256::null();
+    return empty_root;
+}
+
+
+base::Sha256 MerkleTrie::update(const base::Sha256& root, Changes changes)
+{
+    // only the last change of a key matters
+    std::stable_sort(changes.begin(), changes.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    Changes unique_changes;
+    unique_changes.reserve(changes.size());
+    for (auto& change : changes) {
+        if (!unique_changes.empty() && unique_changes.back().first == change.first) {
+            unique_changes.back() = std::move(change);
+        }
+        else {
+            unique_changes.push_back(std::move(change));
+        }
+    }
+
+    std::lock_guard lk(_nodes_mutex);
+    return _update(root, 0, unique_changes.cbegin(), unique_changes.cend());
+}
+
+
+std::optional<base::Sha256> MerkleTrie::find(const base::Sha256& root, const base::Sha256& key) const
+{
+    std::lock_guard lk(_nodes_mutex);
+    auto current = root;
+    for (std::size_t depth = 0; current != emptyRoot(); ++depth) {
+        auto node = _loadNode(current);
+        if (node.is_leaf) {
+            if (node.first == key) {
+                return node.second;
+            }
+            return std::nullopt;
+        }
+        ASSERT(depth < KEY_BITS);
+        current = getBit(key, depth) ? node.second : node.first;
+    }
+    return std::nullopt;
+}
+
+
+void MerkleTrie::flush(base::Database::Batch& batch)
+{
+    std::lock_guard lk(_nodes_mutex);
+    if (!_database) {
+        return;
+    }
+    for (auto& [hash, node] : _unflushed_nodes) {
+        batch.put(makeDatabaseKey(DataType::STATE_TRIE_NODE, hash.getBytes()), node.toBytes());
+        _cache.put(hash, node);
+    }
+    _unflushed_nodes.clear();
+}
+
+
+MerkleTrie::Node MerkleTrie::_loadNode(const base::Sha256& hash) const
+{
+    if (auto it = _unflushed_nodes.find(hash); it != _unflushed_nodes.end()) {
+        return it->second;
+    }
+    if (auto node = _cache.get(hash); node) {
+        return *node;
+    }
+    if (_database) {
+        if (auto data = _database->get(makeDatabaseKey(DataType::STATE_TRIE_NODE, hash.getBytes())); data) {
+            auto node = Node::fromBytes(*data);
+            _cache.put(hash, node);
+            return node;
+        }
+    }
+    RAISE_ERROR(base::DatabaseError, "state trie node was not found");
+}
+
+
+base::Sha256 MerkleTrie::_storeNode(Node node)
+{
+    auto hash = node.computeHash();
+    if (!_cache.contains(hash)) {
+        _unflushed_nodes.try_emplace(hash, std::move(node));
+    }
+    return hash;
+}
+
+
+base::Sha256 MerkleTrie::_makeBranch(const base::Sha256& left, const base::Sha256& right)
+{
+    // a single leaf in a subtree is lifted up to the shallowest possible level
+    if (left == emptyRoot() && right == emptyRoot()) {
+        return emptyRoot();
+    }
+    if (left == emptyRoot() && _loadNode(right).is_leaf) {
+        return right;
+    }
+    if (right == emptyRoot() && _loadNode(left).is_leaf) {
+        return left;
+    }
+    return _storeNode(Node{ false, left, right });
+}
+
+
+base::Sha256 MerkleTrie::_update(const base::Sha256& node_hash, std::size_t depth, Iterator begin, Iterator end)
+{
+    if (begin == end) {
+        return node_hash;
+    }
+    if (node_hash == emptyRoot()) {
+        return _build(depth, begin, end);
+    }
+
+    auto node = _loadNode(node_hash);
+    if (node.is_leaf) {
+        // existing leaf goes down together with the changes, unless it is changed itself
+        Changes merged(begin, end);
+        auto it = std::lower_bound(merged.begin(), merged.end(), node.first, [](const auto& change, const auto& key) {
+            return change.first < key;
+        });
+        if (it == merged.end() || it->first != node.first) {
+            merged.insert(it, { node.first, node.second });
+        }
+        return _build(depth, merged.cbegin(), merged.cend());
+    }
+
+    ASSERT(depth < KEY_BITS);
+    auto middle =
+      std::partition_point(begin, end, [depth](const auto& change) { return !getBit(change.first, depth); });
+    auto left = _update(node.first, depth + 1, begin, middle);
+    auto right = _update(node.second, depth + 1, middle, end);
+    return _makeBranch(left, right);
+}
+
+
+base::Sha256 MerkleTrie::_build(std::size_t depth, Iterator begin, Iterator end)
+{
+    auto values_count = std::count_if(begin, end, [](const auto& change) { return change.second.has_value(); });
+    if (values_count == 0) {
+        return emptyRoot();
+    }
+    if (values_count == 1) {
+        auto it = std::find_if(begin, end, [](const auto& change) { return change.second.has_value(); });
+        return _storeNode(Node{ true, it->first, *it->second });
+    }
+
+    ASSERT(depth < KEY_BITS);
+    auto middle =
+      std::partition_point(begin, end, [depth](const auto& change) { return !getBit(change.first, depth); });
+    return _makeBranch(_build(depth + 1, begin, middle), _build(depth + 1, middle, end));
+}
+
+} // namespace lk
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "base/config.hpp"
+#include "base/database.hpp"
+#include "base/hash.hpp"
+#include "base/hash_map.hpp"
+#include "base/lru_cache.hpp"
+
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace lk
+{
+
+// Compact sparse Merkle tree over 256-bit keys. A leaf keeps a key with a hash of its value and lies at the
+// shallowest level, where no other key shares its path, a branch keeps hashes of its two children. So the tree shape
+// depends only on the set of keys and the root hash commits to the whole content. Nodes are addressed by their
+// hashes: versions of the tree share unchanged nodes, and an update rehashes only the paths to changed keys.
+class MerkleTrie
+{
+  public:
+    // std::nullopt as a value removes the key from the tree
+    using Changes = std::vector<std::pair<base::Sha256, std::optional<base::Sha256>>>;
+    //================
+    MerkleTrie(); // nodes are kept only in memory
+    explicit MerkleTrie(base::Database& database,
+                        std::size_t cache_size = base::config::DATABASE_STATE_TRIE_CACHE_SIZE);
+    MerkleTrie(const MerkleTrie&) = delete;
+    MerkleTrie(MerkleTrie&&) = delete;
+    MerkleTrie& operator=(const MerkleTrie&) = delete;
+    MerkleTrie& operator=(MerkleTrie&&) = delete;
+    ~MerkleTrie() = default;
+    //================
+    static const base::Sha256& emptyRoot();
+    //================
+    [[nodiscard]] base::Sha256 update(const base::Sha256& root, Changes changes);
+    std::optional<base::Sha256> find(const base::Sha256& root, const base::Sha256& key) const;
+    //================
+    // moves nodes, that were created since the last flush, to the batch for the database of the trie
+    void flush(base::Database::Batch& batch);
+    //================
+  private:
+    struct Node
+    {
+        bool is_leaf;
+        base::Sha256 first;  // key of a leaf or hash of the left child of a branch
+        base::Sha256 second; // value hash of a leaf or hash of the right child of a branch
+        //================
+        base::Bytes toBytes() const;
+        static Node fromBytes(const base::Bytes& data);
+        base::Sha256 computeHash() const;
+    };
+
+    using Iterator = Changes::const_iterator;
+
+    base::Database* _database;
+    mutable std::mutex _nodes_mutex;
+    base::HashMap<base::Sha256, Node, base::PrefixHash<base::Sha256>> _unflushed_nodes;
+    mutable base::LruCache<base::Sha256, Node, base::PrefixHash<base::Sha256>> _cache;
+
+    Node _loadNode(const base::Sha256& hash) const;
+    base::Sha256 _storeNode(Node node);
+    base::Sha256 _makeBranch(const base::Sha256& left, const base::Sha256& right);
+    base::Sha256 _update(const base::Sha256& node_hash, std::size_t depth, Iterator begin, Iterator end);
+    base::Sha256 _build(std::size_t depth, Iterator begin, Iterator end);
+};
+
+} // namespace lk
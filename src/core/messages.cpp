@@ -186,6 +186,69 @@ NewBlock NewBlock::deserialize(base::SerializationIArchive& ia)
 }
 
 
+void GetSnapshotManifest::serialize(base::SerializationOArchive&) const {}
+
+
+GetSnapshotManifest GetSnapshotManifest::deserialize(base::SerializationIArchive&)
+{
+    return GetSnapshotManifest{};
+}
+
+
+void SnapshotManifest::serialize(base::SerializationOArchive& oa) const
+{
+    oa.serialize(manifest);
+}
+
+
+SnapshotManifest SnapshotManifest::deserialize(base::SerializationIArchive& ia)
+{
+    auto manifest = ia.deserialize<lk::SnapshotManifest>();
+    return SnapshotManifest{ std::move(manifest) };
+}
+
+
+void GetSnapshotChunk::serialize(base::SerializationOArchive& oa) const
+{
+    oa.serialize(chunk_hash);
+}
+
+
+GetSnapshotChunk GetSnapshotChunk::deserialize(base::SerializationIArchive& ia)
+{
+    auto chunk_hash = ia.deserialize<base::Sha256>();
+    return GetSnapshotChunk{ std::move(chunk_hash) };
+}
+
+
+void SnapshotChunk::serialize(base::SerializationOArchive& oa) const
+{
+    oa.serialize(chunk_hash);
+    oa.serialize(chunk);
+}
+
+
+SnapshotChunk SnapshotChunk::deserialize(base::SerializationIArchive& ia)
+{
+    auto chunk_hash = ia.deserialize<base::Sha256>();
+    auto chunk = ia.deserialize<base::Bytes>();
+    return SnapshotChunk{ std::move(chunk_hash), std::move(chunk) };
+}
+
+
+void SnapshotNotFound::serialize(base::SerializationOArchive& oa) const
+{
+    oa.serialize(chunk_hash);
+}
+
+
+SnapshotNotFound SnapshotNotFound::deserialize(base::SerializationIArchive& ia)
+{
+    auto chunk_hash = ia.deserialize<base::Sha256>();
+    return SnapshotNotFound{ std::move(chunk_hash) };
+}
+
+
 void Close::serialize(base::SerializationOArchive&) const {}
 
 
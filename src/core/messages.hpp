@@ -3,6 +3,7 @@
 #include "base/utility.hpp"
 #include "core/address.hpp"
 #include "core/block.hpp"
+#include "core/snapshot.hpp"
 #include "core/transaction.hpp"
 #include "net/endpoint.hpp"
 
@@ -24,6 +25,11 @@ DEFINE_ENUM_CLASS_WITH_STRING_CONVERSIONS(Type, std::uint8_t,
   (BLOCK)
   (BLOCK_NOT_FOUND)
   (NEW_BLOCK)
+  (GET_SNAPSHOT_MANIFEST)
+  (SNAPSHOT_MANIFEST)
+  (GET_SNAPSHOT_CHUNK)
+  (SNAPSHOT_CHUNK)
+  (SNAPSHOT_NOT_FOUND)
   (CLOSE)
   (DEBUG_MAX)
 )
@@ -181,6 +187,60 @@ struct NewBlock
 };
 
 
+struct GetSnapshotManifest
+{
+    static constexpr Type TYPE_ID = Type::GET_SNAPSHOT_MANIFEST;
+
+    void serialize(base::SerializationOArchive& oa) const;
+    static GetSnapshotManifest deserialize(base::SerializationIArchive& ia);
+};
+
+
+struct SnapshotManifest
+{
+    static constexpr Type TYPE_ID = Type::SNAPSHOT_MANIFEST;
+
+    lk::SnapshotManifest manifest;
+
+    void serialize(base::SerializationOArchive& oa) const;
+    static SnapshotManifest deserialize(base::SerializationIArchive& ia);
+};
+
+
+struct GetSnapshotChunk
+{
+    static constexpr Type TYPE_ID = Type::GET_SNAPSHOT_CHUNK;
+
+    base::Sha256 chunk_hash;
+
+    void serialize(base::SerializationOArchive& oa) const;
+    static GetSnapshotChunk deserialize(base::SerializationIArchive& ia);
+};
+
+
+struct SnapshotChunk
+{
+    static constexpr Type TYPE_ID = Type::SNAPSHOT_CHUNK;
+
+    base::Sha256 chunk_hash;
+    base::Bytes chunk;
+
+    void serialize(base::SerializationOArchive& oa) const;
+    static SnapshotChunk deserialize(base::SerializationIArchive& ia);
+};
+
+
+struct SnapshotNotFound
+{
+    static constexpr Type TYPE_ID = Type::SNAPSHOT_NOT_FOUND;
+
+    base::Sha256 chunk_hash; // null hash if the manifest was requested
+
+    void serialize(base::SerializationOArchive& oa) const;
+    static SnapshotNotFound deserialize(base::SerializationIArchive& ia);
+};
+
+
 struct Close
 {
     static constexpr Type TYPE_ID = Type::CLOSE;
@@ -0,0 +1,98 @@
+#include "parallel_executor.hpp"
+
+#include "base/log.hpp"
+
+#include <boost/asio/post.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+namespace lk
+{
+
+ParallelExecutor::ParallelExecutor(std::size_t threads_count)
+  : _threads_count{ std::max<std::size_t>(threads_count, 1) }
+{
+    if (_threads_count > 1) {
+        _pool.emplace(_threads_count - 1);
+    }
+}
+
+
+std::size_t ParallelExecutor::execute(StateManager& state_manager,
+                                      std::size_t tasks_count,
+                                      const ExecuteFunction& execute_task,
+                                      const ApplyFunction& on_applied)
+{
+    if (!_pool || tasks_count < 2) {
+        for (std::size_t i = 0; i < tasks_count; ++i) {
+            auto commit = state_manager.createCommit();
+            execute_task(i, commit);
+            state_manager.applyCommit(std::move(commit));
+            on_applied(i);
+        }
+        return 0;
+    }
+
+    // the state is not changed until every task is executed speculatively
+    std::vector<std::optional<Commit>> commits(tasks_count);
+    std::atomic<std::size_t> next_task{ 0 };
+    auto run_tasks = [&] {
+        for (auto i = next_task++; i < tasks_count; i = next_task++) {
+            try {
+                auto commit = state_manager.createCommit();
+                execute_task(i, commit);
+                commits[i].emplace(std::move(commit));
+            }
+            catch (const std::exception& e) {
+                // the task will be executed once more in order, where the error is not swallowed
+                LOG_DEBUG << "Speculative execution of task #" << i << " failed: " << e.what();
+            }
+        }
+    };
+
+    std::size_t workers_left = std::min(_threads_count, tasks_count) - 1;
+    std::mutex workers_mutex;
+    std::condition_variable workers_done;
+    for (std::size_t i = workers_left; i > 0; --i) {
+        boost::asio::post(*_pool, [&] {
+            run_tasks();
+            std::lock_guard lk(workers_mutex);
+            if (--workers_left == 0) {
+                workers_done.notify_one();
+            }
+        });
+    }
+    run_tasks();
+    {
+        std::unique_lock lk(workers_mutex);
+        workers_done.wait(lk, [&] { return workers_left == 0; });
+    }
+
+    std::size_t reexecuted_count = 0;
+    AccessSet written;
+    for (std::size_t i = 0; i < tasks_count; ++i) {
+        auto& commit = commits[i];
+        if (!commit || commit->hasReadAnyOf(written)) {
+            ++reexecuted_count;
+            commit.emplace(state_manager.createCommit());
+            execute_task(i, *commit);
+        }
+        written.add(commit->getWriteSet());
+        state_manager.applyCommit(std::move(*commit));
+        on_applied(i);
+    }
+
+    LOG_DEBUG << "Executed " << tasks_count << " tasks in parallel, " << reexecuted_count << " of them twice";
+    return reexecuted_count;
+}
+
+
+std::size_t ParallelExecutor::getThreadsCount() const noexcept
+{
+    return _threads_count;
+}
+
+} // namespace lk
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "core/managers.hpp"
+
+#include <boost/asio/thread_pool.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+
+namespace lk
+{
+
+/*
+ * Optimistic parallel execution of tasks over the state, such as transactions of a block. At first all tasks are
+ * executed concurrently against the same state, each in its own commit, which records the accounts and storage slots
+ * it has read. Then the commits are applied in the order of tasks: if a commit has read something, that was written by
+ * one of the previous tasks, the task is executed again against the actual state. So the resulting state is always
+ * the same as after a sequential execution.
+ */
+class ParallelExecutor
+{
+  public:
+    // fills the commit of a task: may be called several times for the same task and concurrently for different ones
+    using ExecuteFunction = std::function<void(std::size_t task_index, Commit& commit)>;
+    // called after the commit of a task is applied, in the order of tasks
+    using ApplyFunction = std::function<void(std::size_t task_index)>;
+    //================
+    explicit ParallelExecutor(std::size_t threads_count);
+    ParallelExecutor(const ParallelExecutor&) = delete;
+    ParallelExecutor(ParallelExecutor&&) = delete;
+    ParallelExecutor& operator=(const ParallelExecutor&) = delete;
+    ParallelExecutor& operator=(ParallelExecutor&&) = delete;
+    ~ParallelExecutor() = default;
+    //================
+    // returns the number of tasks, that were executed once more because of conflicts
+    std::size_t execute(StateManager& state_manager,
+                        std::size_t tasks_count,
+                        const ExecuteFunction& execute_task,
+                        const ApplyFunction& on_applied);
+    //================
+    std::size_t getThreadsCount() const noexcept;
+
+  private:
+    const std::size_t _threads_count;
+    std::optional<boost::asio::thread_pool> _pool; // the calling thread is a worker too, so there is no pool for one
+};
+
+} // namespace lk
@@ -36,6 +36,14 @@ namespace lk
  * of. 2) All blocks are applied sequentially. 3) When initial top-block is applied, we say that host is synchronised
  * with given peer.
  *
+ * Fast synchronisation of a new node.
+ *  1) If the node has only the genesis block and lacks more than BC_SNAPSHOT_PERIOD blocks, then, after all the
+ * blocks are received, it sends GET_SNAPSHOT_MANIFEST.
+ *  2) The manifest is accepted if the next received block after the snapshot block commits to its state root.
+ * Chunks of the snapshot are requested from all handshaked peers in parallel.
+ *  3) When all chunks are received, blocks up to the snapshot are added without execution and the state is imported
+ * from the snapshot. Otherwise (SNAPSHOT_NOT_FOUND, invalid manifest or timeout) all blocks are executed.
+ *
  *
  *  Fix: do a synchronisation during runtime.
  */
@@ -91,6 +99,19 @@ void Peer::requestBlock(const base::Sha256& block_hash)
 }
 
 
+void Peer::requestSnapshotManifest()
+{
+    PEER_LOG << "requesting snapshot manifest";
+    _requests.send(msg::GetSnapshotManifest{});
+}
+
+
+void Peer::requestSnapshotChunk(const base::Sha256& chunk_hash)
+{
+    _requests.send(msg::GetSnapshotChunk{ chunk_hash });
+}
+
+
 std::shared_ptr<Peer> Peer::accepted(std::shared_ptr<net::Session> session, Rating rating, Context context)
 {
     std::shared_ptr<Peer> peer{ new Peer(std::move(session),
@@ -345,15 +366,12 @@ bool Peer::Synchronizer::handleReceivedBlock(const base::Sha256& hash, const Imm
             return true;
         }
         else if (_peer._core.findBlock(next)) {
-            LOG_DEBUG << "Peer " << &_peer << " applying all " << _sync_blocks.size() << " sync blocks";
-            for (auto it = _sync_blocks.crbegin(); it != _sync_blocks.crend(); ++it) {
-                if (_peer._core.tryAddBlock(*it) != Blockchain::AdditionResult ::ADDED) {
-                    LOG_DEBUG << "Applying error";
-                    break;
-                }
+            if (_peer._core.getTopBlock().getDepth() == 0 && _sync_blocks.size() > base::config::BC_SNAPSHOT_PERIOD) {
+                requestSnapshot();
+            }
+            else {
+                applySyncBlocks();
             }
-            _sync_blocks.clear();
-            _sync_blocks.shrink_to_fit();
         }
         else {
             requestBlock(block.getPrevBlockHash());
@@ -387,9 +405,118 @@ bool Peer::Synchronizer::handleReceivedNewBlock(const base::Sha256& hash, const
 }
 
 
+bool Peer::Synchronizer::handleReceivedSnapshotManifest(const SnapshotManifest& manifest)
+{
+    if (!_is_snapshot_requested || _snapshot_import) {
+        _peer._rating.nonExpectedMessage();
+        return false;
+    }
+
+    // the state root of the snapshot must be committed by the block following the snapshot block
+    auto is_valid = [this, &manifest] {
+        if (manifest.depth == 0 || manifest.depth >= _sync_blocks.size() || manifest.chunk_hashes.empty()) {
+            return false;
+        }
+        const auto& snapshot_block = _sync_blocks[_sync_blocks.size() - manifest.depth];
+        const auto& next_block = _sync_blocks[_sync_blocks.size() - manifest.depth - 1];
+        return snapshot_block.getDepth() == manifest.depth && snapshot_block.getHash() == manifest.block_hash &&
+               next_block.getStateRoot() == manifest.state_root;
+    }();
+    if (!is_valid) {
+        LOG_DEBUG << "Peer " << &_peer << " sent invalid snapshot manifest";
+        _peer._rating.invalidMessage();
+        applySyncBlocks();
+        return false;
+    }
+
+    LOG_INFO << "Fetching snapshot at depth " << manifest.depth << " of " << manifest.chunk_hashes.size() << " chunks";
+    _snapshot_import = std::make_shared<SnapshotImport>(manifest);
+    _peer._host.requestSnapshotChunks(_snapshot_import, _peer.weak_from_this(), [peer_holder = _peer.weak_from_this()] {
+        if (auto peer = peer_holder.lock()) {
+            peer->_synchronizer.handleSnapshotImportComplete();
+        }
+    });
+    return true;
+}
+
+
+void Peer::Synchronizer::handleSnapshotNotFound()
+{
+    if (_is_snapshot_requested && !_snapshot_import) {
+        LOG_DEBUG << "Peer " << &_peer << " has no snapshot";
+        applySyncBlocks();
+    }
+}
+
+
 bool Peer::Synchronizer::isSynchronised() const
 {
-    return !_requested_block;
+    return !_requested_block && !_is_snapshot_requested;
+}
+
+
+void Peer::Synchronizer::requestSnapshot()
+{
+    _is_snapshot_requested = true;
+    _peer.setState(lk::Peer::State::REQUESTED_SNAPSHOT);
+    _peer.requestSnapshotManifest();
+
+    _snapshot_timer.emplace(_peer._io_context);
+    _snapshot_timer->expires_after(std::chrono::seconds(base::config::NET_SNAPSHOT_TIMEOUT));
+    _snapshot_timer->async_wait([peer_holder = _peer.weak_from_this()](const boost::system::error_code& ec) {
+        if (auto peer = peer_holder.lock(); peer && !ec) {
+            peer->_synchronizer.handleSnapshotTimeout();
+        }
+    });
+}
+
+
+void Peer::Synchronizer::handleSnapshotImportComplete()
+{
+    if (!_snapshot_import) {
+        return;
+    }
+
+    std::vector<ImmutableBlock> blocks(_sync_blocks.crbegin(), _sync_blocks.crend());
+    auto manifest = _snapshot_import->getManifest();
+    auto state = _snapshot_import->takeState();
+    LOG_DEBUG << "Peer " << &_peer << " applying " << blocks.size() << " sync blocks with snapshot";
+    if (!_peer._core.tryAddBlocksWithSnapshot(manifest, state, blocks)) {
+        LOG_WARNING << "Snapshot from " << _peer.getEndpoint() << " was not applied";
+    }
+
+    _is_snapshot_requested = false;
+    _snapshot_import.reset();
+    _snapshot_timer.reset();
+    _sync_blocks.clear();
+    _sync_blocks.shrink_to_fit();
+}
+
+
+void Peer::Synchronizer::handleSnapshotTimeout()
+{
+    if (_is_snapshot_requested) {
+        LOG_WARNING << "Snapshot was not received in time, executing all blocks";
+        applySyncBlocks();
+    }
+}
+
+
+void Peer::Synchronizer::applySyncBlocks()
+{
+    _is_snapshot_requested = false;
+    _snapshot_import.reset();
+    _snapshot_timer.reset();
+
+    LOG_DEBUG << "Peer " << &_peer << " applying all " << _sync_blocks.size() << " sync blocks";
+    for (auto it = _sync_blocks.crbegin(); it != _sync_blocks.crend(); ++it) {
+        if (_peer._core.tryAddBlock(*it) != Blockchain::AdditionResult ::ADDED) {
+            LOG_DEBUG << "Applying error";
+            break;
+        }
+    }
+    _sync_blocks.clear();
+    _sync_blocks.shrink_to_fit();
 }
 
 
@@ -459,6 +586,26 @@ void Peer::process(base::SerializationIArchive&& ia)
             handle(ia.deserialize<msg::NewBlock>());
             break;
         }
+        case msg::GetSnapshotManifest::TYPE_ID: {
+            handle(ia.deserialize<msg::GetSnapshotManifest>());
+            break;
+        }
+        case msg::SnapshotManifest::TYPE_ID: {
+            handle(ia.deserialize<msg::SnapshotManifest>());
+            break;
+        }
+        case msg::GetSnapshotChunk::TYPE_ID: {
+            handle(ia.deserialize<msg::GetSnapshotChunk>());
+            break;
+        }
+        case msg::SnapshotChunk::TYPE_ID: {
+            handle(ia.deserialize<msg::SnapshotChunk>());
+            break;
+        }
+        case msg::SnapshotNotFound::TYPE_ID: {
+            handle(ia.deserialize<msg::SnapshotNotFound>());
+            break;
+        }
         case msg::Close::TYPE_ID: {
             handle(ia.deserialize<msg::Close>());
             break;
@@ -620,6 +767,51 @@ void Peer::handle(lk::msg::NewBlock&& msg)
 }
 
 
+void Peer::handle(lk::msg::GetSnapshotManifest&&)
+{
+    if (auto manifest = _core.getSnapshotManifest()) {
+        _requests.send(msg::SnapshotManifest{ std::move(*manifest) });
+    }
+    else {
+        _requests.send(msg::SnapshotNotFound{ base::Sha256::null() });
+    }
+}
+
+
+void Peer::handle(lk::msg::SnapshotManifest&& msg)
+{
+    _synchronizer.handleReceivedSnapshotManifest(msg.manifest);
+}
+
+
+void Peer::handle(lk::msg::GetSnapshotChunk&& msg)
+{
+    if (auto chunk = _core.findSnapshotChunk(msg.chunk_hash)) {
+        _requests.send(msg::SnapshotChunk{ msg.chunk_hash, std::move(*chunk) });
+    }
+    else {
+        _requests.send(msg::SnapshotNotFound{ msg.chunk_hash });
+    }
+}
+
+
+void Peer::handle(lk::msg::SnapshotChunk&& msg)
+{
+    _host.handleSnapshotChunk(msg.chunk_hash, msg.chunk);
+}
+
+
+void Peer::handle(lk::msg::SnapshotNotFound&& msg)
+{
+    if (msg.chunk_hash != base::Sha256::null()) {
+        _host.handleSnapshotChunkNotFound(msg.chunk_hash, *this);
+    }
+    else {
+        _synchronizer.handleSnapshotNotFound();
+    }
+}
+
+
 void Peer::handle(lk::msg::Close&& msg)
 {
     detachFromPools();
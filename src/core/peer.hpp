@@ -7,6 +7,7 @@
 #include "core/block.hpp"
 #include "core/messages.hpp"
 #include "core/rating.hpp"
+#include "core/snapshot.hpp"
 #include "net/error.hpp"
 #include "net/session.hpp"
 
@@ -122,6 +123,7 @@ class Peer : public std::enable_shared_from_this<Peer>
     {
         JUST_ESTABLISHED,
         REQUESTED_BLOCKS,
+        REQUESTED_SNAPSHOT,
         SYNCHRONISED
     };
 
@@ -143,6 +145,8 @@ class Peer : public std::enable_shared_from_this<Peer>
     //=========================
     void requestLookup(const lk::Address& address, uint8_t alpha);
     void requestBlock(const base::Sha256& block_hash);
+    void requestSnapshotManifest();
+    void requestSnapshotChunk(const base::Sha256& chunk_hash);
 
     void sendBlock(const ImmutableBlock& block);
     void sendNewBlock(const ImmutableBlock& block);
@@ -199,14 +203,24 @@ class Peer : public std::enable_shared_from_this<Peer>
         void handleReceivedTopBlockHash(const base::Sha256& peers_top_block);
         bool handleReceivedBlock(const base::Sha256& hash, const ImmutableBlock& block);
         bool handleReceivedNewBlock(const base::Sha256& hash, const ImmutableBlock& block);
+        bool handleReceivedSnapshotManifest(const SnapshotManifest& manifest);
+        void handleSnapshotNotFound();
         bool isSynchronised() const;
 
       private:
         Peer& _peer;
         std::optional<base::Sha256> _requested_block;
-        std::deque<ImmutableBlock> _sync_blocks;
+        std::deque<ImmutableBlock> _sync_blocks; // from the newest to the oldest one
+
+        bool _is_snapshot_requested{ false };
+        std::shared_ptr<SnapshotImport> _snapshot_import;
+        std::optional<boost::asio::steady_timer> _snapshot_timer;
 
         void requestBlock(base::Sha256 block_hash);
+        void requestSnapshot();
+        void handleSnapshotImportComplete();
+        void handleSnapshotTimeout();
+        void applySyncBlocks();
     };
 
     Synchronizer _synchronizer{ *this };
@@ -231,6 +245,11 @@ class Peer : public std::enable_shared_from_this<Peer>
     void handle(msg::Block&& msg);
     void handle(msg::BlockNotFound&& msg);
     void handle(msg::NewBlock&& msg);
+    void handle(msg::GetSnapshotManifest&& msg);
+    void handle(msg::SnapshotManifest&& msg);
+    void handle(msg::GetSnapshotChunk&& msg);
+    void handle(msg::SnapshotChunk&& msg);
+    void handle(msg::SnapshotNotFound&& msg);
     void handle(msg::Close&& msg);
     //=========================
 };
@@ -0,0 +1,125 @@
+#include "precompiles.hpp"
+
+#include "base/assert.hpp"
+#include "base/crypto.hpp"
+#include "base/error.hpp"
+#include "base/hash.hpp"
+
+#include <algorithm>
+#include <memory>
+
+namespace
+{
+
+constexpr std::size_t WORD_SIZE = 32;
+constexpr std::size_t ADDRESS_PADDING = WORD_SIZE - lk::Address::LENGTH_IN_BYTES;
+
+
+lk::Fee getWordsCount(const base::Bytes& input)
+{
+    return (input.size() + WORD_SIZE - 1) / WORD_SIZE;
+}
+
+
+// the gas of Ethereum: a base cost and a cost of each word of the input
+lk::PrecompiledContract::GasFunction linearGas(lk::Fee base_cost, lk::Fee word_cost)
+{
+    return [base_cost, word_cost](const base::Bytes& input) { return base_cost + word_cost * getWordsCount(input); };
+}
+
+
+base::Bytes padAddress(const lk::Address& address)
+{
+    return base::Bytes(ADDRESS_PADDING) + address.getBytes().toBytes();
+}
+
+
+// the input is the hash, v (27 or 28), r and s in words, the missing bytes are zeros
+base::Bytes recoverSigner(const base::Bytes& input)
+{
+    base::Bytes words(4 * WORD_SIZE);
+    std::copy_n(input.getData(), std::min(input.size(), words.size()), words.getData());
+
+    const auto* v = words.getData() + WORD_SIZE;
+    if (std::any_of(v, v + WORD_SIZE - 1, [](base::Byte byte) { return byte != 0; }) ||
+        (v[WORD_SIZE - 1] != 27 && v[WORD_SIZE - 1] != 28)) {
+        return {};
+    }
+    base::Secp256PrivateKey::Signature signature;
+    std::copy_n(words.getData() + 2 * WORD_SIZE, 2 * WORD_SIZE, signature.getData());
+    signature[2 * WORD_SIZE] = static_cast<base::Byte>(v[WORD_SIZE - 1] - 27);
+
+    try {
+        const base::FixedBytes<base::Sha256::LENGTH> hash(words.getData(), WORD_SIZE);
+        return padAddress(lk::Address(base::Secp256PrivateKey::recoverPublicKey(signature, hash)));
+    }
+    catch (const base::CryptoError&) { // the signature is wrong, which is not an error of the call
+        return {};
+    }
+}
+
+
+base::Bytes computeSha256(const base::Bytes& input)
+{
+    return base::Sha256::compute(input).getBytes().toBytes();
+}
+
+
+base::Bytes computeRipemd160(const base::Bytes& input)
+{
+    return base::Bytes(ADDRESS_PADDING) + base::Ripemd160::compute(input).getBytes().toBytes();
+}
+
+
+base::Bytes copyInput(const base::Bytes& input)
+{
+    return input;
+}
+
+} // namespace
+
+
+namespace lk
+{
+
+lk::Address getPrecompileAddress(std::uint8_t number)
+{
+    base::FixedBytes<lk::Address::LENGTH_IN_BYTES> bytes;
+    bytes[bytes.size() - 1] = number;
+    return lk::Address(bytes);
+}
+
+
+void PrecompilesRegistry::add(std::uint8_t number, PrecompiledContract contract)
+{
+    ASSERT(number != 0);
+    ASSERT(contract.gas && contract.run);
+    _contracts[number] = std::move(contract);
+}
+
+
+const PrecompiledContract* PrecompilesRegistry::find(const lk::Address& address) const noexcept
+{
+    const auto& bytes = address.getBytes().toArray();
+    if (std::any_of(bytes.begin(), bytes.end() - 1, [](base::Byte byte) { return byte != 0; })) {
+        return nullptr;
+    }
+    const auto& contract = _contracts[bytes.back()];
+    return contract ? &*contract : nullptr;
+}
+
+
+const PrecompilesRegistry& PrecompilesRegistry::getNative()
+{
+    static const auto registry = [] {
+        auto native = std::make_unique<PrecompilesRegistry>();
+        native->add(1, { linearGas(3'000, 0), recoverSigner });
+        native->add(2, { linearGas(60, 12), computeSha256 });
+        native->add(3, { linearGas(600, 120), computeRipemd160 });
+        native->add(4, { linearGas(15, 3), copyInput });
+        return native;
+    }();
+    return *registry;
+}
+
+} // namespace lk
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "base/bytes.hpp"
+#include "core/address.hpp"
+#include "core/types.hpp"
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <optional>
+
+namespace lk
+{
+
+// A contract implemented by the node, so a call of it costs a fixed schedule of gas instead of the interpretation of
+// its bytecode. Its address is one of 0x00..01 - 0x00..ff, the same as in Ethereum.
+struct PrecompiledContract
+{
+    using GasFunction = std::function<lk::Fee(const base::Bytes& input)>;
+    // the output of a call: a failed call, e.g. with a wrong signature, has an empty output, but uses the gas anyway
+    using RunFunction = std::function<base::Bytes(const base::Bytes& input)>;
+
+    GasFunction gas;
+    RunFunction run;
+};
+
+
+lk::Address getPrecompileAddress(std::uint8_t number);
+
+
+// Precompiled contracts by their addresses, which calls are dispatched by the host instead of being passed to the VM.
+// A lookup is a check of the address prefix and an index in an array, so it's cheap for calls of other contracts.
+class PrecompilesRegistry
+{
+  public:
+    //================
+    PrecompilesRegistry() = default;
+    PrecompilesRegistry(const PrecompilesRegistry&) = delete;
+    PrecompilesRegistry(PrecompilesRegistry&&) = delete;
+    PrecompilesRegistry& operator=(const PrecompilesRegistry&) = delete;
+    PrecompilesRegistry& operator=(PrecompilesRegistry&&) = delete;
+    ~PrecompilesRegistry() = default;
+    //================
+    void add(std::uint8_t number, PrecompiledContract contract);
+    const PrecompiledContract* find(const lk::Address& address) const noexcept;
+    //================
+    // ecrecover (1), sha256 (2), ripemd160 (3) and identity (4) with the gas schedule of Ethereum; ecrecover returns
+    // the likelib address of the signer, so it's compared with the addresses of the senders of transactions
+    static const PrecompilesRegistry& getNative();
+    //================
+  private:
+    std::array<std::optional<PrecompiledContract>, 256> _contracts; // by the last bytes of the addresses
+};
+
+} // namespace lk
@@ -1,18 +1,132 @@
 #include "rating.hpp"
 
+#include "base/log.hpp"
+
 #include <algorithm>
+#include <chrono>
 
 namespace lk
 {
 
 RatingManager::RatingManager(const base::PropertyTree& config)
-  : _db{ config.get<std::string>("net.peers_db") }
+  : _db{ config.get<std::string>("net.peers_db"), base::readDatabaseOptions(config, "net.peers_db_options") }
+  , _flush_thread{ &RatingManager::flushThreadWorker, this }
 {}
 
 
+RatingManager::~RatingManager()
+{
+    {
+        std::lock_guard lk(_flush_thread_mutex);
+        _is_stopped = true;
+    }
+    _flush_thread_notifier.notify_one();
+    _flush_thread.join();
+
+    try {
+        flush();
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR << "Failed to write peer ratings: " << e.what();
+    }
+}
+
+
 Rating RatingManager::get(const net::Endpoint& ep)
 {
-    return Rating{ ep, _db };
+    return Rating{ ep, *this };
+}
+
+
+void RatingManager::flush()
+{
+    std::lock_guard flush_lk(_flush_mutex);
+
+    base::Database::Batch batch;
+    std::vector<base::Bytes> written_keys;
+    {
+        std::lock_guard lk(_ratings_mutex);
+        for (auto& [serialized_ep, entry] : _ratings) {
+            if (entry.is_changed) {
+                batch.put(serialized_ep, base::toBytes(entry.data));
+                entry.is_changed = false;
+                written_keys.push_back(serialized_ep);
+            }
+        }
+    }
+
+    try {
+        _db.write(std::move(batch));
+    }
+    catch (...) {
+        std::lock_guard lk(_ratings_mutex);
+        for (const auto& serialized_ep : written_keys) {
+            if (auto it = _ratings.find(serialized_ep); it != _ratings.end()) {
+                it->second.is_changed = true;
+            }
+        }
+        throw;
+    }
+
+    // unchanged ratings are read again on the next request of the peer
+    std::lock_guard lk(_ratings_mutex);
+    for (auto it = _ratings.begin(); it != _ratings.end() && _ratings.size() > base::config::NET_RATINGS_CACHE_SIZE;) {
+        if (it->second.is_changed) {
+            ++it;
+        }
+        else {
+            it = _ratings.erase(it);
+        }
+    }
+}
+
+
+Rating::Data RatingManager::load(const base::Bytes& serialized_ep)
+{
+    std::lock_guard lk(_ratings_mutex);
+    return findOrLoad(serialized_ep).data;
+}
+
+
+Rating::Data RatingManager::update(const base::Bytes& serialized_ep, const std::function<void(Rating::Data&)>& change)
+{
+    std::lock_guard lk(_ratings_mutex);
+    auto& entry = findOrLoad(serialized_ep);
+    change(entry.data);
+    entry.is_changed = true;
+    return entry.data;
+}
+
+
+RatingManager::Entry& RatingManager::findOrLoad(const base::Bytes& serialized_ep)
+{
+    if (auto it = _ratings.find(serialized_ep); it != _ratings.end()) {
+        return it->second;
+    }
+
+    // a peer without a stored rating has the initial one, so it isn't written until it changes
+    Entry entry{ { Rating::INITIAL_PEER_RATING, base::Time{} }, false };
+    if (auto stored = _db.get(serialized_ep)) {
+        entry.data = base::fromBytes<Rating::Data>(*stored);
+    }
+    return _ratings.emplace(serialized_ep, entry).first->second;
+}
+
+
+void RatingManager::flushThreadWorker()
+{
+    const auto period = std::chrono::seconds(base::config::NET_RATINGS_FLUSH_PERIOD);
+    std::unique_lock lk(_flush_thread_mutex);
+    while (!_flush_thread_notifier.wait_for(lk, period, [this] { return _is_stopped; })) {
+        lk.unlock();
+        try {
+            flush();
+        }
+        catch (const std::exception& e) {
+            LOG_ERROR << "Failed to write peer ratings: " << e.what();
+        }
+        lk.lock();
+    }
 }
 
 
@@ -31,19 +145,11 @@ Rating::Data Rating::Data::deserialize(base::SerializationIArchive& ia)
 }
 
 
-Rating::Rating(const net::Endpoint& ep, base::Database& db)
+Rating::Rating(const net::Endpoint& ep, RatingManager& manager)
   : _serialized_ep{ base::toBytes(ep) }
-  , _db{ db }
-{
-    if (auto ret = _db.get(_serialized_ep)) {
-        _data = base::fromBytes<Data>(*ret);
-    }
-    else {
-        _data.value = INITIAL_PEER_RATING;
-        _data.ts = base::Time{};
-        dbUpdate();
-    };
-}
+  , _manager{ manager }
+  , _data{ _manager.load(_serialized_ep) }
+{}
 
 
 Rating::Value Rating::getValue()
@@ -52,25 +158,26 @@ Rating::Value Rating::getValue()
         return _data.value;
     }
     else {
-        const auto current_time = base::Time::now();
-        static constexpr unsigned SECONDS_IN_HOUR = 3600;
-        Value hours_passed = (current_time - _data.ts).getSeconds() / SECONDS_IN_HOUR;
-        static constexpr Rating::Value RATING_VALUE_REPAIRED_EACH_HOUR = 1;
-        Value new_value =
-          std::min(int(INITIAL_PEER_RATING), _data.value + hours_passed * RATING_VALUE_REPAIRED_EACH_HOUR);
-        if (_data.value != new_value) {
-            _data.value = new_value;
-            _data.ts = current_time;
-            dbUpdate();
-        }
+        update([](Data& data) {
+            const auto current_time = base::Time::now();
+            static constexpr unsigned SECONDS_IN_HOUR = 3600;
+            Value hours_passed = (current_time - data.ts).getSeconds() / SECONDS_IN_HOUR;
+            static constexpr Rating::Value RATING_VALUE_REPAIRED_EACH_HOUR = 1;
+            Value new_value =
+              std::min(int(INITIAL_PEER_RATING), data.value + hours_passed * RATING_VALUE_REPAIRED_EACH_HOUR);
+            if (data.value != new_value) {
+                data.value = new_value;
+                data.ts = current_time;
+            }
+        });
         return _data.value;
     }
 }
 
 
-void Rating::dbUpdate()
+void Rating::update(const std::function<void(Data&)>& change)
 {
-    _db.put(_serialized_ep, base::toBytes(_data));
+    _data = _manager.update(_serialized_ep, change);
 }
 
 
@@ -88,48 +195,42 @@ Rating::operator bool() const noexcept
 
 Rating& Rating::nonExpectedMessage()
 {
-    _data.value -= 20;
-    dbUpdate();
+    update([](Data& data) { data.value -= 20; });
     return *this;
 }
 
 
 Rating& Rating::invalidMessage()
 {
-    _data.value -= 30;
-    dbUpdate();
+    update([](Data& data) { data.value -= 30; });
     return *this;
 }
 
 
 Rating& Rating::badBlock()
 {
-    _data.value -= 10;
-    dbUpdate();
+    update([](Data& data) { data.value -= 10; });
     return *this;
 }
 
 
 Rating& Rating::differentGenesis()
 {
-    _data.value -= 2 * INITIAL_PEER_RATING;
-    dbUpdate();
+    update([](Data& data) { data.value -= 2 * INITIAL_PEER_RATING; });
     return *this;
 }
 
 
 Rating& Rating::connectionRefused()
 {
-    _data.value = -INITIAL_PEER_RATING - 10;
-    dbUpdate();
+    update([](Data& data) { data.value = -INITIAL_PEER_RATING - 10; });
     return *this;
 }
 
 
 Rating& Rating::cannotAddToPool()
 {
-    _data.value -= 10;
-    dbUpdate();
+    update([](Data& data) { data.value -= 10; });
     return *this;
 }
 
@@ -8,18 +8,25 @@
 #include "base/time.hpp"
 #include "net/endpoint.hpp"
 
+#include <condition_variable>
 #include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
 #include <type_traits>
+#include <unordered_map>
 
 namespace lk
 {
 
+class RatingManager;
+
 class Rating
 {
   public:
     using Value = std::int16_t;
 
-    Rating(const net::Endpoint& ep, base::Database& db);
+    Rating(const net::Endpoint& ep, RatingManager& manager);
 
     Value getValue();
 
@@ -34,10 +41,12 @@ class Rating
     Rating& cannotAddToPool();
 
   private:
+    friend RatingManager;
+
     static constexpr Value INITIAL_PEER_RATING = 20;
 
     const base::Bytes _serialized_ep;
-    base::Database& _db;
+    RatingManager& _manager;
 
     struct Data
     {
@@ -49,19 +58,50 @@ class Rating
     };
     Data _data;
 
-    void dbUpdate();
+    // applies the change to the rating shared by all Rating objects of the peer
+    void update(const std::function<void(Data&)>& change);
 };
 
 
+// keeps the ratings in memory: a rating is read from the database on the first request of the peer,
+// and the changed ones are written by a background thread once in a while
 class RatingManager
 {
   public:
     RatingManager(const base::PropertyTree& config);
+    RatingManager(const RatingManager&) = delete;
+    RatingManager& operator=(const RatingManager&) = delete;
+    ~RatingManager(); // writes the changes, that are not written yet
 
     Rating get(const net::Endpoint& ep);
 
+    // writes all changed ratings with a single batch
+    void flush();
+
   private:
+    friend Rating;
+
+    struct Entry
+    {
+        Rating::Data data;
+        bool is_changed;
+    };
+
     base::Database _db;
+
+    std::mutex _ratings_mutex;
+    std::unordered_map<base::Bytes, Entry> _ratings;
+
+    std::mutex _flush_mutex; // the batches are written one by one, so an older one can't overwrite a newer one
+    std::mutex _flush_thread_mutex;
+    std::condition_variable _flush_thread_notifier;
+    bool _is_stopped{ false };
+    std::thread _flush_thread;
+
+    Rating::Data load(const base::Bytes& serialized_ep);
+    Rating::Data update(const base::Bytes& serialized_ep, const std::function<void(Rating::Data&)>& change);
+    Entry& findOrLoad(const base::Bytes& serialized_ep); // must be called with the ratings mutex locked
+    void flushThreadWorker();
 };
 
 }
\ No newline at end of file
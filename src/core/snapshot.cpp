@@ -0,0 +1,132 @@
+#include "snapshot.hpp"
+
+#include "base/error.hpp"
+
+namespace lk
+{
+
+void SnapshotManifest::serialize(base::SerializationOArchive& oa) const
+{
+    oa.serialize(depth);
+    oa.serialize(block_hash);
+    oa.serialize(state_root);
+    oa.serialize(chunk_hashes);
+}
+
+
+SnapshotManifest SnapshotManifest::deserialize(base::SerializationIArchive& ia)
+{
+    auto depth = ia.deserialize<BlockDepth>();
+    auto block_hash = ia.deserialize<base::Sha256>();
+    auto state_root = ia.deserialize<base::Sha256>();
+    auto chunk_hashes = ia.deserialize<std::vector<base::Sha256>>();
+    return SnapshotManifest{ depth, std::move(block_hash), std::move(state_root), std::move(chunk_hashes) };
+}
+
+
+Snapshot::Snapshot(BlockDepth depth,
+                   base::Sha256 block_hash,
+                   base::Sha256 state_root,
+                   const base::Bytes& state,
+                   std::size_t chunk_size)
+  : _manifest{ depth, std::move(block_hash), std::move(state_root), {} }
+{
+    if (chunk_size == 0) {
+        RAISE_ERROR(base::InvalidArgument, "snapshot chunk size must be positive");
+    }
+    for (std::size_t offset = 0; offset < state.size(); offset += chunk_size) {
+        auto chunk = state.takePart(offset, std::min(offset + chunk_size, state.size()));
+        _manifest.chunk_hashes.push_back(base::Sha256::compute(chunk));
+        _chunks.push_back(std::move(chunk));
+    }
+}
+
+
+const SnapshotManifest& Snapshot::getManifest() const noexcept
+{
+    return _manifest;
+}
+
+
+std::optional<base::Bytes> Snapshot::findChunk(const base::Sha256& chunk_hash) const
+{
+    for (std::size_t i = 0; i < _chunks.size(); ++i) {
+        if (_manifest.chunk_hashes[i] == chunk_hash) {
+            return _chunks[i];
+        }
+    }
+    return std::nullopt;
+}
+
+
+SnapshotImport::SnapshotImport(SnapshotManifest manifest)
+  : _manifest{ std::move(manifest) }
+  , _chunks(_manifest.chunk_hashes.size())
+  , _missing_count{ _manifest.chunk_hashes.size() }
+{}
+
+
+const SnapshotManifest& SnapshotImport::getManifest() const noexcept
+{
+    return _manifest;
+}
+
+
+bool SnapshotImport::addChunk(const base::Sha256& chunk_hash, const base::Bytes& chunk)
+{
+    if (base::Sha256::compute(chunk) != chunk_hash) {
+        return false;
+    }
+
+    std::lock_guard lk(_chunks_mutex);
+    bool is_found = false;
+    // equal chunks have equal hashes, so a received chunk fills all positions with its hash
+    for (std::size_t i = 0; i < _chunks.size(); ++i) {
+        if (_manifest.chunk_hashes[i] == chunk_hash) {
+            is_found = true;
+            if (!_chunks[i]) {
+                _chunks[i] = chunk;
+                --_missing_count;
+            }
+        }
+    }
+    return is_found;
+}
+
+
+std::vector<base::Sha256> SnapshotImport::getMissingChunks() const
+{
+    std::lock_guard lk(_chunks_mutex);
+    std::vector<base::Sha256> ret;
+    for (std::size_t i = 0; i < _chunks.size(); ++i) {
+        if (!_chunks[i]) {
+            ret.push_back(_manifest.chunk_hashes[i]);
+        }
+    }
+    return ret;
+}
+
+
+bool SnapshotImport::isComplete() const
+{
+    std::lock_guard lk(_chunks_mutex);
+    return _missing_count == 0;
+}
+
+
+base::Bytes SnapshotImport::takeState()
+{
+    std::lock_guard lk(_chunks_mutex);
+    if (_missing_count != 0) {
+        RAISE_ERROR(base::LogicError, "cannot assemble state from incomplete snapshot");
+    }
+    base::Bytes state;
+    for (auto& chunk : _chunks) {
+        state.append(*chunk);
+        chunk.reset();
+    }
+    _missing_count = _chunks.size();
+    return state;
+}
+
+} // namespace lk
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "base/bytes.hpp"
+#include "base/config.hpp"
+#include "base/hash.hpp"
+#include "base/serialization.hpp"
+#include "core/types.hpp"
+
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace lk
+{
+
+// Describes a state snapshot: the serialized state after applying the block is cut into chunks, which are fetched
+// independently and checked against their hashes. The assembled state is checked against the state root, which is
+// committed by the header of the next block.
+struct SnapshotManifest
+{
+    BlockDepth depth;
+    base::Sha256 block_hash;
+    base::Sha256 state_root;
+    std::vector<base::Sha256> chunk_hashes;
+
+    void serialize(base::SerializationOArchive& oa) const;
+    static SnapshotManifest deserialize(base::SerializationIArchive& ia);
+};
+
+
+class Snapshot
+{
+  public:
+    //=================
+    Snapshot(BlockDepth depth,
+             base::Sha256 block_hash,
+             base::Sha256 state_root,
+             const base::Bytes& state,
+             std::size_t chunk_size = base::config::NET_SNAPSHOT_CHUNK_SIZE);
+    //=================
+    const SnapshotManifest& getManifest() const noexcept;
+    std::optional<base::Bytes> findChunk(const base::Sha256& chunk_hash) const;
+    //=================
+  private:
+    SnapshotManifest _manifest;
+    std::vector<base::Bytes> _chunks;
+};
+
+
+// assembles a state from chunks, that may come from different peers in any order
+class SnapshotImport
+{
+  public:
+    //=================
+    explicit SnapshotImport(SnapshotManifest manifest);
+    //=================
+    const SnapshotManifest& getManifest() const noexcept;
+    //=================
+    // returns false if the chunk doesn't belong to the snapshot
+    bool addChunk(const base::Sha256& chunk_hash, const base::Bytes& chunk);
+    std::vector<base::Sha256> getMissingChunks() const;
+    bool isComplete() const;
+    //=================
+    // concatenates chunks back to the serialized state, can be called only once the import is complete
+    base::Bytes takeState();
+    //=================
+  private:
+    const SnapshotManifest _manifest;
+    std::vector<std::optional<base::Bytes>> _chunks;
+    std::size_t _missing_count;
+    mutable std::mutex _chunks_mutex;
+};
+
+} // namespace lk
@@ -0,0 +1,152 @@
+#include "trace.hpp"
+
+#include <algorithm>
+
+namespace lk
+{
+
+const char* ExecutionTrace::getName(HostCall call) noexcept
+{
+    switch (call) {
+        case HostCall::ACCOUNT_EXISTS:
+            return "account_exists";
+        case HostCall::GET_STORAGE:
+            return "get_storage";
+        case HostCall::SET_STORAGE:
+            return "set_storage";
+        case HostCall::GET_BALANCE:
+            return "get_balance";
+        case HostCall::GET_CODE_SIZE:
+            return "get_code_size";
+        case HostCall::GET_CODE_HASH:
+            return "get_code_hash";
+        case HostCall::COPY_CODE:
+            return "copy_code";
+        case HostCall::SELFDESTRUCT:
+            return "selfdestruct";
+        case HostCall::CALL:
+            return "call";
+        case HostCall::GET_TX_CONTEXT:
+            return "get_tx_context";
+        case HostCall::GET_BLOCK_HASH:
+            return "get_block_hash";
+        case HostCall::EMIT_LOG:
+            return "emit_log";
+    }
+    return "unknown";
+}
+
+
+void ExecutionTrace::addHostCall(HostCall call, std::chrono::nanoseconds time)
+{
+    auto& statistics = _host_calls[static_cast<std::size_t>(call)];
+    ++statistics.count;
+    statistics.time += time;
+}
+
+
+void ExecutionTrace::addFrame(Frame frame)
+{
+    _frames.push_back(std::move(frame));
+}
+
+
+void ExecutionTrace::setTime(std::chrono::nanoseconds time)
+{
+    _time = time;
+}
+
+
+const ExecutionTrace::HostCalls& ExecutionTrace::getHostCalls() const noexcept
+{
+    return _host_calls;
+}
+
+
+const std::vector<ExecutionTrace::Frame>& ExecutionTrace::getFrames() const noexcept
+{
+    return _frames;
+}
+
+
+std::chrono::nanoseconds ExecutionTrace::getTime() const noexcept
+{
+    return _time;
+}
+
+
+HostCallScope::HostCallScope(ExecutionTrace* trace, ExecutionTrace::HostCall call) noexcept
+  : _trace{ trace }
+  , _call{ call }
+{
+    if (_trace) {
+        _start = std::chrono::steady_clock::now();
+    }
+}
+
+
+HostCallScope::~HostCallScope()
+{
+    if (_trace) {
+        _trace->addHostCall(_call, std::chrono::steady_clock::now() - _start);
+    }
+}
+
+
+void ExecutionProfile::add(const ExecutionTrace& trace)
+{
+    ++_transactions_count;
+    _time += trace.getTime();
+    for (std::size_t i = 0; i < _host_calls.size(); ++i) {
+        _host_calls[i].count += trace.getHostCalls()[i].count;
+        _host_calls[i].time += trace.getHostCalls()[i].time;
+    }
+
+    // a frame ends after the frames it called, so the sums of the nested frames by depths are ready at its end
+    std::vector<lk::Fee> nested_gas;
+    std::vector<std::chrono::nanoseconds> nested_time;
+    for (const auto& frame : trace.getFrames()) {
+        if (nested_gas.size() < frame.depth + 2) {
+            nested_gas.resize(frame.depth + 2, 0);
+            nested_time.resize(frame.depth + 2, std::chrono::nanoseconds{ 0 });
+        }
+        auto& statistics = _contracts[frame.address];
+        ++statistics.calls_count;
+        statistics.gas_used += frame.gas_used - std::min(frame.gas_used, nested_gas[frame.depth + 1]);
+        statistics.time += frame.time - std::min(frame.time, nested_time[frame.depth + 1]);
+        nested_gas[frame.depth + 1] = 0;
+        nested_time[frame.depth + 1] = std::chrono::nanoseconds{ 0 };
+        nested_gas[frame.depth] += frame.gas_used;
+        nested_time[frame.depth] += frame.time;
+    }
+}
+
+
+std::uint64_t ExecutionProfile::getTransactionsCount() const noexcept
+{
+    return _transactions_count;
+}
+
+
+std::chrono::nanoseconds ExecutionProfile::getTime() const noexcept
+{
+    return _time;
+}
+
+
+const ExecutionTrace::HostCalls& ExecutionProfile::getHostCalls() const noexcept
+{
+    return _host_calls;
+}
+
+
+std::vector<std::pair<lk::Address, ExecutionProfile::ContractStatistics>> ExecutionProfile::getContracts() const
+{
+    std::vector<std::pair<lk::Address, ContractStatistics>> contracts(_contracts.begin(), _contracts.end());
+    std::stable_sort(contracts.begin(), contracts.end(), [](const auto& a, const auto& b) {
+        return a.second.time > b.second.time;
+    });
+    return contracts;
+}
+
+} // namespace lk
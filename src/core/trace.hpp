@@ -0,0 +1,120 @@
+#pragma once
+
+#include "core/address.hpp"
+#include "core/types.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace lk
+{
+
+/*
+ * Where the execution of a transaction spends its time and gas. The VM doesn't report the opcodes it executes, so the
+ * trace is what the host sees: the frames of the calls of contracts and precompiles with the gas they used, and the
+ * calls of the host made by the VM. Each call of the host is an opcode, that accesses the state or the environment,
+ * e.g. GET_STORAGE is SLOAD, SET_STORAGE is SSTORE, and CALL is any of CALL, DELEGATECALL, STATICCALL and CREATE.
+ */
+class ExecutionTrace
+{
+  public:
+    enum class HostCall : std::size_t
+    {
+        ACCOUNT_EXISTS,
+        GET_STORAGE,
+        SET_STORAGE,
+        GET_BALANCE,
+        GET_CODE_SIZE,
+        GET_CODE_HASH,
+        COPY_CODE,
+        SELFDESTRUCT,
+        CALL,
+        GET_TX_CONTEXT,
+        GET_BLOCK_HASH,
+        EMIT_LOG
+    };
+    static constexpr std::size_t HOST_CALLS_COUNT = static_cast<std::size_t>(HostCall::EMIT_LOG) + 1;
+
+    struct HostCallStatistics
+    {
+        std::uint64_t count{ 0 };
+        std::chrono::nanoseconds time{ 0 }; // a call includes the nested frames it executes
+    };
+    using HostCalls = std::array<HostCallStatistics, HOST_CALLS_COUNT>;
+
+    struct Frame
+    {
+        lk::Address address; // of the called contract or precompile
+        std::uint32_t depth;
+        lk::Fee gas_used; // with the nested frames
+        std::chrono::nanoseconds time; // with the nested frames
+        bool is_success;
+    };
+    //================
+    static const char* getName(HostCall call) noexcept;
+    //================
+    void addHostCall(HostCall call, std::chrono::nanoseconds time);
+    // frames are added, when they end, so the nested frames precede the frame, that called them
+    void addFrame(Frame frame);
+    void setTime(std::chrono::nanoseconds time);
+    //================
+    const HostCalls& getHostCalls() const noexcept;
+    const std::vector<Frame>& getFrames() const noexcept;
+    // of the whole transaction, including the checks and the payment of the fee
+    std::chrono::nanoseconds getTime() const noexcept;
+    //================
+  private:
+    HostCalls _host_calls;
+    std::vector<Frame> _frames;
+    std::chrono::nanoseconds _time{ 0 };
+};
+
+
+// Measures a call of the host, while in the scope. If the execution is not traced, it costs a check of the pointer.
+class HostCallScope
+{
+  public:
+    HostCallScope(ExecutionTrace* trace, ExecutionTrace::HostCall call) noexcept;
+    HostCallScope(const HostCallScope&) = delete;
+    HostCallScope& operator=(const HostCallScope&) = delete;
+    ~HostCallScope();
+
+  private:
+    ExecutionTrace* const _trace;
+    const ExecutionTrace::HostCall _call;
+    std::chrono::steady_clock::time_point _start;
+};
+
+
+// Traces of many transactions, e.g. of replayed blocks, summed up by the contracts to find the hot ones. The gas and
+// time of a contract are its own: a nested frame is counted for the contract, that it calls.
+class ExecutionProfile
+{
+  public:
+    struct ContractStatistics
+    {
+        std::uint64_t calls_count{ 0 };
+        lk::Fee gas_used{ 0 };
+        std::chrono::nanoseconds time{ 0 };
+    };
+    //================
+    void add(const ExecutionTrace& trace);
+    //================
+    std::uint64_t getTransactionsCount() const noexcept;
+    std::chrono::nanoseconds getTime() const noexcept;
+    const ExecutionTrace::HostCalls& getHostCalls() const noexcept;
+    // the contracts, that take the most time, go first
+    std::vector<std::pair<lk::Address, ContractStatistics>> getContracts() const;
+    //================
+  private:
+    std::uint64_t _transactions_count{ 0 };
+    std::chrono::nanoseconds _time{ 0 };
+    ExecutionTrace::HostCalls _host_calls;
+    std::map<lk::Address, ContractStatistics> _contracts;
+};
+
+} // namespace lk
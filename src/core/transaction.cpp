@@ -243,6 +243,35 @@ const Transaction& invalidTransaction()
 }
 
 
+bool Log::operator==(const Log& other) const
+{
+    return address == other.address && topics == other.topics && data == other.data;
+}
+
+
+bool Log::operator!=(const Log& other) const
+{
+    return !(*this == other);
+}
+
+
+void Log::serialize(base::SerializationOArchive& oa) const
+{
+    oa.serialize(address);
+    oa.serialize(topics);
+    oa.serialize(data);
+}
+
+
+Log Log::deserialize(base::SerializationIArchive& ia)
+{
+    auto address = ia.deserialize<lk::Address>();
+    auto topics = ia.deserialize<std::vector<LogTopic>>();
+    auto data = ia.deserialize<base::Bytes>();
+    return Log{ std::move(address), std::move(topics), std::move(data) };
+}
+
+
 TransactionStatus::TransactionStatus(StatusCode status,
                                      ActionType type,
                                      Fee fee_left,
@@ -293,4 +322,16 @@ Fee TransactionStatus::getFeeLeft() const noexcept
     return _fee_left;
 }
 
+
+const std::vector<Log>& TransactionStatus::getLogs() const noexcept
+{
+    return _logs;
+}
+
+
+std::vector<Log>& TransactionStatus::getLogs() noexcept
+{
+    return _logs;
+}
+
 } // namespace lk
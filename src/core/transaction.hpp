@@ -94,6 +94,25 @@ class TransactionBuilder
 const Transaction& invalidTransaction();
 
 
+// topics of logs are EVM words: usually the first one is the hash of the event signature
+using LogTopic = base::FixedBytes<32>;
+
+
+// an event emitted by a contract during the execution of a transaction
+struct Log
+{
+    lk::Address address; // of the contract
+    std::vector<LogTopic> topics;
+    base::Bytes data;
+
+    bool operator==(const Log& other) const;
+    bool operator!=(const Log& other) const;
+
+    void serialize(base::SerializationOArchive& oa) const;
+    static Log deserialize(base::SerializationIArchive& ia);
+};
+
+
 class TransactionStatus
 {
   public:
@@ -139,11 +158,16 @@ class TransactionStatus
 
     std::uint64_t getFeeLeft() const noexcept;
 
+    // emitted by a successful execution in the order of emission, the logs of reverted calls are dropped
+    const std::vector<Log>& getLogs() const noexcept;
+    std::vector<Log>& getLogs() noexcept;
+
   private:
     StatusCode _status;
     ActionType _action;
     std::string _message;
     Fee _fee_left;
+    std::vector<Log> _logs;
 };
 
 } // namespace lk
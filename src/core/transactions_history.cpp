@@ -0,0 +1,130 @@
+#include "transactions_history.hpp"
+
+#include "core/database_keys.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+
+base::Bytes makeAccountKey(const lk::Address& address)
+{
+    return lk::makeDatabaseKey(lk::DataType::ACCOUNT_TRANSACTION, address.getBytes().toBytes());
+}
+
+
+base::Bytes makeTransactionKey(const lk::Address& address, std::uint64_t sequence)
+{
+    return lk::makeDatabaseKey(lk::DataType::ACCOUNT_TRANSACTION, address.getBytes().toBytes(), sequence);
+}
+
+
+bool hasPrefix(const base::Bytes& key, const base::Bytes& prefix)
+{
+    return key.size() >= prefix.size() && std::memcmp(key.getData(), prefix.getData(), prefix.size()) == 0;
+}
+
+} // namespace
+
+
+namespace lk
+{
+
+TransactionsHistory::TransactionsHistory()
+  : _database{ nullptr }
+{}
+
+
+TransactionsHistory::TransactionsHistory(base::Database& database)
+  : _database{ &database }
+{}
+
+
+void TransactionsHistory::add(const lk::Address& address, std::uint64_t sequence, const base::Sha256& tx_hash)
+{
+    std::lock_guard lk(_changes_mutex);
+    _unflushed_changes.insert_or_assign(makeTransactionKey(address, sequence), tx_hash);
+}
+
+
+void TransactionsHistory::remove(const lk::Address& address, std::uint64_t sequence)
+{
+    std::lock_guard lk(_changes_mutex);
+    if (_database) {
+        _unflushed_changes.insert_or_assign(makeTransactionKey(address, sequence), std::nullopt);
+    }
+    else {
+        _unflushed_changes.erase(makeTransactionKey(address, sequence));
+    }
+}
+
+
+std::vector<base::Sha256> TransactionsHistory::getPage(const lk::Address& address,
+                                                       std::uint64_t offset,
+                                                       std::size_t limit) const
+{
+    const auto account_key = makeAccountKey(address);
+    const auto first_key = makeTransactionKey(address, offset);
+    using Entry = std::pair<base::Bytes, base::Sha256>;
+
+    std::lock_guard lk(_changes_mutex);
+    // both sources are ordered by keys: the first entries of each contain the first entries of the page
+    std::vector<Entry> unflushed_entries;
+    for (auto it = _unflushed_changes.lower_bound(first_key);
+         it != _unflushed_changes.end() && hasPrefix(it->first, account_key) && unflushed_entries.size() < limit;
+         ++it) {
+        if (it->second) {
+            unflushed_entries.emplace_back(it->first, *it->second);
+        }
+    }
+
+    std::vector<Entry> stored_entries;
+    if (_database && limit > 0) {
+        _database->scan(account_key, first_key, [&](const leveldb::Slice& key, const leveldb::Slice& value) {
+            base::Bytes entry_key(reinterpret_cast<const base::Byte*>(key.data()), key.size());
+            // the unflushed change of the entry, if any, overrides it
+            if (!_unflushed_changes.contains(entry_key)) {
+                stored_entries.emplace_back(std::move(entry_key),
+                                            base::Sha256(base::Bytes(reinterpret_cast<const base::Byte*>(value.data()),
+                                                                     value.size())));
+            }
+            return stored_entries.size() < limit;
+        });
+    }
+
+    std::vector<Entry> entries;
+    std::merge(stored_entries.begin(),
+               stored_entries.end(),
+               unflushed_entries.begin(),
+               unflushed_entries.end(),
+               std::back_inserter(entries),
+               [](const Entry& a, const Entry& b) { return a.first < b.first; });
+
+    std::vector<base::Sha256> page;
+    page.reserve(std::min(entries.size(), limit));
+    for (std::size_t i = 0; i < entries.size() && i < limit; ++i) {
+        page.push_back(std::move(entries[i].second));
+    }
+    return page;
+}
+
+
+void TransactionsHistory::flush(base::Database::Batch& batch)
+{
+    std::lock_guard lk(_changes_mutex);
+    if (!_database) {
+        return;
+    }
+    for (const auto& [key, tx_hash] : _unflushed_changes) {
+        if (tx_hash) {
+            batch.put(key, tx_hash->getBytes());
+        }
+        else {
+            batch.remove(key);
+        }
+    }
+    _unflushed_changes.clear();
+}
+
+} // namespace lk
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "base/database.hpp"
+#include "base/hash.hpp"
+#include "core/address.hpp"
+
+#include <map>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace lk
+{
+
+// Hashes of transactions sent by accounts, keyed by the account address and the sequence number of a transaction,
+// so a page of the history of an account is read with a single scan. The state keeps only the number of
+// transactions of an account. Changes are kept in memory until flushed with a batch, the same as state trie nodes.
+class TransactionsHistory
+{
+  public:
+    //================
+    TransactionsHistory(); // the history is kept only in memory
+    explicit TransactionsHistory(base::Database& database);
+    TransactionsHistory(const TransactionsHistory&) = delete;
+    TransactionsHistory(TransactionsHistory&&) = delete;
+    TransactionsHistory& operator=(const TransactionsHistory&) = delete;
+    TransactionsHistory& operator=(TransactionsHistory&&) = delete;
+    ~TransactionsHistory() = default;
+    //================
+    void add(const lk::Address& address, std::uint64_t sequence, const base::Sha256& tx_hash);
+    void remove(const lk::Address& address, std::uint64_t sequence);
+    //================
+    // hashes with sequence numbers starting from the offset in the order of sequence numbers; the sequence numbers,
+    // which were removed or are missing (e.g. sent before the state was imported), are skipped
+    std::vector<base::Sha256> getPage(const lk::Address& address, std::uint64_t offset, std::size_t limit) const;
+    //================
+    // moves changes, that were made since the last flush, to the batch for the database of the history
+    void flush(base::Database::Batch& batch);
+    //================
+  private:
+    base::Database* _database;
+    mutable std::mutex _changes_mutex;
+    // keyed by database keys, std::nullopt marks a removed entry
+    std::map<base::Bytes, std::optional<base::Sha256>> _unflushed_changes;
+};
+
+} // namespace lk
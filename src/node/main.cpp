@@ -2,6 +2,8 @@
 #include "node/node.hpp"
 #include "node/soft_config.hpp"
 
+#include "core/core.hpp"
+
 #include "base/assert.hpp"
 #include "base/config.hpp"
 #include "base/log.hpp"
@@ -18,7 +20,9 @@
 #include <cstdlib>
 #include <exception>
 #include <filesystem>
+#include <iomanip>
 #include <iostream>
+#include <limits>
 #include <thread>
 
 namespace
@@ -50,6 +54,43 @@ void atExitHandler()
     base::flushLog();
 }
 
+
+double toMilliseconds(std::chrono::nanoseconds time)
+{
+    return std::chrono::duration<double, std::milli>(time).count();
+}
+
+
+// replays the stored blocks with tracing and prints where the execution of their transactions spends time and gas
+void printProfile(const base::PropertyTree& config, lk::BlockDepth from_depth, lk::BlockDepth to_depth)
+{
+    static constexpr std::size_t CONTRACTS_PRINTED = 20;
+    base::KeyVault key_vault(config);
+    lk::Core core(config, key_vault);
+    auto profile = core.profileBlocks(from_depth, to_depth);
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "transactions: " << profile.getTransactionsCount() << ", time: " << toMilliseconds(profile.getTime())
+              << " ms" << std::endl;
+    std::cout << "host calls:" << std::endl;
+    for (std::size_t i = 0; i < lk::ExecutionTrace::HOST_CALLS_COUNT; ++i) {
+        const auto& statistics = profile.getHostCalls()[i];
+        if (statistics.count > 0) {
+            std::cout << "  " << std::setw(16) << std::left
+                      << lk::ExecutionTrace::getName(static_cast<lk::ExecutionTrace::HostCall>(i)) << std::right
+                      << " count: " << statistics.count << ", time: " << toMilliseconds(statistics.time) << " ms"
+                      << std::endl;
+        }
+    }
+    std::cout << "contracts by own time:" << std::endl;
+    auto contracts = profile.getContracts();
+    for (std::size_t i = 0; i < std::min(contracts.size(), CONTRACTS_PRINTED); ++i) {
+        const auto& [address, statistics] = contracts[i];
+        std::cout << "  " << address << " calls: " << statistics.calls_count << ", gas: " << statistics.gas_used
+                  << ", time: " << toMilliseconds(statistics.time) << " ms" << std::endl;
+    }
+}
+
 } // namespace
 
 int main(int argc, char** argv)
@@ -61,6 +102,10 @@ int main(int argc, char** argv)
         // set up options parser
         base::ProgramOptionsParser parser;
         parser.addOption<std::string>("config,c", config::CONFIG_PATH, "Path to config file");
+        parser.addOption<lk::BlockDepth>("profile_from",
+                                         "Replay the stored blocks and profile the transactions of the blocks "
+                                         "starting from the depth, then exit; the node must be stopped");
+        parser.addOption<lk::BlockDepth>("profile_to", "The last block to profile, the top block if not set");
 
         // process options
         parser.process(argc, argv);
@@ -92,6 +137,12 @@ int main(int argc, char** argv)
 
         //=====================
         SoftConfig exe_config(config_file_path);
+        if (parser.hasOption("profile_from")) {
+            auto to_depth = parser.hasOption("profile_to") ? parser.getValue<lk::BlockDepth>("profile_to")
+                                                           : std::numeric_limits<lk::BlockDepth>::max();
+            printProfile(exe_config, parser.getValue<lk::BlockDepth>("profile_from"), to_depth);
+            return base::config::EXIT_OK;
+        }
         Node node(exe_config);
         node.run();
         //=====================
@@ -191,6 +191,270 @@ void FindTransactionStatusTask::execute(PublicService& service)
     LOG_DEBUG << "Cant find transaction status task";
 }
 
+CallContractTask::CallContractTask(websocket::SessionId session_id,
+                                   websocket::QueryId query_id,
+                                   base::PropertyTree&& args)
+  : Task{ session_id, query_id, std::move(args) }
+{}
+
+
+bool CallContractTask::prepareArgs()
+{
+    if (!_args.hasKey("to") || !_args.hasKey("data")) {
+        LOG_DEBUG << "not any options exists";
+        return false;
+    }
+    auto to = websocket::deserializeAddress(_args.get<std::string>("to"));
+    auto data = websocket::deserializeBytes(_args.get<std::string>("data"));
+    auto from = _args.hasKey("from") ? websocket::deserializeAddress(_args.get<std::string>("from"))
+                                     : std::optional{ lk::Address::null() };
+    auto amount = _args.hasKey("amount") ? websocket::deserializeBalance(_args.get<std::string>("amount"))
+                                         : std::optional{ lk::Balance{ 0 } };
+    auto fee = _args.hasKey("fee") ? websocket::deserializeFee(_args.get<std::string>("fee"))
+                                   : std::optional{ lk::Fee{ base::config::RPC_CONTRACT_CALL_GAS_LIMIT } };
+    if (!to || !data || !from || !amount || !fee) {
+        LOG_DEBUG << "deserialization error";
+        return false;
+    }
+
+    lk::TransactionBuilder txb;
+    txb.setFrom(from.value());
+    txb.setTo(to.value());
+    txb.setAmount(amount.value());
+    txb.setTimestamp(base::Time::now());
+    txb.setFee(fee.value());
+    txb.setData(std::move(data.value()));
+    _tx = std::move(txb).build();
+    return true;
+}
+
+
+void CallContractTask::execute(PublicService& service)
+{
+    auto status = service._core.callContract(_tx.value());
+    base::PropertyTree answer = websocket::serializeTransactionStatus(status);
+    service.sendResponse(_session_id, _query_id, std::move(answer));
+}
+
+
+EstimateFeeTask::EstimateFeeTask(websocket::SessionId session_id,
+                                 websocket::QueryId query_id,
+                                 base::PropertyTree&& args)
+  : Task{ session_id, query_id, std::move(args) }
+{}
+
+
+bool EstimateFeeTask::prepareArgs()
+{
+    if (!_args.hasKey("from")) {
+        LOG_DEBUG << "not any options exists";
+        return false;
+    }
+    auto from = websocket::deserializeAddress(_args.get<std::string>("from"));
+    auto to = _args.hasKey("to") ? websocket::deserializeAddress(_args.get<std::string>("to"))
+                                 : std::optional{ lk::Address::null() };
+    auto amount = _args.hasKey("amount") ? websocket::deserializeBalance(_args.get<std::string>("amount"))
+                                         : std::optional{ lk::Balance{ 0 } };
+    auto fee = _args.hasKey("fee") ? websocket::deserializeFee(_args.get<std::string>("fee"))
+                                   : std::optional{ lk::Fee{ 0 } };
+    auto data = _args.hasKey("data") ? websocket::deserializeBytes(_args.get<std::string>("data"))
+                                     : std::optional{ base::Bytes{} };
+    if (!from || !to || !amount || !fee || !data) {
+        LOG_DEBUG << "deserialization error";
+        return false;
+    }
+
+    lk::TransactionBuilder txb;
+    txb.setFrom(from.value());
+    txb.setTo(to.value());
+    txb.setAmount(amount.value());
+    txb.setTimestamp(base::Time::now());
+    txb.setFee(fee.value());
+    txb.setData(std::move(data.value()));
+    _tx = std::move(txb).build();
+    return true;
+}
+
+
+void EstimateFeeTask::execute(PublicService& service)
+{
+    auto estimate = service._core.estimateFee(_tx.value());
+    base::PropertyTree answer = websocket::serializeFeeEstimate(estimate);
+    service.sendResponse(_session_id, _query_id, std::move(answer));
+}
+
+
+TraceTransactionTask::TraceTransactionTask(websocket::SessionId session_id,
+                                           websocket::QueryId query_id,
+                                           base::PropertyTree&& args)
+  : Task{ session_id, query_id, std::move(args) }
+{}
+
+
+bool TraceTransactionTask::prepareArgs()
+{
+    if (_args.hasKey("hash")) {
+        _tx_hash = websocket::deserializeHash(_args.get<std::string>("hash"));
+        if (!_tx_hash) {
+            LOG_DEBUG << "deserialization error";
+            return false;
+        }
+        return true;
+    }
+    if (!_args.hasKey("from")) {
+        LOG_DEBUG << "not any options exists";
+        return false;
+    }
+    auto from = websocket::deserializeAddress(_args.get<std::string>("from"));
+    auto to = _args.hasKey("to") ? websocket::deserializeAddress(_args.get<std::string>("to"))
+                                 : std::optional{ lk::Address::null() };
+    auto amount = _args.hasKey("amount") ? websocket::deserializeBalance(_args.get<std::string>("amount"))
+                                         : std::optional{ lk::Balance{ 0 } };
+    auto fee = _args.hasKey("fee") ? websocket::deserializeFee(_args.get<std::string>("fee"))
+                                   : std::optional{ lk::Fee{ 0 } };
+    auto data = _args.hasKey("data") ? websocket::deserializeBytes(_args.get<std::string>("data"))
+                                     : std::optional{ base::Bytes{} };
+    if (!from || !to || !amount || !fee || !data) {
+        LOG_DEBUG << "deserialization error";
+        return false;
+    }
+
+    lk::TransactionBuilder txb;
+    txb.setFrom(from.value());
+    txb.setTo(to.value());
+    txb.setAmount(amount.value());
+    txb.setTimestamp(base::Time::now());
+    txb.setFee(fee.value());
+    txb.setData(std::move(data.value()));
+    _tx = std::move(txb).build();
+    return true;
+}
+
+
+void TraceTransactionTask::execute(PublicService& service)
+{
+    if (_tx_hash) {
+        auto trace = service._core.findTransactionTrace(_tx_hash.value());
+        if (!trace) {
+            LOG_DEBUG << "Cant find transaction trace";
+            return;
+        }
+        base::PropertyTree answer;
+        answer.add("trace", websocket::serializeExecutionTrace(trace.value()));
+        service.sendResponse(_session_id, _query_id, std::move(answer));
+        return;
+    }
+    auto trace = service._core.traceTransaction(_tx.value());
+    base::PropertyTree answer = websocket::serializeTransactionTrace(trace);
+    service.sendResponse(_session_id, _query_id, std::move(answer));
+}
+
+
+LogsCallTask::LogsCallTask(websocket::SessionId session_id, websocket::QueryId query_id, base::PropertyTree&& args)
+  : Task{ session_id, query_id, std::move(args) }
+{}
+
+
+bool LogsCallTask::prepareArgs()
+{
+    if (_args.hasKey("from_depth")) {
+        _from_depth = _args.get<lk::BlockDepth>("from_depth");
+    }
+    if (_args.hasKey("to_depth")) {
+        _to_depth = _args.get<lk::BlockDepth>("to_depth");
+    }
+    if (_args.hasKey("limit")) {
+        _limit = std::min(_args.get<std::size_t>("limit"), base::config::RPC_LOGS_MAX_COUNT);
+    }
+    _filter = websocket::deserializeLogsFilter(_args);
+    if (!_filter) {
+        LOG_DEBUG << "deserialization error";
+        return false;
+    }
+    return true;
+}
+
+
+void LogsCallTask::execute(PublicService& service)
+{
+    auto to_depth = _to_depth ? *_to_depth : service._core.getTopBlock().getDepth();
+    auto logs = service._core.getLogs(_from_depth, to_depth, _filter.value(), _limit);
+    base::PropertyTree answer;
+    answer.add("logs", websocket::serializeLogRecords(logs));
+    service.sendResponse(_session_id, _query_id, std::move(answer));
+}
+
+
+LogsSubscribeTask::LogsSubscribeTask(websocket::SessionId session_id,
+                                     websocket::QueryId query_id,
+                                     base::PropertyTree&& args)
+  : Task{ session_id, query_id, std::move(args) }
+{}
+
+
+bool LogsSubscribeTask::prepareArgs()
+{
+    _filter = websocket::deserializeLogsFilter(_args);
+    if (!_filter) {
+        LOG_DEBUG << "deserialization error";
+        return false;
+    }
+    return true;
+}
+
+
+void LogsSubscribeTask::execute(PublicService& service)
+{
+    auto iter = service._logs_sessions_registry.find(_session_id);
+    if (iter != service._logs_sessions_registry.end()) {
+        return;
+    }
+
+    auto sendResponse = std::bind(
+      &PublicService::sendResponse, &service, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
+    auto sub_id = service._event_block_added.subscribe([session_id = this->_session_id,
+                                                        query_id = this->_query_id,
+                                                        sendResponse = std::move(sendResponse),
+                                                        filter = std::move(_filter.value()),
+                                                        &core = service._core](lk::ImmutableBlock block) {
+        // the logs of the block are indexed before it is announced
+        auto logs = core.getLogs(block.getDepth(), block.getDepth(), filter);
+        if (!logs.empty()) {
+            base::PropertyTree answer;
+            answer.add("logs", websocket::serializeLogRecords(logs));
+            sendResponse(session_id, query_id, std::move(answer));
+        }
+    });
+
+    service._logs_sessions_registry.insert({ _session_id, sub_id });
+}
+
+
+LogsUnsubscribeTask::LogsUnsubscribeTask(websocket::SessionId session_id,
+                                         websocket::QueryId query_id,
+                                         base::PropertyTree&& args)
+  : Task{ session_id, query_id, std::move(args) }
+{}
+
+
+bool LogsUnsubscribeTask::prepareArgs()
+{
+    return true;
+}
+
+
+void LogsUnsubscribeTask::execute(PublicService& service)
+{
+    auto iter = service._logs_sessions_registry.find(_session_id);
+    if (iter == service._logs_sessions_registry.end()) {
+        return;
+    }
+
+    service._event_block_added.unsubscribe(iter->second);
+    service._logs_sessions_registry.erase(iter);
+}
+
+
 NodeInfoCallTask::NodeInfoCallTask(websocket::SessionId session_id,
                                    websocket::QueryId query_id,
                                    base::PropertyTree&& args)
@@ -214,6 +478,26 @@ void NodeInfoCallTask::execute(PublicService& service)
 }
 
 
+DatabaseStatisticsCallTask::DatabaseStatisticsCallTask(websocket::SessionId session_id,
+                                                       websocket::QueryId query_id,
+                                                       base::PropertyTree&& args)
+  : Task{ session_id, query_id, std::move(args) }
+{}
+
+
+bool DatabaseStatisticsCallTask::prepareArgs()
+{
+    return true;
+}
+
+
+void DatabaseStatisticsCallTask::execute(PublicService& service)
+{
+    auto answer = websocket::serializeDatabaseStatistics(service._core.getDatabaseStatistics());
+    service.sendResponse(_session_id, _query_id, std::move(answer));
+}
+
+
 NodeInfoSubscribeTask::NodeInfoSubscribeTask(websocket::SessionId session_id,
                                              websocket::QueryId query_id,
                                              base::PropertyTree&& args)
@@ -288,6 +572,12 @@ bool AccountInfoCallTask::prepareArgs()
             LOG_DEBUG << "deserialization error";
             return false;
         }
+        if (_args.hasKey("offset")) {
+            _offset = _args.get<std::uint64_t>("offset");
+        }
+        if (_args.hasKey("limit")) {
+            _limit = _args.get<std::size_t>("limit");
+        }
         return true;
     }
     LOG_DEBUG << "not any options exists";
@@ -297,7 +587,7 @@ bool AccountInfoCallTask::prepareArgs()
 
 void AccountInfoCallTask::execute(PublicService& service)
 {
-    auto account_info = service._core.getAccountInfo(_address.value());
+    auto account_info = service._core.getAccountInfo(_address.value(), _offset, _limit);
     base::PropertyTree answer = websocket::serializeAccountInfo(account_info);
     service.sendResponse(_session_id, _query_id, std::move(answer));
 }
@@ -461,6 +751,9 @@ void PublicService::run()
 {
     _acceptor.run();
     _worker = std::thread(&PublicService::task_worker, this);
+    for (std::size_t i = 0; i < base::config::RPC_CONTRACT_CALL_WORKERS_COUNT; ++i) {
+        _contract_call_workers.emplace_back(&PublicService::contract_call_worker, this);
+    }
 }
 
 
@@ -469,6 +762,11 @@ void PublicService::stop()
     if (_worker.joinable()) {
         _worker.join();
     }
+    for (auto& worker : _contract_call_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
 }
 
 
@@ -485,6 +783,7 @@ void PublicService::createSession(boost::asio::ip::tcp::socket&& socket)
                 std::placeholders::_3,
                 std::placeholders::_4),
       std::bind(&PublicService::on_session_close, this, std::placeholders::_1));
+    std::unique_lock lk(_running_sessions_mutex);
     _running_sessions.insert({ current_id, std::move(session) });
 }
 
@@ -517,6 +816,23 @@ void PublicService::on_session_request(websocket::SessionId session_id,
         case websocket::Command::CALL_FIND_BLOCK:
             _input_tasks.push(std::make_unique<tasks::FindBlockTask>(session_id, query_id, std::move(args)));
             break;
+        case websocket::Command::CALL_DATABASE_STATISTICS:
+            _input_tasks.push(
+              std::make_unique<tasks::DatabaseStatisticsCallTask>(session_id, query_id, std::move(args)));
+            break;
+        case websocket::Command::CALL_CONTRACT:
+            _contract_calls.push(std::make_unique<tasks::CallContractTask>(session_id, query_id, std::move(args)));
+            break;
+        case websocket::Command::CALL_ESTIMATE_FEE:
+            _contract_calls.push(std::make_unique<tasks::EstimateFeeTask>(session_id, query_id, std::move(args)));
+            break;
+        case websocket::Command::CALL_TRACE_TRANSACTION:
+            _contract_calls.push(
+              std::make_unique<tasks::TraceTransactionTask>(session_id, query_id, std::move(args)));
+            break;
+        case websocket::Command::CALL_LOGS:
+            _contract_calls.push(std::make_unique<tasks::LogsCallTask>(session_id, query_id, std::move(args)));
+            break;
         case websocket::Command::SUBSCRIBE_PUSH_TRANSACTION:
             _input_tasks.push(std::make_unique<tasks::PushTransactionTask>(session_id, query_id, std::move(args)));
             break;
@@ -526,6 +842,9 @@ void PublicService::on_session_request(websocket::SessionId session_id,
         case websocket::Command::SUBSCRIBE_ACCOUNT_INFO:
             _input_tasks.push(std::make_unique<tasks::AccountInfoSubscribeTask>(session_id, query_id, std::move(args)));
             break;
+        case websocket::Command::SUBSCRIBE_LOGS:
+            _input_tasks.push(std::make_unique<tasks::LogsSubscribeTask>(session_id, query_id, std::move(args)));
+            break;
         case websocket::Command::UNSUBSCRIBE_PUSH_TRANSACTION:
             _input_tasks.push(
               std::make_unique<tasks::UnsubscribeTransactionStatusUpdateTask>(session_id, query_id, std::move(args)));
@@ -535,6 +854,9 @@ void PublicService::on_session_request(websocket::SessionId session_id,
             break;
         case websocket::Command::UNSUBSCRIBE_ACCOUNT_INFO:
             break;
+        case websocket::Command::UNSUBSCRIBE_LOGS:
+            _input_tasks.push(std::make_unique<tasks::LogsUnsubscribeTask>(session_id, query_id, std::move(args)));
+            break;
         default:
             // TODO fail
             break;
@@ -568,10 +890,28 @@ void PublicService::on_session_close(websocket::SessionId session_id)
 }
 
 
+[[noreturn]] void PublicService::contract_call_worker() noexcept
+{
+    while (true) {
+        auto task = _contract_calls.pop();
+        try {
+            task->run(*this);
+        }
+        catch (const base::Error& er) {
+            LOG_DEBUG << er.what();
+        }
+        catch (...) {
+            LOG_ERROR << "error at contract call execution";
+        }
+    }
+}
+
+
 void PublicService::sendResponse(websocket::SessionId session_id,
                                  websocket::QueryId query_id,
                                  base::PropertyTree&& result)
 {
+    std::shared_lock lk(_running_sessions_mutex);
     auto sess = _running_sessions.find(session_id);
     ASSERT(sess != _running_sessions.end());
     sess->second->sendResult(query_id, std::move(result));
@@ -36,6 +36,8 @@ class Queue
     void push(std::unique_ptr<Type>&& task);
     std::unique_ptr<Type> get();
     void wait();
+    // waits for a task and takes it, so the queue can be served by several workers
+    std::unique_ptr<Type> pop();
     bool empty() const;
 
   private:
@@ -119,6 +121,97 @@ class FindTransactionStatusTask final : public Task
 };
 
 
+// executes the call on the state after the top block, the call changes nothing and costs nothing
+class CallContractTask final : public Task
+{
+  public:
+    CallContractTask(websocket::SessionId session_id, websocket::QueryId query_id, base::PropertyTree&& args);
+
+  protected:
+    bool prepareArgs() override;
+    void execute(PublicService& service) override;
+
+  private:
+    std::optional<lk::Transaction> _tx;
+};
+
+
+// dry runs of the transaction, which isn't signed, on the pending state with different fees
+class EstimateFeeTask final : public Task
+{
+  public:
+    EstimateFeeTask(websocket::SessionId session_id, websocket::QueryId query_id, base::PropertyTree&& args);
+
+  protected:
+    bool prepareArgs() override;
+    void execute(PublicService& service) override;
+
+  private:
+    std::optional<lk::Transaction> _tx;
+};
+
+
+// the kept trace of a transaction of a block, found by the hash, or a traced dry run of a transaction, which isn't
+// signed, on the state after the top block
+class TraceTransactionTask final : public Task
+{
+  public:
+    TraceTransactionTask(websocket::SessionId session_id, websocket::QueryId query_id, base::PropertyTree&& args);
+
+  protected:
+    bool prepareArgs() override;
+    void execute(PublicService& service) override;
+
+  private:
+    std::optional<base::Sha256> _tx_hash;
+    std::optional<lk::Transaction> _tx;
+};
+
+
+// logs of a range of blocks, the blooms of blocks are checked before their logs are read
+class LogsCallTask final : public Task
+{
+  public:
+    LogsCallTask(websocket::SessionId session_id, websocket::QueryId query_id, base::PropertyTree&& args);
+
+  protected:
+    bool prepareArgs() override;
+    void execute(PublicService& service) override;
+
+  private:
+    lk::BlockDepth _from_depth{ 0 };
+    std::optional<lk::BlockDepth> _to_depth; // the top block, if not set
+    std::size_t _limit{ base::config::RPC_LOGS_MAX_COUNT };
+    std::optional<lk::LogsFilter> _filter;
+};
+
+
+// matching logs of every added block, a session has a single subscription for logs
+class LogsSubscribeTask final : public Task
+{
+  public:
+    LogsSubscribeTask(websocket::SessionId session_id, websocket::QueryId query_id, base::PropertyTree&& args);
+
+  protected:
+    bool prepareArgs() override;
+    void execute(PublicService& service) override;
+
+  private:
+    std::optional<lk::LogsFilter> _filter;
+};
+
+
+class LogsUnsubscribeTask final : public Task
+{
+  public:
+    LogsUnsubscribeTask(websocket::SessionId session_id, websocket::QueryId query_id, base::PropertyTree&& args);
+
+  protected:
+    bool prepareArgs() override;
+    void execute(PublicService& service) override;
+};
+
+
 class NodeInfoCallTask final : public Task
 {
   public:
@@ -130,6 +223,17 @@ class NodeInfoCallTask final : public Task
 };
 
 
+class DatabaseStatisticsCallTask final : public Task
+{
+  public:
+    DatabaseStatisticsCallTask(websocket::SessionId session_id, websocket::QueryId query_id, base::PropertyTree&& args);
+
+  protected:
+    bool prepareArgs() override;
+    void execute(PublicService& service) override;
+};
+
+
 class NodeInfoSubscribeTask final : public Task
 {
   public:
@@ -163,6 +267,9 @@ class AccountInfoCallTask final : public Task
 
   private:
     std::optional<lk::Address> _address;
+    // the page of transactions hashes
+    std::optional<std::uint64_t> _offset;
+    std::size_t _limit{ base::config::RPC_ACCOUNT_TRANSACTIONS_PAGE_SIZE };
 };
 
 
@@ -217,10 +324,17 @@ class PublicService
     friend tasks::FindTransactionTask;
     friend tasks::FindTransactionStatusTask;
     friend tasks::NodeInfoCallTask;
+    friend tasks::DatabaseStatisticsCallTask;
     friend tasks::NodeInfoSubscribeTask;
     friend tasks::NodeInfoUnsubscribeTask;
     friend tasks::AccountInfoCallTask;
     friend tasks::PushTransactionTask;
+    friend tasks::CallContractTask;
+    friend tasks::EstimateFeeTask;
+    friend tasks::TraceTransactionTask;
+    friend tasks::LogsCallTask;
+    friend tasks::LogsSubscribeTask;
+    friend tasks::LogsUnsubscribeTask;
     friend tasks::AccountInfoSubscribeTask;
     friend tasks::AccountInfoUnsubscribeTask;
     friend tasks::UnsubscribeTransactionStatusUpdateTask;
@@ -240,9 +354,14 @@ class PublicService
 
     websocket::SessionId _last_given_session_id{ 0 };
     std::unordered_map<websocket::SessionId, std::unique_ptr<websocket::WebSocketSession>> _running_sessions;
+    std::shared_mutex _running_sessions_mutex;
 
     tasks::Queue<tasks::Task> _input_tasks;
     std::thread _worker;
+    // calls of contracts, fee estimations, traces and searches of logs use nothing but the core, so they are executed
+    // concurrently
+    tasks::Queue<tasks::Task> _contract_calls;
+    std::vector<std::thread> _contract_call_workers;
 
     base::Observable<base::Sha256> _event_transaction_status_update;
     std::unordered_map<websocket::SessionId, std::unordered_map<base::Sha256, std::size_t>>
@@ -250,6 +369,7 @@ class PublicService
 
     base::Observable<const lk::ImmutableBlock&> _event_block_added;
     std::unordered_map<websocket::SessionId, std::size_t> _info_update_sessions_registry;
+    std::unordered_map<websocket::SessionId, std::size_t> _logs_sessions_registry; // also notified on added blocks
 
     base::Observable<lk::Address> _event_account_update;
     std::unordered_map<websocket::SessionId, std::unordered_map<lk::Address, std::size_t>>
@@ -265,6 +385,7 @@ class PublicService
     void on_session_close(websocket::SessionId session_id);
 
     [[noreturn]] void task_worker() noexcept;
+    [[noreturn]] void contract_call_worker() noexcept;
 
     void sendResponse(websocket::SessionId session_id, websocket::QueryId query_id, base::PropertyTree&& result);
 
@@ -33,6 +33,17 @@ void Queue<Type>::wait()
 }
 
 
+template<typename Type>
+std::unique_ptr<Type> Queue<Type>::pop()
+{
+    std::unique_lock lock(_rw_mutex);
+    _has_task.wait(lock, [this]() { return !_tasks.empty(); });
+    std::unique_ptr<Type> current_task{ std::move(_tasks.front()) };
+    _tasks.pop_front();
+    return current_task;
+}
+
+
 template<typename Type>
 bool Queue<Type>::empty() const
 {
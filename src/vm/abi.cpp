@@ -0,0 +1,1023 @@
+#include "abi.hpp"
+
+#include "base/error.hpp"
+#include "base/hash.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <optional>
+
+namespace
+{
+
+using vm::abi::Type;
+using vm::abi::Value;
+
+constexpr std::size_t WORD_SIZE = 32;
+constexpr std::size_t SELECTOR_SIZE = 4;
+
+
+std::size_t parseSize(const std::string& digits, const std::string& type_name)
+{
+    if (digits.empty() || !std::all_of(digits.begin(), digits.end(), [](char c) { return std::isdigit(c); })) {
+        RAISE_ERROR(base::InvalidArgument, "invalid ABI type " + type_name);
+    }
+    return std::stoul(digits);
+}
+
+
+// the first unparsed character is an error
+std::size_t parseIntegerBits(const std::string& digits, const std::string& type_name)
+{
+    if (digits.empty()) {
+        return 256;
+    }
+    auto bits = parseSize(digits, type_name);
+    if (bits == 0 || bits > 256 || bits % 8 != 0) {
+        RAISE_ERROR(base::InvalidArgument, "invalid ABI type " + type_name);
+    }
+    return bits;
+}
+
+
+bool isHex(std::string_view str)
+{
+    return str.size() % 2 == 0 && std::all_of(str.begin(), str.end(), [](char c) { return std::isxdigit(c); });
+}
+
+
+std::string_view removeHexPrefix(std::string_view str)
+{
+    if (str.size() >= 2 && str[0] == '0' && (str[1] == 'x' || str[1] == 'X')) {
+        str.remove_prefix(2);
+    }
+    return str;
+}
+
+
+// bytes are written in arguments as hex strings
+std::optional<base::Bytes> getBytes(const Value& value)
+{
+    if (const auto* bytes = std::get_if<base::Bytes>(&value.data)) {
+        return *bytes;
+    }
+    if (const auto* str = std::get_if<std::string>(&value.data)) {
+        if (auto hex = removeHexPrefix(*str); isHex(hex)) {
+            return base::fromHex<base::Bytes>(hex);
+        }
+    }
+    return std::nullopt;
+}
+
+
+std::optional<lk::Address> getAddress(const Value& value)
+{
+    if (const auto* address = std::get_if<lk::Address>(&value.data)) {
+        return *address;
+    }
+    if (const auto* str = std::get_if<std::string>(&value.data)) {
+        if (auto hex = removeHexPrefix(*str); hex.size() == lk::Address::LENGTH_IN_BYTES * 2 && isHex(hex)) {
+            return lk::Address(base::fromHex<base::FixedBytes<lk::Address::LENGTH_IN_BYTES>>(hex));
+        }
+    }
+    return std::nullopt;
+}
+
+
+void appendWord(base::Bytes& out, Value::Integer value)
+{
+    if (value < 0) {
+        value += Value::Integer{ 1 } << (WORD_SIZE * 8);
+    }
+    std::vector<base::Byte> bytes;
+    boost::multiprecision::export_bits(value, std::back_inserter(bytes), 8);
+    const auto position = out.size();
+    out.resize(position + WORD_SIZE);
+    std::memcpy(out.getData() + position + WORD_SIZE - bytes.size(), bytes.data(), bytes.size());
+}
+
+
+// appends the data padded with zeros to a multiple of the word size
+void appendPadded(base::Bytes& out, const base::Byte* data, std::size_t size)
+{
+    const auto position = out.size();
+    out.resize(position + (size + WORD_SIZE - 1) / WORD_SIZE * WORD_SIZE);
+    if (size > 0) {
+        std::memcpy(out.getData() + position, data, size);
+    }
+}
+
+
+void encodeValue(const Type& type, const Value& value, base::Bytes& out);
+
+
+template<typename TypeAt>
+void encodeSequence(std::size_t count, TypeAt type_at, const Value::List& values, base::Bytes& out)
+{
+    std::size_t heads_size = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        heads_size += type_at(i).getHeadSize();
+    }
+
+    // dynamic values go to tails, which are referred from heads by offsets from the start of the sequence
+    const auto heads_begin = out.size();
+    base::Bytes tails;
+    out.reserve(heads_begin + heads_size);
+    for (std::size_t i = 0; i < count; ++i) {
+        const Type& type = type_at(i);
+        if (type.isDynamic()) {
+            appendWord(out, heads_size + tails.size());
+            encodeValue(type, values[i], tails);
+        }
+        else {
+            encodeValue(type, values[i], out);
+        }
+    }
+    ASSERT(out.size() == heads_begin + heads_size);
+    out.append(tails);
+}
+
+
+// the value is expected to be checked with isConvertible already
+void encodeValue(const Type& type, const Value& value, base::Bytes& out)
+{
+    switch (type.kind) {
+        case Type::Kind::UINT:
+        case Type::Kind::INT:
+            appendWord(out, std::get<Value::Integer>(value.data));
+            break;
+        case Type::Kind::ADDRESS: {
+            const auto address = *getAddress(value);
+            out.append(base::Bytes(WORD_SIZE - lk::Address::LENGTH_IN_BYTES));
+            out.append(address.getBytes().getData(), lk::Address::LENGTH_IN_BYTES);
+            break;
+        }
+        case Type::Kind::BOOL:
+            appendWord(out, std::get<bool>(value.data) ? 1 : 0);
+            break;
+        case Type::Kind::FIXED_BYTES: {
+            const auto bytes = *getBytes(value);
+            appendPadded(out, bytes.getData(), bytes.size());
+            if (bytes.isEmpty()) {
+                out.append(base::Bytes(WORD_SIZE));
+            }
+            break;
+        }
+        case Type::Kind::BYTES: {
+            const auto bytes = *getBytes(value);
+            appendWord(out, bytes.size());
+            appendPadded(out, bytes.getData(), bytes.size());
+            break;
+        }
+        case Type::Kind::STRING: {
+            const auto& str = std::get<std::string>(value.data);
+            appendWord(out, str.size());
+            appendPadded(out, reinterpret_cast<const base::Byte*>(str.data()), str.size());
+            break;
+        }
+        case Type::Kind::ARRAY: {
+            const auto& values = std::get<Value::List>(value.data);
+            if (type.size == 0) {
+                appendWord(out, values.size());
+            }
+            const auto& element_type = type.components.front();
+            encodeSequence(
+              values.size(), [&element_type](std::size_t) -> const Type& { return element_type; }, values, out);
+            break;
+        }
+        case Type::Kind::TUPLE:
+            encodeSequence(
+              type.components.size(),
+              [&type](std::size_t i) -> const Type& { return type.components[i]; },
+              std::get<Value::List>(value.data),
+              out);
+            break;
+    }
+}
+
+
+const base::Byte* readWord(const base::Bytes& data, std::size_t position)
+{
+    if (position > data.size() || data.size() - position < WORD_SIZE) {
+        RAISE_ERROR(base::InvalidArgument, "ABI data is truncated");
+    }
+    return data.getData() + position;
+}
+
+
+Value::Integer readInteger(const base::Bytes& data, std::size_t position)
+{
+    const auto* word = readWord(data, position);
+    Value::Integer value;
+    boost::multiprecision::import_bits(value, word, word + WORD_SIZE, 8);
+    return value;
+}
+
+
+// lengths and offsets can't exceed the data, so a malformed one doesn't make a huge allocation
+std::size_t readSize(const base::Bytes& data, std::size_t position)
+{
+    auto value = readInteger(data, position);
+    if (value > data.size()) {
+        RAISE_ERROR(base::InvalidArgument, "ABI data has invalid length or offset");
+    }
+    return value.convert_to<std::size_t>();
+}
+
+
+Value decodeValue(const Type& type, const base::Bytes& data, std::size_t position);
+
+
+template<typename TypeAt>
+Value::List decodeSequence(std::size_t count, TypeAt type_at, const base::Bytes& data, std::size_t begin)
+{
+    Value::List values;
+    values.reserve(count);
+    auto head = begin;
+    for (std::size_t i = 0; i < count; ++i) {
+        const Type& type = type_at(i);
+        if (type.isDynamic()) {
+            values.push_back(decodeValue(type, data, begin + readSize(data, head)));
+            head += WORD_SIZE;
+        }
+        else {
+            values.push_back(decodeValue(type, data, head));
+            head += type.getHeadSize();
+        }
+    }
+    return values;
+}
+
+
+Value decodeValue(const Type& type, const base::Bytes& data, std::size_t position)
+{
+    switch (type.kind) {
+        case Type::Kind::UINT:
+        case Type::Kind::INT: {
+            auto value = readInteger(data, position);
+            if (type.kind == Type::Kind::INT && bit_test(value, WORD_SIZE * 8 - 1)) {
+                value -= Value::Integer{ 1 } << (WORD_SIZE * 8);
+            }
+            Value result{ std::move(value) };
+            if (!vm::abi::isConvertible(result, type)) {
+                RAISE_ERROR(base::InvalidArgument, "ABI value doesn't fit " + type.name);
+            }
+            return result;
+        }
+        case Type::Kind::ADDRESS: {
+            const auto* word = readWord(data, position);
+            return Value{ lk::Address(base::FixedBytes<lk::Address::LENGTH_IN_BYTES>(
+              word + WORD_SIZE - lk::Address::LENGTH_IN_BYTES, lk::Address::LENGTH_IN_BYTES)) };
+        }
+        case Type::Kind::BOOL: {
+            auto value = readInteger(data, position);
+            if (value > 1) {
+                RAISE_ERROR(base::InvalidArgument, "ABI value doesn't fit bool");
+            }
+            return Value{ value == 1 };
+        }
+        case Type::Kind::FIXED_BYTES:
+            return Value{ base::Bytes(readWord(data, position), type.size) };
+        case Type::Kind::BYTES:
+        case Type::Kind::STRING: {
+            const auto size = readSize(data, position);
+            if (data.size() - position - WORD_SIZE < size) {
+                RAISE_ERROR(base::InvalidArgument, "ABI data is truncated");
+            }
+            const auto* begin = data.getData() + position + WORD_SIZE;
+            if (type.kind == Type::Kind::BYTES) {
+                return Value{ base::Bytes(begin, size) };
+            }
+            return Value{ std::string(reinterpret_cast<const char*>(begin), size) };
+        }
+        case Type::Kind::ARRAY: {
+            auto count = type.size;
+            if (count == 0) {
+                count = readSize(data, position);
+                position += WORD_SIZE;
+            }
+            const auto& element_type = type.components.front();
+            return Value{ decodeSequence(
+              count, [&element_type](std::size_t) -> const Type& { return element_type; }, data, position) };
+        }
+        case Type::Kind::TUPLE:
+            return Value{ decodeSequence(
+              type.components.size(),
+              [&type](std::size_t i) -> const Type& { return type.components[i]; },
+              data,
+              position) };
+    }
+    RAISE_ERROR(base::LogicError, "unknown ABI type");
+}
+
+
+class ArgumentsParser
+{
+  public:
+    explicit ArgumentsParser(const std::string& text)
+      : _text{ text }
+    {}
+
+    std::vector<Value> parse()
+    {
+        std::vector<Value> values;
+        skipSpaces();
+        if (_position == _text.size()) {
+            return values;
+        }
+        values.push_back(parseValue());
+        while (skipSpaces(), _position < _text.size()) {
+            expect(',');
+            values.push_back(parseValue());
+        }
+        return values;
+    }
+
+  private:
+    const std::string& _text;
+    std::size_t _position{ 0 };
+
+    [[noreturn]] void fail(const std::string& message) const
+    {
+        RAISE_ERROR(base::ParsingError, message + " at position " + std::to_string(_position) + " of arguments");
+    }
+
+    void skipSpaces()
+    {
+        while (_position < _text.size() && std::isspace(static_cast<unsigned char>(_text[_position]))) {
+            ++_position;
+        }
+    }
+
+    void expect(char c)
+    {
+        skipSpaces();
+        if (_position == _text.size() || _text[_position] != c) {
+            fail(std::string("expected '") + c + "'");
+        }
+        ++_position;
+    }
+
+    Value parseValue()
+    {
+        skipSpaces();
+        if (_position == _text.size()) {
+            fail("expected a value");
+        }
+        const char c = _text[_position];
+        if (c == '[') {
+            return parseList();
+        }
+        if (c == '"') {
+            return Value{ parseString() };
+        }
+        if (c == '-' || std::isdigit(static_cast<unsigned char>(c))) {
+            return parseInteger();
+        }
+        return parseWord();
+    }
+
+    Value parseList()
+    {
+        expect('[');
+        Value::List values;
+        skipSpaces();
+        if (_position < _text.size() && _text[_position] == ']') {
+            ++_position;
+            return Value{ std::move(values) };
+        }
+        values.push_back(parseValue());
+        while (skipSpaces(), _position < _text.size() && _text[_position] == ',') {
+            ++_position;
+            values.push_back(parseValue());
+        }
+        expect(']');
+        return Value{ std::move(values) };
+    }
+
+    Value parseInteger()
+    {
+        const auto begin = _position;
+        if (_text[_position] == '-') {
+            ++_position;
+        }
+        const auto digits_begin = _position;
+        while (_position < _text.size() && std::isdigit(static_cast<unsigned char>(_text[_position]))) {
+            ++_position;
+        }
+        if (_position == digits_begin) {
+            fail("expected digits");
+        }
+        return Value{ Value::Integer{ _text.substr(begin, _position - begin) } };
+    }
+
+    std::uint32_t parseHexCodeUnit()
+    {
+        if (_text.size() - _position < 4 || !isHex(std::string_view(_text).substr(_position, 4))) {
+            fail("expected 4 hex digits");
+        }
+        auto unit = static_cast<std::uint32_t>(std::stoul(_text.substr(_position, 4), nullptr, 16));
+        _position += 4;
+        return unit;
+    }
+
+    static void appendUtf8(std::string& out, std::uint32_t code_point)
+    {
+        if (code_point < 0x80) {
+            out += static_cast<char>(code_point);
+        }
+        else if (code_point < 0x800) {
+            out += static_cast<char>(0xC0 | (code_point >> 6));
+            out += static_cast<char>(0x80 | (code_point & 0x3F));
+        }
+        else if (code_point < 0x10000) {
+            out += static_cast<char>(0xE0 | (code_point >> 12));
+            out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code_point & 0x3F));
+        }
+        else {
+            out += static_cast<char>(0xF0 | (code_point >> 18));
+            out += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code_point & 0x3F));
+        }
+    }
+
+    // the JSON string syntax
+    std::string parseString()
+    {
+        expect('"');
+        std::string str;
+        while (_position < _text.size() && _text[_position] != '"') {
+            char c = _text[_position++];
+            if (c != '\\') {
+                str += c;
+                continue;
+            }
+            if (_position == _text.size()) {
+                break;
+            }
+            switch (c = _text[_position++]) {
+                case 'b':
+                    str += '\b';
+                    break;
+                case 'f':
+                    str += '\f';
+                    break;
+                case 'n':
+                    str += '\n';
+                    break;
+                case 'r':
+                    str += '\r';
+                    break;
+                case 't':
+                    str += '\t';
+                    break;
+                case 'u': {
+                    auto code_point = parseHexCodeUnit();
+                    if (code_point >= 0xD800 && code_point < 0xDC00 && _text.compare(_position, 2, "\\u") == 0) {
+                        _position += 2;
+                        code_point = 0x10000 + ((code_point - 0xD800) << 10) + (parseHexCodeUnit() - 0xDC00);
+                    }
+                    appendUtf8(str, code_point);
+                    break;
+                }
+                default:
+                    str += c;
+            }
+        }
+        expect('"');
+        return str;
+    }
+
+    Value parseWord()
+    {
+        const auto begin = _position;
+        while (_position < _text.size() &&
+               (std::isalnum(static_cast<unsigned char>(_text[_position])) || _text[_position] == '_')) {
+            ++_position;
+        }
+        const auto word = _text.substr(begin, _position - begin);
+        if (word == "true" || word == "True") {
+            return Value{ true };
+        }
+        if (word == "false" || word == "False") {
+            return Value{ false };
+        }
+        if (word == "Address") {
+            expect('(');
+            skipSpaces();
+            const auto address_begin = _position;
+            while (_position < _text.size() && std::isalnum(static_cast<unsigned char>(_text[_position]))) {
+                ++_position;
+            }
+            const auto raw_address = base::base58Decode(_text.substr(address_begin, _position - address_begin));
+            if (raw_address.size() != lk::Address::LENGTH_IN_BYTES) {
+                fail("invalid address");
+            }
+            expect(')');
+            return Value{ lk::Address(base::FixedBytes<lk::Address::LENGTH_IN_BYTES>(raw_address)) };
+        }
+        fail("unexpected word \"" + word + "\"");
+    }
+};
+
+
+// the same as json.dumps with ensure_ascii does
+void appendJsonString(std::string& out, const std::string& str)
+{
+    static constexpr const char HEX_DIGITS[] = "0123456789abcdef";
+    auto append_code_unit = [&out](std::uint32_t unit) {
+        out += "\\u";
+        for (int shift = 12; shift >= 0; shift -= 4) {
+            out += HEX_DIGITS[(unit >> shift) & 0xF];
+        }
+    };
+
+    out += '"';
+    for (std::size_t i = 0; i < str.size();) {
+        const auto c = static_cast<unsigned char>(str[i]);
+        if (c < 0x80) {
+            switch (c) {
+                case '"':
+                    out += "\\\"";
+                    break;
+                case '\\':
+                    out += "\\\\";
+                    break;
+                case '\b':
+                    out += "\\b";
+                    break;
+                case '\f':
+                    out += "\\f";
+                    break;
+                case '\n':
+                    out += "\\n";
+                    break;
+                case '\r':
+                    out += "\\r";
+                    break;
+                case '\t':
+                    out += "\\t";
+                    break;
+                default:
+                    if (c < 0x20) {
+                        append_code_unit(c);
+                    }
+                    else {
+                        out += static_cast<char>(c);
+                    }
+            }
+            ++i;
+            continue;
+        }
+
+        // a multibyte UTF-8 sequence; an invalid one is escaped byte by byte
+        const std::size_t length = c >= 0xF0 ? 4 : c >= 0xE0 ? 3 : c >= 0xC0 ? 2 : 1;
+        std::uint32_t code_point = length == 4 ? c & 0x07 : length == 3 ? c & 0x0F : c & 0x1F;
+        bool is_valid = length > 1 && i + length <= str.size();
+        for (std::size_t j = 1; is_valid && j < length; ++j) {
+            const auto next = static_cast<unsigned char>(str[i + j]);
+            is_valid = (next & 0xC0) == 0x80;
+            code_point = (code_point << 6) | (next & 0x3F);
+        }
+        if (!is_valid) {
+            append_code_unit(c);
+            ++i;
+            continue;
+        }
+        if (code_point >= 0x10000) {
+            code_point -= 0x10000;
+            append_code_unit(0xD800 + (code_point >> 10));
+            append_code_unit(0xDC00 + (code_point & 0x3FF));
+        }
+        else {
+            append_code_unit(code_point);
+        }
+        i += length;
+    }
+    out += '"';
+}
+
+
+void appendJson(std::string& out, const Value& value)
+{
+    std::visit(
+      [&out](const auto& data) {
+          using T = std::decay_t<decltype(data)>;
+          if constexpr (std::is_same_v<T, Value::Integer>) {
+              out += data.str();
+          }
+          else if constexpr (std::is_same_v<T, bool>) {
+              out += data ? "true" : "false";
+          }
+          else if constexpr (std::is_same_v<T, lk::Address>) {
+              out += '"' + data.toString() + '"';
+          }
+          else if constexpr (std::is_same_v<T, base::Bytes>) {
+              out += '"' + base::toHex(data) + '"';
+          }
+          else if constexpr (std::is_same_v<T, std::string>) {
+              appendJsonString(out, data);
+          }
+          else {
+              out += '[';
+              for (std::size_t i = 0; i < data.size(); ++i) {
+                  if (i > 0) {
+                      out += ", ";
+                  }
+                  appendJson(out, data[i]);
+              }
+              out += ']';
+          }
+      },
+      value.data);
+}
+
+
+std::vector<vm::abi::Parameter> parseParameters(const boost::property_tree::ptree& parameters)
+{
+    std::vector<vm::abi::Parameter> result;
+    for (const auto& [key, parameter] : parameters) {
+        result.push_back({ parameter.get<std::string>("name", ""),
+                           Type::parse(parameter.get<std::string>("type"),
+                                       parameter.get_child("components", boost::property_tree::ptree{})) });
+    }
+    return result;
+}
+
+
+std::vector<Type> getTypes(const std::vector<vm::abi::Parameter>& parameters)
+{
+    std::vector<Type> types;
+    types.reserve(parameters.size());
+    for (const auto& parameter : parameters) {
+        types.push_back(parameter.type);
+    }
+    return types;
+}
+
+
+vm::abi::Function parseFunction(const boost::property_tree::ptree& entry, std::string name)
+{
+    vm::abi::Function function;
+    function.name = std::move(name);
+    function.inputs = parseParameters(entry.get_child("inputs", boost::property_tree::ptree{}));
+    function.outputs = parseParameters(entry.get_child("outputs", boost::property_tree::ptree{}));
+
+    function.signature = function.name + '(';
+    for (std::size_t i = 0; i < function.inputs.size(); ++i) {
+        function.signature += (i > 0 ? "," : "") + function.inputs[i].type.name;
+    }
+    function.signature += ')';
+    const auto hash = base::Keccak256::compute(base::Bytes(function.signature));
+    function.selector = base::FixedBytes<SELECTOR_SIZE>(hash.getBytes().getData(), SELECTOR_SIZE);
+    return function;
+}
+
+} // namespace
+
+
+namespace vm::abi
+{
+
+Type Type::parse(const std::string& type_name, const boost::property_tree::ptree& components)
+{
+    Type type;
+    if (!type_name.empty() && type_name.back() == ']') {
+        const auto bracket = type_name.rfind('[');
+        if (bracket == std::string::npos) {
+            RAISE_ERROR(base::InvalidArgument, "invalid ABI type " + type_name);
+        }
+        const auto dimension = type_name.substr(bracket + 1, type_name.size() - bracket - 2);
+        type.kind = Kind::ARRAY;
+        type.size = dimension.empty() ? 0 : parseSize(dimension, type_name);
+        if (!dimension.empty() && type.size == 0) {
+            RAISE_ERROR(base::InvalidArgument, "invalid ABI type " + type_name);
+        }
+        type.components.push_back(parse(type_name.substr(0, bracket), components));
+        type.name = type.components.front().name + '[' + dimension + ']';
+    }
+    else if (type_name == "tuple") {
+        type.kind = Kind::TUPLE;
+        type.name = "(";
+        for (const auto& [key, component] : components) {
+            type.components.push_back(
+              parse(component.get<std::string>("type"),
+                    component.get_child("components", boost::property_tree::ptree{})));
+            type.name += (type.components.size() > 1 ? "," : "") + type.components.back().name;
+        }
+        type.name += ')';
+    }
+    else if (type_name.starts_with("uint")) {
+        type.kind = Kind::UINT;
+        type.size = parseIntegerBits(type_name.substr(4), type_name);
+        type.name = "uint" + std::to_string(type.size);
+    }
+    else if (type_name.starts_with("int")) {
+        type.kind = Kind::INT;
+        type.size = parseIntegerBits(type_name.substr(3), type_name);
+        type.name = "int" + std::to_string(type.size);
+    }
+    else if (type_name == "address") {
+        type.kind = Kind::ADDRESS;
+        type.name = type_name;
+    }
+    else if (type_name == "bool") {
+        type.kind = Kind::BOOL;
+        type.name = type_name;
+    }
+    else if (type_name == "string") {
+        type.kind = Kind::STRING;
+        type.name = type_name;
+    }
+    else if (type_name == "bytes") {
+        type.kind = Kind::BYTES;
+        type.name = type_name;
+    }
+    else if (type_name.starts_with("bytes")) {
+        type.kind = Kind::FIXED_BYTES;
+        type.size = parseSize(type_name.substr(5), type_name);
+        if (type.size == 0 || type.size > WORD_SIZE) {
+            RAISE_ERROR(base::InvalidArgument, "invalid ABI type " + type_name);
+        }
+        type.name = "bytes" + std::to_string(type.size);
+    }
+    else if (type_name == "function") {
+        // an address followed by a selector
+        type.kind = Kind::FIXED_BYTES;
+        type.size = lk::Address::LENGTH_IN_BYTES + SELECTOR_SIZE;
+        type.name = type_name;
+    }
+    else {
+        RAISE_ERROR(base::InvalidArgument, "unsupported ABI type " + type_name);
+    }
+    return type;
+}
+
+
+bool Type::isDynamic() const
+{
+    switch (kind) {
+        case Kind::BYTES:
+        case Kind::STRING:
+            return true;
+        case Kind::ARRAY:
+            return size == 0 || components.front().isDynamic();
+        case Kind::TUPLE:
+            return std::any_of(components.begin(), components.end(), [](const Type& t) { return t.isDynamic(); });
+        default:
+            return false;
+    }
+}
+
+
+std::size_t Type::getHeadSize() const
+{
+    if (isDynamic()) {
+        return WORD_SIZE;
+    }
+    if (kind == Kind::ARRAY) {
+        return size * components.front().getHeadSize();
+    }
+    if (kind == Kind::TUPLE) {
+        std::size_t head_size = 0;
+        for (const auto& component : components) {
+            head_size += component.getHeadSize();
+        }
+        return head_size;
+    }
+    return WORD_SIZE;
+}
+
+
+bool Value::operator==(const Value& other) const
+{
+    return data == other.data;
+}
+
+
+bool Value::operator!=(const Value& other) const
+{
+    return !(*this == other);
+}
+
+
+bool isConvertible(const Value& value, const Type& type)
+{
+    switch (type.kind) {
+        case Type::Kind::UINT: {
+            const auto* integer = std::get_if<Value::Integer>(&value.data);
+            return integer && *integer >= 0 && *integer < (Value::Integer{ 1 } << type.size);
+        }
+        case Type::Kind::INT: {
+            const auto* integer = std::get_if<Value::Integer>(&value.data);
+            const auto bound = Value::Integer{ 1 } << (type.size - 1);
+            return integer && *integer >= -bound && *integer < bound;
+        }
+        case Type::Kind::ADDRESS:
+            return getAddress(value).has_value();
+        case Type::Kind::BOOL:
+            return std::holds_alternative<bool>(value.data);
+        case Type::Kind::FIXED_BYTES: {
+            const auto bytes = getBytes(value);
+            return bytes && bytes->size() <= type.size;
+        }
+        case Type::Kind::BYTES:
+            return getBytes(value).has_value();
+        case Type::Kind::STRING:
+            return std::holds_alternative<std::string>(value.data);
+        case Type::Kind::ARRAY: {
+            const auto* list = std::get_if<Value::List>(&value.data);
+            return list && (type.size == 0 || list->size() == type.size) &&
+                   std::all_of(list->begin(), list->end(), [&type](const Value& element) {
+                       return isConvertible(element, type.components.front());
+                   });
+        }
+        case Type::Kind::TUPLE: {
+            const auto* list = std::get_if<Value::List>(&value.data);
+            if (!list || list->size() != type.components.size()) {
+                return false;
+            }
+            for (std::size_t i = 0; i < list->size(); ++i) {
+                if (!isConvertible((*list)[i], type.components[i])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+
+base::Bytes encode(const std::vector<Type>& types, const std::vector<Value>& values)
+{
+    if (types.size() != values.size()) {
+        RAISE_ERROR(base::InvalidArgument, "number of values doesn't match number of ABI types");
+    }
+    for (std::size_t i = 0; i < types.size(); ++i) {
+        if (!isConvertible(values[i], types[i])) {
+            RAISE_ERROR(base::InvalidArgument, "value #" + std::to_string(i) + " doesn't fit " + types[i].name);
+        }
+    }
+    base::Bytes out;
+    encodeSequence(
+      types.size(), [&types](std::size_t i) -> const Type& { return types[i]; }, values, out);
+    return out;
+}
+
+
+std::vector<Value> decode(const std::vector<Type>& types, const base::Bytes& data)
+{
+    return decodeSequence(
+      types.size(), [&types](std::size_t i) -> const Type& { return types[i]; }, data, 0);
+}
+
+
+std::vector<Value> parseArguments(const std::string& arguments)
+{
+    return ArgumentsParser{ arguments }.parse();
+}
+
+
+std::string toJson(const std::vector<std::string>& names, const std::vector<Value>& values)
+{
+    ASSERT(names.size() == values.size());
+    // the same as a Python dict: a repeated name keeps its place, but takes the later value
+    std::vector<std::pair<const std::string*, const Value*>> fields;
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        auto it =
+          std::find_if(fields.begin(), fields.end(), [&](const auto& field) { return *field.first == names[i]; });
+        if (it != fields.end()) {
+            it->second = &values[i];
+        }
+        else {
+            fields.emplace_back(&names[i], &values[i]);
+        }
+    }
+
+    std::string out = "{";
+    for (std::size_t i = 0; i < fields.size(); ++i) {
+        if (i > 0) {
+            out += ", ";
+        }
+        appendJsonString(out, *fields[i].first);
+        out += ": ";
+        appendJson(out, *fields[i].second);
+    }
+    out += '}';
+    return out;
+}
+
+
+std::vector<Type> Function::getInputTypes() const
+{
+    return getTypes(inputs);
+}
+
+
+std::vector<Type> Function::getOutputTypes() const
+{
+    return getTypes(outputs);
+}
+
+
+bool Function::accepts(const std::vector<Value>& arguments) const
+{
+    if (arguments.size() != inputs.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        if (!isConvertible(arguments[i], inputs[i].type)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+ContractAbi::ContractAbi(const boost::property_tree::ptree& abi)
+{
+    try {
+        for (const auto& [key, entry] : abi) {
+            const auto entry_type = entry.get<std::string>("type", "function");
+            if (entry_type == "function") {
+                _functions.push_back(parseFunction(entry, entry.get<std::string>("name")));
+            }
+            else if (entry_type == "constructor") {
+                _constructor = parseFunction(entry, {});
+            }
+        }
+    }
+    catch (const boost::property_tree::ptree_error& e) {
+        RAISE_ERROR(base::InvalidArgument, std::string("Invalid ABI format: ") + e.what());
+    }
+}
+
+
+const Function* ContractAbi::findFunction(const std::string& name, const std::vector<Value>& arguments) const
+{
+    auto it = std::find_if(_functions.begin(), _functions.end(), [&](const Function& function) {
+        return function.name == name && function.accepts(arguments);
+    });
+    return it != _functions.end() ? &*it : nullptr;
+}
+
+
+const Function* ContractAbi::findFunction(const base::FixedBytes<4>& selector) const
+{
+    auto it = std::find_if(_functions.begin(), _functions.end(), [&selector](const Function& function) {
+        return function.selector == selector;
+    });
+    return it != _functions.end() ? &*it : nullptr;
+}
+
+
+const Function& ContractAbi::getConstructor() const noexcept
+{
+    return _constructor;
+}
+
+
+base::Bytes ContractAbi::encodeCall(const std::string& name, const std::vector<Value>& arguments) const
+{
+    const auto* function = findFunction(name, arguments);
+    if (!function) {
+        RAISE_ERROR(base::InvalidArgument, "No methods with these arguments have been found");
+    }
+    auto data = function->selector.toBytes();
+    data.append(encode(function->getInputTypes(), arguments));
+    return data;
+}
+
+
+base::Bytes ContractAbi::encodeConstructorArguments(const std::vector<Value>& arguments) const
+{
+    if (!_constructor.accepts(arguments)) {
+        RAISE_ERROR(base::InvalidArgument, "Arguments don't fit the constructor");
+    }
+    return encode(_constructor.getInputTypes(), arguments);
+}
+
+
+std::string ContractAbi::decodeOutputToJson(const base::Bytes& output) const
+{
+    if (output.size() < SELECTOR_SIZE) {
+        RAISE_ERROR(base::InvalidArgument, "Output has no method id");
+    }
+    const auto* function = findFunction(base::FixedBytes<SELECTOR_SIZE>(output.getData(), SELECTOR_SIZE));
+    if (!function) {
+        RAISE_ERROR(base::InvalidArgument, "No metadata with method id data was found");
+    }
+    const auto values = decode(function->getOutputTypes(), output.takePart(SELECTOR_SIZE, output.size()));
+
+    std::vector<std::string> names;
+    for (const auto& output_parameter : function->outputs) {
+        names.push_back(output_parameter.name);
+    }
+    return toJson(names, values);
+}
+
+} // namespace vm::abi
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "base/bytes.hpp"
+#include "core/address.hpp"
+
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace vm::abi
+{
+
+// Solidity ABI codec of contract calls and outputs: types are read from the JSON ABI of a contract, and values
+// are encoded natively, without web3.
+
+// type of a function parameter, e.g. "uint256", "bytes", "address[2]" or a tuple of components
+struct Type
+{
+    enum class Kind
+    {
+        UINT,
+        INT,
+        ADDRESS,
+        BOOL,
+        FIXED_BYTES,
+        BYTES,
+        STRING,
+        ARRAY,
+        TUPLE
+    };
+
+    Kind kind;
+    std::size_t size{ 0 };        // bits of integers, length of fixed bytes and fixed arrays; 0 for dynamic arrays
+    std::vector<Type> components; // the element of an array or the components of a tuple
+    std::string name;             // canonical name, as it goes to the signature of a function
+
+    // components are the "components" child of the parameter in the JSON ABI, they are needed for tuples only
+    static Type parse(const std::string& type_name, const boost::property_tree::ptree& components = {});
+
+    bool isDynamic() const;
+    // bytes, that a value of the type takes in the head of the enclosing tuple
+    std::size_t getHeadSize() const;
+};
+
+
+// argument of a call or a decoded output; arrays and tuples are both kept as lists of values
+struct Value
+{
+    using Integer = boost::multiprecision::cpp_int;
+    using List = std::vector<Value>;
+
+    std::variant<Integer, bool, lk::Address, base::Bytes, std::string, List> data;
+
+    bool operator==(const Value& other) const;
+    bool operator!=(const Value& other) const;
+};
+
+
+// checks, whether the value can be encoded as the given type
+bool isConvertible(const Value& value, const Type& type);
+
+// values are encoded as a tuple of the types; raises base::InvalidArgument if a value doesn't fit its type
+base::Bytes encode(const std::vector<Type>& types, const std::vector<Value>& values);
+
+// raises base::InvalidArgument if the data is malformed or truncated
+std::vector<Value> decode(const std::vector<Type>& types, const base::Bytes& data);
+
+
+// Parses arguments in the syntax of the client: numbers, strings in double quotes, true and false, lists in
+// square brackets and addresses written as Address(<base58>); bytes are written as strings of hex digits.
+// Raises base::ParsingError on a malformed text.
+std::vector<Value> parseArguments(const std::string& arguments);
+
+// JSON object of the values keyed by names; bytes are written as hex and addresses as base58
+std::string toJson(const std::vector<std::string>& names, const std::vector<Value>& values);
+
+
+struct Parameter
+{
+    std::string name;
+    Type type;
+};
+
+
+struct Function
+{
+    std::string name; // empty for the constructor
+    std::vector<Parameter> inputs;
+    std::vector<Parameter> outputs;
+    std::string signature;
+    base::FixedBytes<4> selector;
+
+    std::vector<Type> getInputTypes() const;
+    std::vector<Type> getOutputTypes() const;
+    bool accepts(const std::vector<Value>& arguments) const;
+};
+
+
+// parsed once, the ABI serves any number of calls
+class ContractAbi
+{
+  public:
+    //=================
+    // takes the JSON ABI, which is the "output.abi" child of the metadata of a compiled contract
+    explicit ContractAbi(const boost::property_tree::ptree& abi);
+    //=================
+    // overloaded functions are told apart by the arguments, the first fitting one is chosen
+    const Function* findFunction(const std::string& name, const std::vector<Value>& arguments) const;
+    const Function* findFunction(const base::FixedBytes<4>& selector) const;
+    const Function& getConstructor() const noexcept;
+    //=================
+    base::Bytes encodeCall(const std::string& name, const std::vector<Value>& arguments) const;
+    base::Bytes encodeConstructorArguments(const std::vector<Value>& arguments) const;
+    // the output starts with the selector of the function, which returned it
+    std::string decodeOutputToJson(const base::Bytes& output) const;
+    //=================
+  private:
+    std::vector<Function> _functions;
+    Function _constructor;
+};
+
+
+// value of a native type: an integer, bool, lk::Address, base::Bytes, std::string or std::vector of them
+template<typename T>
+Value toValue(const T& value);
+
+// encodes a call of the function with arguments of native types
+template<typename... Args>
+base::Bytes encodeCall(const Function& function, const Args&... args);
+
+} // namespace vm::abi
+
+#include "abi.tpp"
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "abi.hpp"
+
+#include "base/error.hpp"
+
+#include <type_traits>
+
+namespace vm::abi
+{
+
+template<typename T>
+Value toValue(const T& value)
+{
+    if constexpr (std::is_same_v<T, bool>) {
+        return Value{ value };
+    }
+    else if constexpr (std::is_integral_v<T>) {
+        return Value{ Value::Integer{ value } };
+    }
+    else if constexpr (std::is_same_v<T, lk::Address> || std::is_same_v<T, base::Bytes>) {
+        return Value{ value };
+    }
+    else if constexpr (std::is_convertible_v<T, std::string>) {
+        return Value{ std::string(value) };
+    }
+    else {
+        Value::List list;
+        list.reserve(value.size());
+        for (const auto& item : value) {
+            list.push_back(toValue(item));
+        }
+        return Value{ std::move(list) };
+    }
+}
+
+
+template<typename... Args>
+base::Bytes encodeCall(const Function& function, const Args&... args)
+{
+    std::vector<Value> arguments{ toValue(args)... };
+    if (!function.accepts(arguments)) {
+        RAISE_ERROR(base::InvalidArgument, "arguments don't fit function " + function.signature);
+    }
+    return base::Bytes(function.selector.getData(), function.selector.size()) +
+           encode(function.getInputTypes(), arguments);
+}
+
+} // namespace vm::abi
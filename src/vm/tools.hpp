@@ -56,10 +56,11 @@ std::optional<base::Bytes> encodeCall(const std::filesystem::path& path_to_code_
 
 std::optional<std::string> decodeOutput(const std::filesystem::path& path_to_code_folder, const std::string& output);
 
-std::string callPython(std::vector<std::string>& args);
-
+// data is a call like "method(args)" or "constructor(args)", the result is hex of the call data; the parsed ABI of
+// the contract is cached
 std::string encodeMessage(const std::string& contract_path, const std::string& data);
 
+// data is hex of the selector of the called method followed by its output, the result is JSON of the output values
 std::string decodeMessage(const std::string& contract_path, const std::string& data);
 
 } // namespace vm
\ No newline at end of file
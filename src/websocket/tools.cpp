@@ -50,6 +50,16 @@ std::string serializeCommandName(Command::Id name)
             return "push_transaction";
         case Command::Name::LAST_BLOCK_INFO:
             return "last_block_info";
+        case Command::Name::DATABASE_STATISTICS:
+            return "database_statistics";
+        case Command::Name::CALL_CONTRACT:
+            return "call_contract";
+        case Command::Name::ESTIMATE_FEE:
+            return "estimate_fee";
+        case Command::Name::LOGS:
+            return "logs";
+        case Command::Name::TRACE_TRANSACTION:
+            return "trace_transaction";
         default:
             RAISE_ERROR(base::LogicError, "used unexpected command name");
     }
@@ -77,6 +87,21 @@ websocket::Command::Name deserializeCommandName(const std::string& message)
     if (message == "last_block_info") {
         return websocket::Command::Name::LAST_BLOCK_INFO;
     }
+    if (message == "database_statistics") {
+        return websocket::Command::Name::DATABASE_STATISTICS;
+    }
+    if (message == "call_contract") {
+        return websocket::Command::Name::CALL_CONTRACT;
+    }
+    if (message == "estimate_fee") {
+        return websocket::Command::Name::ESTIMATE_FEE;
+    }
+    if (message == "logs") {
+        return websocket::Command::Name::LOGS;
+    }
+    if (message == "trace_transaction") {
+        return websocket::Command::Name::TRACE_TRANSACTION;
+    }
     RAISE_ERROR(base::InvalidArgument, std::string("not any type found by name") + message);
 }
 
@@ -328,6 +353,7 @@ base::PropertyTree serializeAccountInfo(const lk::AccountInfo& account_info)
     result.add("balance", serializeBalance(account_info.balance));
     result.add("nonce", account_info.nonce);
     result.add("type", serializeAccountType(account_info.type));
+    result.add("transactions_count", account_info.transactions_count);
     base::PropertyTree txs_hashes;
     for (const auto& tx_hash : account_info.transactions_hashes) {
         txs_hashes.add("", serializeHash(tx_hash));
@@ -373,6 +399,11 @@ std::optional<lk::AccountInfo> deserializeAccountInfo(const base::PropertyTree&
             return std::nullopt;
         }
 
+        std::optional<std::uint64_t> transactions_count;
+        if (input.hasKey("transactions_count")) {
+            transactions_count = input.get<std::uint64_t>("transactions_count");
+        }
+
         std::vector<base::Sha256> transactions_hashes;
         if (input.hasKey("transaction_hashes")) {
             for (const auto& res_tx_hash : input.getSubTree("transaction_hashes")) {
@@ -411,7 +442,13 @@ std::optional<lk::AccountInfo> deserializeAccountInfo(const base::PropertyTree&
             return std::nullopt;
         }
 
-        return lk::AccountInfo{ type.value(), address.value(), balance.value(), nonce.value(), transactions_hashes };
+        // answers of older nodes have the whole history
+        return lk::AccountInfo{ type.value(),
+                                address.value(),
+                                balance.value(),
+                                nonce.value(),
+                                transactions_count.value_or(transactions_hashes.size()),
+                                transactions_hashes };
     }
     catch (const base::Error& e) {
         LOG_ERROR << "Failed to deserialize Account Info";
@@ -429,6 +466,23 @@ base::PropertyTree serializeInfo(const NodeInfo& info)
 }
 
 
+base::PropertyTree serializeDatabaseStatistics(const lk::DatabaseStatistics& statistics)
+{
+    base::PropertyTree result;
+    result.add("leveldb_stats", statistics.leveldb_stats);
+    result.add("memory_usage", statistics.memory_usage);
+    result.add("blocks_size", statistics.blocks_size);
+    result.add("transactions_index_size", statistics.transactions_index_size);
+    result.add("state_size", statistics.state_size);
+    result.add("blocks_cache.hits", statistics.blocks_cache.hits);
+    result.add("blocks_cache.misses", statistics.blocks_cache.misses);
+    result.add("blocks_cache.blocks_count", statistics.blocks_cache.blocks_count);
+    result.add("blocks_cache.size", statistics.blocks_cache.size);
+    result.add("blocks_cache.capacity", statistics.blocks_cache.capacity);
+    return result;
+}
+
+
 std::optional<NodeInfo> deserializeInfo(const base::PropertyTree& input)
 {
     try {
@@ -581,6 +635,7 @@ base::PropertyTree serializeBlock(const lk::ImmutableBlock& block)
     result.add("nonce", block.getNonce());
     result.add("coinbase", serializeAddress(block.getCoinbase()));
     result.add("previous_block_hash", serializeHash(block.getPrevBlockHash()));
+    result.add("state_root", serializeHash(block.getStateRoot()));
     result.add("timestamp", block.getTimestamp().getSeconds());
 
     base::PropertyTree txs_values;
@@ -627,6 +682,14 @@ std::optional<lk::ImmutableBlock> deserializeBlock(const base::PropertyTree& inp
             LOG_ERROR << "previous_block_hash field is not exists";
             return std::nullopt;
         }
+        std::optional<base::Sha256> state_root;
+        if (input.hasKey("state_root")) {
+            state_root = deserializeHash(input.get<std::string>("state_root"));
+        }
+        else {
+            LOG_ERROR << "state_root field is not exists";
+            return std::nullopt;
+        }
         std::optional<lk::Address> coinbase;
         if (input.hasKey("coinbase")) {
             coinbase = deserializeAddress(input.get<std::string>("coinbase"));
@@ -652,6 +715,10 @@ std::optional<lk::ImmutableBlock> deserializeBlock(const base::PropertyTree& inp
             LOG_ERROR << "error at previous_block_hash deserialization";
             return std::nullopt;
         }
+        if (!state_root) {
+            LOG_ERROR << "error at state_root deserialization";
+            return std::nullopt;
+        }
         if (!coinbase) {
             LOG_ERROR << "error at coinbase deserialization";
             return std::nullopt;
@@ -679,6 +746,7 @@ std::optional<lk::ImmutableBlock> deserializeBlock(const base::PropertyTree& inp
         b.setDepth(depth.value());
         b.setNonce(nonce.value());
         b.setPrevBlockHash(previous_block_hash.value());
+        b.setStateRoot(state_root.value());
         b.setTimestamp(timestamp.value());
         b.setCoinbase(coinbase.value());
         b.setTransactionsSet(std::move(txs));
@@ -698,6 +766,13 @@ base::PropertyTree serializeTransactionStatus(const lk::TransactionStatus& statu
     result.add("action_type", serializeTransactionStatusActionType(status.getType()));
     result.add("fee_left", serializeFee(status.getFeeLeft()));
     result.add("message", status.getMessage());
+    if (!status.getLogs().empty()) {
+        base::PropertyTree logs;
+        for (const auto& log : status.getLogs()) {
+            logs.pushBack(serializeLog(log));
+        }
+        result.add("logs", std::move(logs));
+    }
     return result;
 }
 
@@ -754,7 +829,18 @@ std::optional<lk::TransactionStatus> deserializeTransactionStatus(const base::Pr
             LOG_ERROR << "error at message deserialization";
             return std::nullopt;
         }
-        return lk::TransactionStatus{ status_code.value(), action_type.value(), fee.value(), message.value() };
+        lk::TransactionStatus status{ status_code.value(), action_type.value(), fee.value(), message.value() };
+        if (input.hasKey("logs")) {
+            for (const auto& res_log : input.getSubTree("logs")) {
+                auto log = deserializeLog(res_log.second);
+                if (!log) {
+                    LOG_ERROR << "error at log deserialization";
+                    return std::nullopt;
+                }
+                status.getLogs().push_back(std::move(*log));
+            }
+        }
+        return status;
     }
     catch (const std::exception& e) {
         LOG_ERROR << "Failed to deserialize TransactionStatus";
@@ -762,4 +848,186 @@ std::optional<lk::TransactionStatus> deserializeTransactionStatus(const base::Pr
     }
 }
 
-}
\ No newline at end of file
+
+base::PropertyTree serializeFeeEstimate(const lk::FeeEstimate& estimate)
+{
+    base::PropertyTree result;
+    result.add("fee", serializeFee(estimate.fee));
+    result.add("status", serializeTransactionStatus(estimate.status));
+    return result;
+}
+
+
+base::PropertyTree serializeExecutionTrace(const lk::ExecutionTrace& trace)
+{
+    base::PropertyTree result;
+    result.add("time", static_cast<std::uint64_t>(trace.getTime().count()));
+    base::PropertyTree frames;
+    for (const auto& frame : trace.getFrames()) {
+        base::PropertyTree frame_tree;
+        frame_tree.add("address", serializeAddress(frame.address));
+        frame_tree.add("depth", frame.depth);
+        frame_tree.add("gas_used", serializeFee(frame.gas_used));
+        frame_tree.add("time", static_cast<std::uint64_t>(frame.time.count()));
+        frame_tree.add("is_success", frame.is_success);
+        frames.pushBack(std::move(frame_tree));
+    }
+    result.add("frames", std::move(frames));
+    base::PropertyTree host_calls;
+    for (std::size_t i = 0; i < trace.getHostCalls().size(); ++i) {
+        const auto& statistics = trace.getHostCalls()[i];
+        if (statistics.count == 0) {
+            continue;
+        }
+        base::PropertyTree statistics_tree;
+        statistics_tree.add("count", statistics.count);
+        statistics_tree.add("time", static_cast<std::uint64_t>(statistics.time.count()));
+        host_calls.add(lk::ExecutionTrace::getName(static_cast<lk::ExecutionTrace::HostCall>(i)),
+                       std::move(statistics_tree));
+    }
+    result.add("host_calls", std::move(host_calls));
+    return result;
+}
+
+
+base::PropertyTree serializeTransactionTrace(const lk::TransactionTrace& trace)
+{
+    base::PropertyTree result;
+    result.add("status", serializeTransactionStatus(trace.status));
+    result.add("trace", serializeExecutionTrace(trace.trace));
+    return result;
+}
+
+
+std::string serializeLogTopic(const lk::LogTopic& topic)
+{
+    return base::base64Encode(topic);
+}
+
+
+std::optional<lk::LogTopic> deserializeLogTopic(const std::string& topic)
+{
+    auto topic_data = deserializeBytes(topic);
+    if (!topic_data || topic_data->size() != lk::LogTopic{}.size()) {
+        LOG_ERROR << "Failed to deserialize log topic";
+        return std::nullopt;
+    }
+    return lk::LogTopic(*topic_data);
+}
+
+
+base::PropertyTree serializeLog(const lk::Log& log)
+{
+    base::PropertyTree result;
+    result.add("address", serializeAddress(log.address));
+    base::PropertyTree topics;
+    for (const auto& topic : log.topics) {
+        topics.pushBack(serializeLogTopic(topic));
+    }
+    result.add("topics", std::move(topics));
+    result.add("data", serializeBytes(log.data));
+    return result;
+}
+
+
+std::optional<lk::Log> deserializeLog(const base::PropertyTree& input)
+{
+    try {
+        if (!input.hasKey("address") || !input.hasKey("topics") || !input.hasKey("data")) {
+            LOG_ERROR << "log fields are not exist";
+            return std::nullopt;
+        }
+        auto address = deserializeAddress(input.get<std::string>("address"));
+        auto data = deserializeBytes(input.get<std::string>("data"));
+        if (!address || !data) {
+            LOG_ERROR << "error at log deserialization";
+            return std::nullopt;
+        }
+        lk::Log log{ std::move(*address), {}, std::move(*data) };
+        for (const auto& res_topic : input.getSubTree("topics")) {
+            auto topic = deserializeLogTopic(res_topic.second.get_value<std::string>());
+            if (!topic) {
+                return std::nullopt;
+            }
+            log.topics.push_back(std::move(*topic));
+        }
+        return log;
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR << "Failed to deserialize Log";
+        return std::nullopt;
+    }
+}
+
+
+base::PropertyTree serializeLogRecords(const std::vector<lk::LogRecord>& records)
+{
+    base::PropertyTree result;
+    for (const auto& record : records) {
+        auto log = serializeLog(record.log);
+        log.add("depth", record.depth);
+        log.add("transaction_hash", serializeHash(record.transaction_hash));
+        log.add("index", record.index);
+        result.pushBack(std::move(log));
+    }
+    return result;
+}
+
+
+base::PropertyTree serializeLogsFilter(const lk::LogsFilter& filter)
+{
+    base::PropertyTree result;
+    base::PropertyTree addresses;
+    for (const auto& address : filter.addresses) {
+        addresses.pushBack(serializeAddress(address));
+    }
+    result.add("addresses", std::move(addresses));
+    base::PropertyTree topics;
+    for (const auto& alternatives : filter.topics) {
+        base::PropertyTree alternatives_tree;
+        for (const auto& topic : alternatives) {
+            alternatives_tree.pushBack(serializeLogTopic(topic));
+        }
+        topics.pushBack(std::move(alternatives_tree));
+    }
+    result.add("topics", std::move(topics));
+    return result;
+}
+
+
+std::optional<lk::LogsFilter> deserializeLogsFilter(const base::PropertyTree& input)
+{
+    try {
+        lk::LogsFilter filter;
+        if (input.hasKey("addresses")) {
+            for (const auto& res_address : input.getSubTree("addresses")) {
+                auto address = deserializeAddress(res_address.second.get_value<std::string>());
+                if (!address) {
+                    LOG_ERROR << "error at address deserialization";
+                    return std::nullopt;
+                }
+                filter.addresses.push_back(std::move(*address));
+            }
+        }
+        if (input.hasKey("topics")) {
+            // an empty array of alternatives matches any topic at its position
+            for (const auto& res_alternatives : input.getSubTree("topics")) {
+                auto& alternatives = filter.topics.emplace_back();
+                for (const auto& res_topic : res_alternatives.second) {
+                    auto topic = deserializeLogTopic(res_topic.second.get_value<std::string>());
+                    if (!topic) {
+                        return std::nullopt;
+                    }
+                    alternatives.push_back(std::move(*topic));
+                }
+            }
+        }
+        return filter;
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR << "Failed to deserialize LogsFilter";
+        return std::nullopt;
+    }
+}
+
+}
@@ -68,6 +68,8 @@ base::PropertyTree serializeInfo(const NodeInfo& info);
 
 std::optional<NodeInfo> deserializeInfo(const base::PropertyTree& input);
 
+base::PropertyTree serializeDatabaseStatistics(const lk::DatabaseStatistics& statistics);
+
 base::PropertyTree serializeTransaction(const lk::Transaction& tx);
 
 std::optional<lk::Transaction> deserializeTransaction(const base::PropertyTree& input);
@@ -80,4 +82,26 @@ base::PropertyTree serializeTransactionStatus(const lk::TransactionStatus& statu
 
 std::optional<lk::TransactionStatus> deserializeTransactionStatus(const base::PropertyTree& input);
 
+base::PropertyTree serializeFeeEstimate(const lk::FeeEstimate& estimate);
+
+// the times are in nanoseconds
+base::PropertyTree serializeExecutionTrace(const lk::ExecutionTrace& trace);
+
+base::PropertyTree serializeTransactionTrace(const lk::TransactionTrace& trace);
+
+std::string serializeLogTopic(const lk::LogTopic& topic);
+
+std::optional<lk::LogTopic> deserializeLogTopic(const std::string& topic);
+
+base::PropertyTree serializeLog(const lk::Log& log);
+
+std::optional<lk::Log> deserializeLog(const base::PropertyTree& input);
+
+base::PropertyTree serializeLogRecords(const std::vector<lk::LogRecord>& records);
+
+base::PropertyTree serializeLogsFilter(const lk::LogsFilter& filter);
+
+// both fields are optional: a missing one matches anything
+std::optional<lk::LogsFilter> deserializeLogsFilter(const base::PropertyTree& input);
+
 }
@@ -22,22 +22,26 @@ enum class Name : std::uint64_t
     PUSH_TRANSACTION = 8,
     FIND_BLOCK = 16,
     ACCOUNT_INFO = 32,
-    RESERVED1 = 64,
-    RESERVED2 = 128
+    DATABASE_STATISTICS = 64,
+    CALL_CONTRACT = 128,
+    ESTIMATE_FEE = 256,
+    LOGS = 512,
+    TRACE_TRANSACTION = 1024,
+    RESERVED2 = 32768
 };
 
 enum class Type : std::uint64_t
 {
-    CALL = 256,
-    SUBSCRIBE = 512,
-    UNSUBSCRIBE = 1024,
-    RESERVED = 2048
+    CALL = 65536,
+    SUBSCRIBE = 131072,
+    UNSUBSCRIBE = 262144,
+    RESERVED = 524288
 };
 
 using Id = std::uint64_t;
 
-constexpr Id NameMask = (static_cast<std::uint64_t>(Name::RESERVED2) * 2) - 1;            // 0000 0000 1111 1111
-constexpr Id TypeMask = (static_cast<std::uint64_t>(Type::RESERVED) * 2) - NameMask - 1; // 0000 1111 0000 0000
+constexpr Id NameMask = (static_cast<std::uint64_t>(Name::RESERVED2) * 2) - 1;            // 0000 0xFFFF
+constexpr Id TypeMask = (static_cast<std::uint64_t>(Type::RESERVED) * 2) - NameMask - 1; // 000F 0000
 
 constexpr Id CALL_LAST_BLOCK_INFO = websocket::Command::Id(websocket::Command::Type::CALL) |
                                     websocket::Command::Id(websocket::Command::Name::LAST_BLOCK_INFO);
@@ -54,6 +58,21 @@ constexpr Id CALL_FIND_TRANSACTION = websocket::Command::Id(websocket::Command::
 constexpr Id CALL_FIND_BLOCK =
   websocket::Command::Id(websocket::Command::Type::CALL) | websocket::Command::Id(websocket::Command::Name::FIND_BLOCK);
 
+constexpr Id CALL_DATABASE_STATISTICS = websocket::Command::Id(websocket::Command::Type::CALL) |
+                                        websocket::Command::Id(websocket::Command::Name::DATABASE_STATISTICS);
+
+constexpr Id CALL_CONTRACT = websocket::Command::Id(websocket::Command::Type::CALL) |
+                             websocket::Command::Id(websocket::Command::Name::CALL_CONTRACT);
+
+constexpr Id CALL_ESTIMATE_FEE = websocket::Command::Id(websocket::Command::Type::CALL) |
+                                 websocket::Command::Id(websocket::Command::Name::ESTIMATE_FEE);
+
+constexpr Id CALL_LOGS =
+  websocket::Command::Id(websocket::Command::Type::CALL) | websocket::Command::Id(websocket::Command::Name::LOGS);
+
+constexpr Id CALL_TRACE_TRANSACTION = websocket::Command::Id(websocket::Command::Type::CALL) |
+                                      websocket::Command::Id(websocket::Command::Name::TRACE_TRANSACTION);
+
 constexpr Id SUBSCRIBE_PUSH_TRANSACTION = websocket::Command::Id(websocket::Command::Type::SUBSCRIBE) |
                                           websocket::Command::Id(websocket::Command::Name::PUSH_TRANSACTION);
 
@@ -63,6 +82,9 @@ constexpr Id SUBSCRIBE_LAST_BLOCK_INFO = websocket::Command::Id(websocket::Comma
 constexpr Id SUBSCRIBE_ACCOUNT_INFO = websocket::Command::Id(websocket::Command::Type::SUBSCRIBE) |
                                       websocket::Command::Id(websocket::Command::Name::ACCOUNT_INFO);
 
+constexpr Id SUBSCRIBE_LOGS =
+  websocket::Command::Id(websocket::Command::Type::SUBSCRIBE) | websocket::Command::Id(websocket::Command::Name::LOGS);
+
 constexpr Id UNSUBSCRIBE_PUSH_TRANSACTION = websocket::Command::Id(websocket::Command::Type::UNSUBSCRIBE) |
                                             websocket::Command::Id(websocket::Command::Name::PUSH_TRANSACTION);
 
@@ -72,6 +94,9 @@ constexpr Id UNSUBSCRIBE_LAST_BLOCK_INFO = websocket::Command::Id(websocket::Com
 constexpr Id UNSUBSCRIBE_ACCOUNT_INFO = websocket::Command::Id(websocket::Command::Type::UNSUBSCRIBE) |
                                         websocket::Command::Id(websocket::Command::Name::ACCOUNT_INFO);
 
+constexpr Id UNSUBSCRIBE_LOGS = websocket::Command::Id(websocket::Command::Type::UNSUBSCRIBE) |
+                                websocket::Command::Id(websocket::Command::Name::LOGS);
+
 }
 
 
@@ -0,0 +1,228 @@
+#include "benchmark.hpp"
+
+#include "base/assert.hpp"
+#include "base/database.hpp"
+#include "base/hash.hpp"
+
+#include <thread>
+
+namespace
+{
+
+constexpr std::size_t BLOCKS_COUNT = 200;
+constexpr std::size_t BLOCK_SIZE = 10 * 1024;
+constexpr std::size_t WRITERS_COUNT = 4;
+constexpr std::size_t LOOKUPS_COUNT = 10'000;
+const std::filesystem::path DATABASE_PATH{ "benchmark_database" };
+
+
+struct StoredBlock
+{
+    base::Bytes hash;
+    base::Bytes prev_hash;
+    base::Bytes data;
+};
+
+
+std::vector<StoredBlock> makeBlocks()
+{
+    std::vector<StoredBlock> blocks;
+    base::Bytes prev_hash = base::Sha256::null().getBytes().toBytes();
+    for (std::size_t i = 0; i < BLOCKS_COUNT; ++i) {
+        base::Bytes data(BLOCK_SIZE);
+        for (std::size_t j = 0; j < BLOCK_SIZE; ++j) {
+            data[j] = static_cast<base::Byte>(i + j);
+        }
+        auto hash = base::Sha256::compute(data).getBytes().toBytes();
+        blocks.push_back({ hash, prev_hash, std::move(data) });
+        prev_hash = hash;
+    }
+    return blocks;
+}
+
+
+// the way blocks were stored before: three synced writes
+void putBlock(base::Database& database, const StoredBlock& block)
+{
+    database.put(base::Bytes("b") + block.hash, block.data);
+    database.put(base::Bytes("p") + block.hash, block.prev_hash);
+    database.put(base::Bytes("last"), block.hash);
+}
+
+
+void writeBlock(base::Database& database, const StoredBlock& block)
+{
+    base::Database::Batch batch;
+    batch.put(base::Bytes("b") + block.hash, block.data);
+    batch.put(base::Bytes("p") + block.hash, block.prev_hash);
+    batch.put(base::Bytes("last"), block.hash);
+    database.write(std::move(batch));
+}
+
+
+template<typename F>
+void runSingleWriter(const std::string& name, const std::vector<StoredBlock>& blocks, F f)
+{
+    auto database = base::createClearDatabaseInstance(DATABASE_PATH);
+    base::Timer timer;
+    timer.start();
+    for (const auto& block : blocks) {
+        f(database, block);
+    }
+    benchmark::report(name, blocks.size(), timer);
+}
+
+
+void runConcurrentWriters(const std::string& name, const std::vector<StoredBlock>& blocks, bool is_group_commit)
+{
+    auto database = base::createClearDatabaseInstance(DATABASE_PATH);
+    database.setGroupCommit(is_group_commit);
+    base::Timer timer;
+    timer.start();
+    std::vector<std::thread> writers;
+    for (std::size_t w = 0; w < WRITERS_COUNT; ++w) {
+        writers.emplace_back([&, w] {
+            for (std::size_t i = w; i < blocks.size(); i += WRITERS_COUNT) {
+                writeBlock(database, blocks[i]);
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    benchmark::report(name, blocks.size(), timer);
+}
+
+
+// the way values were read before: keys and values copied into strings, a fresh buffer per lookup
+void runCopyingLookups(const base::Database& database, const std::vector<base::Bytes>& keys)
+{
+    base::Timer timer;
+    timer.start();
+    std::size_t found = 0;
+    for (std::size_t i = 0; i < LOOKUPS_COUNT; ++i) {
+        const auto key = keys[i % keys.size()].toString();
+        std::string value;
+        if (database.get(leveldb::Slice(key), value)) {
+            found += base::Bytes(value).size() > 0;
+        }
+    }
+    benchmark::report("get of 10KB value, copied key and buffer", LOOKUPS_COUNT, timer);
+    ASSERT(found == LOOKUPS_COUNT);
+}
+
+
+void runLookups(const base::Database& database, const std::vector<base::Bytes>& keys)
+{
+    base::Timer timer;
+    timer.start();
+    std::size_t found = 0;
+    for (std::size_t i = 0; i < LOOKUPS_COUNT; ++i) {
+        found += database.get(keys[i % keys.size()]).value().size() > 0;
+    }
+    benchmark::report("get of 10KB value", LOOKUPS_COUNT, timer);
+    ASSERT(found == LOOKUPS_COUNT);
+
+    timer.start();
+    std::string buffer;
+    for (std::size_t i = 0; i < LOOKUPS_COUNT; ++i) {
+        database.get(keys[i % keys.size()], buffer);
+    }
+    benchmark::report("get of 10KB value into a reused buffer", LOOKUPS_COUNT, timer);
+
+    timer.start();
+    found = 0;
+    for (std::size_t i = 0; i < LOOKUPS_COUNT; ++i) {
+        found += database.exists(keys[i % keys.size()]);
+    }
+    benchmark::report("exists of present key", LOOKUPS_COUNT, timer);
+    ASSERT(found == LOOKUPS_COUNT);
+
+    std::vector<base::Sha256> missing_keys;
+    for (const auto& key : keys) {
+        missing_keys.push_back(base::Sha256::compute(key));
+    }
+    timer.start();
+    found = 0;
+    for (std::size_t i = 0; i < LOOKUPS_COUNT; ++i) {
+        found += database.exists(missing_keys[i % missing_keys.size()].getBytes());
+    }
+    benchmark::report("exists of missing key", LOOKUPS_COUNT, timer);
+    ASSERT(found == 0);
+}
+
+} // namespace
+
+
+BENCHMARK_CASE(database_persist_blocks)
+{
+    const auto blocks = makeBlocks();
+    runSingleWriter("three synced puts per 10KB block", blocks, putBlock);
+    runSingleWriter("one synced batch per 10KB block", blocks, writeBlock);
+    runConcurrentWriters("4 writers, a batch per block", blocks, false);
+    runConcurrentWriters("4 writers, a batch per block, group commit", blocks, true);
+    std::filesystem::remove_all(DATABASE_PATH);
+}
+
+
+BENCHMARK_CASE(database_lookup_values)
+{
+    const auto blocks = makeBlocks();
+    std::vector<base::Bytes> keys;
+    {
+        auto database = base::createClearDatabaseInstance(DATABASE_PATH);
+        base::Database::Batch batch;
+        for (const auto& block : blocks) {
+            batch.put(block.hash, block.data);
+            keys.push_back(block.hash);
+        }
+        database.write(std::move(batch));
+    }
+
+    base::Database database(DATABASE_PATH);
+    for (const auto& key : keys) { // warm up, so the first measured case isn't penalized
+        [[maybe_unused]] auto value = database.get(key);
+    }
+    runCopyingLookups(database, keys);
+    runLookups(database, keys);
+    std::filesystem::remove_all(DATABASE_PATH);
+}
+
+
+BENCHMARK_CASE(database_bloom_filter_lookups)
+{
+    const auto blocks = makeBlocks();
+    for (int bits_per_key : { 0, base::config::DATABASE_BLOOM_FILTER_BITS_PER_KEY }) {
+        base::DatabaseOptions options;
+        options.bloom_filter_bits_per_key = bits_per_key;
+        auto database = base::createClearDatabaseInstance(DATABASE_PATH, options);
+        base::Database::Batch batch;
+        for (const auto& block : blocks) {
+            batch.put(block.hash, block.data);
+        }
+        database.write(std::move(batch));
+
+        const auto suffix = ", " + std::to_string(bits_per_key) + " filter bits per key";
+        base::Timer timer;
+        timer.start();
+        std::size_t found = 0;
+        for (std::size_t i = 0; i < LOOKUPS_COUNT; ++i) {
+            found += database.exists(blocks[i % blocks.size()].hash);
+        }
+        benchmark::report("exists of present key" + suffix, LOOKUPS_COUNT, timer);
+        ASSERT(found == LOOKUPS_COUNT);
+
+        std::vector<base::Bytes> missing_keys;
+        for (const auto& block : blocks) {
+            missing_keys.push_back(block.prev_hash + base::Bytes("missing"));
+        }
+        timer.start();
+        found = 0;
+        for (std::size_t i = 0; i < LOOKUPS_COUNT; ++i) {
+            found += database.exists(missing_keys[i % missing_keys.size()]);
+        }
+        benchmark::report("exists of missing key" + suffix, LOOKUPS_COUNT, timer);
+        ASSERT(found == 0);
+    }
+    std::filesystem::remove_all(DATABASE_PATH);
+}
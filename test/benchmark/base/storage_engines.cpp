@@ -0,0 +1,195 @@
+#include "benchmark.hpp"
+
+#include "base/assert.hpp"
+#include "base/database.hpp"
+#include "base/hash.hpp"
+#include "core/blockchain.hpp"
+
+namespace
+{
+
+constexpr std::size_t ENTRIES_COUNT = 20'000;
+constexpr std::size_t VALUE_SIZE = 256;
+constexpr std::size_t WRITE_BATCH_SIZE = 100;
+constexpr std::size_t LOOKUPS_COUNT = 50'000;
+constexpr std::size_t CHAIN_HEIGHT = 2'000;
+constexpr std::uint_least32_t GENESIS_TIMESTAMP = 1583789617;
+const std::filesystem::path DATABASE_PATH{ "benchmark_database" };
+
+
+struct Engine
+{
+    std::string name;
+    base::StorageEngine engine;
+};
+
+const std::vector<Engine> ENGINES{ { "leveldb", base::StorageEngine::LEVELDB },
+                                   { "memory", base::StorageEngine::MEMORY } };
+
+
+base::Database openDatabase(const Engine& engine)
+{
+    base::DatabaseOptions options;
+    options.engine = engine.engine;
+    options.is_write_synced = false; // the engines are compared, not the disk
+    return base::createClearDatabaseInstance(DATABASE_PATH, options);
+}
+
+
+// hashes spread the keys over the key space, as block and transaction hashes do
+std::vector<base::Bytes> makeKeys(const std::string& seed)
+{
+    std::vector<base::Bytes> keys;
+    for (std::size_t i = 0; i < ENTRIES_COUNT; ++i) {
+        keys.push_back(base::Sha256::compute(base::Bytes(seed + std::to_string(i))).getBytes().toBytes());
+    }
+    return keys;
+}
+
+
+base::Bytes makeValue(std::size_t seed)
+{
+    base::Bytes value(VALUE_SIZE);
+    for (std::size_t i = 0; i < VALUE_SIZE; ++i) {
+        value[i] = static_cast<base::Byte>(seed + i);
+    }
+    return value;
+}
+
+
+void runOperations(const Engine& engine, const std::vector<base::Bytes>& keys, const std::vector<base::Bytes>& values)
+{
+    const auto suffix = ", " + engine.name;
+    auto database = openDatabase(engine);
+
+    base::Timer timer;
+    timer.start();
+    for (std::size_t i = 0; i < keys.size() / 2; ++i) {
+        database.put(keys[i], values[i]);
+    }
+    benchmark::report("put" + suffix, keys.size() / 2, timer);
+
+    timer.start();
+    for (std::size_t i = keys.size() / 2; i < keys.size(); i += WRITE_BATCH_SIZE) {
+        base::Database::Batch batch;
+        for (std::size_t j = i; j < std::min(i + WRITE_BATCH_SIZE, keys.size()); ++j) {
+            batch.put(keys[j], values[j]);
+        }
+        database.write(std::move(batch));
+    }
+    benchmark::report("put in batches of 100" + suffix, keys.size() - keys.size() / 2, timer);
+
+    std::string buffer;
+    timer.start();
+    std::size_t found = 0;
+    for (std::size_t i = 0; i < LOOKUPS_COUNT; ++i) {
+        found += database.get(keys[(i * 7919) % keys.size()], buffer);
+    }
+    benchmark::report("get of present key" + suffix, LOOKUPS_COUNT, timer);
+    ASSERT(found == LOOKUPS_COUNT);
+
+    const auto missing_keys = makeKeys("missing");
+    timer.start();
+    found = 0;
+    for (std::size_t i = 0; i < LOOKUPS_COUNT; ++i) {
+        found += database.exists(missing_keys[i % missing_keys.size()]);
+    }
+    benchmark::report("exists of missing key" + suffix, LOOKUPS_COUNT, timer);
+    ASSERT(found == 0);
+
+    timer.start();
+    std::size_t scanned = 0;
+    database.scan(base::Bytes{}, [&scanned](const leveldb::Slice&, const leveldb::Slice&) {
+        ++scanned;
+        return true;
+    });
+    benchmark::report("scan of all entries" + suffix, scanned, timer);
+    ASSERT(scanned == keys.size());
+
+    // a reader of a snapshot, while the entries are being rewritten
+    timer.start();
+    const auto snapshot = database.getSnapshot();
+    found = 0;
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        found += snapshot.get(keys[i], buffer);
+        database.put(keys[i], values[(i + 1) % values.size()]);
+    }
+    benchmark::report("get from snapshot and put" + suffix, keys.size(), timer);
+    ASSERT(found == keys.size());
+
+    timer.start();
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        database.remove(keys[i]);
+    }
+    benchmark::report("remove" + suffix, keys.size(), timer);
+}
+
+
+lk::ImmutableBlock makeBlock(lk::BlockDepth depth, const base::Sha256& prev_block_hash)
+{
+    lk::TransactionsSet txs;
+    txs.add(lk::Transaction{ lk::Address::null(),
+                             lk::Address::null(),
+                             depth + 1,
+                             0,
+                             base::Time(GENESIS_TIMESTAMP),
+                             base::Bytes{} });
+    // blocks come once in two minutes, so the complexity stays minimal and any block passes the consensus check
+    return lk::ImmutableBlock{ depth,
+                               0,
+                               prev_block_hash,
+                               base::Sha256::null(),
+                               base::Time(static_cast<std::uint_least32_t>(GENESIS_TIMESTAMP + depth * 120)),
+                               lk::Address::null(),
+                               std::move(txs) };
+}
+
+} // namespace
+
+
+BENCHMARK_CASE(storage_engines_operations)
+{
+    const auto keys = makeKeys("key");
+    std::vector<base::Bytes> values;
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        values.push_back(makeValue(i));
+    }
+    for (const auto& engine : ENGINES) {
+        runOperations(engine, keys, values);
+    }
+    std::filesystem::remove_all(DATABASE_PATH);
+}
+
+
+BENCHMARK_CASE(storage_engines_blockchain)
+{
+    std::vector<lk::ImmutableBlock> chain{ makeBlock(0, base::Sha256::null()) };
+    for (std::size_t depth = 1; depth <= CHAIN_HEIGHT; ++depth) {
+        chain.push_back(makeBlock(depth, chain.back().getHash()));
+    }
+
+    for (const auto& engine : ENGINES) {
+        const auto suffix = ", " + engine.name;
+        auto database = openDatabase(engine);
+        base::PropertyTree config;
+        {
+            lk::PersistentBlockchain blockchain{ chain.front(), database, config };
+            blockchain.load();
+            base::Timer timer;
+            timer.start();
+            for (std::size_t depth = 1; depth < chain.size(); ++depth) {
+                [[maybe_unused]] auto result = blockchain.tryAddBlock(chain[depth]);
+            }
+            benchmark::report("add block to persistent blockchain" + suffix, CHAIN_HEIGHT, timer);
+            ASSERT(blockchain.getTopBlock().getDepth() == CHAIN_HEIGHT);
+        }
+
+        lk::PersistentBlockchain blockchain{ chain.front(), database, config };
+        base::Timer timer;
+        timer.start();
+        blockchain.load();
+        benchmark::report("load persistent blockchain" + suffix, CHAIN_HEIGHT, timer);
+        ASSERT(blockchain.getTopBlock().getDepth() == CHAIN_HEIGHT);
+    }
+    std::filesystem::remove_all(DATABASE_PATH);
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "base/time.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace benchmark
+{
+
+class Registry
+{
+  public:
+    using Case = std::function<void()>;
+    //=================
+    static Registry& instance();
+    //=================
+    void add(std::string name, Case benchmark_case);
+    int run(const std::vector<std::string>& filters) const;
+    //=================
+  private:
+    Registry() = default;
+
+    std::vector<std::pair<std::string, Case>> _cases;
+};
+
+
+struct Registrar
+{
+    Registrar(std::string name, Registry::Case benchmark_case);
+};
+
+
+// prints a line "<name>: <operations> ops in <seconds> s (<rate> ops/s)"
+void report(const std::string& name, std::size_t operations, const base::Timer& timer);
+
+} // namespace benchmark
+
+
+#define BENCHMARK_CASE(name)                                                                                           \
+    static void name();                                                                                                \
+    static const ::benchmark::Registrar name##_registrar{ #name, &name };                                              \
+    static void name()
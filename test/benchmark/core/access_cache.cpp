@@ -0,0 +1,113 @@
+#include "benchmark.hpp"
+
+#include "base/assert.hpp"
+#include "core/access_cache.hpp"
+
+#include "vm/tools.hpp"
+
+namespace
+{
+
+constexpr std::size_t LOOP_ITERATIONS = 1'000'000;
+
+
+lk::Address makeAddress(std::size_t seed)
+{
+    return lk::Address(base::Ripemd160::compute(base::Bytes(std::to_string(seed))).getBytes());
+}
+
+
+// a token contract with the balance of the owner in the mapping "balances" at slot 0
+struct State
+{
+    lk::StateManager state_manager;
+    lk::Address owner{ makeAddress(0) };
+    lk::Address token{ lk::Address::null() };
+    lk::StorageKey balance_key;
+};
+
+
+void prepareState(State& state)
+{
+    state.state_manager.applyBlockEmission(state.owner, 1'000'000);
+    auto commit = state.state_manager.createCommit();
+    state.token = commit.createContractAccount(state.owner, base::Sha256::compute(base::Bytes("token")));
+    commit.setRuntimeCode(state.token, base::Bytes("runtime"));
+
+    // the slot of balances[owner] is keccak256(owner . 0)
+    base::Bytes mapping_entry(64);
+    std::copy_n(state.owner.getBytes().getData(), lk::Address::LENGTH_IN_BYTES, mapping_entry.getData() + 12);
+    state.balance_key = base::Keccak256::compute(mapping_entry).getBytes();
+    commit.setStorageValue(state.token, state.balance_key, base::Sha256::compute(base::Bytes("balance")).getBytes());
+    state.state_manager.applyCommit(std::move(commit));
+}
+
+
+evmc::bytes32 toEvmcBytes32(const lk::StorageKey& key)
+{
+    evmc::bytes32 word;
+    std::copy_n(key.getData(), sizeof(word.bytes), word.bytes);
+    return word;
+}
+
+} // namespace
+
+
+// "for (...) total += balances[owner]" and "for (...) total += token.balanceOf(owner)": the same mapping entry is
+// read on every iteration, in the second loop from a new call frame with a check of the code size before it; the
+// host callbacks are served the way EthHost does it
+BENCHMARK_CASE(access_cache_mapping_reads)
+{
+    State state;
+    prepareState(state);
+    const auto token = vm::toEthAddress(state.token);
+    const auto key = toEvmcBytes32(state.balance_key);
+    const lk::StorageKey storage_key(key.bytes, sizeof(key.bytes));
+
+    {
+        // every callback converts the address through base::Bytes and walks through the commit
+        auto commit = state.state_manager.createCommit();
+        std::size_t found = 0;
+        base::Timer timer;
+        timer.start();
+        for (std::size_t i = 0; i < LOOP_ITERATIONS; ++i) {
+            lk::Address address{ base::Bytes(token.bytes, lk::Address::LENGTH_IN_BYTES) };
+            if (commit.hasAccount(address)) {
+                found += commit.getStorageValue(address, storage_key).was_modified;
+            }
+        }
+        benchmark::report("mapping read through Commit", LOOP_ITERATIONS, timer);
+
+        timer.start();
+        for (std::size_t i = 0; i < LOOP_ITERATIONS; ++i) {
+            lk::Address address{ base::Bytes(token.bytes, lk::Address::LENGTH_IN_BYTES) };
+            if (commit.hasAccount(address) && commit.getCodeSize(address) > 0) {
+                lk::ContractStorage storage(commit, address); // of the new frame
+                found += storage.find(storage_key) != nullptr;
+            }
+        }
+        benchmark::report("balanceOf call through Commit", LOOP_ITERATIONS, timer);
+        ASSERT(found == 2 * LOOP_ITERATIONS);
+    }
+    {
+        auto commit = state.state_manager.createCommit();
+        lk::AccessCache accesses(commit);
+        std::size_t found = 0;
+        base::Timer timer;
+        timer.start();
+        for (std::size_t i = 0; i < LOOP_ITERATIONS; ++i) {
+            found += accesses.getStorage(vm::toNativeAddress(token)).find(storage_key) != nullptr;
+        }
+        benchmark::report("mapping read through AccessCache", LOOP_ITERATIONS, timer);
+
+        timer.start();
+        for (std::size_t i = 0; i < LOOP_ITERATIONS; ++i) {
+            auto address = vm::toNativeAddress(token);
+            if (accesses.hasAccount(address) && commit.getCodeSize(address) > 0) {
+                found += accesses.getStorage(vm::toNativeAddress(token)).find(storage_key) != nullptr;
+            }
+        }
+        benchmark::report("balanceOf call through AccessCache", LOOP_ITERATIONS, timer);
+        ASSERT(found == 2 * LOOP_ITERATIONS);
+    }
+}
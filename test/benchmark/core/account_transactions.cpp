@@ -0,0 +1,83 @@
+#include "benchmark.hpp"
+
+#include "base/assert.hpp"
+#include "core/managers.hpp"
+#include "websocket/tools.hpp"
+
+#include <random>
+
+namespace
+{
+
+constexpr std::size_t ACCOUNT_TRANSACTIONS_COUNT = 1'000'000;
+constexpr std::size_t FLUSH_PERIOD = 1'000;
+constexpr std::size_t REQUESTS_COUNT = 10'000;
+constexpr std::size_t WHOLE_HISTORY_REQUESTS_COUNT = 20;
+const std::filesystem::path DATABASE_PATH{ "benchmark_database" };
+
+} // namespace
+
+
+BENCHMARK_CASE(account_transactions_pages)
+{
+    auto database = base::createClearDatabaseInstance(DATABASE_PATH);
+    {
+        lk::StateManager state_manager{ database };
+        const lk::Address address{ base::Ripemd160::compute(base::Bytes("sender")).getBytes() };
+        state_manager.applyBlockEmission(address, 1);
+
+        std::vector<base::Sha256> all_hashes;
+        all_hashes.reserve(ACCOUNT_TRANSACTIONS_COUNT);
+        base::Timer timer;
+        timer.start();
+        for (std::size_t i = 0; i < ACCOUNT_TRANSACTIONS_COUNT; ++i) {
+            auto commit = state_manager.createCommit();
+            all_hashes.push_back(base::Sha256::compute(base::toBytes(i)));
+            commit.addTxHash(address, all_hashes.back());
+            state_manager.applyCommit(std::move(commit));
+            if ((i + 1) % FLUSH_PERIOD == 0) {
+                base::Database::Batch batch;
+                state_manager.flush(batch);
+                database.write(std::move(batch));
+            }
+        }
+        benchmark::report("apply and store transaction of the account", ACCOUNT_TRANSACTIONS_COUNT, timer);
+
+        // the answer to account_info before the history was paged: every hash the account has ever sent
+        std::size_t answers_size = 0;
+        timer.start();
+        for (std::size_t i = 0; i < WHOLE_HISTORY_REQUESTS_COUNT; ++i) {
+            auto info = state_manager.getAccountInfo(address);
+            info.transactions_hashes = all_hashes;
+            answers_size += websocket::serializeAccountInfo(info).toString().size();
+        }
+        benchmark::report("account info with the whole history", WHOLE_HISTORY_REQUESTS_COUNT, timer);
+        ASSERT(answers_size > 0);
+
+        timer.start();
+        for (std::size_t i = 0; i < REQUESTS_COUNT; ++i) {
+            auto info = state_manager.getAccountInfo(address);
+            info.transactions_hashes = state_manager.getTransactionsHashes(
+              address, info.transactions_count - base::config::RPC_ACCOUNT_TRANSACTIONS_PAGE_SIZE,
+              base::config::RPC_ACCOUNT_TRANSACTIONS_PAGE_SIZE);
+            ASSERT(info.transactions_hashes.size() == base::config::RPC_ACCOUNT_TRANSACTIONS_PAGE_SIZE);
+            answers_size += websocket::serializeAccountInfo(info).toString().size();
+        }
+        benchmark::report("account info with the latest page", REQUESTS_COUNT, timer);
+
+        std::mt19937_64 rng{ 2020 };
+        std::uniform_int_distribution<std::uint64_t> distribution{
+            0, ACCOUNT_TRANSACTIONS_COUNT - base::config::RPC_ACCOUNT_TRANSACTIONS_PAGE_SIZE
+        };
+        timer.start();
+        for (std::size_t i = 0; i < REQUESTS_COUNT; ++i) {
+            auto info = state_manager.getAccountInfo(address);
+            info.transactions_hashes = state_manager.getTransactionsHashes(
+              address, distribution(rng), base::config::RPC_ACCOUNT_TRANSACTIONS_PAGE_SIZE);
+            ASSERT(info.transactions_hashes.size() == base::config::RPC_ACCOUNT_TRANSACTIONS_PAGE_SIZE);
+            answers_size += websocket::serializeAccountInfo(info).toString().size();
+        }
+        benchmark::report("account info with a random page", REQUESTS_COUNT, timer);
+    }
+    std::filesystem::remove_all(DATABASE_PATH);
+}
@@ -0,0 +1,105 @@
+#include "benchmark.hpp"
+
+#include "core/managers.hpp"
+
+#include <map>
+#include <random>
+#include <unordered_map>
+
+namespace
+{
+
+constexpr std::size_t ACCOUNTS_COUNT = 1'000'000;
+constexpr std::size_t LOOKUPS_COUNT = 5'000'000;
+
+
+std::vector<lk::Address> makeAddresses()
+{
+    std::vector<lk::Address> addresses;
+    addresses.reserve(ACCOUNTS_COUNT);
+    for (std::size_t i = 0; i < ACCOUNTS_COUNT; ++i) {
+        addresses.emplace_back(base::Ripemd160::compute(base::Bytes(std::to_string(i))).getBytes());
+    }
+    return addresses;
+}
+
+
+std::vector<std::size_t> makeLookupOrder()
+{
+    std::mt19937_64 rng{ 2020 };
+    std::uniform_int_distribution<std::size_t> distribution{ 0, ACCOUNTS_COUNT - 1 };
+    std::vector<std::size_t> order(LOOKUPS_COUNT);
+    for (auto& index : order) {
+        index = distribution(rng);
+    }
+    return order;
+}
+
+
+template<typename Map>
+void runLookups(const std::string& name, const Map& map, const std::vector<lk::Address>& addresses)
+{
+    auto order = makeLookupOrder();
+    std::size_t found = 0;
+
+    base::Timer timer;
+    timer.start();
+    for (auto index : order) {
+        found += map.find(addresses[index]) != map.end();
+    }
+    benchmark::report(name, found, timer);
+}
+
+} // namespace
+
+
+BENCHMARK_CASE(accounts_lookup_containers)
+{
+    const auto addresses = makeAddresses();
+
+    {
+        std::map<lk::Address, lk::Balance> map;
+        for (const auto& address : addresses) {
+            map.insert({ address, 1 });
+        }
+        runLookups("std::map lookups at 1M accounts", map, addresses);
+    }
+    {
+        std::unordered_map<lk::Address, lk::Balance> map;
+        for (const auto& address : addresses) {
+            map.insert({ address, 1 });
+        }
+        runLookups("std::unordered_map lookups at 1M accounts", map, addresses);
+    }
+    {
+        lk::AddressMap<lk::Balance> map;
+        for (const auto& address : addresses) {
+            map.insert({ address, 1 });
+        }
+        runLookups("lk::AddressMap lookups at 1M accounts", map, addresses);
+    }
+}
+
+
+BENCHMARK_CASE(accounts_lookup_state_manager)
+{
+    const auto addresses = makeAddresses();
+
+    lk::StateManager state_manager;
+    {
+        auto commit = state_manager.createCommit();
+        for (const auto& address : addresses) {
+            commit.createClientAccount(address);
+        }
+        state_manager.applyCommit(std::move(commit));
+    }
+
+    auto order = makeLookupOrder();
+    lk::Balance total;
+    base::Timer timer;
+    timer.start();
+    for (auto index : order) {
+        total += state_manager.getBalance(addresses[index]);
+    }
+    benchmark::report("StateManager::getBalance at 1M accounts", order.size(), timer);
+}
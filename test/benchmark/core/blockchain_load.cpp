@@ -0,0 +1,149 @@
+#include "benchmark.hpp"
+
+#include "base/assert.hpp"
+#include "core/blockchain.hpp"
+#include "core/database_keys.hpp"
+
+#include <algorithm>
+
+namespace
+{
+
+constexpr std::size_t TRANSACTIONS_IN_BLOCK = 10;
+constexpr std::uint_least32_t GENESIS_TIMESTAMP = 1583789617;
+const std::filesystem::path DATABASE_PATH{ "benchmark_database" };
+
+
+lk::TransactionsSet makeTransactions(std::size_t seed)
+{
+    lk::TransactionsSet txs;
+    for (std::size_t i = 0; i < TRANSACTIONS_IN_BLOCK; ++i) {
+        txs.add(lk::Transaction{ lk::Address::null(),
+                                 lk::Address::null(),
+                                 seed * TRANSACTIONS_IN_BLOCK + i + 1,
+                                 0,
+                                 base::Time(GENESIS_TIMESTAMP),
+                                 base::Bytes{} });
+    }
+    return txs;
+}
+
+
+// blocks come once in two minutes, so the complexity stays minimal and any block passes the consensus check
+std::vector<lk::ImmutableBlock> makeChain(std::size_t height)
+{
+    std::vector<lk::ImmutableBlock> chain{ lk::ImmutableBlock{ 0,
+                                                               0,
+                                                               base::Sha256::null(),
+                                                               base::Sha256::null(),
+                                                               base::Time(GENESIS_TIMESTAMP),
+                                                               lk::Address::null(),
+                                                               makeTransactions(0) } };
+    for (std::size_t depth = 1; depth <= height; ++depth) {
+        const auto& top = chain.back();
+        chain.push_back(lk::ImmutableBlock{ depth,
+                                            0,
+                                            top.getHash(),
+                                            base::Sha256::null(),
+                                            base::Time(top.getTimestamp().getSeconds() + 120),
+                                            lk::Address::null(),
+                                            makeTransactions(depth) });
+    }
+    return chain;
+}
+
+
+base::Bytes makeHashKey(const std::string& prefix, const base::Sha256& hash)
+{
+    return base::Bytes(prefix) + hash.getBytes().toBytes();
+}
+
+
+// the layout used before: blocks and links to their parents keyed by block hash, and the top block hash
+void storeByHash(const std::vector<lk::ImmutableBlock>& chain)
+{
+    auto database = base::createClearDatabaseInstance(DATABASE_PATH);
+    base::Database::Batch batch;
+    for (std::size_t depth = 1; depth < chain.size(); ++depth) {
+        const auto hash = chain[depth].getHash();
+        batch.put(makeHashKey("b", hash), base::toBytes(chain[depth]));
+        batch.put(makeHashKey("p", hash), chain[depth].getPrevBlockHash().getBytes());
+    }
+    batch.put(base::Bytes("last"), chain.back().getHash().getBytes());
+    database.write(std::move(batch));
+}
+
+
+// the loading used before: walking back through point lookups, then reading, validating and checking every block
+std::size_t loadByHash(const lk::ImmutableBlock& genesis)
+{
+    base::Database database(DATABASE_PATH);
+    base::PropertyTree config;
+    lk::Blockchain blockchain{ genesis, config };
+
+    std::vector<base::Sha256> hashes;
+    for (base::Sha256 hash{ *database.get(base::Bytes("last")) }; hash != genesis.getHash();
+         hash = base::Sha256{ *database.get(makeHashKey("p", hash)) }) {
+        hashes.push_back(hash);
+    }
+    std::reverse(hashes.begin(), hashes.end());
+
+    for (const auto& hash : hashes) {
+        auto block = base::fromBytes<lk::ImmutableBlock>(*database.get(makeHashKey("b", hash)));
+        blockchain.tryAddBlock(block);
+        [[maybe_unused]] auto is_stored = database.exists(makeHashKey("b", hash));
+    }
+    return blockchain.getTopBlock().getDepth();
+}
+
+
+void storeByDepth(const std::vector<lk::ImmutableBlock>& chain)
+{
+    auto database = base::createClearDatabaseInstance(DATABASE_PATH);
+    base::Database::Batch batch;
+    for (std::size_t depth = 1; depth < chain.size(); ++depth) {
+        batch.put(lk::makeDatabaseKey(lk::DataType::BLOCK, depth), base::toBytes(chain[depth]));
+    }
+    database.write(std::move(batch));
+}
+
+
+std::size_t loadByDepth(const lk::ImmutableBlock& genesis, bool is_trusted)
+{
+    base::Database database(DATABASE_PATH);
+    base::PropertyTree config;
+    config.add("database.trusted", is_trusted);
+    lk::PersistentBlockchain blockchain{ genesis, database, config };
+    blockchain.load();
+    return blockchain.getTopBlock().getDepth();
+}
+
+} // namespace
+
+
+BENCHMARK_CASE(blockchain_load_time_by_height)
+{
+    for (std::size_t height : { 1'000, 4'000, 16'000 }) {
+        const auto chain = makeChain(height);
+        const auto suffix = ", height " + std::to_string(height);
+
+        storeByHash(chain);
+        base::Timer timer;
+        timer.start();
+        auto loaded_height = loadByHash(chain.front());
+        benchmark::report("walk back by hash, validate" + suffix, height, timer);
+        ASSERT(loaded_height == height);
+
+        storeByDepth(chain);
+        timer.start();
+        loaded_height = loadByDepth(chain.front(), false);
+        benchmark::report("scan by depth, validate" + suffix, height, timer);
+        ASSERT(loaded_height == height);
+
+        timer.start();
+        loaded_height = loadByDepth(chain.front(), true);
+        benchmark::report("scan by depth, trusted" + suffix, height, timer);
+        ASSERT(loaded_height == height);
+    }
+    std::filesystem::remove_all(DATABASE_PATH);
+}
@@ -0,0 +1,149 @@
+#include "benchmark.hpp"
+
+#include "base/assert.hpp"
+#include "core/blockchain.hpp"
+#include "core/database_keys.hpp"
+
+#include <iostream>
+#include <random>
+
+#include <malloc.h>
+
+namespace
+{
+
+constexpr std::size_t HEIGHT = 200'000;
+constexpr std::size_t WRITE_BATCH_SIZE = 10'000;
+constexpr std::size_t LOOKUPS_COUNT = 100'000;
+constexpr std::size_t RECENT_BLOCKS_COUNT = 1'000;
+constexpr std::size_t BLOCKS_CACHE_SIZE = 16 * 1024 * 1024;
+constexpr std::uint_least32_t GENESIS_TIMESTAMP = 1583789617;
+const std::filesystem::path DATABASE_PATH{ "benchmark_database" };
+
+
+// heap in use, which unlike the resident memory doesn't depend on what was freed before
+std::size_t getAllocatedMemory()
+{
+    const auto info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+
+void reportMemory(const std::string& name, std::size_t bytes)
+{
+    std::cout << name << ": " << bytes / (1024 * 1024) << " MB" << std::endl;
+}
+
+
+lk::ImmutableBlock makeBlock(lk::BlockDepth depth, const base::Sha256& prev_block_hash)
+{
+    lk::TransactionsSet txs;
+    txs.add(lk::Transaction{ lk::Address::null(),
+                             lk::Address::null(),
+                             depth + 1,
+                             0,
+                             base::Time(GENESIS_TIMESTAMP),
+                             base::Bytes{} });
+    // blocks come once in two minutes, so the complexity stays minimal and any block passes the consensus check
+    return lk::ImmutableBlock{ depth,
+                               0,
+                               prev_block_hash,
+                               base::Sha256::null(),
+                               base::Time(static_cast<std::uint_least32_t>(GENESIS_TIMESTAMP + depth * 120)),
+                               lk::Address::null(),
+                               std::move(txs) };
+}
+
+
+// stores the chain the way PersistentBlockchain does, without keeping it in memory
+void storeChain(const lk::ImmutableBlock& genesis)
+{
+    auto database = base::createClearDatabaseInstance(DATABASE_PATH);
+    auto prev_block_hash = genesis.getHash();
+    base::Database::Batch batch;
+    for (lk::BlockDepth depth = 1; depth <= HEIGHT; ++depth) {
+        auto block = makeBlock(depth, prev_block_hash);
+        for (const auto& tx : block.getTransactions()) {
+            batch.put(lk::makeDatabaseKey(lk::DataType::TRANSACTION_BLOCK_DEPTH, tx.hashOfTransaction().getBytes()),
+                      base::toBytes(depth));
+        }
+        batch.put(lk::makeDatabaseKey(lk::DataType::BLOCK, depth), base::toBytes(block));
+        prev_block_hash = block.getHash();
+        if (depth % WRITE_BATCH_SIZE == 0) {
+            database.write(std::move(batch));
+            batch = base::Database::Batch{};
+        }
+    }
+    database.write(std::move(batch));
+}
+
+
+template<typename C>
+void runLookups(const C& blockchain, const std::string& name, std::size_t first_depth)
+{
+    std::mt19937_64 rng{ 2020 };
+    std::uniform_int_distribution<lk::BlockDepth> distribution{ first_depth, HEIGHT };
+    std::vector<base::Sha256> hashes;
+    for (std::size_t i = 0; i < LOOKUPS_COUNT; ++i) {
+        hashes.push_back(*blockchain.findBlockHashByDepth(distribution(rng)));
+    }
+
+    base::Timer timer;
+    timer.start();
+    std::size_t found = 0;
+    for (const auto& hash : hashes) {
+        found += blockchain.findBlock(hash).has_value();
+    }
+    benchmark::report(name, LOOKUPS_COUNT, timer);
+    ASSERT(found == LOOKUPS_COUNT);
+}
+
+} // namespace
+
+
+BENCHMARK_CASE(blocks_cache_memory_and_lookups)
+{
+    const auto genesis = makeBlock(0, base::Sha256::null());
+    storeChain(genesis);
+
+    {
+        base::PropertyTree config;
+        config.add("database.trusted", true);
+        config.add("database.blocks_cache_size", BLOCKS_CACHE_SIZE);
+        base::Database database(DATABASE_PATH);
+        const auto memory_before_load = getAllocatedMemory();
+        lk::PersistentBlockchain blockchain{ genesis, database, config };
+        blockchain.load();
+        ASSERT(blockchain.getTopBlock().getDepth() == HEIGHT);
+        reportMemory("persistent blockchain with 16MB blocks cache, loaded " + std::to_string(HEIGHT) + " blocks",
+                     getAllocatedMemory() - memory_before_load);
+
+        runLookups(blockchain, "findBlock of recent blocks, persistent", HEIGHT - RECENT_BLOCKS_COUNT);
+        runLookups(blockchain, "findBlock of any blocks, persistent", 1);
+        const auto statistics = blockchain.getBlocksCacheStatistics();
+        std::cout << "blocks cache: " << statistics.hits << " hits, " << statistics.misses << " misses, "
+                  << statistics.blocks_count << " blocks" << std::endl;
+    }
+
+    // all bodies in memory, as every blockchain kept them before
+    {
+        base::PropertyTree config;
+        base::Database database(DATABASE_PATH);
+        const auto memory_before_load = getAllocatedMemory();
+        lk::Blockchain blockchain{ genesis, config };
+        database.scan(lk::makeDatabaseKey(lk::DataType::BLOCK, base::Bytes{}),
+                      [&blockchain](const leveldb::Slice&, const leveldb::Slice& value) {
+                          blockchain.tryAddBlock(base::fromBytes<lk::ImmutableBlock>(
+                            base::Bytes(reinterpret_cast<const base::Byte*>(value.data()), value.size())));
+                          return true;
+                      });
+        ASSERT(blockchain.getTopBlock().getDepth() == HEIGHT);
+        reportMemory("in-memory blockchain, loaded " + std::to_string(HEIGHT) + " blocks",
+                     getAllocatedMemory() - memory_before_load);
+
+        runLookups(blockchain, "findBlock of recent blocks, in-memory", HEIGHT - RECENT_BLOCKS_COUNT);
+        runLookups(blockchain, "findBlock of any blocks, in-memory", 1);
+    }
+
+    std::filesystem::remove_all(DATABASE_PATH);
+}
@@ -0,0 +1,117 @@
+#include "benchmark.hpp"
+
+#include "base/assert.hpp"
+#include "base/config.hpp"
+#include "core/managers.hpp"
+
+namespace
+{
+
+constexpr std::size_t CALL_CHAINS = 100;
+constexpr std::size_t CALL_DEPTH = base::config::VM_MAX_CALL_DEPTH;
+
+
+lk::Address makeAddress(std::size_t seed)
+{
+    return lk::Address(base::Ripemd160::compute(base::Bytes(std::to_string(seed))).getBytes());
+}
+
+
+lk::StorageKey makeKey(std::size_t seed)
+{
+    return base::Sha256::compute(base::Bytes(std::to_string(seed))).getBytes();
+}
+
+
+// a contract, which calls itself recursively, writes the slot of the depth and sends 1 coin to the caller
+struct State
+{
+    lk::StateManager state_manager;
+    lk::Address caller{ makeAddress(0) };
+    lk::Address contract{ lk::Address::null() };
+    std::vector<lk::StorageKey> keys;
+};
+
+
+void prepareState(State& state)
+{
+    state.state_manager.applyBlockEmission(state.caller, 1'000'000);
+    auto commit = state.state_manager.createCommit();
+    state.contract = commit.createContractAccount(state.caller, base::Sha256::compute(base::Bytes("recursive")));
+    ASSERT(commit.tryTransferMoney(state.caller, state.contract, 1'000'000));
+    for (std::size_t i = 0; i < CALL_DEPTH; ++i) {
+        state.keys.push_back(makeKey(i));
+        commit.setStorageValue(state.contract, state.keys.back(), makeKey(CALL_DEPTH + i));
+    }
+    state.state_manager.applyCommit(std::move(commit));
+}
+
+
+void runFrame(const State& state, lk::Commit& commit, std::size_t depth)
+{
+    commit.setStorageValue(state.contract, state.keys[depth], state.keys[depth]);
+    ASSERT(commit.tryTransferMoney(state.contract, state.caller, 1));
+}
+
+
+// every frame is a child commit, which is applied to the parent one when the frame succeeds
+void callWithChildCommits(const State& state, lk::Commit& parent, std::size_t depth, std::size_t failing_depth)
+{
+    auto frame = parent.createCommit();
+    runFrame(state, frame, depth);
+    if (depth + 1 < CALL_DEPTH) {
+        callWithChildCommits(state, frame, depth + 1, failing_depth);
+    }
+    if (depth != failing_depth) {
+        parent.applyCommit(std::move(frame));
+    }
+}
+
+
+// every frame is a savepoint of the same commit
+void callWithSavepoints(const State& state, lk::Commit& commit, std::size_t depth, std::size_t failing_depth)
+{
+    auto savepoint = commit.createSavepoint();
+    runFrame(state, commit, depth);
+    if (depth + 1 < CALL_DEPTH) {
+        callWithSavepoints(state, commit, depth + 1, failing_depth);
+    }
+    if (depth != failing_depth) {
+        commit.releaseSavepoint(savepoint);
+    }
+    else {
+        commit.revertToSavepoint(savepoint);
+    }
+}
+
+
+template<typename F>
+void runCallChains(State& state, const std::string& name, std::size_t failing_depth, F&& call)
+{
+    base::Timer timer;
+    timer.start();
+    for (std::size_t i = 0; i < CALL_CHAINS; ++i) {
+        auto commit = state.state_manager.createCommit();
+        call(state, commit, 0, failing_depth);
+        ASSERT(commit.getBalance(state.caller) == std::min(failing_depth, CALL_DEPTH));
+    }
+    benchmark::report(name, CALL_CHAINS * CALL_DEPTH, timer);
+}
+
+} // namespace
+
+
+// a chain of CALL_DEPTH nested calls, in which every frame writes storage and transfers money; it either succeeds
+// or the deepest or the middle frame fails, rewinding the writes of the frames below it
+BENCHMARK_CASE(call_frames_deep_chain)
+{
+    State state;
+    prepareState(state);
+
+    for (auto [failing_depth, description] : { std::pair{ CALL_DEPTH, "all frames succeed" },
+                                               std::pair{ CALL_DEPTH - 1, "deepest frame fails" },
+                                               std::pair{ CALL_DEPTH / 2, "middle frame fails" } }) {
+        runCallChains(state, std::string{ "child commits: " } + description, failing_depth, callWithChildCommits);
+        runCallChains(state, std::string{ "savepoints: " } + description, failing_depth, callWithSavepoints);
+    }
+}
@@ -0,0 +1,95 @@
+#include "benchmark.hpp"
+
+#include "base/assert.hpp"
+#include "core/managers.hpp"
+
+namespace
+{
+
+constexpr std::size_t CALLS_COUNT = 1'000'000;
+constexpr std::size_t BLOCKS_COUNT = 1'000;
+constexpr std::size_t CODE_SIZE = 12 * 1024; // a token contract with a few extensions
+
+
+lk::Address makeAddress(std::size_t seed)
+{
+    return lk::Address(base::Ripemd160::compute(base::Bytes(std::to_string(seed))).getBytes());
+}
+
+
+lk::StorageKey makeKey(std::size_t seed)
+{
+    return base::Sha256::compute(base::Bytes(std::to_string(seed))).getBytes();
+}
+
+
+// stands for the VM, which reads the code
+std::size_t execute(const base::Bytes& code)
+{
+    return code[0] + code[code.size() - 1];
+}
+
+} // namespace
+
+
+// the same contract is called in every transaction: the host looks up its code and hands it to the VM, and at the
+// end of every block the state root is updated with the changed storage of the contract
+BENCHMARK_CASE(code_store_repeated_calls)
+{
+    lk::StateManager state_manager;
+    auto owner = makeAddress(0);
+    state_manager.applyBlockEmission(owner, 1'000'000);
+    lk::Address token{ lk::Address::null() };
+    {
+        auto commit = state_manager.createCommit();
+        token = commit.createContractAccount(owner, base::Sha256::compute(base::Bytes("token")));
+        base::Bytes code(CODE_SIZE);
+        for (std::size_t i = 0; i < CODE_SIZE; ++i) {
+            code[i] = static_cast<base::Byte>(i);
+        }
+        commit.setRuntimeCode(token, std::move(code));
+        state_manager.applyCommit(std::move(commit));
+    }
+
+    {
+        auto commit = state_manager.createCommit();
+        std::size_t executed = 0;
+        base::Timer timer;
+        timer.start();
+        for (std::size_t i = 0; i < CALLS_COUNT; ++i) {
+            base::Bytes code = commit.getRuntimeCode(token)->getBytes();
+            executed += execute(code);
+        }
+        benchmark::report("call with the code copied out of the account", CALLS_COUNT, timer);
+
+        timer.start();
+        for (std::size_t i = 0; i < CALLS_COUNT; ++i) {
+            auto code = commit.getRuntimeCode(token);
+            executed -= execute(code->getBytes());
+        }
+        benchmark::report("call with the shared code", CALLS_COUNT, timer);
+        ASSERT(executed == 0);
+    }
+
+    const auto code = state_manager.createCommit().getRuntimeCode(token);
+    base::Timer timer;
+    timer.start();
+    for (std::size_t block = 0; block < BLOCKS_COUNT; ++block) {
+        auto commit = state_manager.createCommit();
+        commit.setStorageValue(token, makeKey(block % 10), makeKey(block));
+        state_manager.applyCommit(std::move(commit));
+        state_manager.updateStateRoot();
+        // the account hash used to hash the code again
+        ASSERT(base::Sha256::compute(code->getBytes()) != base::Sha256::null());
+    }
+    benchmark::report("state root update with the code hashed again", BLOCKS_COUNT, timer);
+
+    timer.start();
+    for (std::size_t block = 0; block < BLOCKS_COUNT; ++block) {
+        auto commit = state_manager.createCommit();
+        commit.setStorageValue(token, makeKey(block % 10), makeKey(BLOCKS_COUNT + block));
+        state_manager.applyCommit(std::move(commit));
+        state_manager.updateStateRoot();
+    }
+    benchmark::report("state root update with the stored code hash", BLOCKS_COUNT, timer);
+}
@@ -0,0 +1,95 @@
+#include "benchmark.hpp"
+
+#include "core/managers.hpp"
+
+namespace
+{
+
+constexpr std::size_t CONTRACT_STORAGE_SLOTS = 100'000;
+constexpr std::size_t COMMITS_COUNT = 10'000;
+
+
+lk::Address makeAddress(std::size_t seed)
+{
+    return lk::Address(base::Ripemd160::compute(base::Bytes(std::to_string(seed))).getBytes());
+}
+
+
+lk::StorageKey makeKey(std::size_t seed)
+{
+    return base::Sha256::compute(base::Bytes(std::to_string(seed))).getBytes();
+}
+
+
+// fills a StateManager with one funded client and one contract holding CONTRACT_STORAGE_SLOTS storage slots
+lk::Address prepareState(lk::StateManager& state_manager, const lk::Address& client)
+{
+    lk::TransactionsSet txs;
+    txs.add({ lk::Address::null(), client, lk::Balance{ 1 } << 64, 0, base::Time(), base::Bytes{} });
+
+    lk::BlockBuilder b;
+    b.setDepth(0);
+    b.setNonce(0);
+    b.setPrevBlockHash(base::Sha256::null());
+    b.setStateRoot(base::Sha256::null());
+    b.setTimestamp(base::Time());
+    b.setCoinbase(client);
+    b.setTransactionsSet(std::move(txs));
+    state_manager.updateFromGenesis(std::move(b).buildImmutable());
+
+    auto commit = state_manager.createCommit();
+    auto contract = commit.createContractAccount(client, base::Sha256::compute(base::Bytes("contract")));
+    for (std::size_t i = 0; i < CONTRACT_STORAGE_SLOTS; ++i) {
+        commit.setStorageValue(contract, makeKey(i), lk::StorageValue{});
+    }
+    state_manager.applyCommit(std::move(commit));
+    return contract;
+}
+
+} // namespace
+
+
+// models a contract call: a few storage reads, one storage write and a value transfer per commit
+BENCHMARK_CASE(commit_call_large_contract)
+{
+    lk::StateManager state_manager;
+    const auto client = makeAddress(0);
+    const auto contract = prepareState(state_manager, client);
+
+    std::vector<lk::StorageKey> keys;
+    for (std::size_t i = 0; i < COMMITS_COUNT; ++i) {
+        keys.push_back(makeKey((i * 7919) % CONTRACT_STORAGE_SLOTS));
+    }
+
+    base::Timer timer;
+    timer.start();
+    for (std::size_t i = 0; i < COMMITS_COUNT; ++i) {
+        auto commit = state_manager.createCommit();
+        for (std::size_t j = 0; j < 4; ++j) {
+            [[maybe_unused]] const auto& value = commit.getStorageValue(contract, keys[(i + j) % keys.size()]);
+        }
+        commit.setStorageValue(contract, keys[i], makeKey(i));
+        commit.tryTransferMoney(client, contract, 1);
+        state_manager.applyCommit(std::move(commit));
+    }
+    benchmark::report("commit+apply with 100k-slot contract", COMMITS_COUNT, timer);
+}
+
+
+// reverted calls: commit is created, written to and dropped
+BENCHMARK_CASE(commit_revert_large_contract)
+{
+    lk::StateManager state_manager;
+    const auto client = makeAddress(0);
+    const auto contract = prepareState(state_manager, client);
+    const auto key = makeKey(42);
+
+    base::Timer timer;
+    timer.start();
+    for (std::size_t i = 0; i < COMMITS_COUNT; ++i) {
+        auto commit = state_manager.createCommit();
+        commit.setStorageValue(contract, key, makeKey(i));
+        commit.tryTransferMoney(client, contract, 1);
+    }
+    benchmark::report("reverted commit with 100k-slot contract", COMMITS_COUNT, timer);
+}
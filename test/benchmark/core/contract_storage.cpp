@@ -0,0 +1,139 @@
+#include "benchmark.hpp"
+
+#include "core/managers.hpp"
+
+#include "vm/tools.hpp"
+
+namespace
+{
+
+constexpr std::size_t CONTRACT_STORAGE_SLOTS = 1'000;
+constexpr std::size_t LOOP_ITERATIONS = 1'000'000;
+
+
+lk::Address makeAddress(std::size_t seed)
+{
+    return lk::Address(base::Ripemd160::compute(base::Bytes(std::to_string(seed))).getBytes());
+}
+
+
+// storage slots of plain contract variables and arrays: big-endian small numbers
+evmc::bytes32 toWord(std::size_t value)
+{
+    evmc::bytes32 word{};
+    for (std::size_t i = 0; i < sizeof(value); ++i) {
+        word.bytes[sizeof(word.bytes) - 1 - i] = static_cast<std::uint8_t>(value >> (8 * i));
+    }
+    return word;
+}
+
+
+evmc::bytes32 increment(evmc::bytes32 word)
+{
+    for (auto i = sizeof(word.bytes); i > 0; --i) {
+        if (++word.bytes[i - 1] != 0) {
+            break;
+        }
+    }
+    return word;
+}
+
+
+base::FixedBytes<32> toFixedBytes(const evmc::bytes32& word)
+{
+    return base::FixedBytes<32>(word.bytes, sizeof(word.bytes));
+}
+
+
+// a contract with CONTRACT_STORAGE_SLOTS set slots
+lk::Address prepareState(lk::StateManager& state_manager)
+{
+    const auto client = makeAddress(0);
+    state_manager.applyBlockEmission(client, 1'000'000);
+    auto commit = state_manager.createCommit();
+    auto contract = commit.createContractAccount(client, base::Sha256::compute(base::Bytes("contract")));
+    for (std::size_t i = 0; i < CONTRACT_STORAGE_SLOTS; ++i) {
+        commit.setStorageValue(contract, toFixedBytes(toWord(i)), toFixedBytes(toWord(i + 1)));
+    }
+    state_manager.applyCommit(std::move(commit));
+    return contract;
+}
+
+
+template<typename K, typename Hash>
+void runSlotsLookups(const std::string& name, std::size_t lookups_count)
+{
+    base::HashMap<K, lk::StorageData, Hash> storage;
+    for (std::size_t i = 0; i < CONTRACT_STORAGE_SLOTS; ++i) {
+        storage[toFixedBytes(toWord(i))].was_modified = true;
+    }
+
+    std::vector<K> keys;
+    for (std::size_t i = 0; i < CONTRACT_STORAGE_SLOTS; ++i) {
+        keys.push_back(K(toFixedBytes(toWord(i * 7 % CONTRACT_STORAGE_SLOTS))));
+    }
+
+    std::size_t found = 0;
+    base::Timer timer;
+    timer.start();
+    for (std::size_t i = 0; i < lookups_count; ++i) {
+        found += storage.contains(keys[i % keys.size()]);
+    }
+    benchmark::report(name, found, timer);
+}
+
+} // namespace
+
+
+// the loop "for (...) s[i] = s[i] + 1" of a contract: every iteration is an SLOAD and an SSTORE of a warm slot,
+// the EVM words are converted the same way as by EthHost
+BENCHMARK_CASE(contract_storage_loop)
+{
+    lk::StateManager state_manager;
+    const auto contract = prepareState(state_manager);
+
+    {
+        // per access: locks, checks of the account and lookups through the commit layers
+        auto commit = state_manager.createCommit();
+        base::Timer timer;
+        timer.start();
+        for (std::size_t i = 0; i < LOOP_ITERATIONS; ++i) {
+            auto key = toFixedBytes(toWord(i % CONTRACT_STORAGE_SLOTS));
+            evmc::bytes32 value{};
+            if (commit.checkStorageValue(contract, key)) {
+                value = vm::toEvmcBytes32(commit.getStorageValue(contract, key).data);
+            }
+            auto new_value = toFixedBytes(increment(value));
+            if (commit.checkStorageValue(contract, key)) {
+                [[maybe_unused]] auto old_value = commit.getStorageValue(contract, key).data;
+            }
+            commit.setStorageValue(contract, key, new_value);
+        }
+        benchmark::report("s[i] = s[i] + 1 through Commit", LOOP_ITERATIONS, timer);
+    }
+    {
+        auto commit = state_manager.createCommit();
+        base::Timer timer;
+        timer.start();
+        lk::ContractStorage storage(commit, contract);
+        for (std::size_t i = 0; i < LOOP_ITERATIONS; ++i) {
+            auto key = toFixedBytes(toWord(i % CONTRACT_STORAGE_SLOTS));
+            evmc::bytes32 value{};
+            if (auto current = storage.find(key); current) {
+                value = vm::toEvmcBytes32(*current);
+            }
+            storage.set(key, toFixedBytes(increment(value)));
+        }
+        benchmark::report("s[i] = s[i] + 1 through ContractStorage", LOOP_ITERATIONS, timer);
+    }
+}
+
+
+// small-number keys share their first 8 bytes, so hashing only the prefix puts all of them into one probe chain
+BENCHMARK_CASE(contract_storage_slots_hash)
+{
+    runSlotsLookups<base::Sha256, base::PrefixHash<base::Sha256>>("lookups of 1k small-number slots, prefix hash",
+                                                                  100'000);
+    runSlotsLookups<lk::StorageKey, base::WordsHash<lk::StorageKey>>("lookups of 1k small-number slots, words hash",
+                                                                     LOOP_ITERATIONS);
+}
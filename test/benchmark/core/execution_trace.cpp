@@ -0,0 +1,69 @@
+#include "benchmark.hpp"
+
+#include "base/assert.hpp"
+#include "core/trace.hpp"
+
+#include <iostream>
+
+namespace
+{
+
+constexpr std::size_t HOST_CALLS_COUNT = 1'000'000;
+constexpr std::size_t TRACES_COUNT = 10'000;
+constexpr std::size_t CONTRACTS_COUNT = 100;
+
+
+// stands for a call of the host, e.g. a read of a storage slot, that the VM makes
+std::uint64_t hostCall(lk::ExecutionTrace* trace, std::uint64_t value)
+{
+    lk::HostCallScope scope{ trace, lk::ExecutionTrace::HostCall::GET_STORAGE };
+    return value * 6364136223846793005ULL + 1442695040888963407ULL;
+}
+
+} // namespace
+
+
+// The cost, that the tracing adds to each call of the host: without a trace it is a check of the pointer, so the
+// execution of transactions isn't slowed down, when the tracing is off; with a trace it is two reads of the clock.
+// Then the traces of a replay of blocks are summed up into a profile.
+BENCHMARK_CASE(execution_trace_overhead)
+{
+    base::Timer timer;
+    std::uint64_t value = 1;
+    timer.start();
+    for (std::size_t i = 0; i < HOST_CALLS_COUNT; ++i) {
+        value = hostCall(nullptr, value);
+    }
+    benchmark::report("host calls without tracing", HOST_CALLS_COUNT, timer);
+
+    lk::ExecutionTrace trace;
+    timer.start();
+    for (std::size_t i = 0; i < HOST_CALLS_COUNT; ++i) {
+        value = hostCall(&trace, value);
+    }
+    benchmark::report("host calls with tracing", HOST_CALLS_COUNT, timer);
+    ASSERT(trace.getHostCalls()[static_cast<std::size_t>(lk::ExecutionTrace::HostCall::GET_STORAGE)].count ==
+           HOST_CALLS_COUNT);
+    std::cout << "checksum: " << value << std::endl;
+
+    // each transaction calls a contract, that calls two others
+    std::vector<lk::Address> addresses;
+    for (std::size_t i = 0; i < CONTRACTS_COUNT; ++i) {
+        addresses.emplace_back(base::Ripemd160::compute(base::Bytes(std::to_string(i))).getBytes());
+    }
+    std::vector<lk::ExecutionTrace> traces(TRACES_COUNT);
+    for (std::size_t i = 0; i < TRACES_COUNT; ++i) {
+        const std::chrono::nanoseconds time{ 1'000 };
+        traces[i].addFrame({ addresses[(i + 1) % CONTRACTS_COUNT], 1, 1'000, time, true });
+        traces[i].addFrame({ addresses[(i + 2) % CONTRACTS_COUNT], 1, 1'000, time, true });
+        traces[i].addFrame({ addresses[i % CONTRACTS_COUNT], 0, 5'000, 5 * time, true });
+        traces[i].setTime(6 * time);
+    }
+    lk::ExecutionProfile profile;
+    timer.start();
+    for (const auto& transaction_trace : traces) {
+        profile.add(transaction_trace);
+    }
+    ASSERT(profile.getContracts().size() == CONTRACTS_COUNT);
+    benchmark::report("traces added to a profile", TRACES_COUNT, timer);
+}
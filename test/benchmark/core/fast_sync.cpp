@@ -0,0 +1,117 @@
+#include "benchmark.hpp"
+
+#include "base/assert.hpp"
+#include "core/managers.hpp"
+#include "core/snapshot.hpp"
+
+#include <random>
+
+namespace
+{
+
+constexpr std::size_t ACCOUNTS_COUNT = 100'000;
+constexpr std::size_t BLOCKS_COUNT = 2'000;
+constexpr std::size_t SNAPSHOT_DEPTH = 1'900;
+constexpr std::size_t TRANSACTIONS_IN_BLOCK = 100;
+
+
+lk::Address makeAddress(std::size_t seed)
+{
+    return lk::Address(base::Ripemd160::compute(base::Bytes(std::to_string(seed))).getBytes());
+}
+
+
+struct Transfer
+{
+    std::size_t from;
+    std::size_t to;
+};
+
+
+std::vector<std::vector<Transfer>> makeBlocks()
+{
+    std::mt19937_64 rng{ 2020 };
+    std::uniform_int_distribution<std::size_t> distribution{ 0, ACCOUNTS_COUNT - 1 };
+    std::vector<std::vector<Transfer>> blocks(BLOCKS_COUNT);
+    for (auto& block : blocks) {
+        for (std::size_t i = 0; i < TRANSACTIONS_IN_BLOCK; ++i) {
+            block.push_back({ distribution(rng), distribution(rng) });
+        }
+    }
+    return blocks;
+}
+
+
+void prepareGenesis(lk::StateManager& state_manager, const std::vector<lk::Address>& addresses)
+{
+    for (const auto& address : addresses) {
+        state_manager.applyBlockEmission(address, 1'000'000);
+    }
+    state_manager.updateStateRoot();
+}
+
+
+// executes transfers the way Core does: a commit per transaction and a state root per block
+void executeBlock(lk::StateManager& state_manager,
+                  const std::vector<lk::Address>& addresses,
+                  const std::vector<Transfer>& block)
+{
+    for (const auto& transfer : block) {
+        auto commit = state_manager.createCommit();
+        commit.tryTransferMoney(addresses[transfer.from], addresses[transfer.to], 1);
+        state_manager.applyCommit(std::move(commit));
+    }
+    state_manager.updateStateRoot();
+}
+
+} // namespace
+
+
+BENCHMARK_CASE(fast_sync_time_to_synced)
+{
+    std::vector<lk::Address> addresses;
+    for (std::size_t i = 0; i < ACCOUNTS_COUNT; ++i) {
+        addresses.push_back(makeAddress(i));
+    }
+    const auto blocks = makeBlocks();
+
+    // a synced node, which serves the snapshot
+    lk::StateManager source;
+    prepareGenesis(source, addresses);
+    for (std::size_t depth = 1; depth <= SNAPSHOT_DEPTH; ++depth) {
+        executeBlock(source, addresses, blocks[depth - 1]);
+    }
+    lk::Snapshot snapshot{ SNAPSHOT_DEPTH, base::Sha256::null(), source.getStateRoot(), source.exportState() };
+    for (std::size_t depth = SNAPSHOT_DEPTH + 1; depth <= BLOCKS_COUNT; ++depth) {
+        executeBlock(source, addresses, blocks[depth - 1]);
+    }
+    const auto top_state_root = source.getStateRoot();
+
+    {
+        lk::StateManager node;
+        base::Timer timer;
+        timer.start();
+        prepareGenesis(node, addresses);
+        for (const auto& block : blocks) {
+            executeBlock(node, addresses, block);
+        }
+        benchmark::report("full sync: executed blocks of 100 txs at 100k accounts", blocks.size(), timer);
+        ASSERT(node.getStateRoot() == top_state_root);
+    }
+    {
+        lk::StateManager node;
+        base::Timer timer;
+        timer.start();
+        prepareGenesis(node, addresses);
+        lk::SnapshotImport snapshot_import{ snapshot.getManifest() };
+        for (const auto& chunk_hash : snapshot.getManifest().chunk_hashes) {
+            snapshot_import.addChunk(chunk_hash, *snapshot.findChunk(chunk_hash));
+        }
+        ASSERT(node.importState(snapshot_import.takeState(), snapshot.getManifest().state_root));
+        for (std::size_t depth = SNAPSHOT_DEPTH + 1; depth <= BLOCKS_COUNT; ++depth) {
+            executeBlock(node, addresses, blocks[depth - 1]);
+        }
+        benchmark::report("fast sync: snapshot import and executed recent blocks", blocks.size(), timer);
+        ASSERT(node.getStateRoot() == top_state_root);
+    }
+}
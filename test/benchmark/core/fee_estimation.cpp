@@ -0,0 +1,165 @@
+#include "benchmark.hpp"
+
+#include "base/assert.hpp"
+#include "core/access_cache.hpp"
+#include "core/fee_estimator.hpp"
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+
+namespace
+{
+
+constexpr std::size_t ESTIMATES_COUNT = 200;
+constexpr std::size_t PENDING_COUNT = 100;
+constexpr std::size_t HOLDERS_COUNT = 1'000;
+constexpr lk::Fee GAS_LIMIT = 10'000'000;
+constexpr lk::Fee COLD_SLOAD_GAS = 2'100;
+constexpr lk::Fee WARM_SLOAD_GAS = 100;
+constexpr lk::Fee SSTORE_GAS = 20'000;
+constexpr lk::Fee TRANSFER_BASE_GAS = 21'000;
+constexpr lk::Fee GAS_PER_HASH = 1'000; // interpretation of a token transfer takes tens of microseconds
+
+
+lk::Address makeAddress(std::size_t seed)
+{
+    return lk::Address(base::Ripemd160::compute(base::Bytes(std::to_string(seed))).getBytes());
+}
+
+
+lk::StorageKey makeKey(std::size_t seed)
+{
+    return base::Sha256::compute(base::Bytes(std::to_string(seed))).getBytes();
+}
+
+
+lk::StorageValue toWord(std::size_t value)
+{
+    lk::StorageValue word;
+    for (std::size_t i = 0; i < sizeof(value); ++i) {
+        word[word.size() - 1 - i] = static_cast<base::Byte>(value >> (8 * i));
+    }
+    return word;
+}
+
+
+std::size_t fromWord(const lk::StorageValue& word)
+{
+    std::size_t value = 0;
+    for (std::size_t i = 0; i < sizeof(value); ++i) {
+        value |= static_cast<std::size_t>(word[word.size() - 1 - i]) << (8 * i);
+    }
+    return value;
+}
+
+
+// stands for the VM executing a transfer of a token: the gas is charged like in EVM, and a call gets at most 63/64
+// of the gas left, so the least enough fee is greater than the used gas; returns false if the fee is not enough
+bool transferToken(lk::Commit& commit, const lk::Address& token, std::size_t from, std::size_t to, lk::Fee fee)
+{
+    lk::AccessCache accesses(commit);
+    auto& storage = accesses.getStorage(token);
+    lk::Fee gas = fee - fee / 64;
+    base::Sha256 work = makeKey(from);
+    auto charge = [&gas, &work](lk::Fee cost) {
+        if (gas < cost) {
+            return false;
+        }
+        gas -= cost;
+        for (auto i = cost / GAS_PER_HASH; i > 0; --i) {
+            work = base::Sha256::compute(work.getBytes());
+        }
+        return true;
+    };
+    if (!charge(TRANSFER_BASE_GAS)) {
+        return false;
+    }
+
+    // the holder is checked a few times, like the modifiers of the contract do
+    std::size_t from_balance = 0;
+    for (std::size_t i = 0; i < 4; ++i) {
+        if (!charge(storage.isCached(makeKey(from)) ? WARM_SLOAD_GAS : COLD_SLOAD_GAS)) {
+            return false;
+        }
+        from_balance = fromWord(*storage.find(makeKey(from)));
+    }
+    if (!charge(COLD_SLOAD_GAS + 2 * SSTORE_GAS)) {
+        return false;
+    }
+    auto to_balance = fromWord(*storage.find(makeKey(to)));
+    storage.set(makeKey(from), toWord(from_balance - 1));
+    storage.set(makeKey(to), toWord(to_balance + 1));
+    return true;
+}
+
+} // namespace
+
+
+// a transfer of a token is estimated on the state with pending transfers: each estimate executes the pending ones
+// and searches for the least fee by dry runs of the transfer; the dry runs of a round are executed concurrently, so
+// the speedup depends on the number of cores
+BENCHMARK_CASE(fee_estimation_of_token_transfer)
+{
+    lk::StateManager state_manager;
+    auto owner = makeAddress(0);
+    state_manager.applyBlockEmission(owner, 1'000'000);
+    lk::Address token{ lk::Address::null() };
+    {
+        auto commit = state_manager.createCommit();
+        token = commit.createContractAccount(owner, base::Sha256::compute(base::Bytes("token")));
+        for (std::size_t i = 0; i < HOLDERS_COUNT; ++i) {
+            commit.setStorageValue(token, makeKey(i), toWord(1'000'000));
+        }
+        state_manager.applyCommit(std::move(commit));
+    }
+
+    std::atomic<std::size_t> runs_count{ 0 };
+    auto estimate = [&](lk::FeeEstimator& estimator, std::size_t pending_count, bool is_bound_by_used_gas) {
+        auto view = state_manager.createView();
+        auto pending = view.createCommit();
+        for (std::size_t i = 0; i < pending_count; ++i) {
+            ASSERT(transferToken(pending, token, i, i + 1, GAS_LIMIT));
+        }
+
+        lk::Fee used_gas = 0;
+        lk::Fee gas_limit = GAS_LIMIT;
+        if (is_bound_by_used_gas) {
+            auto commit = pending.createCommit();
+            ASSERT(transferToken(commit, token, 0, HOLDERS_COUNT - 1, GAS_LIMIT));
+            used_gas = TRANSFER_BASE_GAS + COLD_SLOAD_GAS + 3 * WARM_SLOAD_GAS + COLD_SLOAD_GAS + 2 * SSTORE_GAS;
+            auto expected_fee = used_gas + used_gas / 63 + 1;
+            auto expected_commit = pending.createCommit();
+            if (transferToken(expected_commit, token, 0, HOLDERS_COUNT - 1, expected_fee)) {
+                gas_limit = expected_fee;
+            }
+        }
+        return estimator.findLeastFee(used_gas, gas_limit, [&](lk::Fee fee) {
+            ++runs_count;
+            auto commit = pending.createCommit();
+            return transferToken(commit, token, 0, HOLDERS_COUNT - 1, fee);
+        });
+    };
+
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+    std::optional<lk::Fee> least_fee;
+    auto run = [&](const std::string& name, std::size_t threads_count, bool is_bound_by_used_gas) {
+        lk::FeeEstimator estimator(threads_count);
+        runs_count = 0;
+        for (std::size_t pending_count : { std::size_t{ 0 }, PENDING_COUNT }) {
+            base::Timer timer;
+            timer.start();
+            for (std::size_t i = 0; i < ESTIMATES_COUNT; ++i) {
+                auto fee = estimate(estimator, pending_count, is_bound_by_used_gas);
+                ASSERT(!least_fee || *least_fee == fee);
+                least_fee = fee;
+            }
+            benchmark::report(name + ", " + std::to_string(pending_count) + " pending", ESTIMATES_COUNT, timer);
+        }
+        std::cout << name << ": " << runs_count / (2 * ESTIMATES_COUNT) << " dry runs per estimate" << std::endl;
+    };
+    run("binary search from zero", 1, false);
+    run("binary search from the used gas", 1, true);
+    run("search from the used gas, 4 threads", 4, true);
+    run("search from the used gas, 8 threads", 8, true);
+}
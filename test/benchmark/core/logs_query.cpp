@@ -0,0 +1,119 @@
+#include "benchmark.hpp"
+
+#include "base/assert.hpp"
+#include "core/database_keys.hpp"
+#include "core/logs.hpp"
+
+namespace
+{
+
+constexpr std::size_t BLOCKS_COUNT = 100'000;
+constexpr std::size_t BLOCKS_WITH_LOGS_PERIOD = 10;
+constexpr std::size_t RARE_LOGS_PERIOD = 5'000;
+constexpr std::size_t TOKENS_COUNT = 5;
+constexpr std::size_t FLUSH_PERIOD = 1'000;
+constexpr std::size_t QUERIES_COUNT = 20;
+const std::filesystem::path DATABASE_PATH{ "benchmark_database" };
+
+
+lk::Address makeAddress(std::size_t seed)
+{
+    return lk::Address(base::Ripemd160::compute(base::Bytes(std::to_string(seed))).getBytes());
+}
+
+
+lk::LogTopic makeTopic(std::size_t seed)
+{
+    return base::Sha256::compute(base::Bytes("topic" + std::to_string(seed))).getBytes();
+}
+
+
+// a few tokens emit transfers in every tenth block, and a rare contract emits a log once in many blocks
+std::vector<lk::LogRecord> makeBlockRecords(lk::BlockDepth depth)
+{
+    std::vector<lk::LogRecord> records;
+    if (depth % BLOCKS_WITH_LOGS_PERIOD != 0) {
+        return records;
+    }
+    const auto transaction_hash = base::Sha256::compute(base::toBytes(depth));
+    auto add = [&](std::size_t address_seed, std::size_t topic_seed) {
+        lk::Log log{ makeAddress(address_seed), { makeTopic(topic_seed), makeTopic(depth) }, base::Bytes(64) };
+        records.push_back({ depth, transaction_hash, static_cast<std::uint32_t>(records.size()), std::move(log) });
+    };
+    for (std::size_t token = 0; token < TOKENS_COUNT; ++token) {
+        add(token, 0);
+        add(token, 0);
+    }
+    if (depth % RARE_LOGS_PERIOD == 0) {
+        add(TOKENS_COUNT, 1);
+    }
+    return records;
+}
+
+} // namespace
+
+
+// logs of 100k blocks are searched for a rare contract and for the transfers of a token in a recent range: the scan
+// reads and checks every stored log, the index reads the logs of the blocks, which blooms match the filter
+BENCHMARK_CASE(logs_query)
+{
+    auto database = base::createClearDatabaseInstance(DATABASE_PATH);
+    {
+        lk::LogsIndex index{ database };
+        base::Timer timer;
+        timer.start();
+        for (lk::BlockDepth depth = 0; depth < BLOCKS_COUNT; ++depth) {
+            index.addBlockLogs(depth, makeBlockRecords(depth));
+            if ((depth + 1) % FLUSH_PERIOD == 0) {
+                base::Database::Batch batch;
+                index.flush(batch);
+                database.write(std::move(batch));
+            }
+        }
+        benchmark::report("add and store logs of a block", BLOCKS_COUNT, timer);
+
+        const lk::LogsFilter rare_filter{ { makeAddress(TOKENS_COUNT) }, {} };
+        const lk::LogsFilter token_filter{ { makeAddress(0) }, { { makeTopic(0) } } };
+        const lk::BlockDepth recent_depth = BLOCKS_COUNT - 2 * base::config::BC_LOGS_SECTION_SIZE;
+        const auto prefix = lk::makeDatabaseKey(lk::DataType::BLOCK_LOGS, base::Bytes{});
+        auto scan = [&](lk::BlockDepth from_depth, const lk::LogsFilter& filter) {
+            std::size_t found = 0;
+            database.scan(prefix, [&](const leveldb::Slice&, const leveldb::Slice& value) {
+                base::Bytes data(reinterpret_cast<const base::Byte*>(value.data()), value.size());
+                base::SerializationIArchive ia(data);
+                for (const auto& record : ia.deserialize<std::vector<lk::LogRecord>>()) {
+                    found += record.depth >= from_depth && filter.matches(record.log);
+                }
+                return true;
+            });
+            return found;
+        };
+
+        std::size_t scan_found = 0;
+        timer.start();
+        for (std::size_t i = 0; i < QUERIES_COUNT; ++i) {
+            scan_found = scan(0, rare_filter);
+        }
+        benchmark::report("rare logs by a scan of all logs", QUERIES_COUNT, timer);
+        std::size_t index_found = 0;
+        timer.start();
+        for (std::size_t i = 0; i < QUERIES_COUNT; ++i) {
+            index_found = index.find(0, BLOCKS_COUNT, rare_filter, base::config::RPC_LOGS_MAX_COUNT).size();
+        }
+        benchmark::report("rare logs by the bloom index", QUERIES_COUNT, timer);
+        ASSERT(scan_found == BLOCKS_COUNT / RARE_LOGS_PERIOD && index_found == scan_found);
+
+        timer.start();
+        for (std::size_t i = 0; i < QUERIES_COUNT; ++i) {
+            scan_found = scan(recent_depth, token_filter);
+        }
+        benchmark::report("recent token transfers by a scan of all logs", QUERIES_COUNT, timer);
+        timer.start();
+        for (std::size_t i = 0; i < QUERIES_COUNT; ++i) {
+            index_found = index.find(recent_depth, BLOCKS_COUNT, token_filter, base::config::RPC_LOGS_MAX_COUNT).size();
+        }
+        benchmark::report("recent token transfers by the bloom index", QUERIES_COUNT, timer);
+        ASSERT(scan_found > 0 && index_found == scan_found);
+    }
+    std::filesystem::remove_all(DATABASE_PATH);
+}
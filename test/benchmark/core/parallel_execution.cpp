@@ -0,0 +1,156 @@
+#include "benchmark.hpp"
+
+#include "base/assert.hpp"
+#include "core/parallel_executor.hpp"
+
+#include <random>
+#include <thread>
+
+namespace
+{
+
+constexpr std::size_t ACCOUNTS_COUNT = 100'000;
+constexpr std::size_t CONTRACTS_COUNT = 10;
+constexpr std::size_t CONTRACT_SLOTS_COUNT = 1'000;
+constexpr std::size_t BLOCKS_COUNT = 200;
+constexpr std::size_t TRANSACTIONS_IN_BLOCK = 100;
+constexpr std::size_t CONTRACT_CALL_HASHES = 200; // stands for the work of the VM, which is not available here
+
+
+lk::Address makeAddress(std::size_t seed)
+{
+    return lk::Address(base::Ripemd160::compute(base::Bytes(std::to_string(seed))).getBytes());
+}
+
+
+struct Call
+{
+    std::size_t from;
+    std::size_t to; // an account for a transfer, a contract for a contract call
+    std::size_t slot;
+};
+
+
+std::vector<std::vector<Call>> makeBlocks(std::size_t targets_count)
+{
+    std::mt19937_64 rng{ 2020 };
+    std::uniform_int_distribution<std::size_t> account{ 0, ACCOUNTS_COUNT - 1 };
+    std::uniform_int_distribution<std::size_t> target{ 0, targets_count - 1 };
+    std::uniform_int_distribution<std::size_t> slot{ 0, CONTRACT_SLOTS_COUNT - 1 };
+    std::vector<std::vector<Call>> blocks(BLOCKS_COUNT);
+    for (auto& block : blocks) {
+        for (std::size_t i = 0; i < TRANSACTIONS_IN_BLOCK; ++i) {
+            block.push_back({ account(rng), target(rng), slot(rng) });
+        }
+    }
+    return blocks;
+}
+
+
+struct State
+{
+    lk::StateManager state_manager;
+    lk::Address coinbase{ makeAddress(ACCOUNTS_COUNT) };
+    std::vector<lk::Address> accounts;
+    std::vector<lk::Address> contracts;
+};
+
+
+void prepareState(State& state)
+{
+    for (std::size_t i = 0; i < ACCOUNTS_COUNT; ++i) {
+        state.accounts.push_back(makeAddress(i));
+        state.state_manager.applyBlockEmission(state.accounts.back(), 1'000'000);
+    }
+    auto commit = state.state_manager.createCommit();
+    for (std::size_t i = 0; i < CONTRACTS_COUNT; ++i) {
+        state.contracts.push_back(
+          commit.createContractAccount(state.accounts[i], base::Sha256::compute(base::Bytes(std::to_string(i)))));
+    }
+    state.state_manager.applyCommit(std::move(commit));
+    state.state_manager.updateStateRoot();
+}
+
+
+void transfer(lk::Commit& commit, const State& state, const Call& call, std::size_t tx_index)
+{
+    const auto& from = state.accounts[call.from];
+    commit.addTxHash(from, base::Sha256::compute(base::Bytes(std::to_string(tx_index))));
+    commit.payFee(from, state.coinbase, 1);
+    commit.tryTransferMoney(from, state.accounts[call.to], 1);
+}
+
+
+void callContract(lk::Commit& commit, const State& state, const Call& call, std::size_t tx_index)
+{
+    const auto& from = state.accounts[call.from];
+    const auto& contract = state.contracts[call.to];
+    commit.addTxHash(from, base::Sha256::compute(base::Bytes(std::to_string(tx_index))));
+
+    auto key = base::Sha256::compute(base::Bytes(std::to_string(call.slot))).getBytes();
+    lk::StorageValue value;
+    if (commit.checkStorageValue(contract, key)) {
+        value = commit.getStorageValue(contract, key).data;
+    }
+    for (std::size_t i = 0; i < CONTRACT_CALL_HASHES; ++i) {
+        value = base::Sha256::compute(value).getBytes();
+    }
+    commit.setStorageValue(contract, key, value);
+    commit.payFee(from, state.coinbase, 1);
+}
+
+
+template<typename F>
+void runBlocks(const std::string& name, std::size_t threads_count, const std::vector<std::vector<Call>>& blocks, F f)
+{
+    State state;
+    prepareState(state);
+    lk::ParallelExecutor executor{ threads_count };
+
+    std::size_t reexecuted_count = 0;
+    base::Timer timer;
+    timer.start();
+    for (std::size_t depth = 0; depth < blocks.size(); ++depth) {
+        const auto& block = blocks[depth];
+        reexecuted_count += executor.execute(
+          state.state_manager,
+          block.size(),
+          [&](std::size_t i, lk::Commit& commit) { f(commit, state, block[i], depth * TRANSACTIONS_IN_BLOCK + i); },
+          [](std::size_t) {});
+        state.state_manager.updateStateRoot();
+    }
+    benchmark::report(name + ", " + std::to_string(threads_count) + " threads, " + std::to_string(reexecuted_count) +
+                        " txs re-executed",
+                      blocks.size() * TRANSACTIONS_IN_BLOCK,
+                      timer);
+}
+
+
+std::vector<std::size_t> threadCounts()
+{
+    std::vector<std::size_t> counts{ 1, 2, 4 };
+    if (std::size_t hardware = std::thread::hardware_concurrency(); hardware > 4) {
+        counts.push_back(hardware);
+    }
+    return counts;
+}
+
+} // namespace
+
+
+BENCHMARK_CASE(parallel_execution_transfers)
+{
+    const auto blocks = makeBlocks(ACCOUNTS_COUNT);
+    for (auto threads_count : threadCounts()) {
+        runBlocks("transfers at 100k accounts", threads_count, blocks, transfer);
+    }
+}
+
+
+BENCHMARK_CASE(parallel_execution_contract_calls)
+{
+    const auto blocks = makeBlocks(CONTRACTS_COUNT);
+    for (auto threads_count : threadCounts()) {
+        runBlocks("calls to 10 contracts with 1k slots", threads_count, blocks, callContract);
+    }
+}
@@ -0,0 +1,86 @@
+#include "benchmark.hpp"
+
+#include "base/assert.hpp"
+#include "core/rating.hpp"
+
+namespace
+{
+
+constexpr std::size_t CONNECTION_ATTEMPTS_COUNT = 5'000;
+constexpr std::size_t ENDPOINTS_COUNT = 500;
+constexpr std::size_t PENALTY_FREQUENCY = 10; // every this attempt the peer misbehaves
+constexpr std::int16_t INITIAL_PEER_RATING = 20;
+const std::filesystem::path PEERS_DATABASE_PATH{ "benchmark_peers" };
+
+
+std::vector<net::Endpoint> makeEndpoints()
+{
+    std::vector<net::Endpoint> endpoints;
+    for (std::size_t i = 0; i < ENDPOINTS_COUNT; ++i) {
+        endpoints.emplace_back("10.0." + std::to_string(i / 256) + "." + std::to_string(i % 256) + ":20203");
+    }
+    return endpoints;
+}
+
+
+// the way ratings were kept before: a read on every attempt and a synced write on every change
+void runSyncedRatings(const std::vector<net::Endpoint>& endpoints)
+{
+    auto database = base::createClearDatabaseInstance(PEERS_DATABASE_PATH);
+    base::Timer timer;
+    timer.start();
+    std::size_t good_count = 0;
+    for (std::size_t i = 0; i < CONNECTION_ATTEMPTS_COUNT; ++i) {
+        const auto key = base::toBytes(endpoints[i % endpoints.size()]);
+        std::int16_t value = INITIAL_PEER_RATING;
+        if (auto stored = database.get(key)) {
+            value = base::fromBytes<std::int16_t>(*stored);
+        }
+        else {
+            database.put(key, base::toBytes(value));
+        }
+        good_count += value > 0;
+        if (i % PENALTY_FREQUENCY == 0) {
+            database.put(key, base::toBytes(static_cast<std::int16_t>(value - 10)));
+        }
+    }
+    benchmark::report("connection attempt, synced write per change", CONNECTION_ATTEMPTS_COUNT, timer);
+    ASSERT(good_count > 0);
+}
+
+
+void runRatingManager(const std::vector<net::Endpoint>& endpoints)
+{
+    std::filesystem::remove_all(PEERS_DATABASE_PATH);
+    base::PropertyTree config;
+    config.add("net.peers_db", PEERS_DATABASE_PATH.string());
+    lk::RatingManager manager{ config };
+
+    base::Timer timer;
+    timer.start();
+    std::size_t good_count = 0;
+    for (std::size_t i = 0; i < CONNECTION_ATTEMPTS_COUNT; ++i) {
+        auto rating = manager.get(endpoints[i % endpoints.size()]);
+        good_count += rating.isGood();
+        if (i % PENALTY_FREQUENCY == 0) {
+            rating.badBlock();
+        }
+    }
+    benchmark::report("connection attempt, rating manager", CONNECTION_ATTEMPTS_COUNT, timer);
+    ASSERT(good_count > 0);
+
+    timer.start();
+    manager.flush();
+    benchmark::report("flush of changed ratings", 1, timer);
+}
+
+} // namespace
+
+
+BENCHMARK_CASE(peers_rating_connection_attempts)
+{
+    const auto endpoints = makeEndpoints();
+    runSyncedRatings(endpoints);
+    runRatingManager(endpoints);
+    std::filesystem::remove_all(PEERS_DATABASE_PATH);
+}
@@ -0,0 +1,81 @@
+#include "benchmark.hpp"
+
+#include "base/assert.hpp"
+#include "core/precompiles.hpp"
+
+#include <include/secp256k1.h>
+#include <include/secp256k1_recovery.h>
+
+#include <iostream>
+#include <memory>
+
+namespace
+{
+
+constexpr std::size_t CALLS_COUNT = 2'000;
+constexpr std::size_t HASHED_INPUT_SIZE = 1'024;
+
+
+// the way the public key was recovered before, with a context created for each recovery
+base::Bytes recoverWithOwnContext(const base::Secp256PrivateKey::Signature& signature, const base::Sha256& hash)
+{
+    std::unique_ptr<secp256k1_context, decltype(&secp256k1_context_destroy)> context(
+      secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY), secp256k1_context_destroy);
+    secp256k1_ecdsa_recoverable_signature recoverable_signature;
+    ASSERT(secp256k1_ecdsa_recoverable_signature_parse_compact(
+      context.get(), &recoverable_signature, signature.getData(), signature[64]));
+    secp256k1_pubkey pubkey;
+    ASSERT(secp256k1_ecdsa_recover(context.get(), &pubkey, &recoverable_signature, hash.getBytes().getData()));
+    base::FixedBytes<base::Secp256PrivateKey::SECP256_PUBLIC_KEY_SIZE> output;
+    std::size_t output_size = output.size();
+    secp256k1_ec_pubkey_serialize(context.get(), output.getData(), &output_size, &pubkey, SECP256K1_EC_UNCOMPRESSED);
+    return lk::Address(output).getBytes().toBytes();
+}
+
+} // namespace
+
+
+// Calls of the precompiled contracts, as the host dispatches them. An implementation of ecrecover in EVM bytecode
+// costs millions of gas, while the precompile costs 3000, so the time per 3000 gas is printed to compare with the
+// interpretation of other contracts. The recovery with a context created per call is how the signatures were
+// recovered before, and the creation of a context is most of its time.
+BENCHMARK_CASE(precompiles_calls)
+{
+    const auto& registry = lk::PrecompilesRegistry::getNative();
+    base::Secp256PrivateKey key;
+    const base::Bytes message("message signed by the key");
+    const auto signature = key.sign(message);
+    const auto hash = base::Sha256::compute(message);
+    base::Bytes v(32);
+    v[31] = static_cast<base::Byte>(signature[64] + 27);
+    const auto recover_input = hash.getBytes().toBytes() + v + signature.toBytes().takePart(0, 64);
+    const auto signer = lk::Address(key.toPublicKey()).getBytes().toBytes();
+
+    base::Timer timer;
+    timer.start();
+    for (std::size_t i = 0; i < CALLS_COUNT; ++i) {
+        ASSERT(recoverWithOwnContext(signature, hash) == signer);
+    }
+    benchmark::report("ecrecover with a context per call", CALLS_COUNT, timer);
+
+    const auto* ecrecover = registry.find(lk::getPrecompileAddress(1));
+    timer.start();
+    for (std::size_t i = 0; i < CALLS_COUNT; ++i) {
+        ASSERT(ecrecover->run(recover_input).takePart(12, 32) == signer);
+    }
+    benchmark::report("ecrecover precompile", CALLS_COUNT, timer);
+    std::cout << "ecrecover precompile: " << timer.elapsedSeconds() * 1'000'000 / CALLS_COUNT << " us per "
+              << ecrecover->gas(recover_input) << " gas" << std::endl;
+
+    const base::Bytes hashed_input(HASHED_INPUT_SIZE);
+    for (std::uint8_t number : { 2, 3, 4 }) {
+        const auto* contract = registry.find(lk::getPrecompileAddress(number));
+        std::size_t output_size = 0;
+        timer.start();
+        for (std::size_t i = 0; i < CALLS_COUNT; ++i) {
+            output_size += contract->run(hashed_input).size();
+        }
+        benchmark::report("precompile " + std::to_string(number) + " of 1 KiB", CALLS_COUNT, timer);
+        ASSERT(output_size > 0);
+    }
+}
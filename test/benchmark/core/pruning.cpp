@@ -0,0 +1,145 @@
+#include "benchmark.hpp"
+
+#include "base/assert.hpp"
+#include "core/blockchain.hpp"
+#include "core/database_keys.hpp"
+#include "core/managers.hpp"
+
+#include <iostream>
+
+#include <malloc.h>
+
+namespace
+{
+
+constexpr std::size_t CHAIN_HEIGHT = 1'000'000;
+constexpr std::size_t KEPT_BLOCKS_COUNT = 10'000;
+constexpr std::size_t ACCOUNT_TRANSACTIONS_COUNT = 1'000'000;
+constexpr std::size_t TRANSACTIONS_HISTORY_LIMIT = 1'000;
+constexpr std::uint_least32_t GENESIS_TIMESTAMP = 1583789617;
+const std::filesystem::path DATABASE_PATH{ "benchmark_database" };
+
+
+// heap in use, which unlike the resident memory doesn't depend on what was freed before
+std::size_t getAllocatedMemory()
+{
+    const auto info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+
+void reportMemory(const std::string& name, std::size_t bytes)
+{
+    std::cout << name << ": " << bytes / (1024 * 1024) << " MB" << std::endl;
+}
+
+
+lk::ImmutableBlock makeBlock(lk::BlockDepth depth, const base::Sha256& prev_block_hash)
+{
+    lk::TransactionsSet txs;
+    txs.add(lk::Transaction{ lk::Address::null(),
+                             lk::Address::null(),
+                             depth + 1,
+                             0,
+                             base::Time(GENESIS_TIMESTAMP),
+                             base::Bytes{} });
+    // blocks come once in two minutes, so the complexity stays minimal and any block passes the consensus check
+    return lk::ImmutableBlock{ depth,
+                               0,
+                               prev_block_hash,
+                               base::Sha256::null(),
+                               base::Time(static_cast<std::uint_least32_t>(GENESIS_TIMESTAMP + depth * 120)),
+                               lk::Address::null(),
+                               std::move(txs) };
+}
+
+
+// the memory engine counts the sizes of keys and values, so its sizes stand for the disk usage of LevelDB
+void runChain(const std::string& mode, const base::PropertyTree& config)
+{
+    const auto suffix = ", " + mode;
+    const auto memory_before = getAllocatedMemory();
+    base::DatabaseOptions options;
+    options.engine = base::StorageEngine::MEMORY;
+    auto database = base::createClearDatabaseInstance(DATABASE_PATH, options);
+    {
+        const auto genesis = makeBlock(0, base::Sha256::null());
+        lk::PersistentBlockchain blockchain{ genesis, database, config };
+        blockchain.load();
+
+        auto prev_block_hash = genesis.getHash();
+        base::Timer timer;
+        timer.start();
+        for (lk::BlockDepth depth = 1; depth <= CHAIN_HEIGHT; ++depth) {
+            auto block = makeBlock(depth, prev_block_hash);
+            prev_block_hash = block.getHash();
+            [[maybe_unused]] auto result = blockchain.tryAddBlock(block);
+            // the way the node allows pruning once it has stored a state snapshot
+            if (depth % base::config::BC_SNAPSHOT_PERIOD == 0) {
+                blockchain.setPrunableDepth(depth);
+            }
+        }
+        benchmark::report("add block" + suffix, CHAIN_HEIGHT, timer);
+        ASSERT(blockchain.getTopBlock().getDepth() == CHAIN_HEIGHT);
+
+        reportMemory("blocks" + suffix,
+                     database.getApproximateSize(lk::makeDatabaseKey(lk::DataType::BLOCK, base::Bytes{})));
+        reportMemory(
+          "transactions index" + suffix,
+          database.getApproximateSize(lk::makeDatabaseKey(lk::DataType::TRANSACTION_BLOCK_DEPTH, base::Bytes{})));
+        reportMemory("headers of pruned blocks" + suffix,
+                     database.getApproximateSize(lk::makeDatabaseKey(lk::DataType::BLOCK_HEADER, base::Bytes{})));
+        reportMemory("heap taken by the blockchain and its database" + suffix, getAllocatedMemory() - memory_before);
+    }
+
+    lk::PersistentBlockchain blockchain{ makeBlock(0, base::Sha256::null()), database, config };
+    base::Timer timer;
+    timer.start();
+    blockchain.load();
+    benchmark::report("load blockchain" + suffix, CHAIN_HEIGHT, timer);
+    ASSERT(blockchain.getTopBlock().getDepth() == CHAIN_HEIGHT);
+}
+
+
+void runTransactionsHistory(const std::string& mode, std::size_t history_limit)
+{
+    const auto suffix = ", " + mode;
+    const auto memory_before = getAllocatedMemory();
+    lk::StateManager state_manager;
+    state_manager.setTransactionsHistoryLimit(history_limit);
+    const lk::Address address{ base::Ripemd160::compute(base::Bytes("sender")).getBytes() };
+    state_manager.applyBlockEmission(address, 1);
+
+    base::Timer timer;
+    timer.start();
+    for (std::size_t i = 0; i < ACCOUNT_TRANSACTIONS_COUNT; ++i) {
+        auto commit = state_manager.createCommit();
+        commit.addTxHash(address, base::Sha256::compute(base::toBytes(i)));
+        state_manager.applyCommit(std::move(commit));
+    }
+    benchmark::report("apply transaction of the account" + suffix, ACCOUNT_TRANSACTIONS_COUNT, timer);
+    reportMemory("heap taken by the state" + suffix, getAllocatedMemory() - memory_before);
+    ASSERT(history_limit == 0 || state_manager.getTransactionsHashes(address, 0, ACCOUNT_TRANSACTIONS_COUNT).size() ==
+                                   TRANSACTIONS_HISTORY_LIMIT);
+}
+
+} // namespace
+
+
+BENCHMARK_CASE(pruning_blocks)
+{
+    runChain("archive", base::PropertyTree{});
+
+    base::PropertyTree config;
+    config.add("database.pruning.kept_blocks", KEPT_BLOCKS_COUNT);
+    runChain("kept 10000 blocks", config);
+
+    std::filesystem::remove_all(DATABASE_PATH);
+}
+
+
+BENCHMARK_CASE(pruning_transactions_history)
+{
+    runTransactionsHistory("full history", 0);
+    runTransactionsHistory("history of 1000 transactions", TRANSACTIONS_HISTORY_LIMIT);
+}
@@ -0,0 +1,48 @@
+#include "benchmark.hpp"
+
+#include "core/managers.hpp"
+
+namespace
+{
+
+constexpr std::size_t ACCOUNTS_COUNT = 200'000;
+constexpr std::size_t BLOCKS_COUNT = 100;
+constexpr std::size_t ACCOUNTS_CHANGED_IN_BLOCK = 1'000;
+
+
+lk::Address makeAddress(std::size_t seed)
+{
+    return lk::Address(base::Ripemd160::compute(base::Bytes(std::to_string(seed))).getBytes());
+}
+
+} // namespace
+
+
+BENCHMARK_CASE(state_root_update)
+{
+    lk::StateManager state_manager;
+    {
+        auto commit = state_manager.createCommit();
+        for (std::size_t i = 0; i < ACCOUNTS_COUNT; ++i) {
+            commit.createClientAccount(makeAddress(i));
+        }
+        state_manager.applyCommit(std::move(commit));
+    }
+
+    base::Timer timer;
+    timer.start();
+    state_manager.updateStateRoot();
+    benchmark::report("full state root computation at 200k accounts", 1, timer);
+
+    // emissions are cheap compared to rehashing, so the loop measures the root updates
+    std::size_t next_account = 0;
+    timer.start();
+    for (std::size_t block = 0; block < BLOCKS_COUNT; ++block) {
+        for (std::size_t i = 0; i < ACCOUNTS_CHANGED_IN_BLOCK; ++i) {
+            state_manager.applyBlockEmission(makeAddress(next_account), 1);
+            next_account = (next_account + 7919) % ACCOUNTS_COUNT;
+        }
+        state_manager.updateStateRoot();
+    }
+    benchmark::report("incremental state root update with 1k changed of 200k accounts", BLOCKS_COUNT, timer);
+}
@@ -0,0 +1,176 @@
+#include "benchmark.hpp"
+
+#include "base/assert.hpp"
+#include "core/managers.hpp"
+
+#include <shared_mutex>
+#include <thread>
+
+namespace
+{
+
+constexpr std::size_t BLOCKS_COUNT = 2'000;
+constexpr std::size_t WRITES_PER_BLOCK = 50;
+constexpr std::size_t SLOTS_COUNT = 1'000;
+constexpr std::size_t READS_PER_CALL = 20;
+constexpr std::size_t CALLERS_COUNT = 4;
+constexpr std::size_t CALLS_PER_CALLER = 20'000;
+
+
+lk::Address makeAddress(std::size_t seed)
+{
+    return lk::Address(base::Ripemd160::compute(base::Bytes(std::to_string(seed))).getBytes());
+}
+
+
+lk::StorageKey makeKey(std::size_t seed)
+{
+    return base::Sha256::compute(base::Bytes(std::to_string(seed))).getBytes();
+}
+
+
+lk::Address prepareContract(lk::StateManager& state_manager)
+{
+    auto owner = makeAddress(0);
+    state_manager.applyBlockEmission(owner, 1'000'000);
+    auto commit = state_manager.createCommit();
+    auto contract = commit.createContractAccount(owner, base::Sha256::compute(base::Bytes("contract")));
+    for (std::size_t i = 0; i < SLOTS_COUNT; ++i) {
+        commit.setStorageValue(contract, makeKey(i), makeKey(i));
+    }
+    state_manager.applyCommit(std::move(commit));
+    return contract;
+}
+
+
+void applyBlock(lk::StateManager& state_manager, const lk::Address& contract, std::size_t block)
+{
+    auto commit = state_manager.createCommit();
+    for (std::size_t i = 0; i < WRITES_PER_BLOCK; ++i) {
+        commit.setStorageValue(contract, makeKey((block * WRITES_PER_BLOCK + i) % SLOTS_COUNT), makeKey(block));
+    }
+    state_manager.applyCommit(std::move(commit));
+}
+
+
+// stands for the VM, which reads some slots of the contract
+std::size_t executeCall(const lk::Commit& commit, const lk::Address& contract, std::size_t call)
+{
+    std::size_t found = 0;
+    for (std::size_t i = 0; i < READS_PER_CALL; ++i) {
+        found += commit.checkStorageValue(contract, makeKey((call * READS_PER_CALL + i) % SLOTS_COUNT));
+    }
+    return found;
+}
+
+
+// blocks are applied, while the callers execute calls of the contract; a call must see the state of a single block,
+// so it either blocks the application of blocks or is executed on a view
+template<typename Call>
+void runCallsDuringBlocks(const char* name, Call call)
+{
+    std::vector<std::thread> callers;
+    base::Timer timer;
+    timer.start();
+    for (std::size_t caller = 0; caller < CALLERS_COUNT; ++caller) {
+        callers.emplace_back([&call, caller] {
+            for (std::size_t i = 0; i < CALLS_PER_CALLER; ++i) {
+                ASSERT(call(i * CALLERS_COUNT + caller) == READS_PER_CALL);
+            }
+        });
+    }
+    for (std::size_t block = 0; block < BLOCKS_COUNT; ++block) {
+        call.applyBlock(block);
+    }
+    benchmark::report(std::string{ name } + ": blocks", BLOCKS_COUNT, timer);
+    for (auto& caller : callers) {
+        caller.join();
+    }
+    benchmark::report(std::string{ name } + ": calls", CALLERS_COUNT * CALLS_PER_CALLER, timer);
+}
+
+
+// the call holds the lock of the blockchain to see the state of a single block
+struct LockedCall
+{
+    lk::StateManager& state_manager;
+    const lk::Address& contract;
+    std::shared_mutex& blockchain_mutex;
+
+    std::size_t operator()(std::size_t call)
+    {
+        std::shared_lock lk(blockchain_mutex);
+        auto commit = state_manager.createCommit();
+        return executeCall(commit, contract, call);
+    }
+
+    void applyBlock(std::size_t block)
+    {
+        std::unique_lock lk(blockchain_mutex);
+        ::applyBlock(state_manager, contract, block);
+    }
+};
+
+
+// the lock of the blockchain is held only to take the view
+struct ViewCall
+{
+    lk::StateManager& state_manager;
+    const lk::Address& contract;
+    std::shared_mutex& blockchain_mutex;
+
+    std::size_t operator()(std::size_t call)
+    {
+        std::shared_lock lk(blockchain_mutex);
+        auto view = state_manager.createView();
+        lk.unlock();
+        auto commit = view.createCommit();
+        return executeCall(commit, contract, call);
+    }
+
+    void applyBlock(std::size_t block)
+    {
+        std::unique_lock lk(blockchain_mutex);
+        ::applyBlock(state_manager, contract, block);
+    }
+};
+
+} // namespace
+
+
+BENCHMARK_CASE(state_view_calls_during_blocks)
+{
+    std::shared_mutex blockchain_mutex;
+    {
+        lk::StateManager state_manager;
+        auto contract = prepareContract(state_manager);
+        runCallsDuringBlocks("calls holding the blockchain lock",
+                             LockedCall{ state_manager, contract, blockchain_mutex });
+    }
+    {
+        lk::StateManager state_manager;
+        auto contract = prepareContract(state_manager);
+        runCallsDuringBlocks("calls on state views", ViewCall{ state_manager, contract, blockchain_mutex });
+    }
+}
+
+
+// what the application of blocks pays for keeping the previous values, while a view is open
+BENCHMARK_CASE(state_view_block_application)
+{
+    lk::StateManager state_manager;
+    auto contract = prepareContract(state_manager);
+    base::Timer timer;
+    timer.start();
+    for (std::size_t block = 0; block < BLOCKS_COUNT; ++block) {
+        applyBlock(state_manager, contract, block);
+    }
+    benchmark::report("block application without views", BLOCKS_COUNT, timer);
+
+    timer.start();
+    for (std::size_t block = 0; block < BLOCKS_COUNT; ++block) {
+        auto view = state_manager.createView();
+        applyBlock(state_manager, contract, block);
+    }
+    benchmark::report("block application with a view per block", BLOCKS_COUNT, timer);
+}
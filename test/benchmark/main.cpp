@@ -0,0 +1,68 @@
+#include "benchmark.hpp"
+
+#include "base/log.hpp"
+
+#include <iomanip>
+#include <iostream>
+
+namespace benchmark
+{
+
+Registry& Registry::instance()
+{
+    static Registry registry;
+    return registry;
+}
+
+
+void Registry::add(std::string name, Case benchmark_case)
+{
+    _cases.emplace_back(std::move(name), std::move(benchmark_case));
+}
+
+
+int Registry::run(const std::vector<std::string>& filters) const
+{
+    int ran = 0;
+    for (const auto& [name, benchmark_case] : _cases) {
+        bool selected = filters.empty();
+        for (const auto& filter : filters) {
+            selected = selected || name.find(filter) != std::string::npos;
+        }
+        if (selected) {
+            std::cout << "=== " << name << std::endl;
+            benchmark_case();
+            ++ran;
+        }
+    }
+    return ran;
+}
+
+
+Registrar::Registrar(std::string name, Registry::Case benchmark_case)
+{
+    Registry::instance().add(std::move(name), std::move(benchmark_case));
+}
+
+
+void report(const std::string& name, std::size_t operations, const base::Timer& timer)
+{
+    auto seconds = timer.elapsedSeconds();
+    std::cout << name << ": " << operations << " ops in " << std::fixed << std::setprecision(3) << seconds << " s ("
+              << std::setprecision(0) << (seconds > 0 ? operations / seconds : 0) << " ops/s)" << std::endl;
+}
+
+} // namespace benchmark
+
+
+// usage: run_benchmarks [name_filter...]
+int main(int argc, char** argv)
+{
+    base::initLog(base::Sink::DISABLE);
+    std::vector<std::string> filters(argv + 1, argv + argc);
+    if (benchmark::Registry::instance().run(filters) == 0) {
+        std::cerr << "no benchmarks matched" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,120 @@
+#include "benchmark.hpp"
+
+#include "base/assert.hpp"
+#include "vm/abi.hpp"
+#include "vm/tools.hpp"
+
+#include <boost/property_tree/json_parser.hpp>
+
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+
+constexpr std::size_t CALLS_COUNT = 100'000;
+constexpr std::size_t UNCACHED_CALLS_COUNT = 10'000;
+const std::filesystem::path CONTRACT_PATH{ "benchmark_contract" };
+
+// the interface of an ERC-20 token with a batch transfer
+const char* const TOKEN_METADATA = R"({"output": {"abi": [
+  {"type": "constructor", "inputs": [{"name": "supply", "type": "uint256"}, {"name": "name", "type": "string"}]},
+  {"type": "function", "name": "name", "inputs": [], "outputs": [{"name": "", "type": "string"}]},
+  {"type": "function", "name": "decimals", "inputs": [], "outputs": [{"name": "", "type": "uint8"}]},
+  {"type": "function", "name": "totalSupply", "inputs": [], "outputs": [{"name": "", "type": "uint256"}]},
+  {"type": "function", "name": "balanceOf", "inputs": [{"name": "owner", "type": "address"}],
+   "outputs": [{"name": "balance", "type": "uint256"}]},
+  {"type": "function", "name": "allowance",
+   "inputs": [{"name": "owner", "type": "address"}, {"name": "spender", "type": "address"}],
+   "outputs": [{"name": "", "type": "uint256"}]},
+  {"type": "function", "name": "approve",
+   "inputs": [{"name": "spender", "type": "address"}, {"name": "value", "type": "uint256"}],
+   "outputs": [{"name": "", "type": "bool"}]},
+  {"type": "function", "name": "transfer",
+   "inputs": [{"name": "to", "type": "address"}, {"name": "value", "type": "uint256"}],
+   "outputs": [{"name": "", "type": "bool"}]},
+  {"type": "function", "name": "transferFrom",
+   "inputs": [{"name": "from", "type": "address"}, {"name": "to", "type": "address"},
+              {"name": "value", "type": "uint256"}],
+   "outputs": [{"name": "", "type": "bool"}]},
+  {"type": "function", "name": "batchTransfer",
+   "inputs": [{"name": "to", "type": "address[]"}, {"name": "values", "type": "uint256[]"},
+              {"name": "memo", "type": "string"}],
+   "outputs": [{"name": "sent", "type": "uint256"}, {"name": "failed", "type": "address[]"}]}
+]}})";
+
+
+lk::Address makeAddress(std::size_t seed)
+{
+    return lk::Address(base::Ripemd160::compute(base::Bytes(std::to_string(seed))).getBytes());
+}
+
+} // namespace
+
+
+BENCHMARK_CASE(abi_encode_decode_calls)
+{
+    std::filesystem::create_directories(CONTRACT_PATH);
+    std::ofstream(CONTRACT_PATH / "compiled_code.bin") << "6080604052";
+    std::ofstream(CONTRACT_PATH / "metadata.json") << TOKEN_METADATA;
+
+    const auto receiver = makeAddress(1);
+    const auto transfer_arguments = "Address(" + receiver.toString() + "), 1000000";
+    const auto transfer_call = "transfer(" + transfer_arguments + ")";
+    std::string batch_arguments = "[";
+    for (std::size_t i = 0; i < 10; ++i) {
+        batch_arguments += (i > 0 ? ", Address(" : "Address(") + makeAddress(i).toString() + ")";
+    }
+    batch_arguments += "], [1, 2, 3, 4, 5, 6, 7, 8, 9, 10], \"salary\"";
+    const auto batch_call = "batchTransfer(" + batch_arguments + ")";
+
+    // the ABI parsed anew for every call, the same as the files of the contract were read before
+    std::size_t encoded_size = 0;
+    base::Timer timer;
+    timer.start();
+    for (std::size_t i = 0; i < UNCACHED_CALLS_COUNT; ++i) {
+        boost::property_tree::ptree metadata;
+        boost::property_tree::read_json((CONTRACT_PATH / "metadata.json").string(), metadata);
+        vm::abi::ContractAbi abi(metadata.get_child("output.abi"));
+        encoded_size += abi.encodeCall("transfer", vm::abi::parseArguments(transfer_arguments)).size();
+    }
+    benchmark::report("encode transfer call, parsing ABI every time", UNCACHED_CALLS_COUNT, timer);
+
+    timer.start();
+    for (std::size_t i = 0; i < CALLS_COUNT; ++i) {
+        encoded_size += vm::encodeMessage(CONTRACT_PATH.string(), transfer_call).size();
+    }
+    benchmark::report("encode transfer call", CALLS_COUNT, timer);
+
+    timer.start();
+    for (std::size_t i = 0; i < CALLS_COUNT; ++i) {
+        encoded_size += vm::encodeMessage(CONTRACT_PATH.string(), batch_call).size();
+    }
+    benchmark::report("encode batch transfer call", CALLS_COUNT, timer);
+
+    boost::property_tree::ptree metadata;
+    boost::property_tree::read_json((CONTRACT_PATH / "metadata.json").string(), metadata);
+    vm::abi::ContractAbi abi(metadata.get_child("output.abi"));
+    const auto& transfer = *abi.findFunction("transfer", { { receiver }, { vm::abi::Value::Integer{ 1 } } });
+    timer.start();
+    for (std::size_t i = 0; i < CALLS_COUNT; ++i) {
+        encoded_size += vm::abi::encodeCall(transfer, receiver, i).size();
+    }
+    benchmark::report("encode transfer call of native arguments", CALLS_COUNT, timer);
+    ASSERT(encoded_size > 0);
+
+    const auto& batch_transfer = *abi.findFunction("batchTransfer", vm::abi::parseArguments(batch_arguments));
+    std::vector<lk::Address> failed{ makeAddress(3), makeAddress(7) };
+    const auto output = base::toHex(batch_transfer.selector) +
+                        base::toHex(vm::abi::encode(batch_transfer.getOutputTypes(),
+                                                    { vm::abi::toValue(8), vm::abi::toValue(failed) }));
+    std::size_t decoded_size = 0;
+    timer.start();
+    for (std::size_t i = 0; i < CALLS_COUNT; ++i) {
+        decoded_size += vm::decodeMessage(CONTRACT_PATH.string(), output).size();
+    }
+    benchmark::report("decode batch transfer output", CALLS_COUNT, timer);
+    ASSERT(decoded_size > 0);
+
+    std::filesystem::remove_all(CONTRACT_PATH);
+}
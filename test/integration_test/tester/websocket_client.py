@@ -85,12 +85,13 @@ class Transaction:
 
 class Block:
     def __init__(self, depth: int, nonce: int, timestamp: int, coinbase: str, previous_block_hash: str,
-                 transactions: list):
+                 state_root: str, transactions: list):
         self.nonce = nonce
         self.depth = depth
         self.timestamp = timestamp
         self.coinbase = coinbase
         self.previous_block_hash = previous_block_hash
+        self.state_root = state_root
         self.transactions = transactions
 
 
@@ -210,11 +211,12 @@ class _GetBlockParser:
         nonce = result["nonce"]
         coinbase = result["coinbase"]
         previous_block_hash = _base64_to_hex(result["previous_block_hash"])
+        state_root = _base64_to_hex(result["state_root"])
         timestamp = result["timestamp"]
         txs = list()
         for item in result['transactions']:
             txs.append(_GetTransactionParser.parse(item))
-        return Block(depth, nonce, timestamp, coinbase, previous_block_hash, txs)
+        return Block(depth, nonce, timestamp, coinbase, previous_block_hash, state_root, txs)
 
 
 class _CallViewParser:
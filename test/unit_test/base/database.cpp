@@ -3,6 +3,8 @@
 #include "base/database.hpp"
 #include "base/error.hpp"
 
+#include <thread>
+
 BOOST_AUTO_TEST_CASE(data_base_test_1)
 {
     std::filesystem::path path_to_data_base_folder("local_test_base");
@@ -236,4 +238,214 @@ BOOST_AUTO_TEST_CASE(data_base_with_long_path)
     BOOST_CHECK_EQUAL(data_base2.get(key1).value().toString(), bytes1.toString());
 
     std::filesystem::remove_all(path_to_data_base_folder);
-}
\ No newline at end of file
+}
+
+BOOST_AUTO_TEST_CASE(data_base_batch_write)
+{
+    std::filesystem::path path_to_data_base_folder("local_test_base");
+
+    base::Bytes key1("key 1");
+    base::Bytes key2("key 2");
+    base::Bytes key3("key 3");
+    {
+        auto data_base = base::createClearDatabaseInstance(path_to_data_base_folder);
+        data_base.put(key1, base::Bytes("old value"));
+
+        base::Database::Batch batch;
+        BOOST_CHECK(batch.isEmpty());
+        batch.put(key2, base::Bytes("value 2"));
+        batch.put(key3, base::Bytes("value 3"));
+        batch.remove(key1);
+        BOOST_CHECK(!batch.isEmpty());
+        BOOST_CHECK(data_base.exists(key1));
+        BOOST_CHECK(!data_base.exists(key2));
+
+        data_base.write(std::move(batch));
+        data_base.write(base::Database::Batch{});
+    }
+
+    base::Database data_base2(path_to_data_base_folder);
+    BOOST_CHECK(!data_base2.exists(key1));
+    BOOST_CHECK_EQUAL(data_base2.get(key2).value().toString(), "value 2");
+    BOOST_CHECK_EQUAL(data_base2.get(key3).value().toString(), "value 3");
+
+    std::filesystem::remove_all(path_to_data_base_folder);
+}
+
+
+BOOST_AUTO_TEST_CASE(data_base_group_commit)
+{
+    std::filesystem::path path_to_data_base_folder("local_test_base");
+    constexpr std::size_t THREADS_COUNT = 8;
+    constexpr std::size_t WRITES_COUNT = 50;
+    {
+        auto data_base = base::createClearDatabaseInstance(path_to_data_base_folder);
+        data_base.setGroupCommit(true);
+
+        std::vector<std::thread> writers;
+        for (std::size_t t = 0; t < THREADS_COUNT; ++t) {
+            writers.emplace_back([&data_base, t] {
+                for (std::size_t i = 0; i < WRITES_COUNT; ++i) {
+                    base::Database::Batch batch;
+                    batch.put(base::Bytes(std::to_string(t) + " " + std::to_string(i)), base::Bytes(std::to_string(i)));
+                    batch.put(base::Bytes("last " + std::to_string(t)), base::Bytes(std::to_string(i)));
+                    data_base.write(std::move(batch));
+                }
+            });
+        }
+        for (auto& writer : writers) {
+            writer.join();
+        }
+    }
+
+    base::Database data_base2(path_to_data_base_folder);
+    for (std::size_t t = 0; t < THREADS_COUNT; ++t) {
+        for (std::size_t i = 0; i < WRITES_COUNT; ++i) {
+            BOOST_CHECK(data_base2.exists(base::Bytes(std::to_string(t) + " " + std::to_string(i))));
+        }
+        BOOST_CHECK_EQUAL(data_base2.get(base::Bytes("last " + std::to_string(t))).value().toString(),
+                          std::to_string(WRITES_COUNT - 1));
+    }
+
+    std::filesystem::remove_all(path_to_data_base_folder);
+}
+
+
+BOOST_AUTO_TEST_CASE(data_base_views_as_keys_and_values)
+{
+    std::filesystem::path path_to_data_base_folder("local_test_base");
+    auto data_base = base::createClearDatabaseInstance(path_to_data_base_folder);
+
+    base::FixedBytes<4> fixed_key{ 0x01, 0x02, 0x03, 0x04 };
+    base::Bytes value("value");
+    base::Bytes long_key("prefix and key");
+    std::span<const base::Byte> span_key(long_key.getData() + 7, long_key.size() - 7);
+
+    data_base.put(fixed_key, std::span<const base::Byte>(value.getData(), value.size()));
+    data_base.put(span_key, value);
+    data_base.put(leveldb::Slice("slice key"), leveldb::Slice("slice value"));
+
+    BOOST_CHECK_EQUAL(data_base.get(fixed_key.toBytes()).value().toString(), "value");
+    BOOST_CHECK(data_base.exists(base::Bytes("and key")));
+    BOOST_CHECK(!data_base.exists(long_key));
+    BOOST_CHECK_EQUAL(data_base.get(base::Bytes("slice key")).value().toString(), "slice value");
+
+    std::string buffer("previous contents");
+    BOOST_CHECK(data_base.get(fixed_key, buffer));
+    BOOST_CHECK_EQUAL(buffer, "value");
+    BOOST_CHECK(!data_base.get(base::Bytes("missing key"), buffer));
+
+    base::Database::Batch batch;
+    batch.remove(span_key);
+    batch.put(leveldb::Slice("batch key"), fixed_key);
+    data_base.write(std::move(batch));
+    BOOST_CHECK(!data_base.exists(span_key));
+    BOOST_CHECK(data_base.get(leveldb::Slice("batch key")).value() == fixed_key.toBytes());
+
+    std::filesystem::remove_all(path_to_data_base_folder);
+}
+
+
+BOOST_AUTO_TEST_CASE(data_base_options_and_statistics)
+{
+    std::filesystem::path path_to_data_base_folder("local_test_base");
+
+    base::PropertyTree config;
+    config.add("database.bloom_filter_bits_per_key", 0);
+    config.add("database.sync_writes", false);
+    config.add("database.data_block_cache_size", 1024 * 1024);
+    auto options = base::readDatabaseOptions(config, "database");
+    BOOST_CHECK_EQUAL(options.bloom_filter_bits_per_key, 0);
+    BOOST_CHECK(!options.is_write_synced);
+    BOOST_CHECK_EQUAL(options.data_block_cache_size, 1024 * 1024);
+    BOOST_CHECK_EQUAL(options.max_open_files, base::DatabaseOptions{}.max_open_files);
+    BOOST_CHECK_EQUAL(base::readDatabaseOptions(config, "other").bloom_filter_bits_per_key,
+                      base::config::DATABASE_BLOOM_FILTER_BITS_PER_KEY);
+
+    auto data_base = base::createClearDatabaseInstance(path_to_data_base_folder, options);
+    data_base.put(base::Bytes("key"), base::Bytes("value"));
+    BOOST_CHECK(data_base.exists(base::Bytes("key")));
+    BOOST_CHECK(!data_base.exists(base::Bytes("missing key")));
+
+    BOOST_CHECK(data_base.getProperty("leveldb.stats"));
+    BOOST_CHECK(!data_base.getProperty("no such property"));
+    BOOST_CHECK_NO_THROW(data_base.getApproximateSize(base::Bytes("k")));
+    BOOST_CHECK_NO_THROW(data_base.getApproximateSize(base::Bytes{}));
+
+    std::filesystem::remove_all(path_to_data_base_folder);
+}
+
+
+BOOST_AUTO_TEST_CASE(data_base_memory_engine)
+{
+    std::filesystem::path path_to_data_base_folder("local_test_base");
+
+    base::PropertyTree config;
+    config.add("database.engine", std::string("memory"));
+    auto options = base::readDatabaseOptions(config, "database");
+    BOOST_CHECK(options.engine == base::StorageEngine::MEMORY);
+
+    config.add("other.engine", std::string("unknown"));
+    BOOST_CHECK_THROW(base::readDatabaseOptions(config, "other"), base::InvalidArgument);
+
+    auto data_base = base::createClearDatabaseInstance(path_to_data_base_folder, options);
+    data_base.put(base::Bytes("a 1"), base::Bytes("value 1"));
+    data_base.put(base::Bytes("b 1"), base::Bytes("value 2"));
+    data_base.put(base::Bytes("a 2"), base::Bytes("value 3"));
+    data_base.put(base::Bytes("a 1"), base::Bytes("new value 1"));
+    data_base.remove(base::Bytes("missing key"));
+
+    base::Database::Batch batch;
+    batch.put(base::Bytes("a 3"), base::Bytes("value 4"));
+    batch.remove(base::Bytes("a 2"));
+    data_base.write(std::move(batch));
+
+    BOOST_CHECK_EQUAL(data_base.get(base::Bytes("a 1")).value().toString(), "new value 1");
+    BOOST_CHECK(!data_base.exists(base::Bytes("a 2")));
+    BOOST_CHECK_EQUAL(data_base.get(base::Bytes("a 3")).value().toString(), "value 4");
+
+    std::vector<std::string> keys;
+    data_base.scan(base::Bytes("a"), [&keys](const leveldb::Slice& key, const leveldb::Slice&) {
+        keys.push_back(key.ToString());
+        return true;
+    });
+    BOOST_CHECK(keys == std::vector<std::string>({ "a 1", "a 3" }));
+
+    BOOST_CHECK_EQUAL(data_base.getApproximateSize(base::Bytes("b")), std::string("b 1value 2").size());
+    BOOST_CHECK_EQUAL(data_base.getProperty("memory.entries-count").value(), "3");
+
+    std::filesystem::remove_all(path_to_data_base_folder);
+}
+
+
+BOOST_AUTO_TEST_CASE(data_base_snapshot)
+{
+    std::filesystem::path path_to_data_base_folder("local_test_base");
+
+    for (const auto engine : { base::StorageEngine::LEVELDB, base::StorageEngine::MEMORY }) {
+        base::DatabaseOptions options;
+        options.engine = engine;
+        auto data_base = base::createClearDatabaseInstance(path_to_data_base_folder, options);
+        data_base.put(base::Bytes("key 1"), base::Bytes("value 1"));
+
+        auto snapshot = data_base.getSnapshot();
+        data_base.put(base::Bytes("key 1"), base::Bytes("new value 1"));
+        data_base.put(base::Bytes("key 2"), base::Bytes("value 2"));
+
+        BOOST_CHECK_EQUAL(snapshot.get(base::Bytes("key 1")).value().toString(), "value 1");
+        BOOST_CHECK(!snapshot.exists(base::Bytes("key 2")));
+        BOOST_CHECK_EQUAL(data_base.get(base::Bytes("key 1")).value().toString(), "new value 1");
+
+        std::size_t entries_count = 0;
+        snapshot.scan(base::Bytes("key"), [&entries_count](const leveldb::Slice&, const leveldb::Slice&) {
+            ++entries_count;
+            return true;
+        });
+        BOOST_CHECK_EQUAL(entries_count, 1);
+
+        BOOST_CHECK_THROW(snapshot.put(base::Bytes("key 3"), base::Bytes("value 3")), base::LogicError);
+        BOOST_CHECK_THROW(snapshot.remove(base::Bytes("key 1")), base::LogicError);
+    }
+
+    std::filesystem::remove_all(path_to_data_base_folder);
+}
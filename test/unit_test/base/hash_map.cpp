@@ -0,0 +1,128 @@
+#include <boost/test/unit_test.hpp>
+
+#include "base/hash.hpp"
+#include "base/hash_map.hpp"
+
+#include <set>
+#include <string>
+
+namespace
+{
+
+// makes every key collide, so that probing and backward shift deletion are exercised
+struct CollidingHash
+{
+    std::size_t operator()(int) const noexcept
+    {
+        return 7;
+    }
+};
+
+} // namespace
+
+
+BOOST_AUTO_TEST_CASE(hash_map_insert_find_erase)
+{
+    base::HashMap<int, std::string> map;
+    BOOST_CHECK(map.empty());
+
+    for (int i = 0; i < 1000; ++i) {
+        BOOST_CHECK(map.try_emplace(i, std::to_string(i)).second);
+    }
+    BOOST_CHECK(!map.try_emplace(5, "other").second);
+    BOOST_CHECK_EQUAL(map.size(), 1000);
+
+    for (int i = 0; i < 1000; i += 2) {
+        BOOST_CHECK_EQUAL(map.erase(i), 1);
+    }
+    BOOST_CHECK_EQUAL(map.erase(0), 0);
+    BOOST_CHECK_EQUAL(map.size(), 500);
+
+    for (int i = 0; i < 1000; ++i) {
+        auto it = map.find(i);
+        if (i % 2) {
+            BOOST_REQUIRE(it != map.end());
+            BOOST_CHECK_EQUAL(it->second, std::to_string(i));
+        }
+        else {
+            BOOST_CHECK(it == map.end());
+            BOOST_CHECK(!map.contains(i));
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(hash_map_colliding_keys)
+{
+    base::HashMap<int, int, CollidingHash> map;
+    for (int i = 0; i < 100; ++i) {
+        map[i] = i * 10;
+    }
+    for (int i = 0; i < 100; i += 3) {
+        map.erase(i);
+    }
+    for (int i = 0; i < 100; ++i) {
+        BOOST_CHECK_EQUAL(map.contains(i), i % 3 != 0);
+        if (i % 3) {
+            BOOST_CHECK_EQUAL(map[i], i * 10);
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(hash_map_references_survive_rehash)
+{
+    base::HashMap<base::Sha256, int, base::PrefixHash<base::Sha256>> map;
+    auto first_key = base::Sha256::compute(base::Bytes("0"));
+    int& first_value = map[first_key];
+    first_value = 42;
+
+    auto initial_capacity = map.capacity();
+    for (int i = 1; i < 10000; ++i) {
+        map.insert_or_assign(base::Sha256::compute(base::Bytes(std::to_string(i))), i);
+    }
+    BOOST_CHECK(map.capacity() > initial_capacity);
+    BOOST_CHECK_EQUAL(&first_value, &map[first_key]);
+    BOOST_CHECK_EQUAL(first_value, 42);
+}
+
+
+BOOST_AUTO_TEST_CASE(hash_map_words_hash_of_small_numbers)
+{
+    // 32-byte big-endian numbers: PrefixHash would see only zeros
+    std::set<std::size_t> hashes;
+    base::WordsHash<base::FixedBytes<32>> hasher;
+    for (int i = 0; i < 1000; ++i) {
+        base::FixedBytes<32> key;
+        key[31] = static_cast<base::Byte>(i);
+        key[30] = static_cast<base::Byte>(i >> 8);
+        hashes.insert(hasher(key));
+    }
+    BOOST_CHECK_EQUAL(hashes.size(), 1000);
+}
+
+
+BOOST_AUTO_TEST_CASE(hash_map_copy_and_iterate)
+{
+    base::HashMap<int, int> map;
+    for (int i = 0; i < 100; ++i) {
+        map[i] = i;
+    }
+
+    auto copy = map;
+    copy[0] = 1000;
+    BOOST_CHECK_EQUAL(map[0], 0);
+
+    int sum = 0;
+    std::size_t count = 0;
+    for (const auto& [key, value] : map) {
+        sum += value;
+        ++count;
+    }
+    BOOST_CHECK_EQUAL(count, 100);
+    BOOST_CHECK_EQUAL(sum, 4950);
+
+    auto moved = std::move(copy);
+    BOOST_CHECK_EQUAL(moved.size(), 100);
+    BOOST_CHECK_EQUAL(moved[0], 1000);
+}
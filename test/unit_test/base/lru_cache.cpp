@@ -0,0 +1,57 @@
+#include <boost/test/unit_test.hpp>
+
+#include "base/lru_cache.hpp"
+
+#include <string>
+
+
+BOOST_AUTO_TEST_CASE(lru_cache_evicts_least_recently_used)
+{
+    base::LruCache<int, std::string> cache(3);
+    cache.put(1, "1");
+    cache.put(2, "2");
+    cache.put(3, "3");
+    BOOST_CHECK(cache.get(1) == "1");
+
+    cache.put(4, "4");
+    BOOST_CHECK_EQUAL(cache.size(), 3);
+    BOOST_CHECK(!cache.contains(2));
+    BOOST_CHECK(cache.contains(1));
+    BOOST_CHECK(cache.contains(3));
+
+    cache.put(3, "three");
+    cache.put(5, "5");
+    BOOST_CHECK(!cache.contains(1));
+    BOOST_CHECK(cache.get(3) == "three");
+
+    BOOST_CHECK_EQUAL(cache.hits(), 2);
+    BOOST_CHECK(!cache.get(1));
+    BOOST_CHECK_EQUAL(cache.misses(), 1);
+}
+
+
+BOOST_AUTO_TEST_CASE(lru_cache_bounds_charge)
+{
+    base::LruCache<int, std::string> cache(100);
+    cache.put(1, "1", 40);
+    cache.put(2, "2", 40);
+    BOOST_CHECK_EQUAL(cache.charge(), 80);
+
+    cache.put(3, "3", 50);
+    BOOST_CHECK(!cache.contains(1));
+    BOOST_CHECK_EQUAL(cache.charge(), 90);
+
+    cache.put(2, "2", 10);
+    BOOST_CHECK_EQUAL(cache.charge(), 60);
+
+    // larger than the whole cache, so it isn't cached and doesn't evict anything
+    cache.put(4, "4", 101);
+    BOOST_CHECK(!cache.contains(4));
+    BOOST_CHECK_EQUAL(cache.size(), 2);
+
+    cache.erase(3);
+    BOOST_CHECK_EQUAL(cache.charge(), 10);
+    cache.clear();
+    BOOST_CHECK_EQUAL(cache.charge(), 0);
+    BOOST_CHECK_EQUAL(cache.size(), 0);
+}
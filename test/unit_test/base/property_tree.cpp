@@ -97,4 +97,32 @@ BOOST_AUTO_TEST_CASE(property_tree_set_value)
     root.add("lol", sub);
 
     std::cout << root.toString();
-}
\ No newline at end of file
+}
+
+BOOST_AUTO_TEST_CASE(property_tree_arrays)
+{
+    base::PropertyTree values;
+    values.pushBack(1);
+    values.pushBack(2);
+
+    base::PropertyTree nested;
+    for (int i = 0; i < 3; ++i) {
+        base::PropertyTree element;
+        element.pushBack(std::to_string(i));
+        nested.pushBack(std::move(element));
+    }
+
+    base::PropertyTree root;
+    root.add("values", std::move(values));
+    root.add("nested", std::move(nested));
+
+    auto parsed = base::parseJson(root.toString());
+    const std::vector<int> right_values{ 1, 2 };
+    BOOST_CHECK(parsed.getVector<int>("values") == right_values);
+    int i = 0;
+    for (const auto& element : parsed.getSubTree("nested")) {
+        BOOST_CHECK_EQUAL(element.second.size(), 1);
+        BOOST_CHECK_EQUAL(element.second.front().second.get_value<std::string>(), std::to_string(i++));
+    }
+    BOOST_CHECK_EQUAL(i, 3);
+}
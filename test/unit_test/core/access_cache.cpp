@@ -0,0 +1,78 @@
+#include <boost/test/unit_test.hpp>
+
+#include "core/access_cache.hpp"
+
+#include "base/error.hpp"
+
+namespace
+{
+
+lk::Address makeAddress(std::size_t seed)
+{
+    return lk::Address(base::Ripemd160::compute(base::Bytes(std::to_string(seed))).getBytes());
+}
+
+
+lk::StorageKey makeKey(std::size_t seed)
+{
+    return base::Sha256::compute(base::Bytes(std::to_string(seed))).getBytes();
+}
+
+} // namespace
+
+
+BOOST_AUTO_TEST_CASE(access_cache_tracks_warm_accounts_and_slots)
+{
+    lk::StateManager state_manager;
+    auto client = makeAddress(1);
+    state_manager.applyBlockEmission(client, 1000);
+
+    auto commit = state_manager.createCommit();
+    auto contract = commit.createContractAccount(client, base::Sha256::compute(base::Bytes("code")));
+    commit.setStorageValue(contract, makeKey(1), makeKey(100));
+
+    lk::AccessCache accesses(commit);
+    BOOST_CHECK(!accesses.isWarm(client));
+    BOOST_CHECK(accesses.hasAccount(client));
+    BOOST_CHECK(accesses.isWarm(client));
+
+    BOOST_CHECK(!accesses.isWarm(contract));
+    BOOST_CHECK(!accesses.isWarm(contract, makeKey(1)));
+    BOOST_CHECK(*accesses.getStorage(contract).find(makeKey(1)) == makeKey(100));
+    BOOST_CHECK(accesses.isWarm(contract));
+    BOOST_CHECK(accesses.isWarm(contract, makeKey(1)));
+    BOOST_CHECK(!accesses.isWarm(contract, makeKey(2)));
+
+    // a missing account is warm, but its absence is not cached
+    auto created = makeAddress(2);
+    BOOST_CHECK(!accesses.hasAccount(created));
+    BOOST_CHECK(accesses.isWarm(created));
+    BOOST_CHECK(commit.tryTransferMoney(client, created, 10));
+    BOOST_CHECK(accesses.hasAccount(created));
+
+    BOOST_CHECK_THROW(accesses.getStorage(client), base::LogicError);
+}
+
+
+BOOST_AUTO_TEST_CASE(access_cache_shares_contract_storage)
+{
+    lk::StateManager state_manager;
+    auto client = makeAddress(1);
+    state_manager.applyBlockEmission(client, 1000);
+
+    auto commit = state_manager.createCommit();
+    auto contract = commit.createContractAccount(client, base::Sha256::compute(base::Bytes("code")));
+
+    lk::AccessCache accesses(commit);
+    auto& storage = accesses.getStorage(contract);
+    storage.set(makeKey(1), makeKey(100));
+    BOOST_CHECK(&accesses.getStorage(contract) == &storage);
+    BOOST_CHECK(commit.getStorageValue(contract, makeKey(1)).data == makeKey(100));
+
+    // a deleted contract has no storage
+    BOOST_CHECK(commit.deleteAccount(contract, client));
+    accesses.forget(contract);
+    BOOST_CHECK(accesses.isWarm(contract));
+    BOOST_CHECK(!accesses.hasAccount(contract));
+    BOOST_CHECK_THROW(accesses.getStorage(contract), base::LogicError);
+}
@@ -0,0 +1,220 @@
+#include <boost/test/unit_test.hpp>
+
+#include "core/blockchain.hpp"
+#include "core/database_keys.hpp"
+
+namespace
+{
+
+const std::filesystem::path DATABASE_PATH{ "local_test_base" };
+constexpr std::uint_least32_t GENESIS_TIMESTAMP = 1583789617;
+
+
+lk::TransactionsSet makeTransactions(std::size_t seed)
+{
+    lk::TransactionsSet txs;
+    txs.add(lk::Transaction{
+      lk::Address::null(), lk::Address::null(), seed + 1, 0, base::Time(GENESIS_TIMESTAMP), base::Bytes{} });
+    return txs;
+}
+
+
+const lk::ImmutableBlock& getGenesis()
+{
+    static const lk::ImmutableBlock genesis{
+        0, 0, base::Sha256::null(), base::Sha256::null(), base::Time(GENESIS_TIMESTAMP), lk::Address::null(),
+        makeTransactions(0)
+    };
+    return genesis;
+}
+
+
+// blocks come once in two minutes, so the complexity stays minimal and any block passes the consensus check
+lk::ImmutableBlock makeNextBlock(const lk::ImmutableBlock& top, lk::TransactionsSet txs)
+{
+    return lk::ImmutableBlock{ top.getDepth() + 1,
+                               0,
+                               top.getHash(),
+                               base::Sha256::null(),
+                               base::Time(top.getTimestamp().getSeconds() + 120),
+                               lk::Address::null(),
+                               std::move(txs) };
+}
+
+} // namespace
+
+
+BOOST_AUTO_TEST_CASE(persistent_blockchain_load)
+{
+    base::PropertyTree config;
+    std::vector<base::Sha256> hashes{ getGenesis().getHash() };
+    {
+        auto database = base::createClearDatabaseInstance(DATABASE_PATH);
+        lk::PersistentBlockchain blockchain{ getGenesis(), database, config };
+        blockchain.load();
+        for (std::size_t i = 1; i <= 600; ++i) {
+            auto block = makeNextBlock(blockchain.getTopBlock(), makeTransactions(i));
+            BOOST_REQUIRE(blockchain.tryAddBlock(block) == lk::IBlockchain::AdditionResult::ADDED);
+            hashes.push_back(block.getHash());
+        }
+    }
+
+    base::Database database(DATABASE_PATH);
+    lk::PersistentBlockchain blockchain{ getGenesis(), database, config };
+    blockchain.load();
+    BOOST_CHECK(blockchain.getTopBlockHash() == hashes.back());
+    for (std::size_t depth = 0; depth < hashes.size(); ++depth) {
+        BOOST_CHECK(blockchain.findBlockHashByDepth(depth) == hashes[depth]);
+    }
+    BOOST_CHECK(blockchain.findBlock(hashes[300])->getDepth() == 300);
+
+    std::filesystem::remove_all(DATABASE_PATH);
+}
+
+
+BOOST_AUTO_TEST_CASE(persistent_blockchain_trusted_load_skips_validation)
+{
+    // a block without transactions is rejected by the validation, but is still linked to its parent
+    const auto block1 = makeNextBlock(getGenesis(), makeTransactions(1));
+    const auto block2 = makeNextBlock(block1, lk::TransactionsSet{});
+    const auto block3 = makeNextBlock(block2, makeTransactions(3));
+    {
+        auto database = base::createClearDatabaseInstance(DATABASE_PATH);
+        for (const auto& block : { block1, block2, block3 }) {
+            database.put(lk::makeDatabaseKey(lk::DataType::BLOCK, block.getDepth()), base::toBytes(block));
+        }
+    }
+
+    base::Database database(DATABASE_PATH);
+    {
+        base::PropertyTree config;
+        lk::PersistentBlockchain blockchain{ getGenesis(), database, config };
+        blockchain.load();
+        BOOST_CHECK(blockchain.getTopBlockHash() == block1.getHash());
+    }
+    {
+        base::PropertyTree config;
+        config.add("database.trusted", true);
+        lk::PersistentBlockchain blockchain{ getGenesis(), database, config };
+        blockchain.load();
+        BOOST_CHECK(blockchain.getTopBlockHash() == block3.getHash());
+    }
+
+    std::filesystem::remove_all(DATABASE_PATH);
+}
+
+
+BOOST_AUTO_TEST_CASE(persistent_blockchain_trusted_load_stops_at_broken_link)
+{
+    const auto block1 = makeNextBlock(getGenesis(), makeTransactions(1));
+    const auto block2 = makeNextBlock(block1, makeTransactions(2));
+    const auto unlinked_block = makeNextBlock(block2, makeTransactions(3));
+    {
+        auto database = base::createClearDatabaseInstance(DATABASE_PATH);
+        database.put(lk::makeDatabaseKey(lk::DataType::BLOCK, block1.getDepth()), base::toBytes(block1));
+        database.put(lk::makeDatabaseKey(lk::DataType::BLOCK, 2), base::toBytes(unlinked_block));
+    }
+
+    base::Database database(DATABASE_PATH);
+    base::PropertyTree config;
+    config.add("database.trusted", true);
+    lk::PersistentBlockchain blockchain{ getGenesis(), database, config };
+    blockchain.load();
+    BOOST_CHECK(blockchain.getTopBlockHash() == block1.getHash());
+
+    std::filesystem::remove_all(DATABASE_PATH);
+}
+
+
+BOOST_AUTO_TEST_CASE(persistent_blockchain_serves_evicted_blocks_from_database)
+{
+    base::PropertyTree config;
+    config.add("database.blocks_cache_size", 4 * 1024);
+    std::vector<lk::ImmutableBlock> blocks{ getGenesis() };
+    {
+        auto database = base::createClearDatabaseInstance(DATABASE_PATH);
+        lk::PersistentBlockchain blockchain{ getGenesis(), database, config };
+        for (std::size_t i = 1; i <= 50; ++i) {
+            blocks.push_back(makeNextBlock(blocks.back(), makeTransactions(i)));
+            BOOST_REQUIRE(blockchain.tryAddBlock(blocks.back()) == lk::IBlockchain::AdditionResult::ADDED);
+        }
+
+        auto statistics = blockchain.getBlocksCacheStatistics();
+        BOOST_CHECK(statistics.blocks_count < blocks.size() - 1);
+        BOOST_CHECK(statistics.size <= statistics.capacity);
+
+        for (const auto& block : blocks) {
+            BOOST_CHECK(blockchain.findBlock(block.getHash())->getHash() == block.getHash());
+        }
+        BOOST_CHECK(blockchain.getBlocksCacheStatistics().misses > statistics.misses);
+
+        const auto& tx = *blocks[2].getTransactions().begin();
+        BOOST_CHECK(blockchain.findTransaction(tx.hashOfTransaction()) == tx);
+    }
+
+    base::Database database(DATABASE_PATH);
+    lk::PersistentBlockchain blockchain{ getGenesis(), database, config };
+    blockchain.load();
+    BOOST_CHECK(blockchain.getTopBlockHash() == blocks.back().getHash());
+    BOOST_CHECK(blockchain.findBlock(blocks[1].getHash())->getDepth() == 1);
+    for (std::size_t i : { 0, 7, 50 }) {
+        const auto& tx = *blocks[i].getTransactions().begin();
+        BOOST_CHECK(blockchain.findTransaction(tx.hashOfTransaction()) == tx);
+    }
+    BOOST_CHECK(!blockchain.findTransaction(base::Sha256::compute(base::Bytes("missing"))));
+
+    std::filesystem::remove_all(DATABASE_PATH);
+}
+
+
+BOOST_AUTO_TEST_CASE(persistent_blockchain_pruning_keeps_headers)
+{
+    base::PropertyTree config;
+    config.add("database.pruning.kept_blocks", 10);
+    std::vector<lk::ImmutableBlock> blocks{ getGenesis() };
+    {
+        auto database = base::createClearDatabaseInstance(DATABASE_PATH);
+        lk::PersistentBlockchain blockchain{ getGenesis(), database, config };
+        blockchain.load();
+        BOOST_CHECK(blockchain.isPruningEnabled());
+        for (std::size_t i = 1; i <= 30; ++i) {
+            blocks.push_back(makeNextBlock(blocks.back(), makeTransactions(i)));
+            BOOST_REQUIRE(blockchain.tryAddBlock(blocks.back()) == lk::IBlockchain::AdditionResult::ADDED);
+        }
+        // nothing is pruned, until the state can be restored without the blocks
+        BOOST_CHECK_EQUAL(blockchain.getPrunedDepth(), 0);
+        BOOST_CHECK(blockchain.findBlock(blocks[5].getHash()));
+
+        blockchain.setPrunableDepth(15);
+        blocks.push_back(makeNextBlock(blocks.back(), makeTransactions(31)));
+        BOOST_REQUIRE(blockchain.tryAddBlock(blocks.back()) == lk::IBlockchain::AdditionResult::ADDED);
+        BOOST_CHECK_EQUAL(blockchain.getPrunedDepth(), 15);
+
+        blockchain.setPrunableDepth(30);
+        blocks.push_back(makeNextBlock(blocks.back(), makeTransactions(32)));
+        BOOST_REQUIRE(blockchain.tryAddBlock(blocks.back()) == lk::IBlockchain::AdditionResult::ADDED);
+        BOOST_CHECK_EQUAL(blockchain.getPrunedDepth(), 22);
+
+        BOOST_CHECK(!blockchain.findBlock(blocks[22].getHash()));
+        BOOST_CHECK(blockchain.findBlock(blocks[23].getHash())->getDepth() == 23);
+        BOOST_CHECK(blockchain.findBlockHashByDepth(5) == blocks[5].getHash());
+        BOOST_CHECK(!blockchain.findTransaction(blocks[5].getTransactions().begin()->hashOfTransaction()));
+        BOOST_CHECK(!database.exists(lk::makeDatabaseKey(lk::DataType::BLOCK, 22)));
+    }
+
+    // the pruned blocks are restored from headers, so the chain is extended as before
+    base::Database database(DATABASE_PATH);
+    lk::PersistentBlockchain blockchain{ getGenesis(), database, config };
+    blockchain.load();
+    BOOST_CHECK_EQUAL(blockchain.getPrunedDepth(), 22);
+    BOOST_CHECK(blockchain.getTopBlockHash() == blocks.back().getHash());
+    for (std::size_t depth = 0; depth < blocks.size(); ++depth) {
+        BOOST_CHECK(blockchain.findBlockHashByDepth(depth) == blocks[depth].getHash());
+    }
+    BOOST_CHECK(blockchain.findBlock(blocks[25].getHash())->getDepth() == 25);
+    blocks.push_back(makeNextBlock(blocks.back(), makeTransactions(33)));
+    BOOST_CHECK(blockchain.tryAddBlock(blocks.back()) == lk::IBlockchain::AdditionResult::ADDED);
+    BOOST_CHECK(blockchain.tryAddBlock(blocks[3]) == lk::IBlockchain::AdditionResult::ALREADY_IN_BLOCKCHAIN);
+
+    std::filesystem::remove_all(DATABASE_PATH);
+}
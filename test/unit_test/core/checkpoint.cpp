@@ -0,0 +1,272 @@
+#include <boost/test/unit_test.hpp>
+
+#include "base/memory_store.hpp"
+#include "core/checkpoint.hpp"
+
+namespace
+{
+
+constexpr std::uint_least32_t GENESIS_TIMESTAMP = 1583789617;
+constexpr lk::BlockDepth CHAIN_HEIGHT = 300;
+constexpr lk::BlockDepth CHECKPOINT_PERIOD = 50;
+constexpr std::size_t MINERS_COUNT = 5;
+
+
+lk::Address makeAddress(std::size_t seed)
+{
+    return lk::Address(base::Ripemd160::compute(base::Bytes(std::to_string(seed))).getBytes());
+}
+
+
+const lk::ImmutableBlock& getGenesis()
+{
+    static const lk::ImmutableBlock genesis = [] {
+        lk::TransactionsSet txs;
+        txs.add(lk::Transaction{ lk::Address::null(), makeAddress(0), 1, 0, base::Time(GENESIS_TIMESTAMP), {} });
+        return lk::ImmutableBlock{ 0,
+                                   0,
+                                   base::Sha256::null(),
+                                   base::Sha256::null(),
+                                   base::Time(GENESIS_TIMESTAMP),
+                                   lk::Address::null(),
+                                   std::move(txs) };
+    }();
+    return genesis;
+}
+
+
+// blocks come once in two minutes, so the complexity stays minimal and any block passes the consensus check
+std::vector<lk::ImmutableBlock> makeChain()
+{
+    std::vector<lk::ImmutableBlock> blocks{ getGenesis() };
+    for (lk::BlockDepth depth = 1; depth <= CHAIN_HEIGHT; ++depth) {
+        const auto coinbase = makeAddress(depth % MINERS_COUNT);
+        const auto timestamp = base::Time(static_cast<std::uint_least32_t>(GENESIS_TIMESTAMP + depth * 120));
+        lk::TransactionsSet txs;
+        txs.add(lk::Transaction{ coinbase, makeAddress(depth), depth, 0, timestamp, base::Bytes{} });
+        auto prev_block_hash = blocks.back().getHash();
+        blocks.emplace_back(depth, 0, prev_block_hash, base::Sha256::null(), timestamp, coinbase, std::move(txs));
+    }
+    return blocks;
+}
+
+
+const std::vector<lk::ImmutableBlock>& getChain()
+{
+    static const auto chain = makeChain();
+    return chain;
+}
+
+
+struct Crash
+{};
+
+// forwards to the engine until the given number of writes is made; then the node is killed during the next write,
+// which is applied entirely or not at all, the same as a LevelDB batch
+class CrashingStore : public base::KeyValueStore
+{
+  public:
+    CrashingStore(std::shared_ptr<base::KeyValueStore> store, std::size_t writes_before_crash)
+      : _store{ std::move(store) }
+      , _writes_left{ writes_before_crash }
+    {}
+
+    bool get(const leveldb::Slice& key, std::string& value) const override
+    {
+        return _store->get(key, value);
+    }
+
+    void put(const leveldb::Slice& key, const leveldb::Slice& value) override
+    {
+        countWrite();
+        _store->put(key, value);
+    }
+
+    void remove(const leveldb::Slice& key) override
+    {
+        countWrite();
+        _store->remove(key);
+    }
+
+    void write(leveldb::WriteBatch& batch) override
+    {
+        countWrite();
+        _store->write(batch);
+    }
+
+    void scan(const leveldb::Slice& begin, const ScanFunction& on_entry) const override
+    {
+        _store->scan(begin, on_entry);
+    }
+
+    std::shared_ptr<base::KeyValueStore> getSnapshot() const override
+    {
+        return _store->getSnapshot();
+    }
+
+    std::optional<std::string> getProperty(const std::string& name) const override
+    {
+        return _store->getProperty(name);
+    }
+
+    std::uint64_t getApproximateSize(const leveldb::Slice& begin, const leveldb::Slice& end) const override
+    {
+        return _store->getApproximateSize(begin, end);
+    }
+
+    void compact(const leveldb::Slice& begin, const leveldb::Slice& end) override
+    {
+        _store->compact(begin, end);
+    }
+
+  private:
+    std::shared_ptr<base::KeyValueStore> _store;
+    std::size_t _writes_left;
+
+    void countWrite()
+    {
+        if (_writes_left == 0) {
+            throw Crash{};
+        }
+        --_writes_left;
+    }
+};
+
+
+// stores blocks and the state the way lk::Core does, but only charges emission and records transactions hashes
+// instead of executing transactions
+class Node
+{
+  public:
+    explicit Node(base::Database& database)
+      : _database{ database }
+      , _blockchain{ getGenesis(), database, base::PropertyTree{} }
+      , _state_manager{ database }
+    {
+        _state_manager.updateFromGenesis(getGenesis());
+        _state_manager.updateStateRoot();
+        _blockchain.load();
+
+        const auto checkpoint = lk::restoreCheckpoint(_database, _blockchain, _state_manager);
+        for (auto depth = checkpoint ? checkpoint->depth + 1 : 1; depth <= _blockchain.getTopBlock().getDepth();
+             ++depth) {
+            applyBlock(*_blockchain.findBlock(*_blockchain.findBlockHashByDepth(depth)));
+            ++_replayed_blocks_count;
+        }
+    }
+
+    void addBlock(const lk::ImmutableBlock& block)
+    {
+        base::Database::Batch batch;
+        _state_manager.flush(batch);
+        BOOST_REQUIRE(_blockchain.tryAddBlock(block, batch) == lk::Blockchain::AdditionResult::ADDED);
+        auto state_root = applyBlock(block);
+        if (block.getDepth() % CHECKPOINT_PERIOD == 0) {
+            lk::Checkpoint checkpoint{ block.getDepth(), block.getHash(), state_root, _state_manager.exportState() };
+            lk::writeCheckpoint(_database, _state_manager, checkpoint);
+        }
+    }
+
+    lk::BlockDepth getTopDepth() const
+    {
+        return _blockchain.getTopBlock().getDepth();
+    }
+
+    std::size_t getReplayedBlocksCount() const noexcept
+    {
+        return _replayed_blocks_count;
+    }
+
+    lk::StateManager& getStateManager() noexcept
+    {
+        return _state_manager;
+    }
+
+  private:
+    base::Database& _database;
+    lk::PersistentBlockchain _blockchain;
+    lk::StateManager _state_manager;
+    std::size_t _replayed_blocks_count{ 0 };
+
+    base::Sha256 applyBlock(const lk::ImmutableBlock& block)
+    {
+        _state_manager.applyBlockEmission(block.getCoinbase(), base::config::BC_EMISSION_VALUE);
+        auto commit = _state_manager.createCommit();
+        for (const auto& tx : block.getTransactions()) {
+            commit.addTxHash(tx.getFrom(), tx.hashOfTransaction());
+        }
+        _state_manager.applyCommit(std::move(commit));
+        return _state_manager.updateStateRoot();
+    }
+};
+
+} // namespace
+
+
+BOOST_AUTO_TEST_CASE(checkpoint_recovers_state_after_crash)
+{
+    const auto& chain = getChain();
+    auto reference_database = base::Database(std::make_shared<base::MemoryStore>());
+    Node reference{ reference_database };
+    for (lk::BlockDepth depth = 1; depth <= CHAIN_HEIGHT; ++depth) {
+        reference.addBlock(chain[depth]);
+    }
+
+    // a block is stored with a single write, and a checkpoint after it with one more write
+    const std::size_t writes_count = CHAIN_HEIGHT + CHAIN_HEIGHT / CHECKPOINT_PERIOD;
+    const std::vector<std::size_t> crash_points{ 0, 1, 49, 50, 51, 52, 177, 203, 254, writes_count - 1 };
+    for (auto writes_before_crash : crash_points) {
+        BOOST_TEST_CONTEXT("writes before crash: " << writes_before_crash)
+        {
+            auto store = std::make_shared<base::MemoryStore>();
+            {
+                auto database = base::Database(std::make_shared<CrashingStore>(store, writes_before_crash));
+                Node node{ database };
+                bool is_crashed = false;
+                try {
+                    for (lk::BlockDepth depth = 1; depth <= CHAIN_HEIGHT; ++depth) {
+                        node.addBlock(chain[depth]);
+                    }
+                }
+                catch (const Crash&) {
+                    is_crashed = true;
+                }
+                BOOST_REQUIRE(is_crashed);
+            }
+
+            auto database = base::Database(store);
+            Node node{ database };
+            BOOST_CHECK(node.getReplayedBlocksCount() <= CHECKPOINT_PERIOD);
+            for (auto depth = node.getTopDepth() + 1; depth <= CHAIN_HEIGHT; ++depth) {
+                node.addBlock(chain[depth]);
+            }
+
+            BOOST_CHECK(node.getStateManager().getStateRoot() == reference.getStateManager().getStateRoot());
+            for (std::size_t i = 0; i < MINERS_COUNT; ++i) {
+                const auto miner = makeAddress(i);
+                BOOST_CHECK(node.getStateManager().getTransactionsHashes(miner, 0, CHAIN_HEIGHT) ==
+                            reference.getStateManager().getTransactionsHashes(miner, 0, CHAIN_HEIGHT));
+            }
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(checkpoint_of_other_chain_is_ignored)
+{
+    auto database = base::Database(std::make_shared<base::MemoryStore>());
+    lk::StateManager state_manager{ database };
+    state_manager.updateFromGenesis(getGenesis());
+    const auto state_root = state_manager.updateStateRoot();
+    lk::writeCheckpoint(
+      database,
+      state_manager,
+      lk::Checkpoint{ 0, base::Sha256::compute(base::Bytes("other")), state_root, state_manager.exportState() });
+    BOOST_REQUIRE(lk::readCheckpoint(database));
+
+    lk::PersistentBlockchain blockchain{ getGenesis(), database, base::PropertyTree{} };
+    blockchain.load();
+    lk::StateManager restored_state_manager{ database };
+    BOOST_CHECK(!lk::restoreCheckpoint(database, blockchain, restored_state_manager));
+    BOOST_CHECK(!restored_state_manager.hasAccount(makeAddress(0)));
+}
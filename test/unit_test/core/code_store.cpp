@@ -0,0 +1,64 @@
+#include <boost/test/unit_test.hpp>
+
+#include "core/managers.hpp"
+
+namespace
+{
+
+lk::Address makeAddress(std::size_t seed)
+{
+    return lk::Address(base::Ripemd160::compute(base::Bytes(std::to_string(seed))).getBytes());
+}
+
+} // namespace
+
+
+BOOST_AUTO_TEST_CASE(code_store_shares_equal_code)
+{
+    lk::CodeStore store(100);
+    auto first = store.add(base::Bytes("code"));
+    BOOST_CHECK(first->getBytes() == base::Bytes("code"));
+    BOOST_CHECK(first->getHash() == base::Sha256::compute(base::Bytes("code")));
+    BOOST_CHECK_EQUAL(first->size(), 4);
+
+    BOOST_CHECK(store.add(base::Bytes("code")) == first);
+    BOOST_CHECK(store.add(base::Bytes("other code")) != first);
+    BOOST_CHECK(store.add(base::Bytes{}) == lk::ContractCode::empty());
+    BOOST_CHECK(lk::ContractCode::empty()->isEmpty());
+
+    // the evicted code is still valid, but no longer shared
+    lk::CodeStore small_store(5);
+    auto code = small_store.add(base::Bytes("code"));
+    small_store.add(base::Bytes("next"));
+    BOOST_CHECK(small_store.add(base::Bytes("code")) != code);
+    BOOST_CHECK(code->getBytes() == base::Bytes("code"));
+}
+
+
+BOOST_AUTO_TEST_CASE(code_store_shares_code_of_contracts)
+{
+    lk::StateManager state_manager;
+    auto client = makeAddress(1);
+    state_manager.applyBlockEmission(client, 1000);
+
+    auto commit = state_manager.createCommit();
+    auto contract = commit.createContractAccount(client, base::Sha256::compute(base::Bytes("code")));
+    BOOST_CHECK(commit.getRuntimeCode(contract)->isEmpty());
+    commit.setRuntimeCode(contract, base::Bytes("runtime"));
+    commit.addTxHash(client, base::Sha256::compute(base::Bytes("tx")));
+    auto twin = commit.createContractAccount(client, base::Sha256::compute(base::Bytes("code")));
+    commit.setRuntimeCode(twin, base::Bytes("runtime"));
+    state_manager.applyCommit(std::move(commit));
+
+    auto check = state_manager.createCommit();
+    auto code = check.getRuntimeCode(contract);
+    BOOST_CHECK(code->getBytes() == base::Bytes("runtime"));
+    BOOST_CHECK(check.getRuntimeCode(twin) == code);
+    BOOST_CHECK_EQUAL(check.getCodeSize(contract), 7);
+
+    // the code outlives the contract
+    BOOST_CHECK(check.deleteAccount(contract, client));
+    BOOST_CHECK(check.deleteAccount(twin, client));
+    state_manager.applyCommit(std::move(check));
+    BOOST_CHECK(code->getBytes() == base::Bytes("runtime"));
+}
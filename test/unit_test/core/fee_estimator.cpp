@@ -0,0 +1,53 @@
+#include <boost/test/unit_test.hpp>
+
+#include "core/fee_estimator.hpp"
+
+#include "base/error.hpp"
+
+#include <atomic>
+#include <stdexcept>
+
+BOOST_AUTO_TEST_CASE(fee_estimator_finds_least_enough_fee)
+{
+    for (std::size_t threads_count : { 1, 2, 4 }) {
+        lk::FeeEstimator estimator(threads_count);
+        for (lk::Fee least_fee : { 0, 1, 20'999, 21'000, 21'001, 54'321, 99'999, 100'000 }) {
+            std::atomic<std::size_t> runs_count{ 0 };
+            auto fee = estimator.findLeastFee(0, 100'000, [&](lk::Fee fee) {
+                ++runs_count;
+                return fee >= least_fee;
+            });
+            BOOST_CHECK_EQUAL(fee, least_fee);
+            // a binary search would take 17 runs
+            BOOST_CHECK_LE(runs_count, 17 * threads_count + threads_count);
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(fee_estimator_searches_only_between_bounds)
+{
+    lk::FeeEstimator estimator(3);
+    auto not_run = [](lk::Fee) -> bool { throw std::logic_error("not run"); };
+    BOOST_CHECK_EQUAL(estimator.findLeastFee(500, 500, not_run), 500);
+
+    // runs below the low bound would be enough, but they aren't made
+    std::atomic<bool> is_out_of_bounds{ false };
+    auto fee = estimator.findLeastFee(500, 1000, [&](lk::Fee fee) {
+        if (fee < 500 || fee >= 1000) {
+            is_out_of_bounds = true;
+        }
+        return true;
+    });
+    BOOST_CHECK_EQUAL(fee, 500);
+    BOOST_CHECK(!is_out_of_bounds);
+
+    // a failed run is a not enough fee
+    fee = estimator.findLeastFee(0, 1000, [](lk::Fee fee) {
+        if (fee < 700) {
+            throw std::runtime_error("out of gas");
+        }
+        return true;
+    });
+    BOOST_CHECK_EQUAL(fee, 700);
+}
@@ -0,0 +1,189 @@
+#include <boost/test/unit_test.hpp>
+
+#include "core/logs.hpp"
+#include "core/managers.hpp"
+
+namespace
+{
+
+const std::filesystem::path DATABASE_PATH{ "local_test_base" };
+
+
+lk::Address makeAddress(std::size_t seed)
+{
+    return lk::Address(base::Ripemd160::compute(base::Bytes(std::to_string(seed))).getBytes());
+}
+
+
+lk::LogTopic makeTopic(std::size_t seed)
+{
+    return base::Sha256::compute(base::Bytes(std::to_string(seed))).getBytes();
+}
+
+
+lk::Log makeLog(std::size_t address_seed, std::vector<lk::LogTopic> topics)
+{
+    return lk::Log{ makeAddress(address_seed), std::move(topics), base::Bytes("data") };
+}
+
+
+std::vector<lk::LogRecord> makeRecords(lk::BlockDepth depth, std::vector<lk::Log> logs)
+{
+    std::vector<lk::LogRecord> records;
+    for (std::uint32_t i = 0; i < logs.size(); ++i) {
+        records.push_back({ depth, base::Sha256::compute(base::Bytes(std::to_string(depth))), i, std::move(logs[i]) });
+    }
+    return records;
+}
+
+
+std::vector<lk::BlockDepth> getDepths(const std::vector<lk::LogRecord>& records)
+{
+    std::vector<lk::BlockDepth> depths;
+    for (const auto& record : records) {
+        depths.push_back(record.depth);
+    }
+    return depths;
+}
+
+} // namespace
+
+
+BOOST_AUTO_TEST_CASE(logs_bloom_add_merge)
+{
+    lk::LogsBloom bloom;
+    BOOST_CHECK(bloom.isEmpty());
+    bloom.add(makeLog(1, { makeTopic(1), makeTopic(2) }));
+    BOOST_CHECK(!bloom.isEmpty());
+    BOOST_CHECK(bloom.mightContain(makeAddress(1).getBytes().toBytes()));
+    BOOST_CHECK(bloom.mightContain(makeTopic(2).toBytes()));
+    BOOST_CHECK(!bloom.mightContain(makeAddress(2).getBytes().toBytes()));
+
+    lk::LogsBloom other;
+    other.add(makeAddress(2).getBytes().toBytes());
+    bloom.merge(other);
+    BOOST_CHECK(bloom.mightContain(makeAddress(1).getBytes().toBytes()));
+    BOOST_CHECK(bloom.mightContain(makeAddress(2).getBytes().toBytes()));
+
+    lk::LogsBloom copy{ bloom.getBits() };
+    BOOST_CHECK(copy.mightContain(makeTopic(1).toBytes()));
+}
+
+
+BOOST_AUTO_TEST_CASE(logs_filter_matches_by_positions)
+{
+    auto log = makeLog(1, { makeTopic(1), makeTopic(2) });
+    lk::LogsBloom bloom;
+    bloom.add(log);
+
+    lk::LogsFilter any;
+    BOOST_CHECK(any.matches(log));
+    BOOST_CHECK(any.mightMatch(bloom));
+    BOOST_CHECK(!any.mightMatch(lk::LogsBloom{}));
+
+    lk::LogsFilter by_address{ { makeAddress(2), makeAddress(1) }, {} };
+    BOOST_CHECK(by_address.matches(log));
+    BOOST_CHECK(by_address.mightMatch(bloom));
+
+    lk::LogsFilter by_second_topic{ {}, { {}, { makeTopic(3), makeTopic(2) } } };
+    BOOST_CHECK(by_second_topic.matches(log));
+    BOOST_CHECK(by_second_topic.mightMatch(bloom));
+
+    lk::LogsFilter by_wrong_position{ {}, { { makeTopic(2) } } };
+    BOOST_CHECK(!by_wrong_position.matches(log));
+
+    lk::LogsFilter by_other_address{ { makeAddress(2) }, {} };
+    BOOST_CHECK(!by_other_address.matches(log));
+    BOOST_CHECK(!by_other_address.mightMatch(bloom));
+
+    lk::LogsFilter by_more_topics{ {}, { {}, {}, {} } };
+    BOOST_CHECK(!by_more_topics.matches(log));
+}
+
+
+BOOST_AUTO_TEST_CASE(logs_index_find_in_range)
+{
+    lk::LogsIndex index;
+    const auto section_size = base::config::BC_LOGS_SECTION_SIZE;
+    index.addBlockLogs(1, makeRecords(1, { makeLog(1, { makeTopic(1) }), makeLog(2, { makeTopic(1) }) }));
+    index.addBlockLogs(5, makeRecords(5, { makeLog(1, { makeTopic(2) }) }));
+    index.addBlockLogs(section_size + 3, makeRecords(section_size + 3, { makeLog(1, { makeTopic(1) }) }));
+    index.addBlockLogs(7, {});
+
+    lk::LogsFilter by_address{ { makeAddress(1) }, {} };
+    auto found = index.find(0, 2 * section_size, by_address, 100);
+    BOOST_CHECK(getDepths(found) == std::vector<lk::BlockDepth>({ 1, 5, section_size + 3 }));
+    BOOST_CHECK(found[0].index == 0);
+    BOOST_CHECK(found[0].log == makeLog(1, { makeTopic(1) }));
+
+    BOOST_CHECK(getDepths(index.find(2, section_size, by_address, 100)) == std::vector<lk::BlockDepth>({ 5 }));
+    BOOST_CHECK(getDepths(index.find(0, 2 * section_size, by_address, 2)) == std::vector<lk::BlockDepth>({ 1, 5 }));
+
+    lk::LogsFilter by_topic{ {}, { { makeTopic(1) } } };
+    found = index.find(0, 10, by_topic, 100);
+    BOOST_REQUIRE(found.size() == 2);
+    BOOST_CHECK(found[0].index == 0 && found[1].index == 1);
+    BOOST_CHECK(found[1].log.address == makeAddress(2));
+
+    BOOST_CHECK(index.find(0, 2 * section_size, { { makeAddress(3) }, {} }, 100).empty());
+    BOOST_CHECK(index.find(6, 10, {}, 100).empty());
+}
+
+
+BOOST_AUTO_TEST_CASE(logs_index_merges_flushed_and_unflushed)
+{
+    auto database = base::createClearDatabaseInstance(DATABASE_PATH);
+    const auto section_size = base::config::BC_LOGS_SECTION_SIZE;
+    {
+        lk::LogsIndex index{ database };
+        index.addBlockLogs(2, makeRecords(2, { makeLog(1, { makeTopic(1) }) }));
+        index.addBlockLogs(section_size, makeRecords(section_size, { makeLog(2, { makeTopic(1) }) }));
+        base::Database::Batch batch;
+        index.flush(batch);
+        database.write(std::move(batch));
+
+        index.addBlockLogs(3, makeRecords(3, { makeLog(1, { makeTopic(2) }) }));
+        // the unflushed logs are found together with the stored ones
+        BOOST_CHECK(getDepths(index.find(0, 10, {}, 100)) == std::vector<lk::BlockDepth>({ 2, 3 }));
+
+        base::Database::Batch next_batch;
+        index.flush(next_batch);
+        database.write(std::move(next_batch));
+    }
+
+    lk::LogsIndex index{ database };
+    lk::LogsFilter by_address{ { makeAddress(1) }, {} };
+    BOOST_CHECK(getDepths(index.find(0, 2 * section_size, by_address, 100)) == std::vector<lk::BlockDepth>({ 2, 3 }));
+    lk::LogsFilter by_topic{ {}, { { makeTopic(1) } } };
+    BOOST_CHECK(getDepths(index.find(0, 2 * section_size, by_topic, 100)) ==
+                std::vector<lk::BlockDepth>({ 2, section_size }));
+    BOOST_CHECK(getDepths(index.find(3, section_size - 1, by_topic, 100)).empty());
+
+    std::filesystem::remove_all(DATABASE_PATH);
+}
+
+
+BOOST_AUTO_TEST_CASE(logs_reverted_with_savepoint)
+{
+    lk::StateManager state_manager;
+    auto commit = state_manager.createCommit();
+    commit.addLog(makeLog(1, { makeTopic(1) }));
+    auto savepoint = commit.createSavepoint();
+    commit.addLog(makeLog(2, {}));
+    commit.revertToSavepoint(savepoint);
+
+    auto nested = commit.createSavepoint();
+    commit.addLog(makeLog(3, {}));
+    commit.releaseSavepoint(nested);
+
+    auto child = commit.createCommit();
+    child.addLog(makeLog(4, {}));
+    commit.applyCommit(std::move(child));
+
+    auto logs = commit.takeLogs();
+    BOOST_REQUIRE(logs.size() == 3);
+    BOOST_CHECK(logs[0].address == makeAddress(1));
+    BOOST_CHECK(logs[1].address == makeAddress(3));
+    BOOST_CHECK(logs[2].address == makeAddress(4));
+    BOOST_CHECK(commit.takeLogs().empty());
+}
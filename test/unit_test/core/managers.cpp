@@ -0,0 +1,507 @@
+#include <boost/test/unit_test.hpp>
+
+#include "core/managers.hpp"
+
+namespace
+{
+
+lk::Address makeAddress(std::size_t seed)
+{
+    return lk::Address(base::Ripemd160::compute(base::Bytes(std::to_string(seed))).getBytes());
+}
+
+
+lk::StorageKey makeKey(std::size_t seed)
+{
+    return base::Sha256::compute(base::Bytes(std::to_string(seed))).getBytes();
+}
+
+
+lk::StorageValue makeValue(const std::string& value)
+{
+    lk::StorageValue word;
+    std::copy(value.begin(), value.end(), word.getData());
+    return word;
+}
+
+
+void fundAccount(lk::StateManager& state_manager, const lk::Address& address, const lk::Balance& amount)
+{
+    lk::TransactionsSet txs;
+    txs.add({ lk::Address::null(), address, amount, 0, base::Time(), base::Bytes{} });
+
+    lk::BlockBuilder b;
+    b.setDepth(0);
+    b.setNonce(0);
+    b.setPrevBlockHash(base::Sha256::null());
+    b.setStateRoot(base::Sha256::null());
+    b.setTimestamp(base::Time());
+    b.setCoinbase(address);
+    b.setTransactionsSet(std::move(txs));
+    state_manager.updateFromGenesis(std::move(b).buildImmutable());
+}
+
+} // namespace
+
+
+BOOST_AUTO_TEST_CASE(commit_reads_through_to_state_manager)
+{
+    lk::StateManager state_manager;
+    auto client = makeAddress(1);
+    fundAccount(state_manager, client, 1000);
+
+    auto commit = state_manager.createCommit();
+    BOOST_CHECK(commit.hasAccount(client));
+    BOOST_CHECK(commit.getAccountType(client) == lk::AccountType::CLIENT);
+    BOOST_CHECK_EQUAL(commit.getBalance(client), 1000);
+    BOOST_CHECK(!commit.hasAccount(makeAddress(2)));
+}
+
+
+BOOST_AUTO_TEST_CASE(commit_changes_are_invisible_until_applied)
+{
+    lk::StateManager state_manager;
+    auto from = makeAddress(1);
+    auto to = makeAddress(2);
+    fundAccount(state_manager, from, 1000);
+
+    auto commit = state_manager.createCommit();
+    BOOST_CHECK(commit.tryTransferMoney(from, to, 300));
+    BOOST_CHECK(!commit.tryTransferMoney(from, to, 701));
+    BOOST_CHECK_EQUAL(commit.getBalance(from), 700);
+    BOOST_CHECK_EQUAL(commit.getBalance(to), 300);
+    BOOST_CHECK_EQUAL(state_manager.getBalance(from), 1000);
+    BOOST_CHECK(!state_manager.hasAccount(to));
+
+    state_manager.applyCommit(std::move(commit));
+    BOOST_CHECK_EQUAL(state_manager.getBalance(from), 700);
+    BOOST_CHECK_EQUAL(state_manager.getBalance(to), 300);
+}
+
+
+BOOST_AUTO_TEST_CASE(commit_merges_only_changed_storage_slots)
+{
+    lk::StateManager state_manager;
+    auto client = makeAddress(1);
+    fundAccount(state_manager, client, 1000);
+
+    auto first = state_manager.createCommit();
+    auto contract = first.createContractAccount(client, base::Sha256::compute(base::Bytes("code")));
+    first.setRuntimeCode(contract, base::Bytes("runtime"));
+    for (std::size_t i = 0; i < 10; ++i) {
+        first.setStorageValue(contract, makeKey(i), makeValue(std::to_string(i)));
+    }
+    state_manager.applyCommit(std::move(first));
+
+    auto second = state_manager.createCommit();
+    BOOST_CHECK(second.getRuntimeCode(contract)->getBytes() == base::Bytes("runtime"));
+    BOOST_CHECK(second.getStorageValue(contract, makeKey(3)).data == makeValue("3"));
+    second.setStorageValue(contract, makeKey(3), makeValue("changed"));
+    second.setStorageValue(contract, makeKey(100), makeValue("new"));
+    BOOST_CHECK(second.getStorageValue(contract, makeKey(3)).data == makeValue("changed"));
+    BOOST_CHECK(second.checkStorageValue(contract, makeKey(100)));
+    BOOST_CHECK(!second.checkStorageValue(contract, makeKey(101)));
+    state_manager.applyCommit(std::move(second));
+
+    auto third = state_manager.createCommit();
+    BOOST_CHECK(third.getStorageValue(contract, makeKey(3)).data == makeValue("changed"));
+    BOOST_CHECK(third.getStorageValue(contract, makeKey(4)).data == makeValue("4"));
+    BOOST_CHECK(third.getStorageValue(contract, makeKey(100)).data == makeValue("new"));
+    BOOST_CHECK(third.getRuntimeCode(contract)->getBytes() == base::Bytes("runtime"));
+}
+
+
+BOOST_AUTO_TEST_CASE(contract_storage_reads_and_writes_through_commit)
+{
+    lk::StateManager state_manager;
+    auto client = makeAddress(1);
+    fundAccount(state_manager, client, 1000);
+
+    auto first = state_manager.createCommit();
+    auto contract = first.createContractAccount(client, base::Sha256::compute(base::Bytes("code")));
+    first.setStorageValue(contract, makeKey(1), makeValue("1"));
+    state_manager.applyCommit(std::move(first));
+
+    auto commit = state_manager.createCommit();
+    BOOST_CHECK_THROW(lk::ContractStorage(commit, client), base::LogicError);
+    BOOST_CHECK_THROW(lk::ContractStorage(commit, makeAddress(2)), base::LogicError);
+
+    lk::ContractStorage storage(commit, contract);
+    BOOST_CHECK(*storage.find(makeKey(1)) == makeValue("1"));
+    BOOST_CHECK(storage.find(makeKey(2)) == nullptr);
+
+    // a zero word isn't written to an empty slot
+    BOOST_CHECK(!storage.set(makeKey(2), lk::StorageValue{}));
+    BOOST_CHECK(storage.find(makeKey(2)) == nullptr);
+    BOOST_CHECK(!commit.checkStorageValue(contract, makeKey(2)));
+
+    BOOST_CHECK(!storage.set(makeKey(2), makeValue("2")));
+    BOOST_CHECK(*storage.set(makeKey(1), makeValue("changed")) == makeValue("1"));
+    BOOST_CHECK(*storage.set(makeKey(1), makeValue("again")) == makeValue("changed"));
+    BOOST_CHECK(*storage.find(makeKey(1)) == makeValue("again"));
+    BOOST_CHECK(commit.getStorageValue(contract, makeKey(1)).data == makeValue("again"));
+    BOOST_CHECK(commit.getStorageValue(contract, makeKey(2)).data == makeValue("2"));
+
+    // changes made past the cache are seen only after the reset
+    BOOST_CHECK(storage.find(makeKey(3)) == nullptr);
+    commit.setStorageValue(contract, makeKey(3), makeValue("3"));
+    BOOST_CHECK(storage.find(makeKey(3)) == nullptr);
+    storage.reset();
+    BOOST_CHECK(*storage.find(makeKey(3)) == makeValue("3"));
+
+    state_manager.applyCommit(std::move(commit));
+    auto check = state_manager.createCommit();
+    BOOST_CHECK(check.getStorageValue(contract, makeKey(1)).data == makeValue("again"));
+    BOOST_CHECK(check.getStorageValue(contract, makeKey(2)).data == makeValue("2"));
+    BOOST_CHECK(check.getStorageValue(contract, makeKey(3)).data == makeValue("3"));
+}
+
+
+BOOST_AUTO_TEST_CASE(commit_delete_account)
+{
+    lk::StateManager state_manager;
+    auto client = makeAddress(1);
+    auto beneficiary = makeAddress(2);
+    fundAccount(state_manager, client, 1000);
+
+    auto commit = state_manager.createCommit();
+    BOOST_CHECK(commit.deleteAccount(client, beneficiary));
+    BOOST_CHECK(!commit.hasAccount(client));
+    BOOST_CHECK_EQUAL(commit.getBalance(beneficiary), 1000);
+    state_manager.applyCommit(std::move(commit));
+
+    BOOST_CHECK(!state_manager.hasAccount(client));
+    BOOST_CHECK_EQUAL(state_manager.getBalance(beneficiary), 1000);
+}
+
+
+BOOST_AUTO_TEST_CASE(commit_child_is_applied_to_parent_only)
+{
+    lk::StateManager state_manager;
+    auto from = makeAddress(1);
+    auto to = makeAddress(2);
+    fundAccount(state_manager, from, 1000);
+
+    auto commit = state_manager.createCommit();
+    commit.addTxHash(from, makeKey(1));
+    {
+        auto dropped = commit.createCommit();
+        BOOST_CHECK(dropped.tryTransferMoney(from, to, 100));
+        BOOST_CHECK_EQUAL(dropped.getBalance(to), 100);
+    }
+    BOOST_CHECK(!commit.hasAccount(to));
+
+    auto child = commit.createCommit();
+    BOOST_CHECK(child.tryTransferMoney(from, to, 300));
+    commit.applyCommit(std::move(child));
+    BOOST_CHECK_EQUAL(commit.getBalance(to), 300);
+    BOOST_CHECK(!state_manager.hasAccount(to));
+
+    state_manager.applyCommit(std::move(commit));
+    BOOST_CHECK_EQUAL(state_manager.getBalance(from), 700);
+    BOOST_CHECK_EQUAL(state_manager.getBalance(to), 300);
+    auto info = state_manager.getAccountInfo(from);
+    BOOST_CHECK_EQUAL(info.nonce, 1);
+    BOOST_CHECK_EQUAL(info.transactions_count, 1);
+    BOOST_CHECK(state_manager.getTransactionsHashes(from, 0, 10) == std::vector<base::Sha256>{ makeKey(1) });
+}
+
+
+BOOST_AUTO_TEST_CASE(commit_reverts_to_savepoint)
+{
+    lk::StateManager state_manager;
+    auto client = makeAddress(1);
+    auto receiver = makeAddress(2);
+    auto coinbase = makeAddress(3);
+    fundAccount(state_manager, client, 1000);
+    auto client_info = state_manager.getAccountInfo(client);
+
+    auto commit = state_manager.createCommit();
+    auto contract = commit.createContractAccount(client, base::Sha256::compute(base::Bytes("code")));
+    commit.setStorageValue(contract, makeKey(1), makeValue("1"));
+
+    auto savepoint = commit.createSavepoint();
+    commit.addTxHash(client, makeKey(10));
+    BOOST_CHECK(commit.tryTransferMoney(client, receiver, 100));
+    BOOST_CHECK(commit.payFee(client, coinbase, 10));
+    commit.setStorageValue(contract, makeKey(1), makeValue("changed"));
+    commit.setStorageValue(contract, makeKey(2), makeValue("2"));
+    commit.setRuntimeCode(contract, base::Bytes("runtime"));
+    {
+        lk::ContractStorage storage(commit, contract);
+        storage.set(makeKey(1), makeValue("again"));
+        storage.set(makeKey(3), makeValue("3"));
+    }
+    auto created = commit.createContractAccount(client, base::Sha256::compute(base::Bytes("other code")));
+    BOOST_CHECK(commit.deleteAccount(contract, client));
+    BOOST_CHECK(!commit.hasAccount(contract));
+
+    commit.revertToSavepoint(savepoint);
+    BOOST_CHECK(commit.hasAccount(contract));
+    BOOST_CHECK(!commit.hasAccount(created));
+    BOOST_CHECK(!commit.hasAccount(receiver));
+    BOOST_CHECK(!commit.hasAccount(coinbase));
+    BOOST_CHECK_EQUAL(commit.getBalance(client), 1000);
+    BOOST_CHECK(commit.getRuntimeCode(contract)->isEmpty());
+    BOOST_CHECK(commit.getStorageValue(contract, makeKey(1)).data == makeValue("1"));
+    BOOST_CHECK(!commit.checkStorageValue(contract, makeKey(2)));
+    BOOST_CHECK(!commit.checkStorageValue(contract, makeKey(3)));
+
+    state_manager.applyCommit(std::move(commit));
+    BOOST_CHECK_EQUAL(state_manager.getAccountInfo(client).nonce, client_info.nonce);
+    BOOST_CHECK_EQUAL(state_manager.getAccountInfo(client).transactions_count, client_info.transactions_count);
+    BOOST_CHECK_EQUAL(state_manager.getBalance(client), 1000);
+    BOOST_CHECK(!state_manager.hasAccount(coinbase));
+}
+
+
+BOOST_AUTO_TEST_CASE(commit_nested_savepoints)
+{
+    lk::StateManager state_manager;
+    auto client = makeAddress(1);
+    fundAccount(state_manager, client, 1000);
+
+    auto commit = state_manager.createCommit();
+    auto contract = commit.createContractAccount(client, base::Sha256::compute(base::Bytes("code")));
+
+    // a call, which makes two nested calls: the first one fails, the second one succeeds
+    auto outer = commit.createSavepoint();
+    commit.setStorageValue(contract, makeKey(1), makeValue("outer"));
+    auto failed = commit.createSavepoint();
+    commit.setStorageValue(contract, makeKey(1), makeValue("failed"));
+    BOOST_CHECK(commit.tryTransferMoney(client, makeAddress(2), 1));
+    commit.revertToSavepoint(failed);
+    auto succeeded = commit.createSavepoint();
+    commit.setStorageValue(contract, makeKey(2), makeValue("succeeded"));
+    commit.releaseSavepoint(succeeded);
+
+    BOOST_CHECK(commit.getStorageValue(contract, makeKey(1)).data == makeValue("outer"));
+    BOOST_CHECK(commit.getStorageValue(contract, makeKey(2)).data == makeValue("succeeded"));
+    BOOST_CHECK(!commit.hasAccount(makeAddress(2)));
+
+    // the outer call fails after all, together with the nested one, which has succeeded
+    commit.revertToSavepoint(outer);
+    BOOST_CHECK(!commit.checkStorageValue(contract, makeKey(1)));
+    BOOST_CHECK(!commit.checkStorageValue(contract, makeKey(2)));
+
+    // without savepoints nothing is journaled, and released changes stay
+    auto last = commit.createSavepoint();
+    commit.setStorageValue(contract, makeKey(3), makeValue("3"));
+    commit.releaseSavepoint(last);
+    BOOST_CHECK(commit.getStorageValue(contract, makeKey(3)).data == makeValue("3"));
+    state_manager.applyCommit(std::move(commit));
+    BOOST_CHECK_EQUAL(state_manager.getBalance(client), 1000);
+}
+
+
+BOOST_AUTO_TEST_CASE(commit_pays_fee_without_reading_receiver)
+{
+    lk::StateManager state_manager;
+    auto from = makeAddress(1);
+    auto coinbase = makeAddress(2);
+    fundAccount(state_manager, from, 1000);
+    state_manager.applyBlockEmission(coinbase, 50);
+
+    auto commit = state_manager.createCommit();
+    BOOST_CHECK(commit.payFee(from, coinbase, 10));
+    BOOST_CHECK(!commit.payFee(from, coinbase, 1000));
+
+    lk::AccessSet coinbase_account;
+    coinbase_account.addAccount(coinbase);
+    BOOST_CHECK(!commit.hasReadAnyOf(coinbase_account));
+    BOOST_CHECK(commit.getWriteSet().intersects(coinbase_account));
+
+    BOOST_CHECK_EQUAL(commit.getBalance(coinbase), 60);
+    BOOST_CHECK(commit.hasReadAnyOf(coinbase_account));
+
+    state_manager.applyCommit(std::move(commit));
+    BOOST_CHECK_EQUAL(state_manager.getBalance(from), 990);
+    BOOST_CHECK_EQUAL(state_manager.getBalance(coinbase), 60);
+}
+
+
+BOOST_AUTO_TEST_CASE(state_root_tracks_applied_changes)
+{
+    lk::StateManager state_manager;
+    auto client = makeAddress(1);
+    auto beneficiary = makeAddress(2);
+    BOOST_CHECK(state_manager.updateStateRoot() == lk::MerkleTrie::emptyRoot());
+
+    fundAccount(state_manager, client, 1000);
+    auto funded_root = state_manager.updateStateRoot();
+    BOOST_CHECK(funded_root != lk::MerkleTrie::emptyRoot());
+    BOOST_CHECK(state_manager.getStateRoot() == funded_root);
+
+    auto commit = state_manager.createCommit();
+    auto contract = commit.createContractAccount(client, base::Sha256::compute(base::Bytes("code")));
+    commit.setStorageValue(contract, makeKey(1), makeValue("1"));
+    // not applied commits don't affect the root
+    BOOST_CHECK(state_manager.updateStateRoot() == funded_root);
+    state_manager.applyCommit(std::move(commit));
+    auto contract_root = state_manager.updateStateRoot();
+    BOOST_CHECK(contract_root != funded_root);
+
+    auto change = state_manager.createCommit();
+    change.setStorageValue(contract, makeKey(1), makeValue("2"));
+    state_manager.applyCommit(std::move(change));
+    auto changed_root = state_manager.updateStateRoot();
+    BOOST_CHECK(changed_root != contract_root);
+
+    auto revert = state_manager.createCommit();
+    revert.setStorageValue(contract, makeKey(1), makeValue("1"));
+    state_manager.applyCommit(std::move(revert));
+    BOOST_CHECK(state_manager.updateStateRoot() == contract_root);
+
+    auto removal = state_manager.createCommit();
+    BOOST_CHECK(removal.deleteAccount(contract, beneficiary));
+    state_manager.applyCommit(std::move(removal));
+    BOOST_CHECK(state_manager.updateStateRoot() != contract_root);
+}
+
+
+BOOST_AUTO_TEST_CASE(state_root_is_the_same_for_equal_states)
+{
+    lk::StateManager first;
+    lk::StateManager second;
+    auto client = makeAddress(1);
+    fundAccount(first, client, 1000);
+    fundAccount(second, client, 1000);
+
+    for (std::size_t i = 2; i < 10; ++i) {
+        first.applyBlockEmission(makeAddress(i), i);
+        first.updateStateRoot();
+    }
+    for (std::size_t i = 9; i >= 2; --i) {
+        second.applyBlockEmission(makeAddress(i), i);
+    }
+    BOOST_CHECK(first.updateStateRoot() == second.updateStateRoot());
+}
+
+
+BOOST_AUTO_TEST_CASE(transactions_history_is_limited)
+{
+    lk::StateManager limited;
+    lk::StateManager full;
+    auto client = makeAddress(1);
+    fundAccount(limited, client, 1000);
+    fundAccount(full, client, 1000);
+
+    limited.setTransactionsHistoryLimit(3);
+    for (auto* state_manager : { &limited, &full }) {
+        for (std::size_t i = 0; i < 5; ++i) {
+            auto commit = state_manager->createCommit();
+            commit.addTxHash(client, makeKey(i));
+            state_manager->applyCommit(std::move(commit));
+        }
+    }
+
+    // the oldest hashes are dropped, while the state root doesn't depend on them
+    const std::vector<base::Sha256> expected{ makeKey(2), makeKey(3), makeKey(4) };
+    BOOST_CHECK(limited.getTransactionsHashes(client, 0, 10) == expected);
+    BOOST_CHECK_EQUAL(full.getTransactionsHashes(client, 0, 10).size(), 5);
+    BOOST_CHECK_EQUAL(limited.getAccountInfo(client).transactions_count, 5);
+    BOOST_CHECK_EQUAL(limited.getAccountInfo(client).nonce, 5);
+    BOOST_CHECK(limited.updateStateRoot() == full.updateStateRoot());
+}
+
+
+BOOST_AUTO_TEST_CASE(state_view_keeps_state_of_its_time)
+{
+    lk::StateManager state_manager;
+    auto client = makeAddress(1);
+    auto receiver = makeAddress(2);
+    fundAccount(state_manager, client, 1000);
+
+    auto first = state_manager.createCommit();
+    auto contract = first.createContractAccount(client, base::Sha256::compute(base::Bytes("code")));
+    first.setRuntimeCode(contract, base::Bytes("runtime"));
+    first.setStorageValue(contract, makeKey(1), makeValue("1"));
+    first.setStorageValue(contract, makeKey(2), makeValue("2"));
+    state_manager.applyCommit(std::move(first));
+
+    auto view = state_manager.createView();
+    auto second = state_manager.createCommit();
+    BOOST_CHECK(second.tryTransferMoney(client, receiver, 300));
+    second.setStorageValue(contract, makeKey(1), makeValue("changed"));
+    second.setStorageValue(contract, makeKey(3), makeValue("new"));
+    state_manager.applyCommit(std::move(second));
+    state_manager.applyBlockEmission(client, 50);
+
+    auto commit = view.createCommit();
+    BOOST_CHECK_EQUAL(commit.getBalance(client), 1000);
+    BOOST_CHECK(!commit.hasAccount(receiver));
+    BOOST_CHECK(commit.getRuntimeCode(contract)->getBytes() == base::Bytes("runtime"));
+    BOOST_CHECK(commit.getStorageValue(contract, makeKey(1)).data == makeValue("1"));
+    BOOST_CHECK(commit.getStorageValue(contract, makeKey(2)).data == makeValue("2"));
+    BOOST_CHECK(!commit.checkStorageValue(contract, makeKey(3)));
+
+    // the commit over the view changes nothing else
+    BOOST_CHECK(commit.tryTransferMoney(client, receiver, 1000));
+    commit.setStorageValue(contract, makeKey(2), makeValue("dropped"));
+    BOOST_CHECK_EQUAL(commit.getBalance(receiver), 1000);
+    BOOST_CHECK_EQUAL(state_manager.getBalance(client), 750);
+    BOOST_CHECK_EQUAL(state_manager.getBalance(receiver), 300);
+
+    auto current = state_manager.createCommit();
+    BOOST_CHECK(current.getStorageValue(contract, makeKey(1)).data == makeValue("changed"));
+    BOOST_CHECK(current.getStorageValue(contract, makeKey(2)).data == makeValue("2"));
+    BOOST_CHECK(current.getStorageValue(contract, makeKey(3)).data == makeValue("new"));
+}
+
+
+BOOST_AUTO_TEST_CASE(state_view_sees_removed_accounts)
+{
+    lk::StateManager state_manager;
+    auto client = makeAddress(1);
+    auto beneficiary = makeAddress(2);
+    fundAccount(state_manager, client, 1000);
+
+    auto first = state_manager.createCommit();
+    auto contract = first.createContractAccount(client, base::Sha256::compute(base::Bytes("code")));
+    first.setStorageValue(contract, makeKey(1), makeValue("1"));
+    state_manager.applyCommit(std::move(first));
+
+    auto before_removal = state_manager.createView();
+    auto also_before_removal = state_manager.createView();
+    auto removal = state_manager.createCommit();
+    BOOST_CHECK(removal.deleteAccount(contract, beneficiary));
+    state_manager.applyCommit(std::move(removal));
+
+    auto after_removal = state_manager.createView();
+    state_manager.applyBlockEmission(beneficiary, 100);
+
+    for (const auto* view : { &before_removal, &also_before_removal }) {
+        auto commit = view->createCommit();
+        BOOST_CHECK(commit.hasAccount(contract));
+        BOOST_CHECK(commit.getStorageValue(contract, makeKey(1)).data == makeValue("1"));
+        BOOST_CHECK(!commit.hasAccount(beneficiary));
+    }
+
+    auto commit = after_removal.createCommit();
+    BOOST_CHECK(!commit.hasAccount(contract));
+    BOOST_CHECK_EQUAL(commit.getBalance(beneficiary), 0);
+    BOOST_CHECK_EQUAL(state_manager.getBalance(beneficiary), 100);
+}
+
+
+BOOST_AUTO_TEST_CASE(state_view_survives_state_import)
+{
+    lk::StateManager source;
+    auto client = makeAddress(1);
+    fundAccount(source, client, 500);
+    auto state_root = source.updateStateRoot();
+    auto state = source.exportState();
+
+    lk::StateManager state_manager;
+    auto other = makeAddress(2);
+    fundAccount(state_manager, other, 1000);
+    auto view = state_manager.createView();
+    BOOST_CHECK(state_manager.importState(state, state_root));
+    state_manager.applyBlockEmission(other, 10);
+
+    auto commit = view.createCommit();
+    BOOST_CHECK_EQUAL(commit.getBalance(other), 1000);
+    BOOST_CHECK(!commit.hasAccount(client));
+    BOOST_CHECK_EQUAL(state_manager.getBalance(client), 500);
+    BOOST_CHECK_EQUAL(state_manager.getBalance(other), 10);
+}
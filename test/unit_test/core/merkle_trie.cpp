@@ -0,0 +1,129 @@
+#include <boost/test/unit_test.hpp>
+
+#include "core/merkle_trie.hpp"
+
+#include <algorithm>
+#include <random>
+
+namespace
+{
+
+base::Sha256 makeHash(std::size_t seed)
+{
+    return base::Sha256::compute(base::Bytes(std::to_string(seed)));
+}
+
+
+lk::MerkleTrie::Changes makeChanges(std::size_t begin, std::size_t end)
+{
+    lk::MerkleTrie::Changes changes;
+    for (std::size_t i = begin; i < end; ++i) {
+        changes.emplace_back(makeHash(i), makeHash(i + 1'000'000));
+    }
+    return changes;
+}
+
+} // namespace
+
+
+BOOST_AUTO_TEST_CASE(merkle_trie_empty_root)
+{
+    lk::MerkleTrie trie;
+    BOOST_CHECK(trie.update(lk::MerkleTrie::emptyRoot(), {}) == lk::MerkleTrie::emptyRoot());
+    BOOST_CHECK(!trie.find(lk::MerkleTrie::emptyRoot(), makeHash(1)));
+    BOOST_CHECK(trie.update(lk::MerkleTrie::emptyRoot(), { { makeHash(1), std::nullopt } }) ==
+                lk::MerkleTrie::emptyRoot());
+}
+
+
+BOOST_AUTO_TEST_CASE(merkle_trie_find)
+{
+    lk::MerkleTrie trie;
+    auto root = trie.update(lk::MerkleTrie::emptyRoot(), makeChanges(0, 1000));
+    BOOST_CHECK(root != lk::MerkleTrie::emptyRoot());
+    for (std::size_t i = 0; i < 1000; ++i) {
+        auto value = trie.find(root, makeHash(i));
+        BOOST_REQUIRE(value);
+        BOOST_CHECK(*value == makeHash(i + 1'000'000));
+    }
+    BOOST_CHECK(!trie.find(root, makeHash(1000)));
+}
+
+
+BOOST_AUTO_TEST_CASE(merkle_trie_root_does_not_depend_on_order)
+{
+    auto changes = makeChanges(0, 500);
+    lk::MerkleTrie trie;
+    auto root = trie.update(lk::MerkleTrie::emptyRoot(), changes);
+
+    std::mt19937 rng{ 2020 };
+    std::shuffle(changes.begin(), changes.end(), rng);
+    BOOST_CHECK(trie.update(lk::MerkleTrie::emptyRoot(), changes) == root);
+
+    auto incremental_root = lk::MerkleTrie::emptyRoot();
+    for (std::size_t i = 0; i < changes.size(); i += 37) {
+        lk::MerkleTrie::Changes part(changes.begin() + i, changes.begin() + std::min(i + 37, changes.size()));
+        incremental_root = trie.update(incremental_root, std::move(part));
+    }
+    BOOST_CHECK(incremental_root == root);
+}
+
+
+BOOST_AUTO_TEST_CASE(merkle_trie_update_and_remove)
+{
+    lk::MerkleTrie trie;
+    auto old_root = trie.update(lk::MerkleTrie::emptyRoot(), makeChanges(0, 100));
+
+    auto new_root = trie.update(old_root, { { makeHash(5), makeHash(5) }, { makeHash(1000), makeHash(1000) } });
+    BOOST_CHECK(new_root != old_root);
+    BOOST_CHECK(*trie.find(new_root, makeHash(5)) == makeHash(5));
+    BOOST_CHECK(*trie.find(new_root, makeHash(1000)) == makeHash(1000));
+    // previous version is still available
+    BOOST_CHECK(*trie.find(old_root, makeHash(5)) == makeHash(1'000'005));
+    BOOST_CHECK(!trie.find(old_root, makeHash(1000)));
+
+    auto restored_root =
+      trie.update(new_root, { { makeHash(5), makeHash(1'000'005) }, { makeHash(1000), std::nullopt } });
+    BOOST_CHECK(restored_root == old_root);
+
+    lk::MerkleTrie::Changes removals;
+    for (std::size_t i = 0; i < 100; ++i) {
+        removals.emplace_back(makeHash(i), std::nullopt);
+    }
+    BOOST_CHECK(trie.update(old_root, std::move(removals)) == lk::MerkleTrie::emptyRoot());
+}
+
+
+BOOST_AUTO_TEST_CASE(merkle_trie_last_change_wins)
+{
+    lk::MerkleTrie trie;
+    lk::MerkleTrie::Changes changes{ { makeHash(1), makeHash(2) },
+                                     { makeHash(1), std::nullopt },
+                                     { makeHash(1), makeHash(3) } };
+    auto root = trie.update(lk::MerkleTrie::emptyRoot(), std::move(changes));
+    BOOST_CHECK(root == trie.update(lk::MerkleTrie::emptyRoot(), { { makeHash(1), makeHash(3) } }));
+}
+
+
+BOOST_AUTO_TEST_CASE(merkle_trie_flushed_nodes_are_loaded)
+{
+    std::filesystem::path path_to_data_base_folder("local_test_base");
+    auto data_base = base::createClearDatabaseInstance(path_to_data_base_folder);
+
+    base::Sha256 root = lk::MerkleTrie::emptyRoot();
+    {
+        lk::MerkleTrie trie{ data_base };
+        root = trie.update(root, makeChanges(0, 100));
+        base::Database::Batch batch;
+        trie.flush(batch);
+        BOOST_CHECK(!batch.isEmpty());
+        data_base.write(std::move(batch));
+    }
+
+    lk::MerkleTrie trie{ data_base };
+    for (std::size_t i = 0; i < 100; ++i) {
+        BOOST_CHECK(trie.find(root, makeHash(i)) == makeHash(i + 1'000'000));
+    }
+
+    std::filesystem::remove_all(path_to_data_base_folder);
+}
@@ -0,0 +1,279 @@
+#include <boost/test/unit_test.hpp>
+
+#include "core/parallel_executor.hpp"
+
+#include "base/error.hpp"
+
+#include <random>
+
+namespace
+{
+
+constexpr std::size_t CLIENTS_COUNT = 20;
+constexpr std::size_t CONTRACTS_COUNT = 3;
+constexpr std::size_t SLOTS_COUNT = 4;
+
+
+lk::Address makeAddress(std::size_t seed)
+{
+    return lk::Address(base::Ripemd160::compute(base::Bytes(std::to_string(seed))).getBytes());
+}
+
+
+base::Sha256 makeKey(std::size_t seed)
+{
+    return base::Sha256::compute(base::Bytes(std::to_string(seed)));
+}
+
+
+lk::StorageValue toWord(std::size_t value)
+{
+    lk::StorageValue word;
+    for (std::size_t i = 0; i < sizeof(value); ++i) {
+        word[word.size() - 1 - i] = static_cast<base::Byte>(value >> (8 * i));
+    }
+    return word;
+}
+
+
+std::size_t fromWord(const lk::StorageValue& word)
+{
+    std::size_t value = 0;
+    for (std::size_t i = word.size() - sizeof(value); i < word.size(); ++i) {
+        value = (value << 8) | word[i];
+    }
+    return value;
+}
+
+
+struct Task
+{
+    enum class Type
+    {
+        TRANSFER,
+        INCREMENT,
+        SPEND_FEES
+    };
+
+    Type type;
+    std::size_t from;
+    std::size_t to; // a client for a transfer, a contract for an increment
+    std::size_t slot;
+    lk::Balance amount;
+};
+
+
+struct Accounts
+{
+    lk::Address coinbase;
+    std::vector<lk::Address> clients;
+    std::vector<lk::Address> contracts;
+};
+
+
+Accounts prepareState(lk::StateManager& state_manager)
+{
+    Accounts accounts{ makeAddress(0), {}, {} };
+    for (std::size_t i = 1; i <= CLIENTS_COUNT; ++i) {
+        accounts.clients.push_back(makeAddress(i));
+        state_manager.applyBlockEmission(accounts.clients.back(), 1000);
+    }
+    state_manager.applyBlockEmission(accounts.coinbase, 1000);
+
+    auto commit = state_manager.createCommit();
+    for (std::size_t i = 0; i < CONTRACTS_COUNT; ++i) {
+        accounts.contracts.push_back(commit.createContractAccount(accounts.clients[i], makeKey(i)));
+    }
+    state_manager.applyCommit(std::move(commit));
+    return accounts;
+}
+
+
+std::vector<Task> makeTasks(std::size_t count, bool with_contracts, bool with_coinbase, std::uint64_t seed)
+{
+    std::mt19937_64 rng{ seed };
+    std::uniform_int_distribution<std::size_t> client{ 0, CLIENTS_COUNT - 1 };
+    std::uniform_int_distribution<std::size_t> contract{ 0, CONTRACTS_COUNT - 1 };
+    std::uniform_int_distribution<std::size_t> slot{ 0, SLOTS_COUNT - 1 };
+    std::uniform_int_distribution<std::size_t> amount{ 0, 400 };
+    std::uniform_int_distribution<std::size_t> type{ 0, 9 };
+
+    std::vector<Task> tasks;
+    for (std::size_t i = 0; i < count; ++i) {
+        auto t = type(rng);
+        if (with_coinbase && t == 0) {
+            tasks.push_back({ Task::Type::SPEND_FEES, 0, client(rng), 0, 0 });
+        }
+        else if (with_contracts && t < 5) {
+            tasks.push_back({ Task::Type::INCREMENT, client(rng), contract(rng), slot(rng), 0 });
+        }
+        else {
+            tasks.push_back({ Task::Type::TRANSFER, client(rng), client(rng), 0, amount(rng) });
+        }
+    }
+    return tasks;
+}
+
+
+// mimics a transaction: the nonce is increased and the fee is paid to the coinbase, whatever the outcome is
+bool perform(lk::Commit& commit, const Accounts& accounts, const Task& task, std::size_t task_index)
+{
+    const auto& from = task.type == Task::Type::SPEND_FEES ? accounts.coinbase : accounts.clients[task.from];
+    commit.addTxHash(from, makeKey(task_index));
+    commit.payFee(from, accounts.coinbase, 1);
+
+    switch (task.type) {
+        case Task::Type::TRANSFER:
+            return commit.tryTransferMoney(from, accounts.clients[task.to], task.amount);
+        case Task::Type::INCREMENT: {
+            const auto& contract = accounts.contracts[task.to];
+            auto key = makeKey(task.slot).getBytes();
+            std::size_t value = 0;
+            if (commit.checkStorageValue(contract, key)) {
+                value = fromWord(commit.getStorageValue(contract, key).data);
+            }
+            commit.setStorageValue(contract, key, toWord(value + 1));
+            return true;
+        }
+        case Task::Type::SPEND_FEES:
+            return commit.tryTransferMoney(from, accounts.clients[task.to], commit.getBalance(from) / 2);
+    }
+    return false;
+}
+
+
+struct Outcome
+{
+    base::Bytes state;
+    std::vector<bool> results;
+    std::vector<std::size_t> applied_order;
+    std::size_t reexecuted_count;
+};
+
+
+Outcome run(std::size_t threads_count, const std::vector<Task>& tasks)
+{
+    lk::StateManager state_manager;
+    auto accounts = prepareState(state_manager);
+
+    std::vector<char> results(tasks.size());
+    Outcome outcome;
+    lk::ParallelExecutor executor{ threads_count };
+    outcome.reexecuted_count = executor.execute(
+      state_manager,
+      tasks.size(),
+      [&](std::size_t i, lk::Commit& commit) { results[i] = perform(commit, accounts, tasks[i], i); },
+      [&](std::size_t i) { outcome.applied_order.push_back(i); });
+
+    outcome.state = state_manager.exportState();
+    outcome.results.assign(results.begin(), results.end());
+    return outcome;
+}
+
+
+void checkSameAsSequential(const std::vector<Task>& tasks)
+{
+    auto sequential = run(1, tasks);
+    for (std::size_t threads_count : { 2, 4, 8 }) {
+        auto parallel = run(threads_count, tasks);
+        BOOST_CHECK(parallel.state == sequential.state);
+        BOOST_CHECK(parallel.results == sequential.results);
+        BOOST_CHECK(parallel.applied_order == sequential.applied_order);
+    }
+}
+
+} // namespace
+
+
+BOOST_AUTO_TEST_CASE(parallel_executor_transfers_same_as_sequential)
+{
+    for (std::uint64_t seed = 0; seed < 10; ++seed) {
+        checkSameAsSequential(makeTasks(100, false, false, seed));
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(parallel_executor_contract_storage_same_as_sequential)
+{
+    for (std::uint64_t seed = 0; seed < 10; ++seed) {
+        checkSameAsSequential(makeTasks(100, true, false, seed));
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(parallel_executor_coinbase_reads_same_as_sequential)
+{
+    for (std::uint64_t seed = 0; seed < 10; ++seed) {
+        checkSameAsSequential(makeTasks(100, true, true, seed));
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(parallel_executor_applies_in_order)
+{
+    auto tasks = makeTasks(50, true, true, 2020);
+    auto outcome = run(4, tasks);
+    BOOST_REQUIRE_EQUAL(outcome.applied_order.size(), tasks.size());
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        BOOST_CHECK_EQUAL(outcome.applied_order[i], i);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(parallel_executor_fees_do_not_conflict)
+{
+    // every task pays a fee to the same coinbase, but senders and receivers are all different
+    std::vector<Task> tasks;
+    for (std::size_t i = 0; i < CLIENTS_COUNT / 2; ++i) {
+        tasks.push_back({ Task::Type::TRANSFER, i, CLIENTS_COUNT / 2 + i, 0, 100 });
+    }
+    auto outcome = run(4, tasks);
+    BOOST_CHECK_EQUAL(outcome.reexecuted_count, 0);
+    BOOST_CHECK(outcome.state == run(1, tasks).state);
+}
+
+
+BOOST_AUTO_TEST_CASE(parallel_executor_reexecutes_conflicting)
+{
+    lk::StateManager state_manager;
+    auto accounts = prepareState(state_manager);
+    lk::ParallelExecutor executor{ 4 };
+
+    // every task increments the same storage slot, so only the first one is executed against the right state
+    auto reexecuted_count = executor.execute(
+      state_manager,
+      CLIENTS_COUNT,
+      [&](std::size_t i, lk::Commit& commit) {
+          perform(commit, accounts, { Task::Type::INCREMENT, i, 0, 0, 0 }, i);
+      },
+      [](std::size_t) {});
+    BOOST_CHECK_EQUAL(reexecuted_count, CLIENTS_COUNT - 1);
+
+    auto commit = state_manager.createCommit();
+    BOOST_CHECK_EQUAL(fromWord(commit.getStorageValue(accounts.contracts[0], makeKey(0).getBytes()).data),
+                      CLIENTS_COUNT);
+}
+
+
+BOOST_AUTO_TEST_CASE(parallel_executor_rethrows_in_order)
+{
+    lk::StateManager state_manager;
+    auto accounts = prepareState(state_manager);
+    lk::ParallelExecutor executor{ 4 };
+
+    std::vector<std::size_t> applied;
+    BOOST_CHECK_THROW(executor.execute(
+                        state_manager,
+                        10,
+                        [&](std::size_t i, lk::Commit& commit) {
+                            commit.addTxHash(accounts.clients[i], makeKey(i));
+                            if (i == 5) {
+                                RAISE_ERROR(base::LogicError, "task failed");
+                            }
+                        },
+                        [&](std::size_t i) { applied.push_back(i); }),
+                      base::LogicError);
+    BOOST_CHECK_EQUAL(applied.size(), 5);
+    BOOST_CHECK_EQUAL(state_manager.getAccountInfo(accounts.clients[4]).nonce, 1);
+    BOOST_CHECK_EQUAL(state_manager.getAccountInfo(accounts.clients[5]).nonce, 0);
+}
@@ -0,0 +1,100 @@
+#include <boost/test/unit_test.hpp>
+
+#include "core/precompiles.hpp"
+
+namespace
+{
+
+base::Bytes runPrecompile(std::uint8_t number, const base::Bytes& input)
+{
+    const auto* contract = lk::PrecompilesRegistry::getNative().find(lk::getPrecompileAddress(number));
+    BOOST_REQUIRE(contract);
+    return contract->run(input);
+}
+
+
+lk::Fee getPrecompileGas(std::uint8_t number, const base::Bytes& input)
+{
+    const auto* contract = lk::PrecompilesRegistry::getNative().find(lk::getPrecompileAddress(number));
+    BOOST_REQUIRE(contract);
+    return contract->gas(input);
+}
+
+
+// the input of ecrecover: the hash, v, r and s in words
+base::Bytes makeRecoverInput(const base::Sha256& hash, const base::Secp256PrivateKey::Signature& signature)
+{
+    base::Bytes v(32);
+    v[31] = static_cast<base::Byte>(signature[64] + 27);
+    return hash.getBytes().toBytes() + v + signature.toBytes().takePart(0, 64);
+}
+
+} // namespace
+
+
+BOOST_AUTO_TEST_CASE(precompiles_registry_find)
+{
+    const auto& registry = lk::PrecompilesRegistry::getNative();
+    for (std::uint8_t number = 1; number <= 4; ++number) {
+        BOOST_CHECK(registry.find(lk::getPrecompileAddress(number)));
+    }
+    BOOST_CHECK(!registry.find(lk::getPrecompileAddress(5)));
+    BOOST_CHECK(!registry.find(lk::Address::null()));
+    BOOST_CHECK(!registry.find(lk::Address(base::Ripemd160::compute(base::Bytes("contract")).getBytes())));
+
+    base::FixedBytes<lk::Address::LENGTH_IN_BYTES> bytes;
+    bytes[0] = 1;
+    bytes[bytes.size() - 1] = 1;
+    BOOST_CHECK(!registry.find(lk::Address(bytes)));
+
+    lk::PrecompilesRegistry custom;
+    BOOST_CHECK(!custom.find(lk::getPrecompileAddress(9)));
+    custom.add(9, { [](const base::Bytes&) { return lk::Fee{ 1 }; }, [](const base::Bytes& input) { return input; } });
+    BOOST_CHECK(custom.find(lk::getPrecompileAddress(9)));
+}
+
+
+BOOST_AUTO_TEST_CASE(precompiles_hashes_and_identity)
+{
+    const base::Bytes input("some data of the contract");
+    BOOST_CHECK(runPrecompile(2, input) == base::Sha256::compute(input).getBytes().toBytes());
+
+    auto ripemd = runPrecompile(3, input);
+    BOOST_REQUIRE_EQUAL(ripemd.size(), 32);
+    BOOST_CHECK(ripemd.takePart(0, 12) == base::Bytes(12));
+    BOOST_CHECK(ripemd.takePart(12, 32) == base::Ripemd160::compute(input).getBytes().toBytes());
+
+    BOOST_CHECK(runPrecompile(4, input) == input);
+    BOOST_CHECK(runPrecompile(4, base::Bytes{}).isEmpty());
+
+    BOOST_CHECK_EQUAL(getPrecompileGas(1, input), 3'000);
+    BOOST_CHECK_EQUAL(getPrecompileGas(2, base::Bytes{}), 60);
+    BOOST_CHECK_EQUAL(getPrecompileGas(2, base::Bytes(33)), 60 + 2 * 12);
+    BOOST_CHECK_EQUAL(getPrecompileGas(3, base::Bytes(32)), 600 + 120);
+    BOOST_CHECK_EQUAL(getPrecompileGas(4, base::Bytes(64)), 15 + 2 * 3);
+}
+
+
+BOOST_AUTO_TEST_CASE(precompiles_ecrecover)
+{
+    base::Secp256PrivateKey key;
+    const base::Bytes message("message signed by the key");
+    const auto signature = key.sign(message);
+    const auto hash = base::Sha256::compute(message);
+    const auto input = makeRecoverInput(hash, signature);
+
+    auto output = runPrecompile(1, input);
+    BOOST_REQUIRE_EQUAL(output.size(), 32);
+    BOOST_CHECK(output.takePart(0, 12) == base::Bytes(12));
+    BOOST_CHECK(output.takePart(12, 32) == lk::Address(key.toPublicKey()).getBytes().toBytes());
+    BOOST_CHECK(base::Secp256PrivateKey::recoverPublicKey(signature, hash.getBytes()) == key.toPublicKey());
+
+    // v must be 27 or 28 in a word
+    auto wrong_v = input;
+    wrong_v[63] = 29;
+    BOOST_CHECK(runPrecompile(1, wrong_v).isEmpty());
+    wrong_v = input;
+    wrong_v[40] = 1;
+    BOOST_CHECK(runPrecompile(1, wrong_v).isEmpty());
+    BOOST_CHECK(runPrecompile(1, base::Bytes{}).isEmpty());
+}
@@ -0,0 +1,67 @@
+#include <boost/test/unit_test.hpp>
+
+#include "core/rating.hpp"
+
+#include <filesystem>
+
+namespace
+{
+
+const std::filesystem::path PEERS_DATABASE_PATH{ "local_test_peers" };
+
+
+base::PropertyTree getConfig()
+{
+    base::PropertyTree config;
+    config.add("net.peers_db", PEERS_DATABASE_PATH.string());
+    config.add("net.peers_db_options.sync_writes", false);
+    return config;
+}
+
+} // namespace
+
+
+BOOST_AUTO_TEST_CASE(rating_is_shared_by_ratings_of_one_peer)
+{
+    std::filesystem::remove_all(PEERS_DATABASE_PATH);
+    const auto config = getConfig();
+    lk::RatingManager manager{ config };
+    const net::Endpoint ep{ "127.0.0.1:20203" };
+
+    auto rating = manager.get(ep);
+    BOOST_CHECK(rating.isGood());
+    const auto initial_value = rating.getValue();
+
+    manager.get(ep).badBlock();
+    BOOST_CHECK_EQUAL(manager.get(ep).getValue(), initial_value - 10);
+    BOOST_CHECK_EQUAL(manager.get(net::Endpoint{ "127.0.0.1:20204" }).getValue(), initial_value);
+
+    // the change is applied to the shared rating, not to the value read when the rating was taken
+    rating.nonExpectedMessage();
+    BOOST_CHECK(!rating);
+    BOOST_CHECK(!manager.get(ep));
+}
+
+
+BOOST_AUTO_TEST_CASE(rating_is_written_on_flush_and_destruction)
+{
+    std::filesystem::remove_all(PEERS_DATABASE_PATH);
+    const auto config = getConfig();
+    const net::Endpoint flushed_ep{ "127.0.0.1:20203" };
+    const net::Endpoint destroyed_ep{ "127.0.0.1:20204" };
+    lk::Rating::Value flushed_value = 0;
+    {
+        lk::RatingManager manager{ config };
+        flushed_value = manager.get(flushed_ep).badBlock().getValue();
+        manager.flush();
+        manager.get(destroyed_ep).connectionRefused();
+    }
+
+    {
+        lk::RatingManager manager{ config };
+        BOOST_CHECK_EQUAL(manager.get(flushed_ep).getValue(), flushed_value);
+        BOOST_CHECK(flushed_value < manager.get(net::Endpoint{ "127.0.0.1:20205" }).getValue());
+        BOOST_CHECK(!manager.get(destroyed_ep));
+    }
+    std::filesystem::remove_all(PEERS_DATABASE_PATH);
+}
@@ -0,0 +1,101 @@
+#include <boost/test/unit_test.hpp>
+
+#include "core/managers.hpp"
+#include "core/snapshot.hpp"
+
+namespace
+{
+
+lk::Address makeAddress(std::size_t seed)
+{
+    return lk::Address(base::Ripemd160::compute(base::Bytes(std::to_string(seed))).getBytes());
+}
+
+
+base::Sha256 makeKey(std::size_t seed)
+{
+    return base::Sha256::compute(base::Bytes(std::to_string(seed)));
+}
+
+
+void fillState(lk::StateManager& state_manager)
+{
+    for (std::size_t i = 0; i < 100; ++i) {
+        state_manager.applyBlockEmission(makeAddress(i), i + 1);
+    }
+    auto commit = state_manager.createCommit();
+    auto contract = commit.createContractAccount(makeAddress(0), base::Sha256::compute(base::Bytes("code")));
+    commit.setRuntimeCode(contract, base::Bytes("runtime"));
+    for (std::size_t i = 0; i < 100; ++i) {
+        commit.setStorageValue(contract, makeKey(i).getBytes(), makeKey(i + 100).getBytes());
+    }
+    state_manager.applyCommit(std::move(commit));
+}
+
+} // namespace
+
+
+BOOST_AUTO_TEST_CASE(snapshot_manifest_serialization)
+{
+    lk::SnapshotManifest manifest{ 1000, makeKey(1), makeKey(2), { makeKey(3), makeKey(4) } };
+    auto deserialized = base::fromBytes<lk::SnapshotManifest>(base::toBytes(manifest));
+    BOOST_CHECK_EQUAL(deserialized.depth, 1000);
+    BOOST_CHECK(deserialized.block_hash == manifest.block_hash);
+    BOOST_CHECK(deserialized.state_root == manifest.state_root);
+    BOOST_CHECK(deserialized.chunk_hashes == manifest.chunk_hashes);
+}
+
+
+BOOST_AUTO_TEST_CASE(snapshot_chunks_are_assembled_in_any_order)
+{
+    lk::StateManager source;
+    fillState(source);
+    auto state_root = source.updateStateRoot();
+    auto state = source.exportState();
+
+    lk::Snapshot snapshot{ 10, makeKey(1), state_root, state, 100 };
+    const auto& chunk_hashes = snapshot.getManifest().chunk_hashes;
+    BOOST_CHECK_EQUAL(chunk_hashes.size(), (state.size() + 99) / 100);
+
+    lk::SnapshotImport snapshot_import{ snapshot.getManifest() };
+    BOOST_CHECK(!snapshot_import.addChunk(makeKey(1), base::Bytes("foreign chunk")));
+    BOOST_CHECK(!snapshot_import.addChunk(chunk_hashes.front(), base::Bytes("tampered chunk")));
+    for (auto it = chunk_hashes.crbegin(); it != chunk_hashes.crend(); ++it) {
+        BOOST_CHECK(!snapshot_import.isComplete());
+        BOOST_CHECK(snapshot_import.addChunk(*it, *snapshot.findChunk(*it)));
+    }
+    BOOST_CHECK(snapshot_import.isComplete());
+    BOOST_CHECK(snapshot_import.getMissingChunks().empty());
+    BOOST_CHECK(snapshot_import.takeState() == state);
+}
+
+
+BOOST_AUTO_TEST_CASE(state_import_is_checked_against_state_root)
+{
+    lk::StateManager source;
+    fillState(source);
+    auto state_root = source.updateStateRoot();
+    auto state = source.exportState();
+
+    lk::StateManager target;
+    target.applyBlockEmission(makeAddress(1000), 1);
+    auto target_root = target.updateStateRoot();
+
+    BOOST_CHECK(!target.importState(state, makeKey(1)));
+    BOOST_CHECK(target.getStateRoot() == target_root);
+    BOOST_CHECK(target.hasAccount(makeAddress(1000)));
+    BOOST_CHECK(!target.hasAccount(makeAddress(1)));
+
+    BOOST_CHECK(!target.importState(base::Bytes("garbage"), state_root));
+    BOOST_CHECK(target.getStateRoot() == target_root);
+
+    BOOST_CHECK(target.importState(state, state_root));
+    BOOST_CHECK(target.getStateRoot() == state_root);
+    BOOST_CHECK(!target.hasAccount(makeAddress(1000)));
+    BOOST_CHECK_EQUAL(target.getBalance(makeAddress(42)), 43);
+    BOOST_CHECK(target.exportState() == state);
+    // the imported state continues to be updated incrementally
+    target.applyBlockEmission(makeAddress(42), 1);
+    source.applyBlockEmission(makeAddress(42), 1);
+    BOOST_CHECK(target.updateStateRoot() == source.updateStateRoot());
+}
@@ -0,0 +1,116 @@
+#include <boost/test/unit_test.hpp>
+
+#include "core/trace.hpp"
+
+#include <thread>
+
+namespace
+{
+
+lk::Address makeAddress(const std::string& seed)
+{
+    return lk::Address(base::Ripemd160::compute(base::Bytes(seed)).getBytes());
+}
+
+
+lk::ExecutionTrace::Frame makeFrame(const lk::Address& address, std::uint32_t depth, lk::Fee gas_used, long time)
+{
+    return lk::ExecutionTrace::Frame{ address, depth, gas_used, std::chrono::nanoseconds{ time }, true };
+}
+
+} // namespace
+
+
+BOOST_AUTO_TEST_CASE(execution_trace_host_calls)
+{
+    lk::ExecutionTrace trace;
+    for (const auto& statistics : trace.getHostCalls()) {
+        BOOST_CHECK_EQUAL(statistics.count, 0);
+        BOOST_CHECK(statistics.time.count() == 0);
+    }
+
+    trace.addHostCall(lk::ExecutionTrace::HostCall::GET_STORAGE, std::chrono::nanoseconds{ 10 });
+    trace.addHostCall(lk::ExecutionTrace::HostCall::GET_STORAGE, std::chrono::nanoseconds{ 5 });
+    trace.addHostCall(lk::ExecutionTrace::HostCall::EMIT_LOG, std::chrono::nanoseconds{ 7 });
+    trace.setTime(std::chrono::nanoseconds{ 100 });
+
+    const auto& storage = trace.getHostCalls()[static_cast<std::size_t>(lk::ExecutionTrace::HostCall::GET_STORAGE)];
+    BOOST_CHECK_EQUAL(storage.count, 2);
+    BOOST_CHECK(storage.time.count() == 15);
+    const auto& log = trace.getHostCalls()[static_cast<std::size_t>(lk::ExecutionTrace::HostCall::EMIT_LOG)];
+    BOOST_CHECK_EQUAL(log.count, 1);
+    BOOST_CHECK_EQUAL(trace.getHostCalls()[static_cast<std::size_t>(lk::ExecutionTrace::HostCall::CALL)].count, 0);
+    BOOST_CHECK(trace.getTime().count() == 100);
+
+    BOOST_CHECK_EQUAL(std::string(lk::ExecutionTrace::getName(lk::ExecutionTrace::HostCall::SET_STORAGE)),
+                      "set_storage");
+    BOOST_CHECK_EQUAL(std::string(lk::ExecutionTrace::getName(lk::ExecutionTrace::HostCall::EMIT_LOG)), "emit_log");
+}
+
+
+BOOST_AUTO_TEST_CASE(host_call_scope)
+{
+    {
+        lk::HostCallScope scope{ nullptr, lk::ExecutionTrace::HostCall::CALL };
+    }
+
+    lk::ExecutionTrace trace;
+    {
+        lk::HostCallScope scope{ &trace, lk::ExecutionTrace::HostCall::CALL };
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    const auto& call = trace.getHostCalls()[static_cast<std::size_t>(lk::ExecutionTrace::HostCall::CALL)];
+    BOOST_CHECK_EQUAL(call.count, 1);
+    BOOST_CHECK(call.time >= std::chrono::milliseconds(1));
+}
+
+
+BOOST_AUTO_TEST_CASE(execution_profile_own_gas_and_time)
+{
+    const auto a = makeAddress("a");
+    const auto b = makeAddress("b");
+    const auto c = makeAddress("c");
+
+    // a calls b, which calls c, and then a calls c; the frames end in post-order
+    lk::ExecutionTrace first;
+    first.addFrame(makeFrame(c, 2, 100, 10));
+    first.addFrame(makeFrame(b, 1, 300, 40));
+    first.addFrame(makeFrame(c, 1, 200, 20));
+    first.addFrame(makeFrame(a, 0, 1'000, 100));
+    first.addHostCall(lk::ExecutionTrace::HostCall::CALL, std::chrono::nanoseconds{ 70 });
+    first.setTime(std::chrono::nanoseconds{ 120 });
+
+    // a transaction, that calls b only
+    lk::ExecutionTrace second;
+    second.addFrame(makeFrame(b, 0, 50, 5));
+    second.setTime(std::chrono::nanoseconds{ 8 });
+
+    lk::ExecutionProfile profile;
+    profile.add(first);
+    profile.add(second);
+
+    BOOST_CHECK_EQUAL(profile.getTransactionsCount(), 2);
+    BOOST_CHECK(profile.getTime().count() == 128);
+    BOOST_CHECK_EQUAL(profile.getHostCalls()[static_cast<std::size_t>(lk::ExecutionTrace::HostCall::CALL)].count, 1);
+
+    auto contracts = profile.getContracts();
+    BOOST_REQUIRE_EQUAL(contracts.size(), 3);
+
+    // a: 1000 - 300 - 200 gas, 100 - 40 - 20 ns
+    BOOST_CHECK(contracts[0].first == a);
+    BOOST_CHECK_EQUAL(contracts[0].second.calls_count, 1);
+    BOOST_CHECK_EQUAL(contracts[0].second.gas_used, 500);
+    BOOST_CHECK(contracts[0].second.time.count() == 40);
+
+    // b: 300 - 100 + 50 gas, 40 - 10 + 5 ns
+    BOOST_CHECK(contracts[1].first == b);
+    BOOST_CHECK_EQUAL(contracts[1].second.calls_count, 2);
+    BOOST_CHECK_EQUAL(contracts[1].second.gas_used, 250);
+    BOOST_CHECK(contracts[1].second.time.count() == 35);
+
+    // c: 100 + 200 gas, 10 + 20 ns
+    BOOST_CHECK(contracts[2].first == c);
+    BOOST_CHECK_EQUAL(contracts[2].second.calls_count, 2);
+    BOOST_CHECK_EQUAL(contracts[2].second.gas_used, 300);
+    BOOST_CHECK(contracts[2].second.time.count() == 30);
+}
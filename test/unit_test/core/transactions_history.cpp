@@ -0,0 +1,88 @@
+#include <boost/test/unit_test.hpp>
+
+#include "core/transactions_history.hpp"
+
+namespace
+{
+
+const std::filesystem::path DATABASE_PATH{ "local_test_base" };
+
+
+lk::Address makeAddress(std::size_t seed)
+{
+    return lk::Address(base::Ripemd160::compute(base::Bytes(std::to_string(seed))).getBytes());
+}
+
+
+base::Sha256 makeHash(std::size_t seed)
+{
+    return base::Sha256::compute(base::Bytes(std::to_string(seed)));
+}
+
+
+std::vector<base::Sha256> makeHashes(std::size_t begin, std::size_t end)
+{
+    std::vector<base::Sha256> hashes;
+    for (std::size_t i = begin; i < end; ++i) {
+        hashes.push_back(makeHash(i));
+    }
+    return hashes;
+}
+
+} // namespace
+
+
+BOOST_AUTO_TEST_CASE(transactions_history_pages)
+{
+    lk::TransactionsHistory history;
+    const auto address = makeAddress(1);
+    const auto other_address = makeAddress(2);
+    for (std::size_t i = 0; i < 10; ++i) {
+        history.add(address, i, makeHash(i));
+        history.add(other_address, i, makeHash(100 + i));
+    }
+
+    BOOST_CHECK(history.getPage(address, 0, 4) == makeHashes(0, 4));
+    BOOST_CHECK(history.getPage(address, 8, 4) == makeHashes(8, 10));
+    BOOST_CHECK(history.getPage(address, 10, 4).empty());
+    BOOST_CHECK(history.getPage(other_address, 3, 2) == makeHashes(103, 105));
+    BOOST_CHECK(history.getPage(makeAddress(3), 0, 4).empty());
+
+    history.remove(address, 0);
+    BOOST_CHECK(history.getPage(address, 0, 2) == makeHashes(1, 3));
+}
+
+
+BOOST_AUTO_TEST_CASE(transactions_history_merges_flushed_and_unflushed)
+{
+    auto database = base::createClearDatabaseInstance(DATABASE_PATH);
+    const auto address = makeAddress(1);
+    {
+        lk::TransactionsHistory history{ database };
+        for (std::size_t i = 0; i < 6; ++i) {
+            history.add(address, i, makeHash(i));
+        }
+        base::Database::Batch batch;
+        history.flush(batch);
+        database.write(std::move(batch));
+
+        for (std::size_t i = 6; i < 10; ++i) {
+            history.add(address, i, makeHash(i));
+        }
+        history.remove(address, 0);
+        history.remove(address, 1);
+        // removals are not written yet, but the page skips them
+        BOOST_CHECK(history.getPage(address, 0, 6) == makeHashes(2, 8));
+        BOOST_CHECK(history.getPage(address, 5, 3) == makeHashes(5, 8));
+
+        base::Database::Batch next_batch;
+        history.flush(next_batch);
+        database.write(std::move(next_batch));
+    }
+
+    lk::TransactionsHistory history{ database };
+    BOOST_CHECK(history.getPage(address, 0, 100) == makeHashes(2, 10));
+    BOOST_CHECK(history.getPage(address, 4, 2) == makeHashes(4, 6));
+
+    std::filesystem::remove_all(DATABASE_PATH);
+}
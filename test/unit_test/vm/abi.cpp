@@ -0,0 +1,340 @@
+#include <boost/test/unit_test.hpp>
+
+#include "vm/abi.hpp"
+#include "vm/tools.hpp"
+
+#include <boost/property_tree/json_parser.hpp>
+
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+
+// examples of the Solidity ABI specification
+const char* const SPEC_ABI = R"([
+  {"type": "function", "name": "baz", "inputs": [{"name": "x", "type": "uint32"}, {"name": "y", "type": "bool"}],
+   "outputs": [{"name": "", "type": "bool"}]},
+  {"type": "function", "name": "bar", "inputs": [{"name": "", "type": "bytes3[2]"}], "outputs": []},
+  {"type": "function", "name": "sam",
+   "inputs": [{"name": "", "type": "bytes"}, {"name": "", "type": "bool"}, {"name": "", "type": "uint[]"}],
+   "outputs": []},
+  {"type": "function", "name": "f",
+   "inputs": [{"name": "", "type": "uint"}, {"name": "", "type": "uint32[]"}, {"name": "", "type": "bytes10"},
+              {"name": "", "type": "bytes"}],
+   "outputs": []},
+  {"type": "function", "name": "g", "inputs": [{"name": "", "type": "uint[][]"}, {"name": "", "type": "string[]"}],
+   "outputs": []}
+])";
+
+
+const char* const TOKEN_ABI = R"([
+  {"type": "constructor", "inputs": [{"name": "owner", "type": "address"}, {"name": "supply", "type": "uint256"}]},
+  {"type": "function", "name": "transfer",
+   "inputs": [{"name": "to", "type": "address"}, {"name": "value", "type": "uint256"}],
+   "outputs": [{"name": "", "type": "bool"}]},
+  {"type": "function", "name": "set", "inputs": [{"name": "value", "type": "int64"}], "outputs": []},
+  {"type": "function", "name": "set", "inputs": [{"name": "value", "type": "string"}], "outputs": []},
+  {"type": "function", "name": "info", "inputs": [],
+   "outputs": [{"name": "value", "type": "uint256"}, {"name": "owner", "type": "address"},
+               {"name": "delta", "type": "int8"}, {"name": "note", "type": "string"},
+               {"name": "hash", "type": "bytes32"},
+               {"name": "pair", "type": "tuple", "components": [{"name": "a", "type": "uint8"},
+                                                                {"name": "b", "type": "bytes"}]},
+               {"name": "list", "type": "uint16[]"}]}
+])";
+
+
+boost::property_tree::ptree parseJson(const std::string& json)
+{
+    std::istringstream input(json);
+    boost::property_tree::ptree tree;
+    boost::property_tree::read_json(input, tree);
+    return tree;
+}
+
+
+vm::abi::ContractAbi makeAbi(const std::string& json)
+{
+    return vm::abi::ContractAbi(parseJson(json));
+}
+
+
+base::Bytes encodeCall(const vm::abi::ContractAbi& abi, const std::string& name, const std::string& arguments)
+{
+    return abi.encodeCall(name, vm::abi::parseArguments(arguments));
+}
+
+
+lk::Address makeAddress(const std::string& seed)
+{
+    return lk::Address(base::Ripemd160::compute(base::Bytes(seed)).getBytes());
+}
+
+
+vm::abi::Value::Integer makeInteger(long long value)
+{
+    return vm::abi::Value::Integer{ value };
+}
+
+
+struct ContractFolder
+{
+    std::filesystem::path path{ std::filesystem::temp_directory_path() / "likelib_abi_test_contract" };
+
+    ContractFolder(const std::string& code, const std::string& abi)
+    {
+        std::filesystem::create_directories(path);
+        write(code, abi);
+    }
+
+    ~ContractFolder()
+    {
+        std::filesystem::remove_all(path);
+    }
+
+    // the files are stamped as written later, than any previous version, even within the same clock tick
+    void write(const std::string& code, const std::string& abi)
+    {
+        const auto write_time = std::filesystem::file_time_type::clock::now() + std::chrono::seconds(++_version);
+        std::ofstream(path / "compiled_code.bin") << code;
+        std::ofstream(path / "metadata.json") << R"({"output": {"abi": )" << abi << "}}";
+        std::filesystem::last_write_time(path / "compiled_code.bin", write_time);
+        std::filesystem::last_write_time(path / "metadata.json", write_time);
+    }
+
+  private:
+    int _version{ 0 };
+};
+
+} // namespace
+
+
+BOOST_AUTO_TEST_CASE(abi_type_parse)
+{
+    auto array_type = vm::abi::Type::parse("uint[][3]");
+    BOOST_CHECK(array_type.kind == vm::abi::Type::Kind::ARRAY);
+    BOOST_CHECK_EQUAL(array_type.name, "uint256[][3]");
+    BOOST_CHECK_EQUAL(array_type.size, 3);
+    BOOST_CHECK(array_type.isDynamic());
+    BOOST_CHECK(array_type.components.front().kind == vm::abi::Type::Kind::ARRAY);
+    BOOST_CHECK_EQUAL(array_type.components.front().size, 0);
+
+    auto fixed_type = vm::abi::Type::parse("bytes4[2]");
+    BOOST_CHECK(!fixed_type.isDynamic());
+    BOOST_CHECK_EQUAL(fixed_type.getHeadSize(), 64);
+
+    auto tuple_type = vm::abi::Type::parse(
+      "tuple[]", parseJson(R"([{"name": "a", "type": "int8"}, {"name": "b", "type": "address[2]"}])"));
+    BOOST_CHECK_EQUAL(tuple_type.name, "(int8,address[2])[]");
+
+    BOOST_CHECK_THROW(vm::abi::Type::parse("uint7"), base::InvalidArgument);
+    BOOST_CHECK_THROW(vm::abi::Type::parse("bytes33"), base::InvalidArgument);
+    BOOST_CHECK_THROW(vm::abi::Type::parse("uint256[0]"), base::InvalidArgument);
+    BOOST_CHECK_THROW(vm::abi::Type::parse("fixed128x18"), base::InvalidArgument);
+}
+
+
+BOOST_AUTO_TEST_CASE(abi_encode_specification_examples)
+{
+    auto abi = makeAbi(SPEC_ABI);
+
+    BOOST_CHECK_EQUAL(base::toHex(encodeCall(abi, "baz", "69, true")),
+                      "cdcd77c0"
+                      "0000000000000000000000000000000000000000000000000000000000000045"
+                      "0000000000000000000000000000000000000000000000000000000000000001");
+
+    BOOST_CHECK_EQUAL(base::toHex(encodeCall(abi, "bar", R"(["616263", "646566"])")),
+                      "fce353f6"
+                      "6162630000000000000000000000000000000000000000000000000000000000"
+                      "6465660000000000000000000000000000000000000000000000000000000000");
+
+    BOOST_CHECK_EQUAL(base::toHex(encodeCall(abi, "sam", R"("64617665", true, [1, 2, 3])")),
+                      "a5643bf2"
+                      "0000000000000000000000000000000000000000000000000000000000000060"
+                      "0000000000000000000000000000000000000000000000000000000000000001"
+                      "00000000000000000000000000000000000000000000000000000000000000a0"
+                      "0000000000000000000000000000000000000000000000000000000000000004"
+                      "6461766500000000000000000000000000000000000000000000000000000000"
+                      "0000000000000000000000000000000000000000000000000000000000000003"
+                      "0000000000000000000000000000000000000000000000000000000000000001"
+                      "0000000000000000000000000000000000000000000000000000000000000002"
+                      "0000000000000000000000000000000000000000000000000000000000000003");
+
+    BOOST_CHECK_EQUAL(
+      base::toHex(encodeCall(abi, "f", R"(291, [1110, 1929], "31323334353637383930", "48656c6c6f2c20776f726c6421")")),
+      "8be65246"
+      "0000000000000000000000000000000000000000000000000000000000000123"
+      "0000000000000000000000000000000000000000000000000000000000000080"
+      "3132333435363738393000000000000000000000000000000000000000000000"
+      "00000000000000000000000000000000000000000000000000000000000000e0"
+      "0000000000000000000000000000000000000000000000000000000000000002"
+      "0000000000000000000000000000000000000000000000000000000000000456"
+      "0000000000000000000000000000000000000000000000000000000000000789"
+      "000000000000000000000000000000000000000000000000000000000000000d"
+      "48656c6c6f2c20776f726c642100000000000000000000000000000000000000");
+
+    BOOST_CHECK_EQUAL(base::toHex(encodeCall(abi, "g", R"([[1, 2], [3]], ["one", "two", "three"])")),
+                      "2289b18c"
+                      "0000000000000000000000000000000000000000000000000000000000000040"
+                      "0000000000000000000000000000000000000000000000000000000000000140"
+                      "0000000000000000000000000000000000000000000000000000000000000002"
+                      "0000000000000000000000000000000000000000000000000000000000000040"
+                      "00000000000000000000000000000000000000000000000000000000000000a0"
+                      "0000000000000000000000000000000000000000000000000000000000000002"
+                      "0000000000000000000000000000000000000000000000000000000000000001"
+                      "0000000000000000000000000000000000000000000000000000000000000002"
+                      "0000000000000000000000000000000000000000000000000000000000000001"
+                      "0000000000000000000000000000000000000000000000000000000000000003"
+                      "0000000000000000000000000000000000000000000000000000000000000003"
+                      "0000000000000000000000000000000000000000000000000000000000000060"
+                      "00000000000000000000000000000000000000000000000000000000000000a0"
+                      "00000000000000000000000000000000000000000000000000000000000000e0"
+                      "0000000000000000000000000000000000000000000000000000000000000003"
+                      "6f6e650000000000000000000000000000000000000000000000000000000000"
+                      "0000000000000000000000000000000000000000000000000000000000000003"
+                      "74776f0000000000000000000000000000000000000000000000000000000000"
+                      "0000000000000000000000000000000000000000000000000000000000000005"
+                      "7468726565000000000000000000000000000000000000000000000000000000");
+
+    BOOST_CHECK_THROW(encodeCall(abi, "baz", "4294967296, true"), base::InvalidArgument);
+    BOOST_CHECK_THROW(encodeCall(abi, "baz", "69"), base::InvalidArgument);
+    BOOST_CHECK_THROW(encodeCall(abi, "bar", R"(["61626364", "646566"])"), base::InvalidArgument);
+}
+
+
+BOOST_AUTO_TEST_CASE(abi_encode_native_arguments)
+{
+    auto abi = makeAbi(SPEC_ABI);
+    const auto& sam = *abi.findFunction("sam", vm::abi::parseArguments(R"("64617665", true, [1, 2, 3])"));
+    BOOST_CHECK_EQUAL(vm::abi::encodeCall(sam, base::Bytes("dave"), true, std::vector<int>{ 1, 2, 3 }),
+                      encodeCall(abi, "sam", R"("64617665", true, [1, 2, 3])"));
+
+    const auto& g = *abi.findFunction(base::FixedBytes<4>(base::fromHex<base::Bytes>("2289b18c")));
+    BOOST_CHECK_EQUAL(g.signature, "g(uint256[][],string[])");
+    BOOST_CHECK_EQUAL(vm::abi::encodeCall(g,
+                                          std::vector<std::vector<std::uint64_t>>{ { 1, 2 }, { 3 } },
+                                          std::vector<std::string>{ "one", "two", "three" }),
+                      encodeCall(abi, "g", R"([[1, 2], [3]], ["one", "two", "three"])"));
+    BOOST_CHECK_THROW(vm::abi::encodeCall(g, 1, 2), base::InvalidArgument);
+}
+
+
+BOOST_AUTO_TEST_CASE(abi_round_trip)
+{
+    const auto owner = makeAddress("owner");
+    std::vector<vm::abi::Type> types{ vm::abi::Type::parse("int256"),
+                                      vm::abi::Type::parse("int8[]"),
+                                      vm::abi::Type::parse("address"),
+                                      vm::abi::Type::parse("bytes"),
+                                      vm::abi::Type::parse("string"),
+                                      vm::abi::Type::parse("tuple",
+                                                           parseJson(R"([{"name": "a", "type": "uint8"},
+                                                                         {"name": "b", "type": "string[]"},
+                                                                         {"name": "c", "type": "bytes2"}])")) };
+    std::vector<vm::abi::Value> values{
+        { makeInteger(-1) },
+        { vm::abi::Value::List{ { makeInteger(-128) }, { makeInteger(127) }, { makeInteger(0) } } },
+        { owner },
+        { base::Bytes(std::string(100, 'x')) },
+        { std::string("") },
+        { vm::abi::Value::List{ { makeInteger(255) },
+                                { vm::abi::Value::List{ { std::string("a") }, { std::string("bc") } } },
+                                { base::fromHex<base::Bytes>("beef") } } }
+    };
+
+    auto encoded = vm::abi::encode(types, values);
+    BOOST_CHECK_EQUAL(base::toHex(encoded.takePart(0, 32)),
+                      "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff");
+    BOOST_CHECK(vm::abi::decode(types, encoded) == values);
+
+    BOOST_CHECK_THROW(vm::abi::decode(types, encoded.takePart(0, encoded.size() - 64)), base::InvalidArgument);
+    BOOST_CHECK_THROW(vm::abi::decode({ vm::abi::Type::parse("uint8") }, encoded.takePart(0, 32 * 2)),
+                      base::InvalidArgument);
+    BOOST_CHECK_THROW(vm::abi::decode({ vm::abi::Type::parse("bool") }, base::Bytes(31)), base::InvalidArgument);
+
+    // an offset, that points far beyond the data
+    auto malformed = encoded;
+    malformed[32 + 31] = 0xff;
+    malformed[32 + 30] = 0xff;
+    BOOST_CHECK_THROW(vm::abi::decode(types, malformed), base::InvalidArgument);
+}
+
+
+BOOST_AUTO_TEST_CASE(abi_parse_arguments)
+{
+    const auto owner = makeAddress("owner");
+    auto values = vm::abi::parseArguments(" -15 , \"a\\\"b\\u00e9\\n\", [True, false], [], Address(" +
+                                          owner.toString() + ")");
+    BOOST_REQUIRE_EQUAL(values.size(), 5);
+    BOOST_CHECK(values[0] == vm::abi::Value{ makeInteger(-15) });
+    BOOST_CHECK(values[1] == vm::abi::Value{ std::string("a\"b\xc3\xa9\n") });
+    BOOST_CHECK(values[2] == (vm::abi::Value{ vm::abi::Value::List{ { true }, { false } } }));
+    BOOST_CHECK(values[3] == vm::abi::Value{ vm::abi::Value::List{} });
+    BOOST_CHECK(values[4] == vm::abi::Value{ owner });
+
+    BOOST_CHECK(vm::abi::parseArguments("  ").empty());
+    BOOST_CHECK_THROW(vm::abi::parseArguments("1,"), base::ParsingError);
+    BOOST_CHECK_THROW(vm::abi::parseArguments("[1, 2"), base::ParsingError);
+    BOOST_CHECK_THROW(vm::abi::parseArguments("\"abc"), base::ParsingError);
+    BOOST_CHECK_THROW(vm::abi::parseArguments("none"), base::ParsingError);
+    BOOST_CHECK_THROW(vm::abi::parseArguments("Address(1)"), base::ParsingError);
+}
+
+
+BOOST_AUTO_TEST_CASE(abi_encode_decode_message)
+{
+    const auto owner = makeAddress("owner");
+    const auto receiver = makeAddress("receiver");
+    ContractFolder contract{ "6080604052\n", TOKEN_ABI };
+
+    // the address is padded to a word, the same as the bytes32 argument the former encoder got instead of it
+    BOOST_CHECK_EQUAL(vm::encodeMessage(contract.path, "constructor(Address(" + owner.toString() + "), 1000)"),
+                      "6080604052"
+                      "000000000000000000000000" +
+                        base::toHex(owner.getBytes()) +
+                        "00000000000000000000000000000000000000000000000000000000000003e8");
+    BOOST_CHECK_EQUAL(vm::encodeMessage(contract.path, "transfer(Address(" + receiver.toString() + "), 5)"),
+                      "a9059cbb"
+                      "000000000000000000000000" +
+                        base::toHex(receiver.getBytes()) +
+                        "0000000000000000000000000000000000000000000000000000000000000005");
+
+    // overloads are told apart by arguments
+    BOOST_CHECK_EQUAL(vm::encodeMessage(contract.path, "set(-1)").substr(0, 8),
+                      base::toHex(base::Keccak256::compute(base::Bytes("set(int64)")).getBytes()).substr(0, 8));
+    BOOST_CHECK_EQUAL(vm::encodeMessage(contract.path, "set(\"x\")").substr(0, 8),
+                      base::toHex(base::Keccak256::compute(base::Bytes("set(string)")).getBytes()).substr(0, 8));
+    BOOST_CHECK_THROW(vm::encodeMessage(contract.path, "set(true)"), base::InvalidArgument);
+    BOOST_CHECK_THROW(vm::encodeMessage(contract.path, "set(1"), base::InvalidArgument);
+
+    auto abi = makeAbi(TOKEN_ABI);
+    const auto& info = *abi.findFunction("info", {});
+    auto output = vm::abi::encode(
+      info.getOutputTypes(),
+      { { makeInteger(42) },
+        { owner },
+        { makeInteger(-5) },
+        { std::string("caf\xc3\xa9 \"\xf0\x9f\x98\x80\"") },
+        { base::Bytes(32) },
+        { vm::abi::Value::List{ { makeInteger(7) }, { base::fromHex<base::Bytes>("0102") } } },
+        { vm::abi::Value::List{ { makeInteger(1) }, { makeInteger(2) } } } });
+    auto message = base::toHex(info.selector) + base::toHex(output);
+
+    // the same JSON as json.dumps of the former Python decoder gave
+    BOOST_CHECK_EQUAL(vm::decodeMessage(contract.path, message),
+                      R"({"value": 42, "owner": ")" + owner.toString() +
+                        R"(", "delta": -5, "note": "caf\u00e9 \"\ud83d\ude00\"", )"
+                        R"("hash": "0000000000000000000000000000000000000000000000000000000000000000", )"
+                        R"("pair": [7, "0102"], "list": [1, 2]})");
+    const auto& transfer = *abi.findFunction("transfer", { { receiver }, { makeInteger(1) } });
+    BOOST_CHECK_EQUAL(vm::decodeMessage(contract.path, base::toHex(transfer.selector) + std::string(63, '0') + "1"),
+                      R"({"": true})");
+    BOOST_CHECK_THROW(vm::decodeMessage(contract.path, "00000000"), base::InvalidArgument);
+
+    // a recompiled contract is read again, instead of the cached one
+    contract.write("60806040", R"([{"type": "function", "name": "get", "inputs": [], "outputs": []}])");
+    BOOST_CHECK_EQUAL(vm::encodeMessage(contract.path, "constructor()"), "60806040");
+    BOOST_CHECK_EQUAL(vm::encodeMessage(contract.path, "get()"), "6d4ce63c");
+    BOOST_CHECK_THROW(vm::encodeMessage(contract.path, "info()"), base::InvalidArgument);
+}